@@ -14,6 +14,11 @@
 
 if (VN_SDK_SIMD AND TARGET_ARCH MATCHES "^x86")
     target_compile_options(lcevc_dec::compiler INTERFACE -msse4.1)
+    # Applied only to the sources that contain AVX2, AVX-512 or BMI2 kernels, which are selected at
+    # runtime
+    set(VN_SDK_AVX2_COMPILE_OPTIONS -mavx2)
+    set(VN_SDK_AVX512_COMPILE_OPTIONS -mavx2 -mavx512f -mavx512bw -mavx512vl)
+    set(VN_SDK_BMI2_COMPILE_OPTIONS -mbmi2)
 endif ()
 
 if (VN_SDK_COVERAGE)
@@ -756,6 +756,45 @@ LCEVC_ReturnCode LCEVC_SendDecoderEnhancementData( LCEVC_DecoderHandle decHandle
                                                    const uint8_t* data,
                                                    uint32_t byteSize );
 
+/*!
+ * Callback used to return enhancement data passed to SendDecoderEnhancementDataEx.
+ *
+ * @param[in]    data                pointer to the LCEVC enhancement data buffer
+ * @param[in]    byteSize            size of the LCEVC enhancement data buffer
+ * @param[in]    userData            A user pointer that was passed in to
+ *                                   SendDecoderEnhancementDataEx
+ */
+typedef void (*LCEVC_EnhancementDataReleaseCallback)( const uint8_t* data,
+                                                      uint32_t byteSize,
+                                                      void* userData );
+
+/*!
+ * Send enhancement data to the LCEVC Decoder without copying it.
+ *
+ * As SendDecoderEnhancementData, except that the decoder may reference the buffer rather than
+ * copying it. If LCEVC_Success is returned, the buffer must not be modified or freed until the
+ * decoder calls releaseCallback, which it will do exactly once - typically when the decoder has
+ * parsed the data, and at the latest when the decoder is destroyed. The callback may be made from
+ * any decoder thread, or from within this call. If any other value is returned, the callback is
+ * not made, and the buffer remains the client's.
+ *
+ * @param[in]    decHandle           LCEVC Decoder instance
+ * @param[in]    timestamp           Timestamp for the passed LCEVC data
+ * @param[in]    data                pointer to the LCEVC enhancement data buffer
+ * @param[in]    byteSize            size of the LCEVC enhancement data buffer
+ * @param[in]    releaseCallback     Called when the decoder has finished with the buffer
+ * @param[in]    userData            A user pointer that is passed to releaseCallback
+ * @return                           As SendDecoderEnhancementData, or LCEVC_InvalidParam if
+ *                                   data or releaseCallback is NULL.
+ */
+LCEVC_API
+LCEVC_ReturnCode LCEVC_SendDecoderEnhancementDataEx( LCEVC_DecoderHandle decHandle,
+                                                     uint64_t timestamp,
+                                                     const uint8_t* data,
+                                                     uint32_t byteSize,
+                                                     LCEVC_EnhancementDataReleaseCallback releaseCallback,
+                                                     void* userData );
+
 /*!
  * Send a base picture to the LCEVC Decoder.
  *
@@ -477,10 +477,8 @@ LCEVC_ReturnCode LCEVC_ConfigureDecoderStringArray(LCEVC_DecoderHandle decHandle
     }
 
     std::vector<std::string> stringArr(count, "");
-    size_t idx = 0;
-    for (const char* str = *arr; idx < count; idx++) {
-        stringArr[idx] = std::string(str);
-        str++;
+    for (size_t idx = 0; idx < count; idx++) {
+        stringArr[idx] = std::string(arr[idx]);
     }
 
     return internalConfigure(decHandle, name, stringArr);
@@ -503,6 +501,22 @@ LCEVC_API LCEVC_ReturnCode LCEVC_SendDecoderEnhancementData(LCEVC_DecoderHandle
     });
 }
 
+LCEVC_API LCEVC_ReturnCode LCEVC_SendDecoderEnhancementDataEx(
+    LCEVC_DecoderHandle decHandle, uint64_t timestamp, const uint8_t* data, uint32_t byteSize,
+    LCEVC_EnhancementDataReleaseCallback releaseCallback, void* userData)
+{
+    // The callback is only made for a buffer the decoder holds on to, so there must be one
+    if (data == nullptr || releaseCallback == nullptr) {
+        return LCEVC_InvalidParam;
+    }
+
+    return withLockedDecoder(
+        decHandle.hdl, [&timestamp, &data, &byteSize, &releaseCallback, &userData](DecoderContext* context) {
+            return fromLdcReturnCode(context->pipeline()->sendEnhancementDataExternal(
+                timestamp, data, byteSize, releaseCallback, userData));
+        });
+}
+
 LCEVC_API LCEVC_ReturnCode LCEVC_SendDecoderBase(LCEVC_DecoderHandle decHandle, uint64_t timestamp,
                                                  LCEVC_PictureHandle base, uint32_t timeoutUs, void* userData)
 {
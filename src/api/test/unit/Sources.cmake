@@ -18,6 +18,7 @@ set(SOURCES
     "src/decoder_asynchronous.cpp"
     "src/decoder_synchronous.cpp"
     "src/test_api_bad_streams.cpp"
+    "src/test_api_enhancement_data.cpp"
     "src/test_api_events_threaded.cpp"
     "src/test_event_dispatcher.cpp"
     "src/test_pipeline_types.cpp"
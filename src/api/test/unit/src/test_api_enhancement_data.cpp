@@ -0,0 +1,159 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// This tests LCEVC_SendDecoderEnhancementDataEx - enhancement data that is referenced by the
+// decoder until it is released back to the client.
+
+// Define this to use the interface of the API (which normally would be in a dll).
+#define VNDisablePublicAPI
+
+#include "data.h"
+#include "utils.h"
+
+#include <gtest/gtest.h>
+#include <LCEVC/lcevc_dec.h>
+
+#include <map>
+#include <vector>
+
+static const int64_t kFrameCount = 9;
+
+// Counts the number of times each buffer has been released
+using ReleaseCounts = std::map<const uint8_t*, uint32_t>;
+
+static void releaseEnhancementData(const uint8_t* data, uint32_t /*byteSize*/, void* userData)
+{
+    (*static_cast<ReleaseCounts*>(userData))[data]++;
+}
+
+class APIEnhancementDataExFixture : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_EQ(LCEVC_CreateDecoder(&m_decHdl, {}), LCEVC_Success);
+        ASSERT_EQ(LCEVC_ConfigureDecoderInt(m_decHdl, "log_level", 1), LCEVC_Success);
+        ASSERT_EQ(LCEVC_ConfigureDecoderInt(m_decHdl, "threads", 1), LCEVC_Success);
+        ASSERT_EQ(LCEVC_InitializeDecoder(m_decHdl), LCEVC_Success);
+
+        // Client owned copies of the enhancement data
+        for (int64_t pts = 0; pts < kFrameCount; ++pts) {
+            const EnhancementWithData enhancement = getEnhancement(pts, kValidEnhancements);
+            m_enhancements.emplace_back(enhancement.first, enhancement.first + enhancement.second);
+        }
+    }
+
+    void TearDown() override { destroyDecoder(); }
+
+    void destroyDecoder()
+    {
+        if (m_decHdl.hdl) {
+            LCEVC_DestroyDecoder(m_decHdl);
+            m_decHdl = {};
+        }
+    }
+
+    LCEVC_ReturnCode sendEnhancement(int64_t pts)
+    {
+        const std::vector<uint8_t>& enhancement = m_enhancements[pts];
+        return LCEVC_SendDecoderEnhancementDataEx(m_decHdl, pts, enhancement.data(),
+                                                  static_cast<uint32_t>(enhancement.size()),
+                                                  releaseEnhancementData, &m_releaseCounts);
+    }
+
+    uint32_t releaseCount(int64_t pts) { return m_releaseCounts[m_enhancements[pts].data()]; }
+
+    LCEVC_DecoderHandle m_decHdl = {};
+    std::vector<std::vector<uint8_t>> m_enhancements;
+    ReleaseCounts m_releaseCounts;
+};
+
+TEST_F(APIEnhancementDataExFixture, NullCallbackIsInvalid)
+{
+    const std::vector<uint8_t>& enhancement = m_enhancements[0];
+    EXPECT_EQ(LCEVC_SendDecoderEnhancementDataEx(m_decHdl, 0, enhancement.data(),
+                                                 static_cast<uint32_t>(enhancement.size()),
+                                                 nullptr, nullptr),
+              LCEVC_InvalidParam);
+}
+
+TEST_F(APIEnhancementDataExFixture, NullDataIsInvalid)
+{
+    EXPECT_EQ(LCEVC_SendDecoderEnhancementDataEx(m_decHdl, 0, nullptr, 0, releaseEnhancementData,
+                                                 &m_releaseCounts),
+              LCEVC_InvalidParam);
+
+    // The buffer remains the client's, so the callback is never made
+    destroyDecoder();
+    EXPECT_TRUE(m_releaseCounts.empty());
+}
+
+TEST_F(APIEnhancementDataExFixture, ReleasedOnceAfterDecode)
+{
+    LCEVC_PictureDesc inputDesc = {};
+    LCEVC_PictureDesc outputDesc = {};
+    LCEVC_DefaultPictureDesc(&inputDesc, LCEVC_I420_8, 960, 540);
+    LCEVC_DefaultPictureDesc(&outputDesc, LCEVC_I420_8, 1920, 1080);
+
+    for (int64_t pts = 0; pts < kFrameCount; ++pts) {
+        ASSERT_EQ(sendEnhancement(pts), LCEVC_Success);
+
+        LCEVC_PictureHandle baseHdl = {};
+        ASSERT_EQ(LCEVC_AllocPicture(m_decHdl, &inputDesc, &baseHdl), LCEVC_Success);
+        ASSERT_EQ(LCEVC_SendDecoderBase(m_decHdl, pts, baseHdl, UINT32_MAX, nullptr), LCEVC_Success);
+
+        LCEVC_PictureHandle outputHdl = {};
+        ASSERT_EQ(LCEVC_AllocPicture(m_decHdl, &outputDesc, &outputHdl), LCEVC_Success);
+        ASSERT_EQ(LCEVC_SendDecoderPicture(m_decHdl, outputHdl), LCEVC_Success);
+
+        LCEVC_DecodeInformation info = {};
+        LCEVC_ReturnCode res = LCEVC_Again;
+        while ((res = LCEVC_ReceiveDecoderPicture(m_decHdl, &outputHdl, &info)) == LCEVC_Again) {
+        }
+        ASSERT_EQ(res, LCEVC_Success);
+        EXPECT_EQ(info.timestamp, pts);
+        EXPECT_TRUE(info.enhanced);
+
+        // Data has been handed back once the frame is decoded
+        EXPECT_EQ(releaseCount(pts), 1);
+
+        LCEVC_FreePicture(m_decHdl, outputHdl);
+        while (LCEVC_ReceiveDecoderBase(m_decHdl, &baseHdl) == LCEVC_Success) {
+            LCEVC_FreePicture(m_decHdl, baseHdl);
+        }
+    }
+
+    destroyDecoder();
+
+    for (int64_t pts = 0; pts < kFrameCount; ++pts) {
+        EXPECT_EQ(releaseCount(pts), 1);
+    }
+}
+
+TEST_F(APIEnhancementDataExFixture, ReleasedOnDestroy)
+{
+    // No bases, so frames stay pending until the decoder goes
+    for (int64_t pts = 0; pts < kFrameCount; ++pts) {
+        ASSERT_EQ(sendEnhancement(pts), LCEVC_Success);
+    }
+
+    // Sending the same timestamp again fails, and is not released
+    ASSERT_NE(sendEnhancement(0), LCEVC_Success);
+
+    destroyDecoder();
+
+    for (int64_t pts = 0; pts < kFrameCount; ++pts) {
+        EXPECT_EQ(releaseCount(pts), 1);
+    }
+}
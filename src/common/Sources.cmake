@@ -25,12 +25,14 @@ list(
     "src/diagnostics_tracefile.c"
     "src/memory.c"
     "src/memory_malloc.c"
+    "src/memory_numa.c"
     "src/random.c"
     "src/ring_buffer.c"
     "src/rolling_arena.c"
     "src/shared_library.c"
     "src/string_format.c"
     "src/task_pool.c"
+    "src/threads_cpu_set.c"
     "src/vector.c")
 
 if (NOT VN_SDK_THREADS_CUSTOM)
@@ -47,6 +49,7 @@ list(
     APPEND
     INTERFACES
     "include/LCEVC/common/acceleration.h"
+    "include/LCEVC/common/avx2.h"
     "include/LCEVC/common/bitutils.h"
     "include/LCEVC/common/check.h"
     "include/LCEVC/common/class_utils.hpp"
@@ -60,6 +63,7 @@ list(
     "include/LCEVC/common/limit.h"
     "include/LCEVC/common/log.h"
     "include/LCEVC/common/memory.h"
+    "include/LCEVC/common/memory_numa.h"
     "include/LCEVC/common/neon.h"
     "include/LCEVC/common/platform.h"
     "include/LCEVC/common/printf_macros.h"
@@ -22,17 +22,71 @@ extern "C"
 {
 #endif
 
+/*! \brief The kernel families whose SIMD level can be overridden, eg: to A/B test one of them. */
+typedef enum LdcAccelerationKernel
+{
+    LdcKernelApplyCmdBuffer,
+    LdcKernelBlit,
+    LdcKernelEntropy,
+    LdcKernelTransform,
+    LdcKernelUpscale,
+
+    LdcKernelCount
+} LdcAccelerationKernel;
+
+/*! \brief The widest instruction set that a kernel family may use. */
+typedef enum LdcAccelerationLevel
+{
+    LdcAccelerationLevelAuto = 0, /**< The widest that the CPU supports. */
+    LdcAccelerationLevelScalar,
+    LdcAccelerationLevelBaseline, /**< SSE4.1 or NEON. */
+    LdcAccelerationLevelAVX2,     /**< AVX2 and BMI2. */
+    LdcAccelerationLevelAVX512,
+
+    LdcAccelerationLevelCount
+} LdcAccelerationLevel;
+
+/*! \brief Instruction sets that a kernel family may dispatch on. */
+typedef struct LdcAccelerationFeatures
+{
+    bool SSE;    /* SSE4.1 */
+    bool AVX2;
+    bool AVX512; /* AVX-512 F, BW and VL */
+    bool BMI2;
+    bool NEON;
+    bool SVE;
+} LdcAccelerationFeatures;
+
+/*! \brief Instruction sets supported by both the build and the CPU, detected at runtime, and each
+ *         kernel family's share of them. */
 typedef struct LdcAcceleration
 {
-    bool SSE;
+    bool SSE;    /* SSE4.1 */
     bool AVX2;
+    bool AVX512; /* AVX-512 F, BW and VL */
+    bool BMI2;
     bool NEON;
+    bool SVE;
+
+    LdcAccelerationLevel kernelLevel[LdcKernelCount];
+    LdcAccelerationFeatures kernel[LdcKernelCount]; /* Resolved from all of the above */
 } LdcAcceleration;
 
+/*! \brief Detect the CPU's instruction sets, or disable all of them. Kernel levels are kept. */
 void ldcAccelerationInitialize(bool enable);
+
+/*! \brief Use the acceleration of another instance, eg: a pipeline library's parent. */
 void ldcAccelerationSet(const LdcAcceleration* parentAcceleration);
+
+/*! \brief Limit the instruction set used by one kernel family, in this instance's acceleration.
+ *         Returns false if out of range. */
+bool ldcAccelerationSetKernelLevel(LdcAccelerationKernel kernel, LdcAccelerationLevel level);
+
 const LdcAcceleration* ldcAccelerationGet(void);
 
+/*! \brief The acceleration that a kernel family should dispatch on, with its level applied. */
+const LdcAccelerationFeatures* ldcAccelerationGetKernel(LdcAccelerationKernel kernel);
+
 #ifdef __cplusplus
 }
 #endif
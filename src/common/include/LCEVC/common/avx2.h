@@ -0,0 +1,55 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#ifndef VN_LCEVC_COMMON_AVX2_H
+#define VN_LCEVC_COMMON_AVX2_H
+
+#include <LCEVC/build_config.h>
+
+/* AVX2 code lives in its own translation units that are compiled with AVX2 enabled (see
+ * VN_SDK_AVX2_COMPILE_OPTIONS), and is only called once `LdcAcceleration::AVX2` has been
+ * detected at runtime. Everything else in the SDK is built for the SSE baseline. */
+#if VN_CORE_FEATURE(AVX2)
+
+#include "sse.h"
+
+#include <immintrin.h>
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------*/
+
+/*! \brief Load 2 unaligned 128-bit values into the low and high lanes of a register. */
+static inline __m256i loadu2M128iAVX2(const void* hi, const void* lo)
+{
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)lo)),
+                                   _mm_loadu_si128((const __m128i*)hi), 1);
+}
+
+/*! \brief Store the low and high lanes of a register to 2 unaligned 128-bit locations. */
+static inline void storeu2M128iAVX2(void* hi, void* lo, __m256i value)
+{
+    _mm_storeu_si128((__m128i*)lo, _mm256_castsi256_si128(value));
+    _mm_storeu_si128((__m128i*)hi, _mm256_extracti128_si256(value, 1));
+}
+
+/*! \brief Broadcast a pair of 16-bit values to every 32-bit element, with `lo` in the low half. */
+static inline __m256i set1PairS16AVX2(int16_t lo, int16_t hi)
+{
+    return _mm256_set1_epi32((int32_t)(((uint32_t)(uint16_t)hi << 16) | (uint16_t)lo));
+}
+
+/*------------------------------------------------------------------------------*/
+
+#endif
+#endif // VN_LCEVC_COMMON_AVX2_H
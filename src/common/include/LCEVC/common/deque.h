@@ -81,6 +81,16 @@ static inline void ldcDequeFrontPush(LdcDeque* deque, const void* element);
  */
 static inline bool ldcDequeFrontPop(LdcDeque* deque, void* element);
 
+/*! Get pointer to element at a given position in deque
+ *
+ * The pointer is only valid until the deque is next modified.
+ *
+ * @param[in]  deque            An initialized deque.
+ * @param[in]  index            Position of element, counted from front of deque - must be less than size.
+ * @return                      Pointer to `elementSize` bytes of element.
+ */
+static inline void* ldcDequeAt(const LdcDeque* deque, uint32_t index);
+
 /*! Get the number of element the buffer can hold before reallocating
  *
  * @param[in]  deque            An initialized deque.
@@ -62,6 +62,12 @@ static inline bool ldcDequeIsEmpty(const LdcDeque* deque)
     return deque->front == deque->back;
 }
 
+static inline void* ldcDequeAt(const LdcDeque* deque, uint32_t index)
+{
+    assert(index < ldcDequeSize(deque));
+    return deque->data + ((deque->front + index) & deque->mask) * deque->elementSize;
+}
+
 static inline void ldcDequeBackPush(LdcDeque* deque, const void* element)
 {
     // Check capacity
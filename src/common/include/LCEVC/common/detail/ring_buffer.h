@@ -36,10 +36,29 @@ struct LdcRingBuffer
 
     LdcMemoryAllocator* allocator;
     LdcMemoryAllocation dataAllocation;
+
+    // Lock free modes keep positions, slot sequence numbers and waiter counts in a separately
+    // allocated block of atomics (see ring_buffer.c) - `front` and `back` are not used.
+    LdcRingBufferMode mode;
+    struct LdcRingBufferLockFree* lockFree;
+    LdcMemoryAllocation lockFreeAllocation;
 };
 
+// Lock free implementations
+//
+void ldcRingBufferLockFreePush(LdcRingBuffer* ringBuffer, const void* element);
+bool ldcRingBufferLockFreeTryPush(LdcRingBuffer* ringBuffer, const void* element);
+void ldcRingBufferLockFreePop(LdcRingBuffer* ringBuffer, void* element);
+bool ldcRingBufferLockFreeTryPop(LdcRingBuffer* ringBuffer, void* element);
+uint32_t ldcRingBufferLockFreeSize(const LdcRingBuffer* ringBuffer);
+
 static inline void ldcRingBufferPush(LdcRingBuffer* ringBuffer, const void* element)
 {
+    if (ringBuffer->mode != LdcRingBufferModeLocked) {
+        ldcRingBufferLockFreePush(ringBuffer, element);
+        return;
+    }
+
     threadMutexLock(&ringBuffer->mutex);
 
     // Wait while buffer is full
@@ -58,6 +77,10 @@ static inline void ldcRingBufferPush(LdcRingBuffer* ringBuffer, const void* elem
 
 static inline bool ldcRingBufferTryPush(LdcRingBuffer* ringBuffer, const void* element)
 {
+    if (ringBuffer->mode != LdcRingBufferModeLocked) {
+        return ldcRingBufferLockFreeTryPush(ringBuffer, element);
+    }
+
     threadMutexLock(&ringBuffer->mutex);
 
     // Wait while buffer is full
@@ -78,6 +101,11 @@ static inline bool ldcRingBufferTryPush(LdcRingBuffer* ringBuffer, const void* e
 
 static inline void ldcRingBufferPop(LdcRingBuffer* ringBuffer, void* element)
 {
+    if (ringBuffer->mode != LdcRingBufferModeLocked) {
+        ldcRingBufferLockFreePop(ringBuffer, element);
+        return;
+    }
+
     threadMutexLock(&ringBuffer->mutex);
 
     // Wait while buffer is empty
@@ -94,6 +122,10 @@ static inline void ldcRingBufferPop(LdcRingBuffer* ringBuffer, void* element)
 
 static inline bool ldcRingBufferTryPop(LdcRingBuffer* ringBuffer, void* element)
 {
+    if (ringBuffer->mode != LdcRingBufferModeLocked) {
+        return ldcRingBufferLockFreeTryPop(ringBuffer, element);
+    }
+
     threadMutexLock(&ringBuffer->mutex);
 
     // Check if buffer is empty
@@ -119,6 +151,10 @@ static inline uint32_t ldcRingBufferCapacity(const LdcRingBuffer* buffer)
 
 static inline uint32_t ldcRingBufferSize(LdcRingBuffer* buffer)
 {
+    if (buffer->mode != LdcRingBufferModeLocked) {
+        return ldcRingBufferLockFreeSize(buffer);
+    }
+
     threadMutexLock(&buffer->mutex);
     uint32_t size = (buffer->capacity + buffer->front - buffer->back) & buffer->mask;
     threadMutexUnlock(&buffer->mutex);
@@ -127,6 +163,10 @@ static inline uint32_t ldcRingBufferSize(LdcRingBuffer* buffer)
 
 static inline bool ldcRingBufferIsEmpty(LdcRingBuffer* buffer)
 {
+    if (buffer->mode != LdcRingBufferModeLocked) {
+        return ldcRingBufferLockFreeSize(buffer) == 0;
+    }
+
     threadMutexLock(&buffer->mutex);
     bool isEmpty = buffer->front == buffer->back;
     threadMutexUnlock(&buffer->mutex);
@@ -135,6 +175,10 @@ static inline bool ldcRingBufferIsEmpty(LdcRingBuffer* buffer)
 
 static inline bool ldcRingBufferIsFull(LdcRingBuffer* buffer)
 {
+    if (buffer->mode != LdcRingBufferModeLocked) {
+        return ldcRingBufferLockFreeSize(buffer) >= buffer->capacity - 1;
+    }
+
     threadMutexLock(&buffer->mutex);
     bool isFull = ((buffer->front + 1) & buffer->mask) == buffer->back;
     threadMutexUnlock(&buffer->mutex);
@@ -17,12 +17,18 @@
 
 #include <LCEVC/common/memory.h>
 #include <LCEVC/common/threads.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 // Number of reallocation buffers that can be pending
 //
 #define kRollingArenaMaxBuffers 16
 
+// Minimum alignment of allocations in bytes
+//
+#define kRollingArenaMinAlignment 64
+
 struct LdcRollingArenaSlot
 {
     uint32_t beginOffset; // First offset in chunk covered by slot - NB: returned pointer may be further along to account for alignment and wrapping
@@ -80,7 +86,62 @@ struct LdcMemoryAllocatorRollingArena
     // Buffers
     struct LdcRollingArenaBuffer buffers[kRollingArenaMaxBuffers];
 
+    // Number of buffer entries that have been used, and the one new allocations come from
     uint32_t bufferCount;
+    uint32_t bufferActive;
 };
 
+// Inline fast path for allocation - handles the common case of an allocation that fits at the
+// front of the active buffer, otherwise falls back to the general out of line version.
+//
+static inline void* ldcRollingArenaAllocateInline(LdcMemoryAllocator* allocator,
+                                                  LdcMemoryAllocation* allocation, size_t size,
+                                                  size_t alignment, bool clearToZero)
+{
+    LdcMemoryAllocatorRollingArena* arena = (LdcMemoryAllocatorRollingArena*)allocator;
+    const size_t align =
+        (alignment > kRollingArenaMinAlignment) ? alignment : kRollingArenaMinAlignment;
+    const size_t alignedSize = size + align - 1;
+    void* ptr = NULL;
+
+    threadMutexLock(&arena->mutex);
+
+    const uint32_t front = arena->bufferFront;
+    const uint32_t used = (front + arena->bufferSize - arena->bufferBack) & arena->bufferMask;
+
+    if (size > 0 && alignedSize < arena->bufferSize - used &&
+        alignedSize <= arena->bufferSize - front &&
+        ((arena->slotFront + 1) & arena->slotsMask) != arena->slotBack) {
+        const uint32_t slot = arena->slotFront;
+
+        arena->bufferFront = (uint32_t)((front + alignedSize) & arena->bufferMask);
+        arena->slotFront = (slot + 1) & arena->slotsMask;
+
+        arena->slots[slot].beginOffset = front;
+        arena->slots[slot].endOffset = arena->bufferFront;
+        arena->slots[slot].bufferIndex = arena->bufferActive;
+        arena->buffers[arena->bufferActive].allocationCount++;
+
+        ptr = (uint8_t*)arena->buffers[arena->bufferActive].memory.ptr + front;
+        ptr = (void*)(((uintptr_t)ptr + align - 1) & ~(uintptr_t)(align - 1));
+
+        allocation->ptr = ptr;
+        allocation->size = size;
+        allocation->alignment = alignment;
+        allocation->allocatorData = arena->allocationIndexNext++;
+    }
+
+    threadMutexUnlock(&arena->mutex);
+
+    if (!ptr) {
+        ptr = ldcRollingArenaAllocate(allocator, allocation, size, alignment);
+    }
+
+    if (ptr && clearToZero) {
+        memset(ptr, 0, size);
+    }
+
+    return ptr;
+}
+
 #endif // VN_LCEVC_COMMON_DETAIL_ROLLING_ARENA_H
@@ -23,7 +23,37 @@
 #include <LCEVC/common/threads.h>
 #include <LCEVC/common/vector.h>
 
+/*! Per task name latency statistics, and the metric sites they are published to
+ *
+ * Each worker records into its own table, and tasks finished on other threads go into the pool's
+ * table. Tables are merged under the pool's `statsMutex` when statistics are queried or
+ * published.
+ */
+typedef struct LdcTaskStatsTable
+{
+    LdcTaskStats stats[kTaskPoolMaxStatsNames];
+    const struct LdcTaskMetricSites* sites[kTaskPoolMaxStatsNames];
+    uint32_t count;
+
+    // Mutex protecting the table - only contended whilst tables are merged
+    ThreadMutex mutex;
+} LdcTaskStatsTable;
+
 /*! The underlying task pool
+ *
+ * Locking:
+ *
+ *  - `mutex` protects the task allocation registry (`tasks`, `pendingTaskCount`), the `Done`
+ *    state and `detached` flag of every task, and the running state of standalone tasks.
+ *  - Each LdcTaskGroup has its own mutex that protects the dependencies and waiting tasks of
+ *    that group, and the running state of its tasks.
+ *  - Each LdcTaskThread has its own mutex protecting its deque of ready parts. A snapshot of
+ *    each deque's size and earliest deadline (`readySnapshots`) is written under that mutex, and
+ *    read without locks.
+ *  - `idleMutex` is held whilst `idleThreadCount` changes, and is used with `condVarReady` to
+ *    park idle threads. The count is also read without locks, when deciding whether to defer parts.
+ *
+ * Locks are always taken in that order: group -> pool -> thread -> idle.
  */
 typedef struct LdcTaskPool
 {
@@ -32,9 +62,19 @@ typedef struct LdcTaskPool
 
     uint32_t threadCount;
 
+    // CPUs that worker threads are restricted to, if affinitySet is true
+    ThreadCpuSet affinity;
+    bool affinitySet;
+
     // Per thread data
+    // If not multithreaded, there is a single LdcTaskThread with no OS thread, used to hold the
+    // parts that are run on the caller's thread.
     LdcMemoryAllocation threads;
 
+    // Per thread snapshot of the ready parts deque - an allocated block of atomics (see
+    // task_pool.c)
+    LdcMemoryAllocation readySnapshots;
+
     // Per task data - vector of allocations
     LdcVector tasks;
 
@@ -47,42 +87,94 @@ typedef struct LdcTaskPool
     // Thread workers are running
     bool running;
 
-    // A deque of ready task parts
-    // This will move to per-thread later when work stealing is sorted (and the reason
-    // why this is a deque vs. a simple list)
-    LdcDeque readyParts;
-
-    // Mutex for locking whole pool
-    // NB: THis is way too conservative - but is a good starting point for getting
-    // everything correct
+    // Mutex for task allocation and completion
     ThreadMutex mutex;
 
-    // Condition variable that is signalled when tasks become ready to run.
-    //
-    // NB: THis is way too conservative - but is a good starting point for getting
-    // everything correct
-    ThreadCondVar condVarReady;
-
     // Condition variable that is signalled when tasks have been completed
     //
     ThreadCondVar condVarCompleted;
+
+    // Mutex and condition variable used to park and wake idle workers
+    ThreadMutex idleMutex;
+    ThreadCondVar condVarReady;
+
+    // Number of workers that are parked, or about to park, on condVarReady - an allocated atomic
+    // (see task_pool.c)
+    LdcMemoryAllocation idleThreadCount;
+
+    // Idle policy - how long workers spin, then yield, before parking - protected by `idleMutex`
+    uint32_t idleSpinMicroseconds;
+    uint32_t idleYieldMicroseconds;
+
+    // List of attached clients, and their total weight - protected by `mutex`
+    LdcTaskPoolClient* clients;
+    uint32_t clientsWeight;
+
+    // Latency statistics of tasks finished outside the worker threads, and a mutex that
+    // serialises merging of all the tables
+    LdcTaskStatsTable stats;
+    ThreadMutex statsMutex;
 } LdcTaskPool;
 
+/*! A client of a pool - allows several users (e.g. decoders) to share a pool fairly.
+ *
+ * Whilst no workers are idle, the number of parts of a client's tasks that can run at once is
+ * limited to its quota - the client's weighted share of the pool's threads. Parts that are over
+ * quota are deferred until other parts of the same client finish.
+ */
+typedef struct LdcTaskPoolClient
+{
+    LdcTaskPool* pool;
+
+    // Next client attached to pool
+    LdcTaskPoolClient* next;
+
+    // Relative weight of this client
+    uint32_t weight;
+
+    // Maximum parts that can run at once when there are no idle workers
+    uint32_t quota;
+
+    // Number of this client's parts that are currently running
+    uint32_t runningParts;
+
+    // Parts that have been deferred whilst over quota
+    LdcDeque deferredParts;
+
+    // Mutex protecting quota, runningParts, and deferredParts
+    ThreadMutex mutex;
+} LdcTaskPoolClient;
+
 /*! Per thread state
  */
 typedef struct LdcTaskThread
 {
     LdcTaskPool* taskPool;
 
+    // Index of this thread within pool
+    uint32_t index;
+
     // The thread
     Thread thread;
 
     // Current task part being processed by this thread
     LdcTaskPart part;
 
-    // Pointer to first ready task on this thread
-    // Once stable - ready lists will move to be per-thread.
-    // LdcTask* readyTasks;
+    // A deque of ready task parts
+    //
+    // Kept in order of task deadline, with the earliest at the back. Amongst parts with the same
+    // deadline, the owning thread pushes and pops at the back (LIFO), other threads steal from the
+    // front (FIFO).
+    LdcDeque readyParts;
+
+    // Mutex protecting readyParts
+    ThreadMutex mutex;
+
+    // Number of times this worker has waited on condVarReady - protected by the pool's `idleMutex`
+    uint32_t parkCount;
+
+    // Latency statistics of tasks finished on this thread
+    LdcTaskStatsTable stats;
 } LdcTaskThread;
 
 /*! Running state of task.
@@ -126,7 +218,9 @@ typedef struct LdcTask
     // Total number of things in overall task
     uint32_t iterationsTotalCount;
 
-    // Limit on number of iterations handled by each part
+    // Limit on number of iterations handled by each call to taskFunction - parts are split lazily
+    // down to this size as they run. If 0, there is no limit, and the task is split into one part
+    // per thread when it becomes ready.
     uint32_t maxIterationsPerPart;
 
     // Updated by threads as task progresses
@@ -138,19 +232,25 @@ typedef struct LdcTask
     // Number of task parts in progress
     uint32_t activeParts;
 
+    // Scheduling deadline - copied from group when task becomes ready
+    uint64_t deadline;
+
+    // Times that the task became ready, and that its first part started - for statistics
+    uint64_t readyTime;
+    uint64_t startTime;
+
     // Next task in waiting list
     LdcTask* nextTask;
 
-    // For future LBS control, will `:
-    //  - uint32_t stopSplittingThreshold;
-    //  - int32_t profitableParallelismThreshold;
-
     // The output value from the task
     void* outputValue;
 
     // True if the caller will not wait for the task - set via ldcTaskNoWait()
     bool detached;
 
+    // True if the task function should not be called - set via ldcTaskGroupCancel()
+    bool cancelled;
+
     size_t dataSize; // Size of per-task parameter data
     uint8_t data[1]; // Variable size array of per task data - will be allocated following LdcTask structure
     // NB: DO NOT PUT ANY MORE MEMBERS HERE
@@ -169,13 +269,33 @@ typedef struct LdcTaskGroup
     // Pool that holds this group of tasks
     LdcTaskPool* pool;
 
+    // Mutex protecting the dependencies and task lists of this group
+    ThreadMutex mutex;
+
+    // Condition variable that is signalled when dependencies are met, or tasks are completed
+    ThreadCondVar condVar;
+
     const char* name; // Name used in debug dumps
 
+    // Optional pool client that this group's tasks are accounted to
+    LdcTaskPoolClient* client;
+
+    // Ready parts of tasks with earlier deadlines are run first - UINT64_MAX if no deadline
+    uint64_t deadline;
+
+    // If not NULL, the graph that added tasks are recorded into
+    LdcTaskGraph* recordGraph;
+
     // Tasks remaining in this group
     uint32_t tasksCount;
 
-    // True if group is blocked - added tasks will not be scheduled
-    bool blocked;
+    // Called in place of the task function of cancelled tasks - set via ldcTaskGroupCancel()
+    LdcTaskGroupCancelledFunction cancelledFunction;
+    void* cancelledContext;
+
+    // Number of outstanding ldcTaskGroupBlock() calls - whilst non-zero, added tasks will not be
+    // scheduled
+    uint32_t blockedCount;
 
     // List of tasks that are waiting to be scheduled when group is no longer blocked
     uint32_t blockedTasksCount;
@@ -205,5 +325,28 @@ typedef struct LdcTaskGroup
 
 } LdcDependencies;
 
+/*! A recorded set of group tasks and dependencies, that can be added to other groups in one step
+ *
+ * Each node is stored in `nodes` as an LdcTaskGraphNode header, followed by its inputs and then
+ * its data.
+ */
+typedef struct LdcTaskGraph
+{
+    LdcMemoryAllocator* allocator;
+
+    // Packed nodes
+    LdcMemoryAllocation nodes;
+    size_t nodesSize;
+    uint32_t nodesCount;
+    uint32_t maxDataSize;
+
+    // Group dependency count at start and end of recording
+    uint32_t firstDependency;
+    uint32_t dependenciesCount;
+
+    // False if an allocation failed whilst recording
+    bool valid;
+} LdcTaskGraph;
+
 // NOLINTEND(modernize-use-using)
 #endif // VN_LCEVC_COMMON_DETAIL_TASK_POOL_H
@@ -0,0 +1,62 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+#ifndef VN_LCEVC_COMMON_MEMORY_NUMA_H
+#define VN_LCEVC_COMMON_MEMORY_NUMA_H
+
+#include <LCEVC/common/memory.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*! @file
+ * @brief A memory allocator that places large allocations on a given NUMA node
+ *
+ * Thread safe, if the parent allocator is.
+ *
+ * Allocations are made from a parent allocator, then the page aligned interior of any large block
+ * is given a preferred NUMA node, so that pages are placed on that node as they are first touched.
+ * Small allocations, and platforms without a memory policy interface, are passed straight through.
+ */
+
+/*! Allocations smaller than this are not bound to the node. */
+#define kMemoryNumaMinBindSize (256 * 1024) // NOLINT
+
+typedef struct LdcMemoryAllocatorNuma
+{
+    LdcMemoryAllocator allocator;
+    LdcMemoryAllocator* parentAllocator;
+    uint32_t node;
+    size_t pageSize;
+} LdcMemoryAllocatorNuma;
+
+/*! Initialize a NUMA allocator.
+ *
+ * @param[out]      numaAllocator           The allocator to be initialized.
+ * @param[in]       parentAllocator         The underlying allocator to allocate blocks from.
+ * @param[in]       node                    The preferred NUMA node for large allocations.
+ *
+ * @return          A pointer to an allocator - as passed in via `numaAllocator`
+ */
+LdcMemoryAllocator* ldcMemoryAllocatorNumaInitialize(LdcMemoryAllocatorNuma* numaAllocator,
+                                                     LdcMemoryAllocator* parentAllocator,
+                                                     uint32_t node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VN_LCEVC_COMMON_MEMORY_NUMA_H
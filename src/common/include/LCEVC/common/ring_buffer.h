@@ -29,9 +29,21 @@ extern "C"
 
 /*! @file
  * @brief A thread safe ring buffer.
+ *
+ * The default mode uses a mutex and condition variables. The lock free modes only touch the
+ * mutex and condition variables when a blocking push or pop has to wait, or has to wake a waiter.
  */
 typedef struct LdcRingBuffer LdcRingBuffer;
 
+/*! Ring buffer synchronization modes
+ */
+typedef enum LdcRingBufferMode
+{
+    LdcRingBufferModeLocked = 0, // Mutex protected - any number of producers and consumers
+    LdcRingBufferModeSPSC = 1,   // Lock free - one producer thread and one consumer thread
+    LdcRingBufferModeMPMC = 2,   // Lock free - any number of producers and consumers
+} LdcRingBufferMode;
+
 /*! Initialize a ring buffer.
  *
  * Allocate internal buffers of given size, and sets to empty.
@@ -44,6 +56,15 @@ typedef struct LdcRingBuffer LdcRingBuffer;
 void ldcRingBufferInitialize(LdcRingBuffer* ringBuffer, uint32_t capacity, uint32_t elementSize,
                              LdcMemoryAllocator* allocator);
 
+/*! Initialize a ring buffer with a given synchronization mode.
+ *
+ * As ldcRingBufferInitialize().
+ *
+ * @param[in]  mode              How pushes and pops are synchronized.
+ */
+void ldcRingBufferInitializeMode(LdcRingBuffer* ringBuffer, uint32_t capacity, uint32_t elementSize,
+                                 LdcMemoryAllocator* allocator, LdcRingBufferMode mode);
+
 /*! Destroy a previously initialized ring buffer.
  *
  * Free all associated memory. Any pending records will be lost.
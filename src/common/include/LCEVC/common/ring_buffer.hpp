@@ -23,14 +23,16 @@ namespace lcevc_dec::common {
 
 // Type templated C++ wrapper for the LdcRingBuffer
 //
-template<typename T>
+// `Mode` selects the synchronization - see LdcRingBufferMode.
+//
+template<typename T, LdcRingBufferMode Mode = LdcRingBufferModeLocked>
 class RingBuffer {
 public:
     explicit RingBuffer(uint32_t capacity, LdcMemoryAllocator* allocator) {
-        ldcRingBufferInitialize(&m_ringBuffer, capacity, sizeof(T), allocator);
+        ldcRingBufferInitializeMode(&m_ringBuffer, capacity, sizeof(T), allocator, Mode);
     }
     explicit RingBuffer(uint32_t capacity) {
-        ldcRingBufferInitialize(&m_ringBuffer, capacity, sizeof(T), ldcMemoryAllocatorMalloc());
+        ldcRingBufferInitializeMode(&m_ringBuffer, capacity, sizeof(T), ldcMemoryAllocatorMalloc(), Mode);
     }
     ~RingBuffer() {
         ldcRingBufferDestroy(&m_ringBuffer);
@@ -68,25 +68,58 @@ LdcMemoryAllocator* ldcRollingArenaInitialize(LdcMemoryAllocatorRollingArena* ro
  */
 void ldcRollingArenaDestroy(LdcMemoryAllocatorRollingArena* arena);
 
-// Specializations of the memory macros that can be adjusted later to call directly into the arena code (which can then be inlined)
+/*! Allocate from a rolling arena, bypassing the allocator function table.
+ *
+ * Same behaviour as `ldcMemoryAllocate()` on the arena's allocator.
+ */
+void* ldcRollingArenaAllocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
+                              size_t size, size_t alignment);
 
+/*! Reallocate from a rolling arena, bypassing the allocator function table.
+ *
+ * If the allocation is the most recent one, it can usually be grown or shrunk in place.
+ */
+void* ldcRollingArenaReallocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
+                                size_t size);
+
+/*! Free an allocation from a rolling arena, bypassing the allocator function table.
+ *
+ * Freeing an empty allocation does nothing.
+ */
+void ldcRollingArenaFree(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation);
+
+// Specializations of the memory macros - `allocator` must be a rolling arena. Allocations that fit
+// in the current buffer are done inline, without a call through the allocator function table.
+
+/* clang-format off */
+
+#if !defined(__cplusplus)
 /**! Helper for performing malloc for a single object. */
-#define VNRollingArenaAllocate(allocator, allocation, type) VNAllocate(allocator, allocation, type)
+#define VNRollingArenaAllocate(allocator, allocation, type) (type*)ldcRollingArenaAllocateInline(allocator, allocation, sizeof(type), VNAlignof(type), false)
 
 /**! Helper for performing malloc for an array of objects. */
-#define VNRollingArenaAllocateArray(allocator, allocation, type, count) \
-    VNAllocateArray(allocator, allocation, type, count)
+#define VNRollingArenaAllocateArray(allocator, allocation, type, count) (type*)ldcRollingArenaAllocateInline(allocator, allocation, sizeof(type) * (count), VNAlignof(type), false)
+
+/**! Helper for performing calloc for a single object. */
+#define VNRollingArenaAllocateZero(allocator, allocation, type) (type*)ldcRollingArenaAllocateInline(allocator, allocation, sizeof(type), VNAlignof(type), true)
 
 /**! Helper for performing realloc for a single object. */
-#define VNRollingArenaReallocate(allocator, allocation, type) \
-    VNReallocate(allocator, allocation, type)
+#define VNRollingArenaReallocate(allocator, allocation, type) (type*)ldcRollingArenaReallocate(allocator, allocation, sizeof(type))
 
 /**! Helper for performing realloc for an array of objects. */
-#define VNRollingArenaReallocateArray(allocator, allocation, type, prevCount, count) \
-    VNReallocateArray(allocator, allocation, type, count)
+#define VNRollingArenaReallocateArray(allocator, allocation, type, prevCount, count) (type*)ldcRollingArenaReallocate(allocator, allocation, sizeof(type) * (count))
+#else
+#define VNRollingArenaAllocate(allocator, allocation, type) static_cast<type*>(ldcRollingArenaAllocateInline(allocator, allocation, sizeof(type), VNAlignof(type), false))
+#define VNRollingArenaAllocateArray(allocator, allocation, type, count) static_cast<type*>(ldcRollingArenaAllocateInline(allocator, allocation, sizeof(type) * (count), VNAlignof(type), false))
+#define VNRollingArenaAllocateZero(allocator, allocation, type) static_cast<type*>(ldcRollingArenaAllocateInline(allocator, allocation, sizeof(type), VNAlignof(type), true))
+#define VNRollingArenaReallocate(allocator, allocation, type) static_cast<type*>(ldcRollingArenaReallocate(allocator, allocation, sizeof(type)))
+#define VNRollingArenaReallocateArray(allocator, allocation, type, prevCount, count) static_cast<type*>(ldcRollingArenaReallocate(allocator, allocation, sizeof(type) * (count)))
+#endif
 
 /**! Helper for freeing an allocation performed with one of the above macros. */
-#define VNRollingArenaFree(allocator, allocation) VNRollingArenaFree(allocator, allocation)
+#define VNRollingArenaFree(allocator, allocation) do { ldcRollingArenaFree(allocator, allocation); } while(false)
+
+/* clang-format on */
 
 // Allocator definition and inline fast paths
 //
@@ -20,12 +20,21 @@
 /*! @file
  *  @brief A general threaded task runner.
  *
- * Currently, operates a simple FIFO of tasks, consumed by threads, but it is designed such that
- * it can be improved to use Lazy Binary-Splitting (https://terpconnect.umd.edu/~barua/ppopp164.pdf)
+ * Each worker thread has a deque of ready task parts. Parts made ready by a worker are pushed onto
+ * the back of its own deque and popped from there (LIFO), whilst idle workers steal from the front
+ * of other workers' deques (FIFO).
+ *
+ * Tasks with a limit on iterations per part use Lazy Binary-Splitting
+ * (https://terpconnect.umd.edu/~barua/ppopp164.pdf) - a running part checks between calls to the
+ * task function whether its worker's deque is empty, and if so, splits off half of its remaining
+ * iterations for other workers to steal.
+ *
+ * Dependency resolution within a task group only locks that group.
  */
 #include <LCEVC/build_config.h>
 #include <LCEVC/common/memory.h>
 #include <LCEVC/common/platform.h>
+#include <LCEVC/common/threads.h>
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -39,6 +48,8 @@ extern "C"
 typedef struct LdcTaskPool LdcTaskPool;
 typedef struct LdcTask LdcTask;
 typedef struct LdcTaskGroup LdcTaskGroup;
+typedef struct LdcTaskPoolClient LdcTaskPoolClient;
+typedef struct LdcTaskGraph LdcTaskGraph;
 
 /*! Passed to taskFunction to describe the task and which iterations it is responsible for.
  */
@@ -84,12 +95,98 @@ bool ldcTaskPoolInitialize(LdcTaskPool* taskPool, LdcMemoryAllocator* longTermAl
                            LdcMemoryAllocator* shortTermAllocator, uint32_t threadsCount,
                            uint32_t reservedTaskCount);
 
+/*! Initialize the task pool, with worker threads restricted to a set of CPUs.
+ *
+ * As ldcTaskPoolInitialize(), with each worker setting its own affinity as it starts. If the
+ * affinity cannot be set, a warning is logged and the worker runs unrestricted.
+ *
+ *  @param[in]      affinity            The CPUs to run workers on, or NULL for no restriction.
+ *
+ *  @return                             True on success
+ */
+bool ldcTaskPoolInitializeAffinity(LdcTaskPool* taskPool, LdcMemoryAllocator* longTermAllocator,
+                                   LdcMemoryAllocator* shortTermAllocator, uint32_t threadsCount,
+                                   uint32_t reservedTaskCount, const ThreadCpuSet* affinity);
+
 /*! Release the task pool.
  *
  *  @param[in]      taskPool        The TaskPool to destroy.
  */
 void ldcTaskPoolDestroy(LdcTaskPool* taskPool);
 
+/*! Set how worker threads wait when they run out of work.
+ *
+ * An idle worker first spins, polling for ready parts with CPU pause hints, for up to
+ * `spinMicroseconds`. It then yields its time slice between polls for up to `yieldMicroseconds`,
+ * before parking until it is signalled. Spinning trades idle CPU time for lower latency when work
+ * arrives shortly after a worker runs out. The default is 0 for both - park immediately.
+ *
+ * Workers pick up a new policy the next time they park.
+ *
+ *  @param[in]      taskPool            The task pool to configure.
+ *  @param[in]      spinMicroseconds    Time to spin before yielding.
+ *  @param[in]      yieldMicroseconds   Time to yield before parking.
+ */
+void ldcTaskPoolSetIdlePolicy(LdcTaskPool* taskPool, uint32_t spinMicroseconds,
+                              uint32_t yieldMicroseconds);
+
+/*! Number of buckets in each task latency histogram.
+ *
+ * Bucket 0 counts times under 1us, bucket `i` counts times in [2^(i-1), 2^i) us, and the last
+ * bucket also counts anything longer.
+ */
+#define kTaskStatsBuckets 24 // NOLINT
+
+/*! Maximum number of distinct task names that a pool keeps statistics for. Once the table is
+ * full, tasks with other names are counted under "other".
+ */
+#define kTaskPoolMaxStatsNames 32 // NOLINT
+
+/*! Latency statistics for all the completed tasks with the same name.
+ *
+ * Wait time is from the task becoming ready to its first part starting, and run time is from
+ * then until the task completes. All times are in microseconds.
+ */
+typedef struct LdcTaskStats
+{
+    const char* name;
+    uint64_t count;
+    uint64_t waitTotal;
+    uint64_t runTotal;
+    uint32_t waitHistogram[kTaskStatsBuckets];
+    uint32_t runHistogram[kTaskStatsBuckets];
+} LdcTaskStats;
+
+/*! Get a snapshot of the task pool's per task name latency statistics.
+ *
+ * Percentiles of each name's wait and run times are also published periodically as metrics
+ * named "task:<name>:waitP50", "task:<name>:waitP99", "task:<name>:runP50" and "task:<name>:runP99".
+ *
+ *  @param[in]      taskPool    The task pool to query.
+ *  @param[out]     stats       Array to copy statistics into - may be NULL if statsCount is 0.
+ *  @param[in]      statsCount  Number of entries in `stats`.
+ *
+ *  @return                     The number of task names that the pool has statistics for - at
+ *                              most this many entries are written to `stats`.
+ */
+uint32_t ldcTaskPoolGetStats(LdcTaskPool* taskPool, LdcTaskStats* stats, uint32_t statsCount);
+
+/*! Clear the task pool's latency statistics.
+ *
+ *  @param[in]      taskPool    The task pool to reset.
+ */
+void ldcTaskPoolResetStats(LdcTaskPool* taskPool);
+
+/*! Estimate a percentile from a latency histogram.
+ *
+ *  @param[in]      histogram   A wait or run histogram from LdcTaskStats.
+ *  @param[in]      percent     The percentile wanted, 0 to 100.
+ *
+ *  @return                     Upper bound in microseconds of the bucket holding the percentile,
+ *                              or 0 if the histogram is empty.
+ */
+uint32_t ldcTaskStatsPercentile(const uint32_t histogram[kTaskStatsBuckets], uint32_t percent);
+
 /*! Add a new stand alone task to the pool with no dependencies
  *
  *  @param[in]      taskPool            The task pool the task to be added to.
@@ -122,6 +219,9 @@ LdcTask* ldcTaskPoolAdd(LdcTaskPool* taskPool, LdcTaskFunction taskFunction,
  *  @param[in]      completionFunction      The function to call one task has been executed.
  *  @param[in]      iterations              The number of 'things' that comprise this task.
  *  @param[in]      maxIterationsPerPart    The maximum number of 'things' that can be executed in each call to taskFunction.
+ *                                          The task is split lazily down to this size as workers
+ *                                          become free. 0 means no limit - the task is split once
+ *                                          by number of threads.
  *  @param[in]      dataSize                Size in bytes of task specific input that that is copied into task.
  *  @param[in]      data                    Task specific data to copy into task.
  *  @param[in]      name                    The groups name - for logging.
@@ -149,7 +249,12 @@ void ldcTaskPoolWait(LdcTaskPool* taskPool);
  *
  *  If the return is true the task pointer will no longer be valid - the task block will have ben cleared up.
  *
- *  @return                                 True if task completed, or NULL if task pointer was NULL
+ *  Must not be called from one of the pool's worker threads - an error is logged and false is
+ *  returned. A task should pass itself as the parent of any nested work, so that its output is
+ *  deferred instead.
+ *
+ *  @return                                 True if task completed, false if task pointer was NULL or
+ *                                          called from a worker thread
  */
 bool ldcTaskWait(LdcTask* task, void** outputPtr);
 
@@ -331,29 +436,192 @@ LdcTaskDependency ldcTaskRemoveOutput(LdcTask* task);
  *  @param[in]     argument     Data that is copied and passed as an argument to `function` and `completion`
  *  @param[in]     argumentSize Size in bytes of argument data to be copied.
  *  @param[in]     totalSize    Number of iterations for this task.
+ *  @param[in]     minSliceSize Minimum grain - slices are split lazily down to this many iterations
+ *                              whilst other workers are available. 0 means the task is initially
+ *                              split by number of threads, and not split further.
  *
- *  @return                     True if task was successfully created.
+ *  @return                     True if task was successfully created. False if `parent` is NULL
+ *                              and this is called from a worker of the pool, as the task would
+ *                              have to be waited for.
  */
 bool ldcTaskPoolAddSlicedDeferred(LdcTaskPool* pool, LdcTask* parent,
                                   bool (*function)(void* argument, uint32_t offset, uint32_t count),
                                   bool (*completion)(void* argument, uint32_t count),
-                                  void* argument, uint32_t argumentSize, uint32_t totalSize);
+                                  void* argument, uint32_t argumentSize, uint32_t totalSize,
+                                  uint32_t minSliceSize);
+
+/*! Attach a client to a task pool
+ *
+ * Clients allow several independent users to share one pool - each client's tasks get a share of
+ * the pool's threads in proportion to its weight whenever the pool is fully busy.
+ *
+ *  @param[in]      taskPool    The task pool to attach to.
+ *  @param[out]     client      The client to initialize.
+ *  @param[in]      weight      Relative weight of this client - 0 is treated as 1.
+ *
+ *  @return                     True if successful.
+ */
+bool ldcTaskPoolClientAttach(LdcTaskPool* taskPool, LdcTaskPoolClient* client, uint32_t weight);
+
+/*! Detach a client from its task pool
+ *
+ * All tasks of the client should be finished before it is detached.
+ *
+ *  @param[in]      client      The client to detach.
+ */
+void ldcTaskPoolClientDetach(LdcTaskPoolClient* client);
+
+/*! Set the client that a group's tasks will be accounted to
+ *
+ * Should be called before any tasks are added to the group.
+ *
+ *  @param[in]      taskGroup   The task group.
+ *  @param[in]      client      The client attached to the group's pool, or NULL for none.
+ */
+void ldcTaskGroupSetClient(LdcTaskGroup* taskGroup, LdcTaskPoolClient* client);
+
+/*! Set the scheduling deadline of a group
+ *
+ * Workers prefer ready parts of tasks from groups with earlier deadlines (Earliest Deadline First).
+ * Applies to tasks that become ready after the call.
+ *
+ *  @param[in]      taskGroup   The task group.
+ *  @param[in]      deadline    Deadline as from threadTimeMicroseconds(), or UINT64_MAX for none.
+ */
+void ldcTaskGroupSetDeadline(LdcTaskGroup* taskGroup, uint64_t deadline);
+
+/*! Function used to update the data of each task in a graph
+ *
+ *  @param[in]      context     Context pointer passed to ldcTaskGraphPatch() or ldcTaskGroupInstantiate().
+ *  @param[in]      function    The task function of the node being patched.
+ *  @param[in,out]  data        The node's task data.
+ *  @param[in]      dataSize    Size in bytes of task data.
+ */
+typedef void (*LdcTaskGraphPatchFunction)(void* context, LdcTaskFunction function, void* data,
+                                          size_t dataSize);
+
+/*! Initialize an empty task graph
+ *
+ *  @param[out]     graph       The graph to initialize.
+ *  @param[in]      allocator   Allocator for recorded nodes.
+ */
+void ldcTaskGraphInitialize(LdcTaskGraph* graph, LdcMemoryAllocator* allocator);
+
+/*! Release any memory used by a task graph
+ *
+ *  @param[in]      graph       The graph to destroy.
+ */
+void ldcTaskGraphDestroy(LdcTaskGraph* graph);
+
+/*! Update the task data of every node in a graph
+ *
+ *  This is typically used after recording to replace any pointers that are specific to the
+ *  recording group with something that can be resolved at instantiation.
+ *
+ *  @param[in]      graph       The graph to patch.
+ *  @param[in]      patch       Function called for each node.
+ *  @param[in]      context     Passed to `patch`.
+ */
+void ldcTaskGraphPatch(LdcTaskGraph* graph, LdcTaskGraphPatchFunction patch, void* context);
+
+/*! Start recording tasks and dependencies added to a group into a graph
+ *
+ *  Any previous contents of the graph are discarded. Dependencies added during recording are
+ *  numbered from the group's current dependency count.
+ *
+ *  @param[in]      taskGroup   The task group to record.
+ *  @param[in]      graph       The graph to record into.
+ */
+void ldcTaskGroupRecordBegin(LdcTaskGroup* taskGroup, LdcTaskGraph* graph);
+
+/*! Stop recording a group
+ *
+ *  @param[in]      taskGroup   The task group being recorded.
+ *
+ *  @return                     True if the recorded graph is complete.
+ */
+bool ldcTaskGroupRecordEnd(LdcTaskGroup* taskGroup);
+
+/*! Add the dependencies and tasks of a recorded graph to a group
+ *
+ *  The group must have the same number of dependencies as the recorded group did when recording
+ *  started. Each node's data is copied and passed to `patch` (if not NULL) before the task is added.
+ *
+ *  @param[in]      taskGroup   The task group to add to.
+ *  @param[in]      graph       A recorded graph.
+ *  @param[in]      patch       If not NULL, function called to update each node's task data.
+ *  @param[in]      context     Passed to `patch`.
+ *
+ *  @return                     True if successful.
+ */
+bool ldcTaskGroupInstantiate(LdcTaskGroup* taskGroup, const LdcTaskGraph* graph,
+                             LdcTaskGraphPatchFunction patch, void* context);
 
 /*! Block a task group - will stop new tasks being scheduled
  *
  * This can be used to inspect the full task graph for a group, with the
  * scheduler diving and removing steps.
  *
+ * Blocks nest - the group stays blocked until each call has been matched by
+ * ldcTaskGroupUnblock().
+ *
  *  @param[in]      taskGroup   The task group to block.
  */
 void ldcTaskGroupBlock(LdcTaskGroup* taskGroup);
 
-/*! Unblock a task group - all pending tasks will be scheduled
+/*! Unblock a task group - once the last block is released, all pending tasks will be scheduled
  *
  *  @param[in]      taskGroup   The task group to unblock.
  */
 void ldcTaskGroupUnblock(LdcTaskGroup* taskGroup);
 
+/*! Function used to pick tasks that must still run when a group is cancelled
+ *
+ *  @param[in]      context     Context pointer passed to ldcTaskGroupCancel().
+ *  @param[in]      function    The task function of the task being considered.
+ *  @param[in]      data        The task's data.
+ *  @param[in]      dataSize    Size in bytes of task data.
+ *
+ *  @return                     True if the task should still run.
+ */
+typedef bool (*LdcTaskGroupKeepFunction)(void* context, LdcTaskFunction function,
+                                         const void* data, size_t dataSize);
+
+/*! Function called in place of the task function of a cancelled task
+ *
+ * Called once the task's inputs are met, with the task's group locked - it must not call task
+ * group functions for the same group. This allows tasks that hand resources back to do so for
+ * cancelled work.
+ *
+ *  @param[in]      context     Context pointer passed to ldcTaskGroupCancel().
+ *  @param[in]      task        The cancelled task.
+ */
+typedef void (*LdcTaskGroupCancelledFunction)(void* context, LdcTask* task);
+
+/*! Cancel the tasks of a group that have not started yet
+ *
+ * A cancelled task still waits for its inputs, but its task function is not called, and its output
+ * is met with a NULL value as soon as the inputs are met - without going through the ready
+ * deques. Chains of cancelled tasks resolve in one step when their first input is met. Parts of
+ * cancelled tasks that are already ready are removed from the pool, and their outputs are met
+ * before this function returns.
+ *
+ * Tasks are not cancelled if they have started, have a completion function, or are picked by
+ * `keep`. Any other tasks that produce the inputs of such tasks are also kept.
+ *
+ * Only tasks in the group at the time of the call are affected.
+ *
+ *  @param[in]      taskGroup   The task group to cancel.
+ *  @param[in]      keep        If not NULL, function called for each task that could be cancelled.
+ *  @param[in]      cancelled   If not NULL, function called for each cancelled task once its
+ *                              inputs are met.
+ *  @param[in]      context     Passed to `keep` and `cancelled`.
+ *
+ *  @return                     The number of cancelled tasks in the group that are not done yet.
+ */
+uint32_t ldcTaskGroupCancel(LdcTaskGroup* taskGroup, LdcTaskGroupKeepFunction keep,
+                            LdcTaskGroupCancelledFunction cancelled, void* context);
+
 #ifdef VN_SDK_LOG_ENABLE_DEBUG
 
 /*! Utility function to dump state of task pool to log
@@ -19,6 +19,10 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#if VN_ARCH(X86) || VN_ARCH(X64)
+#include <emmintrin.h>
+#endif
+
 /*! @file
  * @brief Threads and inter-thread communications.
  *
@@ -97,6 +101,11 @@ int threadSleep(uint32_t milliseconds);
  */
 static inline void threadYield(void);
 
+/*! Hint to the CPU that the caller is in a spin-wait loop.
+ *
+ */
+static inline void threadPause(void);
+
 /*! Try to associate a name with the current thread.
  *
  * Typically used by debuggers and performance tracing.
@@ -111,6 +120,97 @@ void threadSetName(const char* name);
  */
 int32_t threadNumCores(void);
 
+/*! Maximum number of CPUs that can be described by a `ThreadCpuSet`
+ */
+#define kThreadCpuSetMax 256 // NOLINT
+
+/*! A set of logical CPUs, used to control where threads are scheduled.
+ */
+typedef struct ThreadCpuSet
+{
+    uint64_t bits[kThreadCpuSetMax / 64];
+} ThreadCpuSet;
+
+/*! Classes of core on processors that mix core types (eg: Intel P/E cores, ARM big.LITTLE)
+ */
+typedef enum ThreadCoreClass
+{
+    ThreadCoreClassAny = 0,
+    ThreadCoreClassPerformance = 1,
+    ThreadCoreClassEfficiency = 2,
+} ThreadCoreClass;
+
+static inline void threadCpuSetClear(ThreadCpuSet* set)
+{
+    for (uint32_t i = 0; i < kThreadCpuSetMax / 64; ++i) {
+        set->bits[i] = 0;
+    }
+}
+
+static inline void threadCpuSetAdd(ThreadCpuSet* set, uint32_t cpu)
+{
+    if (cpu < kThreadCpuSetMax) {
+        set->bits[cpu / 64] |= 1ULL << (cpu % 64);
+    }
+}
+
+static inline bool threadCpuSetContains(const ThreadCpuSet* set, uint32_t cpu)
+{
+    return cpu < kThreadCpuSetMax && (set->bits[cpu / 64] & (1ULL << (cpu % 64))) != 0;
+}
+
+static inline bool threadCpuSetIsEmpty(const ThreadCpuSet* set)
+{
+    for (uint32_t i = 0; i < kThreadCpuSetMax / 64; ++i) {
+        if (set->bits[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*! Remove any CPUs from `set` that are not also in `other`.
+ */
+static inline void threadCpuSetIntersect(ThreadCpuSet* set, const ThreadCpuSet* other)
+{
+    for (uint32_t i = 0; i < kThreadCpuSetMax / 64; ++i) {
+        set->bits[i] &= other->bits[i];
+    }
+}
+
+/*! Parse a CPU list of the form used by Linux sysfs and `taskset`, eg: "0-3,8,10-11".
+ *
+ * @param[out] set          The set to fill in.
+ * @param[in]  list         The CPU list string.
+ * @return                  True if the list was well formed.
+ */
+bool threadCpuSetParse(ThreadCpuSet* set, const char* list);
+
+/*! Get the set of CPUs that belong to a core class.
+ *
+ * If the processor does not have distinguishable core classes, all CPUs are returned.
+ *
+ * @param[out] set          The set to fill in.
+ * @param[in]  coreClass    The class of core wanted.
+ * @return                  True if successful, false if the platform cannot describe its CPUs.
+ */
+bool threadCpuSetFromCoreClass(ThreadCpuSet* set, ThreadCoreClass coreClass);
+
+/*! Get the set of CPUs that are local to a NUMA node.
+ *
+ * @param[out] set          The set to fill in.
+ * @param[in]  node         The NUMA node index.
+ * @return                  True if successful, false if the node is not known.
+ */
+bool threadCpuSetFromNumaNode(ThreadCpuSet* set, uint32_t node);
+
+/*! Restrict the current thread to run on the given set of CPUs.
+ *
+ * @param[in] set           A non-empty set of CPUs.
+ * @return                  0 if successful, an error otherwise.
+ */
+int threadSetAffinity(const ThreadCpuSet* set);
+
 /*! Opaque type for mutexes.
  *
  */
@@ -243,6 +343,19 @@ uint64_t threadTimeMicroseconds(int32_t microseconds);
 #include "detail/threads_pthread.h"
 #endif
 
+// Spin-wait hint depends on architecture rather than OS
+//
+static inline void threadPause(void)
+{
+#if VN_ARCH(X86) || VN_ARCH(X64)
+    _mm_pause();
+#elif (VN_ARCH(ARM64) || VN_ARCH(ARM7A)) && VN_COMPILER(MSVC)
+    __yield();
+#elif VN_ARCH(ARM64) || VN_ARCH(ARM7A)
+    __asm__ __volatile__("yield");
+#endif
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,33 +16,186 @@
 #include <LCEVC/common/acceleration.h>
 //
 #include <assert.h>
+#include <stdint.h>
+
+#define VN_ACCELERATION_CPUID() \
+    (VN_SDK_FEATURE(SSE) && (VN_ARCH(X86) || VN_ARCH(X64)) && !VN_OS(BROWSER))
+
+#if VN_ACCELERATION_CPUID() && VN_COMPILER(MSVC)
+#include <intrin.h>
+#elif VN_ACCELERATION_CPUID()
+#include <cpuid.h>
+#endif
+
+#if VN_SDK_FEATURE(NEON) && VN_ARCH(ARM64) && (VN_OS(LINUX) || VN_OS(ANDROID))
+#include <sys/auxv.h>
+#endif
+
+/*------------------------------------------------------------------------------*/
 
 static LdcAcceleration defaultAcceleration = {0};
 static const LdcAcceleration* currentAcceleration = &defaultAcceleration;
 
-void ldcAccelerationInitialize(bool enable)
+/*------------------------------------------------------------------------------*/
+
+#if VN_ACCELERATION_CPUID()
+
+/* The kernels for each instruction set are built into their own translation units, so a build for
+ * the SSE baseline can still use them if the CPU it is running on supports them. */
+typedef struct CPUInfo
 {
-    if (enable) {
-#if VN_SDK_FEATURE(SSE)
-        defaultAcceleration.SSE = true;
+    uint32_t maxLeaf;
+    uint32_t leaf1ECX;
+    uint32_t leaf7EBX;
+    uint64_t xcr0;
+} CPUInfo;
+
+static void loadCPUID(uint32_t leaf, uint32_t regs[4])
+{
+#if VN_COMPILER(MSVC)
+    int info[4] = {0};
+    __cpuidex(info, (int)leaf, 0);
+    for (int32_t i = 0; i < 4; ++i) {
+        regs[i] = (uint32_t)info[i];
+    }
 #else
-        defaultAcceleration.SSE = false;
+    __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
 #endif
-#if VN_SDK_FEATURE(AVX2)
-        defaultAcceleration.AVX2 = true;
+}
+
+/* XCR0 says which register state the OS saves on a context switch - only valid with OSXSAVE. */
+static uint64_t loadXCR0(void)
+{
+#if VN_COMPILER(MSVC)
+    return _xgetbv(0);
 #else
-        defaultAcceleration.AVX2 = false;
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+    __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((uint64_t)hi << 32) | lo;
 #endif
-#if VN_SDK_FEATURE(NEON)
-        defaultAcceleration.NEON = true;
+}
+
+static CPUInfo loadCPUInfo(void)
+{
+    static const uint32_t kOSXSAVE = 1u << 27;
+    CPUInfo info = {0};
+    uint32_t regs[4] = {0};
+
+    loadCPUID(0, regs);
+    info.maxLeaf = regs[0];
+
+    if (info.maxLeaf >= 1) {
+        loadCPUID(1, regs);
+        info.leaf1ECX = regs[2];
+        if (info.leaf1ECX & kOSXSAVE) {
+            info.xcr0 = loadXCR0();
+        }
+    }
+    if (info.maxLeaf >= 7) {
+        loadCPUID(7, regs);
+        info.leaf7EBX = regs[1];
+    }
+
+    return info;
+}
+
+static bool detectSSE(const CPUInfo* info)
+{
+    static const uint32_t kSSE41 = 1u << 19;
+    return (info->leaf1ECX & kSSE41) != 0;
+}
+
+static bool detectAVX2(const CPUInfo* info)
+{
+    static const uint32_t kAVX = 1u << 28;
+    static const uint32_t kAVX2 = 1u << 5;
+    static const uint64_t kYMMState = 0x6; /* XMM and YMM */
+
+    return (info->leaf1ECX & kAVX) && ((info->xcr0 & kYMMState) == kYMMState) &&
+           (info->leaf7EBX & kAVX2);
+}
+
+/* AVX-512 kernels need the F, BW (16-bit elements) and VL (128/256-bit forms) subsets. */
+static bool detectAVX512(const CPUInfo* info)
+{
+    static const uint32_t kAVX512 = (1u << 16) | (1u << 30) | (1u << 31);
+    static const uint64_t kZMMState = 0xE6; /* XMM, YMM, opmask and both halves of ZMM */
+
+    return ((info->xcr0 & kZMMState) == kZMMState) && ((info->leaf7EBX & kAVX512) == kAVX512);
+}
+
+static bool detectBMI2(const CPUInfo* info)
+{
+    static const uint32_t kBMI2 = 1u << 8;
+    return (info->leaf7EBX & kBMI2) != 0;
+}
+
+#endif /* VN_ACCELERATION_CPUID() */
+
+static bool detectSVE(void)
+{
+#if VN_SDK_FEATURE(NEON) && VN_ARCH(ARM64) && (VN_OS(LINUX) || VN_OS(ANDROID))
+    static const unsigned long kHWCapSVE = 1ul << 22;
+    return (getauxval(AT_HWCAP) & kHWCapSVE) != 0;
 #else
-        defaultAcceleration.NEON = false;
+    return false;
 #endif
+}
+
+static void detectFeatures(LdcAcceleration* acceleration)
+{
+#if VN_ACCELERATION_CPUID()
+    const CPUInfo info = loadCPUInfo();
+
+    acceleration->SSE = detectSSE(&info);
+    acceleration->AVX2 = acceleration->SSE && detectAVX2(&info);
+    acceleration->AVX512 = acceleration->AVX2 && detectAVX512(&info);
+    acceleration->BMI2 = detectBMI2(&info);
+#else
+    acceleration->SSE = VN_SDK_FEATURE(SSE);
+    acceleration->AVX2 = VN_SDK_FEATURE(AVX2);
+    acceleration->AVX512 = VN_SDK_FEATURE(AVX512);
+    acceleration->BMI2 = false;
+#endif
+
+    /* NEON is part of the AArch64 baseline, and builds for other ARM targets require it. */
+    acceleration->NEON = VN_SDK_FEATURE(NEON);
+    acceleration->SVE = acceleration->NEON && detectSVE();
+}
+
+/*------------------------------------------------------------------------------*/
+
+/* Apply each kernel family's level up front, so that dispatch only has to read its flags. */
+static void resolveKernels(LdcAcceleration* acceleration)
+{
+    for (int32_t kernel = 0; kernel < LdcKernelCount; ++kernel) {
+        const LdcAccelerationLevel level = acceleration->kernelLevel[kernel];
+        const bool isAuto = (level == LdcAccelerationLevelAuto);
+        LdcAccelerationFeatures* features = &acceleration->kernel[kernel];
+
+        features->SSE = acceleration->SSE && (isAuto || level >= LdcAccelerationLevelBaseline);
+        features->AVX2 = acceleration->AVX2 && (isAuto || level >= LdcAccelerationLevelAVX2);
+        features->AVX512 = acceleration->AVX512 && (isAuto || level >= LdcAccelerationLevelAVX512);
+        features->BMI2 = acceleration->BMI2 && (isAuto || level >= LdcAccelerationLevelAVX2);
+        features->NEON = acceleration->NEON && (isAuto || level >= LdcAccelerationLevelBaseline);
+        features->SVE = acceleration->SVE && (isAuto || level >= LdcAccelerationLevelBaseline);
+    }
+}
+
+void ldcAccelerationInitialize(bool enable)
+{
+    if (enable) {
+        detectFeatures(&defaultAcceleration);
     } else {
         defaultAcceleration.SSE = false;
         defaultAcceleration.AVX2 = false;
+        defaultAcceleration.AVX512 = false;
+        defaultAcceleration.BMI2 = false;
         defaultAcceleration.NEON = false;
+        defaultAcceleration.SVE = false;
     }
+    resolveKernels(&defaultAcceleration);
 
     currentAcceleration = &defaultAcceleration;
 }
@@ -53,4 +206,21 @@ void ldcAccelerationSet(const LdcAcceleration* acceleration)
     currentAcceleration = acceleration;
 }
 
+bool ldcAccelerationSetKernelLevel(LdcAccelerationKernel kernel, LdcAccelerationLevel level)
+{
+    if (kernel < 0 || kernel >= LdcKernelCount || level < 0 || level >= LdcAccelerationLevelCount) {
+        return false;
+    }
+
+    defaultAcceleration.kernelLevel[kernel] = level;
+    resolveKernels(&defaultAcceleration);
+    return true;
+}
+
 const LdcAcceleration* ldcAccelerationGet(void) { return currentAcceleration; }
+
+const LdcAccelerationFeatures* ldcAccelerationGetKernel(LdcAccelerationKernel kernel)
+{
+    assert(kernel >= 0 && kernel < LdcKernelCount);
+    return &currentAcceleration->kernel[kernel];
+}
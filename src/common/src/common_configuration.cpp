@@ -20,8 +20,45 @@
 #include <LCEVC/common/diagnostics.h>
 #include <LCEVC/common/log.h>
 
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 namespace lcevc_dec::common {
 
+// Names used by the 'simd_kernels' option, as "<kernel>=<level>".
+//
+static const std::pair<std::string_view, LdcAccelerationKernel> kKernelNames[] = {
+    {"apply_cmdbuffer", LdcKernelApplyCmdBuffer},
+    {"blit", LdcKernelBlit},
+    {"entropy", LdcKernelEntropy},
+    {"transform", LdcKernelTransform},
+    {"upscale", LdcKernelUpscale},
+};
+
+static const std::pair<std::string_view, LdcAccelerationLevel> kLevelNames[] = {
+    {"auto", LdcAccelerationLevelAuto},
+    {"scalar", LdcAccelerationLevelScalar},
+    {"sse", LdcAccelerationLevelBaseline},
+    {"neon", LdcAccelerationLevelBaseline},
+    {"avx2", LdcAccelerationLevelAVX2},
+    {"avx512", LdcAccelerationLevelAVX512},
+};
+
+template <typename T, size_t N>
+static bool findName(const std::pair<std::string_view, T> (&names)[N], std::string_view name,
+                     T& out)
+{
+    for (const auto& [key, value] : names) {
+        if (key == name) {
+            out = value;
+            return true;
+        }
+    }
+    return false;
+}
+
 class CommonConfiguration
 {
 public:
@@ -64,6 +101,27 @@ public:
         return true;
     }
 
+    bool setSIMDKernels(const std::vector<std::string>& arr)
+    {
+        bool res = true;
+        for (const std::string& entry : arr) {
+            const std::string_view view(entry);
+            const size_t split = view.find('=');
+            LdcAccelerationKernel kernel = LdcKernelCount;
+            LdcAccelerationLevel level = LdcAccelerationLevelAuto;
+
+            if (split == std::string_view::npos ||
+                !findName(kKernelNames, view.substr(0, split), kernel) ||
+                !findName(kLevelNames, view.substr(split + 1), level)) {
+                VNLogErrorF("Invalid simd_kernels entry: %s", entry.c_str());
+                res = false;
+                continue;
+            }
+            ldcAccelerationSetKernelLevel(kernel, level);
+        }
+        return res;
+    }
+
     bool setLogLevel(const int32_t& val)
     {
         if (val < 0 || val >= LdcLogLevelCount) {
@@ -87,6 +145,7 @@ private:
 static const common::ConfigMemberMap<CommonConfiguration> kConfigMemberMap = {
     {"log_stdout", makeBinding(&CommonConfiguration::setLogToStdout)},
     {"disable_simd", makeBinding(&CommonConfiguration::setDisableSIMD)},
+    {"simd_kernels", makeBinding(&CommonConfiguration::setSIMDKernels)},
     {"log_level", makeBinding(&CommonConfiguration::setLogLevel)},
     {"trace_file", makeBinding(&CommonConfiguration::setTraceFile)},
     {"log_levels", makeBinding(&CommonConfiguration::setLogLevels)},
@@ -0,0 +1,111 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#include <LCEVC/common/memory_numa.h>
+#include <LCEVC/common/platform.h>
+
+#if VN_OS(LINUX) || VN_OS(ANDROID)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if (VN_OS(LINUX) || VN_OS(ANDROID)) && defined(SYS_mbind)
+#define VN_NUMA_MBIND 1
+#else
+#define VN_NUMA_MBIND 0
+#endif
+
+#if VN_NUMA_MBIND
+// From <linux/mempolicy.h>
+#define kMpolPreferred 1 // NOLINT
+#define kMaxNumaNodes 1024 // NOLINT
+#endif
+
+// Give the whole pages within an allocation a preferred node. Pages that have already been touched
+// are left where they are.
+static void numaBind(const LdcMemoryAllocatorNuma* na, const LdcMemoryAllocation* allocation)
+{
+#if VN_NUMA_MBIND
+    if (!allocation->ptr || allocation->size < kMemoryNumaMinBindSize || na->node >= kMaxNumaNodes) {
+        return;
+    }
+
+    const uintptr_t start = ((uintptr_t)allocation->ptr + na->pageSize - 1) & ~(na->pageSize - 1);
+    const uintptr_t end = ((uintptr_t)allocation->ptr + allocation->size) & ~(na->pageSize - 1);
+    if (end <= start) {
+        return;
+    }
+
+    unsigned long nodeMask[kMaxNumaNodes / (8 * sizeof(unsigned long))] = {0};
+    nodeMask[na->node / (8 * sizeof(unsigned long))] = 1UL << (na->node % (8 * sizeof(unsigned long)));
+
+    // Failure just leaves default placement
+    syscall(SYS_mbind, (void*)start, (unsigned long)(end - start), kMpolPreferred, nodeMask,
+            (unsigned long)kMaxNumaNodes, 0U);
+#else
+    VNUnused(na);
+    VNUnused(allocation);
+#endif
+}
+
+static void* numaAllocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
+                          size_t size, size_t alignment)
+{
+    LdcMemoryAllocatorNuma* na = (LdcMemoryAllocatorNuma*)allocator;
+
+    void* ptr = na->parentAllocator->functions->allocate(na->parentAllocator, allocation, size, alignment);
+    numaBind(na, allocation);
+    return ptr;
+}
+
+static void* numaReallocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation, size_t size)
+{
+    LdcMemoryAllocatorNuma* na = (LdcMemoryAllocatorNuma*)allocator;
+
+    void* ptr = na->parentAllocator->functions->reallocate(na->parentAllocator, allocation, size);
+    numaBind(na, allocation);
+    return ptr;
+}
+
+static void numaFree(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation)
+{
+    LdcMemoryAllocatorNuma* na = (LdcMemoryAllocatorNuma*)allocator;
+
+    na->parentAllocator->functions->free(na->parentAllocator, allocation);
+}
+
+/* clang-format off */
+static const LdcMemoryAllocatorFunctions kNumaMemoryFunctions = {
+    numaAllocate,
+    numaReallocate,
+    numaFree
+};
+/* clang-format on */
+
+LdcMemoryAllocator* ldcMemoryAllocatorNumaInitialize(LdcMemoryAllocatorNuma* numaAllocator,
+                                                     LdcMemoryAllocator* parentAllocator, uint32_t node)
+{
+    numaAllocator->allocator.functions = &kNumaMemoryFunctions;
+    numaAllocator->allocator.allocatorData = NULL;
+    numaAllocator->parentAllocator = parentAllocator;
+    numaAllocator->node = node;
+#if VN_NUMA_MBIND
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    numaAllocator->pageSize = (pageSize > 0) ? (size_t)pageSize : 4096;
+#else
+    numaAllocator->pageSize = 4096;
+#endif
+
+    return &numaAllocator->allocator;
+}
@@ -20,9 +20,46 @@
 #include <LCEVC/common/threads.h>
 //
 #include <assert.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+// Number of attempts a blocking push or pop makes before falling back to waiting on a condvar -
+// the first few with a CPU pause between them, then yielding so that a producer or consumer
+// sharing the core can make progress.
+static const uint32_t kRingBufferPauseCount = 16;
+static const uint32_t kRingBufferSpinCount = 64;
+
+enum
+{
+    kRingBufferCacheLine = 64
+};
+
+// Shared state for lock free modes.
+//
+// `tail` and `head` are free running positions - `tail` is written by producers and `head` by
+// consumers, so each gets its own cache line. For MPMC, each slot has a sequence number (Vyukov
+// style) that says whether it is ready to be written (== position) or read (== position + 1).
+//
+typedef struct LdcRingBufferLockFree
+{
+    atomic_uint tail;
+    uint8_t pad0[kRingBufferCacheLine - sizeof(atomic_uint)];
+    atomic_uint head;
+    uint8_t pad1[kRingBufferCacheLine - sizeof(atomic_uint)];
+    atomic_uint waitingProducers;
+    atomic_uint waitingConsumers;
+    uint8_t pad2[kRingBufferCacheLine - 2 * sizeof(atomic_uint)];
+    atomic_uint sequence[];
+} LdcRingBufferLockFree;
 
 void ldcRingBufferInitialize(LdcRingBuffer* ringBuffer, uint32_t capacity, uint32_t elementSize,
                              LdcMemoryAllocator* allocator)
+{
+    ldcRingBufferInitializeMode(ringBuffer, capacity, elementSize, allocator, LdcRingBufferModeLocked);
+}
+
+void ldcRingBufferInitializeMode(LdcRingBuffer* ringBuffer, uint32_t capacity, uint32_t elementSize,
+                                 LdcMemoryAllocator* allocator, LdcRingBufferMode mode)
 {
     assert(allocator);
     assert(VNIsPowerOfTwo(capacity));
@@ -36,7 +73,29 @@ void ldcRingBufferInitialize(LdcRingBuffer* ringBuffer, uint32_t capacity, uint3
     ringBuffer->capacity = capacity;
     ringBuffer->mask = capacity - 1;
     ringBuffer->elementSize = elementSize;
+    ringBuffer->mode = mode;
+
+    if (mode != LdcRingBufferModeLocked) {
+        const size_t sequenceCount = (mode == LdcRingBufferModeMPMC) ? capacity : 0;
+        const size_t size = sizeof(LdcRingBufferLockFree) + sequenceCount * sizeof(atomic_uint);
+
+        VNAllocateAlignedZeroArray(allocator, &ringBuffer->lockFreeAllocation, uint8_t,
+                                   kRingBufferCacheLine, size);
+        VNCheck(VNAllocationSucceeded(ringBuffer->lockFreeAllocation));
+        LdcRingBufferLockFree* lockFree =
+            VNAllocationPtr(ringBuffer->lockFreeAllocation, LdcRingBufferLockFree);
 
+        atomic_init(&lockFree->tail, 0);
+        atomic_init(&lockFree->head, 0);
+        atomic_init(&lockFree->waitingProducers, 0);
+        atomic_init(&lockFree->waitingConsumers, 0);
+        for (uint32_t i = 0; i < sequenceCount; ++i) {
+            atomic_init(&lockFree->sequence[i], i);
+        }
+        ringBuffer->lockFree = lockFree;
+    }
+
+    // The mutex and condition variables are used by blocking lock free operations too
     VNCheck(threadMutexInitialize(&ringBuffer->mutex) == ThreadResultSuccess);
     VNCheck(threadCondVarInitialize(&ringBuffer->notEmpty) == ThreadResultSuccess);
     VNCheck(threadCondVarInitialize(&ringBuffer->notFull) == ThreadResultSuccess);
@@ -47,8 +106,222 @@ void ldcRingBufferInitialize(LdcRingBuffer* ringBuffer, uint32_t capacity, uint3
 void ldcRingBufferDestroy(LdcRingBuffer* buffer)
 {
     VNFree(buffer->allocator, &buffer->dataAllocation);
+    if (buffer->lockFree) {
+        VNFree(buffer->allocator, &buffer->lockFreeAllocation);
+        buffer->lockFree = NULL;
+    }
 
     threadCondVarDestroy(&buffer->notEmpty);
     threadCondVarDestroy(&buffer->notFull);
     threadMutexDestroy(&buffer->mutex);
 }
+
+// Lock free push/pop without any waking of waiters
+//
+static bool lockFreePushSPSC(LdcRingBuffer* ringBuffer, const void* element)
+{
+    LdcRingBufferLockFree* lockFree = ringBuffer->lockFree;
+    const uint32_t tail = atomic_load_explicit(&lockFree->tail, memory_order_relaxed);
+    const uint32_t head = atomic_load_explicit(&lockFree->head, memory_order_acquire);
+
+    if (tail - head >= ringBuffer->capacity - 1) {
+        return false;
+    }
+
+    memcpy(ringBuffer->data + (tail & ringBuffer->mask) * ringBuffer->elementSize, element,
+           ringBuffer->elementSize);
+    atomic_store_explicit(&lockFree->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+static bool lockFreePopSPSC(LdcRingBuffer* ringBuffer, void* element)
+{
+    LdcRingBufferLockFree* lockFree = ringBuffer->lockFree;
+    const uint32_t head = atomic_load_explicit(&lockFree->head, memory_order_relaxed);
+    const uint32_t tail = atomic_load_explicit(&lockFree->tail, memory_order_acquire);
+
+    if (head == tail) {
+        return false;
+    }
+
+    memcpy(element, ringBuffer->data + (head & ringBuffer->mask) * ringBuffer->elementSize,
+           ringBuffer->elementSize);
+    atomic_store_explicit(&lockFree->head, head + 1, memory_order_release);
+    return true;
+}
+
+static bool lockFreePushMPMC(LdcRingBuffer* ringBuffer, const void* element)
+{
+    LdcRingBufferLockFree* lockFree = ringBuffer->lockFree;
+    uint32_t pos = atomic_load_explicit(&lockFree->tail, memory_order_relaxed);
+
+    for (;;) {
+        // Keep the same usable capacity as the locked buffer - 'pos' may be stale, so compare signed
+        const uint32_t head = atomic_load_explicit(&lockFree->head, memory_order_acquire);
+        if ((int32_t)(pos - head) >= (int32_t)(ringBuffer->capacity - 1)) {
+            return false;
+        }
+
+        atomic_uint* sequence = &lockFree->sequence[pos & ringBuffer->mask];
+        const uint32_t seq = atomic_load_explicit(sequence, memory_order_acquire);
+        const int32_t diff = (int32_t)(seq - pos);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&lockFree->tail, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                memcpy(ringBuffer->data + (pos & ringBuffer->mask) * ringBuffer->elementSize,
+                       element, ringBuffer->elementSize);
+                atomic_store_explicit(sequence, pos + 1, memory_order_release);
+                return true;
+            }
+            // 'pos' was updated by failed exchange
+        } else if (diff < 0) {
+            // Slot still holds an element that has not been popped
+            return false;
+        } else {
+            pos = atomic_load_explicit(&lockFree->tail, memory_order_relaxed);
+        }
+    }
+}
+
+static bool lockFreePopMPMC(LdcRingBuffer* ringBuffer, void* element)
+{
+    LdcRingBufferLockFree* lockFree = ringBuffer->lockFree;
+    uint32_t pos = atomic_load_explicit(&lockFree->head, memory_order_relaxed);
+
+    for (;;) {
+        atomic_uint* sequence = &lockFree->sequence[pos & ringBuffer->mask];
+        const uint32_t seq = atomic_load_explicit(sequence, memory_order_acquire);
+        const int32_t diff = (int32_t)(seq - (pos + 1));
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&lockFree->head, &pos, pos + 1,
+                                                      memory_order_release, memory_order_relaxed)) {
+                memcpy(element, ringBuffer->data + (pos & ringBuffer->mask) * ringBuffer->elementSize,
+                       ringBuffer->elementSize);
+                atomic_store_explicit(sequence, pos + ringBuffer->capacity, memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // Slot not yet written - empty
+            return false;
+        } else {
+            pos = atomic_load_explicit(&lockFree->head, memory_order_relaxed);
+        }
+    }
+}
+
+static inline bool lockFreePush(LdcRingBuffer* ringBuffer, const void* element)
+{
+    return (ringBuffer->mode == LdcRingBufferModeSPSC) ? lockFreePushSPSC(ringBuffer, element)
+                                                       : lockFreePushMPMC(ringBuffer, element);
+}
+
+static inline bool lockFreePop(LdcRingBuffer* ringBuffer, void* element)
+{
+    return (ringBuffer->mode == LdcRingBufferModeSPSC) ? lockFreePopSPSC(ringBuffer, element)
+                                                       : lockFreePopMPMC(ringBuffer, element);
+}
+
+// Wake any threads blocked in the opposite direction.
+//
+// The fence pairs with the one in the blocking paths after the waiting count is raised - either
+// the waiter sees the new position, or this sees the waiting count.
+//
+static void lockFreeWake(LdcRingBuffer* ringBuffer, atomic_uint* waiting, ThreadCondVar* condVar)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(waiting, memory_order_relaxed) == 0) {
+        return;
+    }
+
+    threadMutexLock(&ringBuffer->mutex);
+    threadCondVarBroadcast(condVar);
+    threadMutexUnlock(&ringBuffer->mutex);
+}
+
+bool ldcRingBufferLockFreeTryPush(LdcRingBuffer* ringBuffer, const void* element)
+{
+    if (!lockFreePush(ringBuffer, element)) {
+        return false;
+    }
+    lockFreeWake(ringBuffer, &ringBuffer->lockFree->waitingConsumers, &ringBuffer->notEmpty);
+    return true;
+}
+
+bool ldcRingBufferLockFreeTryPop(LdcRingBuffer* ringBuffer, void* element)
+{
+    if (!lockFreePop(ringBuffer, element)) {
+        return false;
+    }
+    lockFreeWake(ringBuffer, &ringBuffer->lockFree->waitingProducers, &ringBuffer->notFull);
+    return true;
+}
+
+void ldcRingBufferLockFreePush(LdcRingBuffer* ringBuffer, const void* element)
+{
+    LdcRingBufferLockFree* lockFree = ringBuffer->lockFree;
+
+    for (uint32_t spin = 0; spin < kRingBufferSpinCount; ++spin) {
+        if (ldcRingBufferLockFreeTryPush(ringBuffer, element)) {
+            return;
+        }
+        if (spin < kRingBufferPauseCount) {
+            threadPause();
+        } else {
+            threadYield();
+        }
+    }
+
+    // Slow path - announce that a producer is waiting, then retry under the mutex
+    threadMutexLock(&ringBuffer->mutex);
+    atomic_fetch_add_explicit(&lockFree->waitingProducers, 1, memory_order_seq_cst);
+    atomic_thread_fence(memory_order_seq_cst);
+    while (!lockFreePush(ringBuffer, element)) {
+        threadCondVarWait(&ringBuffer->notFull, &ringBuffer->mutex);
+    }
+    atomic_fetch_sub_explicit(&lockFree->waitingProducers, 1, memory_order_relaxed);
+    threadMutexUnlock(&ringBuffer->mutex);
+
+    lockFreeWake(ringBuffer, &lockFree->waitingConsumers, &ringBuffer->notEmpty);
+}
+
+void ldcRingBufferLockFreePop(LdcRingBuffer* ringBuffer, void* element)
+{
+    LdcRingBufferLockFree* lockFree = ringBuffer->lockFree;
+
+    for (uint32_t spin = 0; spin < kRingBufferSpinCount; ++spin) {
+        if (ldcRingBufferLockFreeTryPop(ringBuffer, element)) {
+            return;
+        }
+        if (spin < kRingBufferPauseCount) {
+            threadPause();
+        } else {
+            threadYield();
+        }
+    }
+
+    // Slow path - announce that a consumer is waiting, then retry under the mutex
+    threadMutexLock(&ringBuffer->mutex);
+    atomic_fetch_add_explicit(&lockFree->waitingConsumers, 1, memory_order_seq_cst);
+    atomic_thread_fence(memory_order_seq_cst);
+    while (!lockFreePop(ringBuffer, element)) {
+        threadCondVarWait(&ringBuffer->notEmpty, &ringBuffer->mutex);
+    }
+    atomic_fetch_sub_explicit(&lockFree->waitingConsumers, 1, memory_order_relaxed);
+    threadMutexUnlock(&ringBuffer->mutex);
+
+    lockFreeWake(ringBuffer, &lockFree->waitingProducers, &ringBuffer->notFull);
+}
+
+uint32_t ldcRingBufferLockFreeSize(const LdcRingBuffer* ringBuffer)
+{
+    LdcRingBufferLockFree* lockFree = ringBuffer->lockFree;
+
+    // Read head first so that a concurrent pop cannot make the result go negative
+    const uint32_t head = atomic_load_explicit(&lockFree->head, memory_order_acquire);
+    const uint32_t tail = atomic_load_explicit(&lockFree->tail, memory_order_acquire);
+    const uint32_t size = tail - head;
+
+    return (size < ringBuffer->capacity) ? size : ringBuffer->capacity - 1;
+}
@@ -23,9 +23,6 @@
 #include <stdio.h>
 #include <string.h>
 
-// Minimum alignment of allocations in bytes
-#define kMinAlignment 64
-
 static const LdcMemoryAllocatorFunctions kRollingArenaFunctions;
 
 static void rollingArenaDoubleSlots(LdcMemoryAllocatorRollingArena* arena)
@@ -52,17 +49,32 @@ static void rollingArenaAddBuffer(LdcMemoryAllocatorRollingArena* arena, uint32_
 {
     assert(VNIsPowerOfTwo(bufferSize));
 
-    // Pick next buffer
-    VNCheck(arena->bufferCount < kRollingArenaMaxBuffers);
-    struct LdcRollingArenaBuffer* buffer = &arena->buffers[arena->bufferCount];
-    arena->bufferCount++;
+    // Pick next buffer - reusing an entry whose memory has been released if possible
+    uint32_t index = 0;
+    while (index < arena->bufferCount && VNIsAllocated(arena->buffers[index].memory)) {
+        index++;
+    }
+    if (index == arena->bufferCount) {
+        VNCheck(arena->bufferCount < kRollingArenaMaxBuffers);
+        arena->bufferCount++;
+    }
+    struct LdcRollingArenaBuffer* buffer = &arena->buffers[index];
+    assert(buffer->allocationCount == 0);
 
     // Allocate the new memory buffer
-    VNCheck(VNAllocateAlignedArray(arena->parentAllocator, &buffer->memory, uint8_t, kMinAlignment,
-                                   bufferSize) != NULL);
+    VNCheck(VNAllocateAlignedArray(arena->parentAllocator, &buffer->memory, uint8_t,
+                                   kRollingArenaMinAlignment, bufferSize) != NULL);
     buffer->allocationCount = 0;
 
+    // Previous active buffer can be released now if nothing is using it
+    if (arena->bufferCount > 1 && arena->bufferActive != index &&
+        VNIsAllocated(arena->buffers[arena->bufferActive].memory) &&
+        arena->buffers[arena->bufferActive].allocationCount == 0) {
+        VNFree(arena->parentAllocator, &arena->buffers[arena->bufferActive].memory);
+    }
+
     // Adjust buffer state to refer to this new buffer
+    arena->bufferActive = index;
     arena->bufferSize = bufferSize;
     arena->bufferMask = bufferSize - 1;
     arena->bufferFront = 0;
@@ -113,7 +125,9 @@ void ldcRollingArenaDestroy(LdcMemoryAllocatorRollingArena* arena)
 {
     // Release buffers
     for (uint32_t buffer = 0; buffer < arena->bufferCount; ++buffer) {
-        VNFree(arena->parentAllocator, &arena->buffers[buffer].memory);
+        if (VNIsAllocated(arena->buffers[buffer].memory)) {
+            VNFree(arena->parentAllocator, &arena->buffers[buffer].memory);
+        }
     }
 
     // Release slots
@@ -125,10 +139,15 @@ static inline void* internalAllocate(LdcMemoryAllocator* allocator, LdcMemoryAll
 {
     LdcMemoryAllocatorRollingArena* arena = (LdcMemoryAllocatorRollingArena*)allocator;
 
-    assert(size > 0);
+    // Zero sized allocations still get a distinct slot
+    if (size == 0) {
+        size = 1;
+    }
 
     // Extra size for alignment
-    uintptr_t align = (allocation->alignment > kMinAlignment) ? allocation->alignment : kMinAlignment;
+    uintptr_t align = (allocation->alignment > kRollingArenaMinAlignment)
+                          ? allocation->alignment
+                          : kRollingArenaMinAlignment;
     const size_t alignedSize = size + align - 1;
 
     // Get buffer region
@@ -179,18 +198,18 @@ static inline void* internalAllocate(LdcMemoryAllocator* allocator, LdcMemoryAll
     // match this due to alignment and wrapping
     arena->slots[slot].beginOffset = oldBufferFront;
     arena->slots[slot].endOffset = arena->bufferFront;
-    arena->slots[slot].bufferIndex = arena->bufferCount - 1;
+    arena->slots[slot].bufferIndex = arena->bufferActive;
 
     // Mark active buffer as having another allocation
-    arena->buffers[arena->bufferCount - 1].allocationCount++;
+    arena->buffers[arena->bufferActive].allocationCount++;
 
     // Align the pointer as required
-    void* ptr = (uint8_t*)arena->buffers[arena->bufferCount - 1].memory.ptr + offset;
+    void* ptr = (uint8_t*)arena->buffers[arena->bufferActive].memory.ptr + offset;
     ptr = (void*)(((uintptr_t)ptr + align - 1) & ~(align - 1));
 
     // Fill in allocation
     allocation->ptr = ptr;
-    allocation->size = (uint32_t)size;
+    allocation->size = size;
     allocation->allocatorData = allocationIndex;
 
     return ptr;
@@ -218,7 +237,7 @@ static inline void internalFree(LdcMemoryAllocator* allocator, LdcMemoryAllocati
     // Mark slot as empty
     arena->slots[slot].beginOffset = arena->slots[slot].endOffset;
 
-    if (buffer == arena->bufferCount - 1) {
+    if (buffer == arena->bufferActive) {
         // Allocation is in active buffer ...
         if (beginOffset == arena->bufferBack) {
             // Oldest slot in active buffer  - bump buffer back over empty slots
@@ -244,14 +263,14 @@ static inline void internalFree(LdcMemoryAllocator* allocator, LdcMemoryAllocati
     assert(arena->buffers[buffer].allocationCount > 0);
     arena->buffers[buffer].allocationCount--;
 
-    if (arena->buffers[buffer].allocationCount == 0 && buffer != arena->bufferCount - 1) {
+    if (arena->buffers[buffer].allocationCount == 0 && buffer != arena->bufferActive) {
         // Buffer can be released
         VNFree(arena->parentAllocator, &arena->buffers[buffer].memory);
     }
 }
 
-static void* rollingArenaAllocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
-                                  size_t size, size_t alignment)
+void* ldcRollingArenaAllocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
+                              size_t size, size_t alignment)
 {
     assert(allocator);
     assert(allocation);
@@ -265,22 +284,38 @@ static void* rollingArenaAllocate(LdcMemoryAllocator* allocator, LdcMemoryAlloca
     return ptr;
 }
 
-static void rollingArenaFree(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation)
+void ldcRollingArenaFree(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation)
 {
     assert(allocator);
     assert(allocation);
     LdcMemoryAllocatorRollingArena* arena = (LdcMemoryAllocatorRollingArena*)allocator;
+
+    if (!VNIsAllocated(*allocation)) {
+        return;
+    }
+
     threadMutexLock(&arena->mutex);
 
     internalFree(allocator, allocation);
 
     threadMutexUnlock(&arena->mutex);
+
+    allocation->ptr = NULL;
+    allocation->size = 0;
+    allocation->allocatorData = 0;
 }
 
-static void* rollingArenaReallocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
-                                    size_t size)
+void* ldcRollingArenaReallocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
+                                size_t size)
 {
+    assert(allocator);
+    assert(allocation);
     LdcMemoryAllocatorRollingArena* arena = (LdcMemoryAllocatorRollingArena*)allocator;
+
+    if (!VNIsAllocated(*allocation)) {
+        return ldcRollingArenaAllocate(allocator, allocation, size, allocation->alignment);
+    }
+
     threadMutexLock(&arena->mutex);
 
     // Get slot number for this allocation
@@ -294,27 +329,48 @@ static void* rollingArenaReallocate(LdcMemoryAllocator* allocator, LdcMemoryAllo
     const uint32_t buffer = arena->slots[slot].bufferIndex;
     const uint32_t allocationOffset =
         (uint32_t)((uint8_t*)allocation->ptr - (uint8_t*)arena->buffers[buffer].memory.ptr);
+    const uint32_t endOffset = arena->slots[slot].endOffset;
 
-    // How much space is available in current allocation?
+    // How much space is available in current allocation? If the allocation was wrapped to the
+    // start of the buffer, it runs up to the end offset, and if it finishes exactly at the end of
+    // the buffer, the end offset has wrapped to 0.
     size_t currentSize = 0;
-    if (arena->slots[slot].endOffset > arena->slots[slot].beginOffset) {
-        currentSize = arena->slots[slot].endOffset - allocationOffset;
+    if (endOffset > allocationOffset) {
+        currentSize = endOffset - allocationOffset;
     } else {
-        // Allocation wraps over buffer - only consider end to end of buffer
         currentSize = arena->buffers[buffer].memory.size - allocationOffset;
     }
 
+    // Most recent allocation in active buffer can be grown in place, up to the back of the buffer
+    const bool isFront = (slot == ((arena->slotFront + arena->slotsMask) & arena->slotsMask)) &&
+                         buffer == arena->bufferActive && endOffset == arena->bufferFront &&
+                         endOffset > allocationOffset;
+    size_t frontLimit = 0;
+    if (isFront) {
+        if (arena->bufferBack > arena->bufferFront) {
+            frontLimit = arena->bufferBack - 1;
+        } else {
+            frontLimit = (arena->bufferBack == 0) ? arena->bufferSize - 1 : arena->bufferSize;
+        }
+    }
+
     // Check requested size vs. buffer
     if (size <= currentSize) {
         // If block can fit in existing buffer (getting smaller, or next slot has been freed)
         // just increase allocation and run away
         allocation->size = size;
+    } else if (isFront && allocationOffset + size <= frontLimit) {
+        // Extend the front of the buffer
+        arena->bufferFront = (uint32_t)((allocationOffset + size) & arena->bufferMask);
+        arena->slots[slot].endOffset = arena->bufferFront;
+        allocation->size = size;
     } else {
         // Need to create another allocation
         //
         const size_t preservedSize = (size < allocation->size) ? size : (allocation->size);
 
         LdcMemoryAllocation newAllocation = {0};
+        newAllocation.alignment = allocation->alignment;
         uint8_t* const newPtr = internalAllocate(allocator, &newAllocation, size);
         VNCheck(newPtr);
         // Copy old to new
@@ -335,4 +391,4 @@ static void* rollingArenaReallocate(LdcMemoryAllocator* allocator, LdcMemoryAllo
 /* Memory Allocator function table
  */
 static const LdcMemoryAllocatorFunctions kRollingArenaFunctions = {
-    rollingArenaAllocate, rollingArenaReallocate, rollingArenaFree};
+    ldcRollingArenaAllocate, ldcRollingArenaReallocate, ldcRollingArenaFree};
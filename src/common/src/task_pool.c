@@ -22,10 +22,12 @@
 #include <LCEVC/common/log.h>
 #include <LCEVC/common/memory.h>
 #include <LCEVC/common/platform.h>
+#include <LCEVC/common/printf_macros.h>
 #include <LCEVC/common/threads.h>
 //
 #include <assert.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -34,16 +36,41 @@
 
 // Forward declarations
 static void scheduleTask(LdcTaskPool* pool, LdcTask* task, LdcTask** head);
+static void runInline(LdcTaskPool* pool);
 #ifdef VN_SDK_LOG_ENABLE_DEBUG
 static void taskPoolDump(LdcTaskPool* pool, const LdcTaskGroup* group);
 #endif
 
+// The task thread that the current OS thread is working for - NULL if not a pool worker
+//
+static VNThreadLocal() LdcTaskThread* tlsTaskThread = NULL;
+
+// Get the pool worker that is calling, or NULL if the calling thread is not one of pool's workers
+//
+static inline LdcTaskThread* poolCurrentWorker(const LdcTaskPool* pool)
+{
+    return (tlsTaskThread && tlsTaskThread->taskPool == pool) ? tlsTaskThread : NULL;
+}
+
+// The mutex that protects the running state of a task - the group mutex for grouped tasks,
+// otherwise the pool mutex.
+//
+static inline ThreadMutex* taskMutex(LdcTaskPool* pool, LdcTaskGroup* group)
+{
+    return group ? &group->mutex : &pool->mutex;
+}
+
 // Common task creation
 //
+// If `detached` is set, the task will not be waited for, and is cleared away as it finishes -
+// saving a later trip through the pool mutex to mark it so.
+//
+// NB: Called with task's mutex locked (see taskMutex())
+//
 static LdcTask* addTask(LdcTaskPool* pool, LdcTaskGroup* group, const LdcTaskDependency* inputs,
                         uint32_t inputsCount, LdcTaskDependency output, LdcTaskFunction function,
                         LdcTaskFunction completion, uint32_t iterations, uint32_t maxIterationsPerPart,
-                        size_t dataSize, const void* data, const char* name)
+                        size_t dataSize, const void* data, const char* name, bool detached)
 {
     assert(pool);
     assert(pool->running);
@@ -58,17 +85,29 @@ static LdcTask* addTask(LdcTaskPool* pool, LdcTaskGroup* group, const LdcTaskDep
     // NB: there is a wasted byte which will likely round up to a machine word - no great loss
     // but may be worth clearing up once everything else is stable.
     dataSize = VNAlignSize(dataSize, sizeof(uint32_t));
+
+    // Allocation and task registry are protected by pool mutex
+    if (group) {
+        threadMutexLock(&pool->mutex);
+    }
+
     LdcTask* task =
         (LdcTask*)VNAllocateZeroArray(pool->shortTermAllocator, &allocation, uint8_t,
                                       sizeof(LdcTask) + dataSize + sizeof(uint32_t) * inputsCount);
+    if (task != NULL) {
+        ldcVectorAppend(&pool->tasks, &allocation);
+        pool->pendingTaskCount++;
+    }
+
+    if (group) {
+        threadMutexUnlock(&pool->mutex);
+    }
 
     if (task == NULL) {
         VNLogError("Cannot allocate task.");
         return NULL;
     }
 
-    ldcVectorAppend(&pool->tasks, &allocation);
-    pool->pendingTaskCount++;
     if (group) {
         group->tasksCount++;
     }
@@ -76,6 +115,7 @@ static LdcTask* addTask(LdcTaskPool* pool, LdcTaskGroup* group, const LdcTaskDep
     // Fill in slot
     task->pool = pool;
     task->group = group;
+    task->detached = detached;
     task->output = output;
     task->taskFunction = function;
     task->completionFunction = completion;
@@ -113,7 +153,7 @@ static LdcTask* addTask(LdcTaskPool* pool, LdcTaskGroup* group, const LdcTaskDep
 
 // Try to remove from head of list, given pointer to head
 //
-// NB: Called with task pool locked
+// NB: Called with task's group locked
 //
 static inline LdcTask* getNextTask(LdcTask** head)
 {
@@ -132,11 +172,6 @@ static inline LdcTask* getNextTask(LdcTask** head)
 //
 static void removeTask(LdcTaskPool* pool, LdcTask* task)
 {
-    if (task->group) {
-        assert(task->group->tasksCount > 0);
-        task->group->tasksCount--;
-    }
-
     LdcMemoryAllocation* alloc = ldcVectorFindUnordered(&pool->tasks, ldcVectorCompareAllocationPtr, task);
 
     if (!alloc) {
@@ -149,6 +184,231 @@ static void removeTask(LdcTaskPool* pool, LdcTask* task)
     ldcVectorRemoveReorder(&pool->tasks, alloc);
 }
 
+// Ready task parts
+//
+// Parts pushed by a worker of the pool go on the back of that worker's own deque, and will be
+// popped from there by the same worker (LIFO). Other workers steal from the front of the
+// deque (FIFO).
+//
+// Parts pushed from outside the pool are spread across the worker deques.
+//
+// Each deque is kept in deadline order, earliest at the back, so that parts of tasks with the
+// earliest deadline are taken first (EDF). Parts with the same deadline keep the above order.
+//
+static inline LdcTaskThread* taskThreadGet(const LdcTaskPool* pool, uint32_t index)
+{
+    return VNAllocationPtr(pool->threads, LdcTaskThread) + index;
+}
+
+static inline uint64_t readyPartDeadline(const LdcDeque* deque, uint32_t index)
+{
+    return ((const LdcTaskPart*)ldcDequeAt(deque, index))->task->deadline;
+}
+
+// Snapshot of a worker's deque - the number of parts, and the deadline of the part at the back
+//
+// Written with the deque's thread locked, and read without any locks, to pick a victim when
+// stealing and to check for ready parts before parking. Anything read here is confirmed with the
+// victim locked.
+//
+enum
+{
+    kReadySnapshotCacheLine = 64
+};
+
+typedef struct ReadySnapshot
+{
+    atomic_ullong deadline;
+    atomic_uint count;
+    uint8_t pad[kReadySnapshotCacheLine - sizeof(atomic_ullong) - sizeof(atomic_uint)];
+} ReadySnapshot;
+
+static inline ReadySnapshot* readySnapshotGet(const LdcTaskPool* pool, uint32_t index)
+{
+    return VNAllocationPtr(pool->readySnapshots, ReadySnapshot) + index;
+}
+
+// Update a worker's snapshot after its deque has changed
+//
+// NB: Called with deque's thread locked
+//
+static inline void readySnapshotUpdate(const LdcTaskPool* pool, const LdcTaskThread* taskThread)
+{
+    ReadySnapshot* snapshot = readySnapshotGet(pool, taskThread->index);
+    const uint32_t size = ldcDequeSize(&taskThread->readyParts);
+
+    atomic_store_explicit(&snapshot->deadline,
+                          size ? readyPartDeadline(&taskThread->readyParts, size - 1) : UINT64_MAX,
+                          memory_order_relaxed);
+    atomic_store_explicit(&snapshot->count, size, memory_order_relaxed);
+}
+
+// Number of workers that are parked, or about to park, on condVarReady
+//
+// Changed with `idleMutex` held, so a worker is counted before it makes its final check for ready
+// parts. Read without locks where a stale count only affects how parts are scheduled.
+//
+typedef struct IdleThreadCount
+{
+    atomic_uint count;
+    uint8_t pad[kReadySnapshotCacheLine - sizeof(atomic_uint)];
+} IdleThreadCount;
+
+static inline atomic_uint* idleThreadCount(const LdcTaskPool* pool)
+{
+    return &VNAllocationPtr(pool->idleThreadCount, IdleThreadCount)->count;
+}
+
+// Push part onto back of deque, then move it towards the front past any earlier deadlines
+//
+// NB: Called with deque's thread locked
+//
+static void readyPartsInsert(LdcDeque* deque, const LdcTaskPart* part)
+{
+    ldcDequeBackPush(deque, part);
+
+    const uint64_t deadline = part->task->deadline;
+    uint32_t index = ldcDequeSize(deque) - 1;
+
+    while (index > 0 && readyPartDeadline(deque, index - 1) < deadline) {
+        LdcTaskPart* prev = (LdcTaskPart*)ldcDequeAt(deque, index - 1);
+        *(LdcTaskPart*)ldcDequeAt(deque, index) = *prev;
+        *prev = *part;
+        index--;
+    }
+}
+
+// Take the part with the earliest deadline from a deque - from the back if `owner`, otherwise from
+// the front, unless the back has an earlier deadline.
+//
+// NB: Called with deque's thread locked
+//
+static bool readyPartsTake(LdcDeque* deque, LdcTaskPart* part, bool owner)
+{
+    const uint32_t size = ldcDequeSize(deque);
+    if (size == 0) {
+        return false;
+    }
+
+    if (owner || readyPartDeadline(deque, size - 1) < readyPartDeadline(deque, 0)) {
+        return ldcDequeBackPop(deque, part);
+    }
+
+    return ldcDequeFrontPop(deque, part);
+}
+
+static void readyPartsPush(LdcTaskPool* pool, const LdcTaskPart* parts, uint32_t partsCount)
+{
+    LdcTaskThread* current = poolCurrentWorker(pool);
+
+    if (current) {
+        // Push onto this worker's own deque
+        threadMutexLock(&current->mutex);
+        for (uint32_t i = 0; i < partsCount; ++i) {
+            readyPartsInsert(&current->readyParts, &parts[i]);
+        }
+        readySnapshotUpdate(pool, current);
+        threadMutexUnlock(&current->mutex);
+    } else {
+        // Spread parts over threads - starting at a slot picked from task address
+        const uint32_t threadCount = pool->multiThreaded ? pool->threadCount : 1;
+        uint32_t index = (uint32_t)(((uintptr_t)parts[0].task / sizeof(LdcTask)) % threadCount);
+        for (uint32_t i = 0; i < partsCount; ++i) {
+            LdcTaskThread* taskThread = taskThreadGet(pool, index);
+            threadMutexLock(&taskThread->mutex);
+            readyPartsInsert(&taskThread->readyParts, &parts[i]);
+            readySnapshotUpdate(pool, taskThread);
+            threadMutexUnlock(&taskThread->mutex);
+            index = (index + 1) % threadCount;
+        }
+    }
+
+    if (!pool->multiThreaded) {
+        return;
+    }
+
+    // Kick any idle workers
+    threadMutexLock(&pool->idleMutex);
+    if (atomic_load_explicit(idleThreadCount(pool), memory_order_relaxed) > 0) {
+        if (partsCount == 1) {
+            threadCondVarSignal(&pool->condVarReady);
+        } else {
+            threadCondVarBroadcast(&pool->condVarReady);
+        }
+    }
+    threadMutexUnlock(&pool->idleMutex);
+}
+
+// Get next part to work on - from our own deque, or stolen from another's
+//
+// When stealing, the victim is the worker whose deque holds the earliest deadline, with ties going
+// to the first found after `self`. Victims are picked from the snapshots, so only the victim is
+// locked.
+//
+// `self` may be NULL if the calling thread is not a worker.
+//
+static bool readyPartsPop(LdcTaskPool* pool, LdcTaskThread* self, LdcTaskPart* part)
+{
+    if (self) {
+        threadMutexLock(&self->mutex);
+        const bool gotPart = readyPartsTake(&self->readyParts, part, true);
+        readySnapshotUpdate(pool, self);
+        threadMutexUnlock(&self->mutex);
+        if (gotPart) {
+            return true;
+        }
+    }
+
+    const uint32_t threadCount = pool->multiThreaded ? pool->threadCount : 1;
+    const uint32_t first = self ? self->index + 1 : 0;
+
+    for (;;) {
+        LdcTaskThread* victim = NULL;
+        uint64_t victimDeadline = UINT64_MAX;
+
+        for (uint32_t i = 0; i < threadCount; ++i) {
+            const uint32_t index = (first + i) % threadCount;
+            const ReadySnapshot* snapshot = readySnapshotGet(pool, index);
+            if ((self && index == self->index) ||
+                atomic_load_explicit(&snapshot->count, memory_order_relaxed) == 0) {
+                continue;
+            }
+            const uint64_t deadline =
+                atomic_load_explicit(&snapshot->deadline, memory_order_relaxed);
+            if (!victim || deadline < victimDeadline) {
+                victim = taskThreadGet(pool, index);
+                victimDeadline = deadline;
+            }
+        }
+
+        if (!victim) {
+            return false;
+        }
+
+        threadMutexLock(&victim->mutex);
+        const bool gotPart = readyPartsTake(&victim->readyParts, part, false);
+        readySnapshotUpdate(pool, victim);
+        threadMutexUnlock(&victim->mutex);
+        if (gotPart) {
+            return true;
+        }
+        // Victim was emptied by another thread since its snapshot was read - try again
+    }
+}
+
+// Check if there any parts ready in any deque - without taking any thread locks
+//
+static bool readyPartsAvailable(const LdcTaskPool* pool)
+{
+    for (uint32_t i = 0; i < pool->threadCount; ++i) {
+        if (atomic_load_explicit(&readySnapshotGet(pool, i)->count, memory_order_relaxed) != 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 // Low level dependency bit operations
 //
 static inline void dependencyMetBitSet(LdcTaskGroup* group, LdcTaskDependency dependency)
@@ -167,6 +427,8 @@ static inline bool dependencyMetBitGet(const LdcTaskGroup* group, LdcTaskDepende
 
 // Dependency has been met - record value and reschedule tasks as appropriate.
 //
+// NB: Called with group locked
+//
 static void dependencyMet(LdcTaskGroup* group, LdcTaskDependency dependency, void* value)
 {
     assert(group);
@@ -192,6 +454,8 @@ static void dependencyMet(LdcTaskGroup* group, LdcTaskDependency dependency, voi
         scheduleTask(group->pool, *head, head);
         assert(*head == next);
     }
+
+    threadCondVarBroadcast(&group->condVar);
 }
 
 // Check if all a tasks dependencies have been met
@@ -239,31 +503,328 @@ static inline bool taskDependsOnInput(const LdcTask* task, LdcTaskDependency dep
     return false;
 }
 
+// Task statistics
+//
+// Percentiles for each task name are published as metrics after every this many completions
+#define kTaskStatsPublishInterval 64 // NOLINT
+
+#if VN_SDK_FEATURE(METRICS)
+enum
+{
+    kTaskMetricWaitP50,
+    kTaskMetricWaitP99,
+    kTaskMetricRunP50,
+    kTaskMetricRunP99,
+    kTaskMetricCount
+};
+
+typedef struct LdcTaskMetricSites
+{
+    char taskName[64];
+    char names[kTaskMetricCount][96];
+    LdcDiagSite sites[kTaskMetricCount];
+} LdcTaskMetricSites;
+
+// Metric sites are shared by all pools, and never released, as buffered diagnostic records can
+// refer to them after a pool has been destroyed.
+#define kTaskMetricSitesMax 128 // NOLINT
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+static LdcTaskMetricSites taskMetricSites[kTaskMetricSitesMax];
+static uint32_t taskMetricSitesCount = 0;
+static atomic_flag taskMetricSitesLock = ATOMIC_FLAG_INIT;
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+static const LdcTaskMetricSites* taskMetricSitesGet(const char* name)
+{
+    static const char* const kSuffixes[kTaskMetricCount] = {"waitP50", "waitP99", "runP50",
+                                                            "runP99"};
+
+    while (atomic_flag_test_and_set_explicit(&taskMetricSitesLock, memory_order_acquire)) {
+        threadYield();
+    }
+
+    LdcTaskMetricSites* found = NULL;
+    for (uint32_t i = 0; i < taskMetricSitesCount; ++i) {
+        if (strncmp(taskMetricSites[i].taskName, name, sizeof(taskMetricSites[i].taskName) - 1) == 0) {
+            found = &taskMetricSites[i];
+            break;
+        }
+    }
+
+    if (!found && taskMetricSitesCount < kTaskMetricSitesMax) {
+        found = &taskMetricSites[taskMetricSitesCount++];
+        snprintf(found->taskName, sizeof(found->taskName), "%s", name);
+        for (uint32_t m = 0; m < kTaskMetricCount; ++m) {
+            snprintf(found->names[m], sizeof(found->names[m]), "task:%.63s:%s", name,
+                     kSuffixes[m]);
+            const LdcDiagSite site = {LdcDiagTypeMetric, __FILE__, __LINE__,         LdcLogLevelNone,
+                                      found->names[m],   0,        NULL,             NULL,
+                                      LdcDiagArgUInt32};
+            found->sites[m] = site;
+        }
+    }
+
+    atomic_flag_clear_explicit(&taskMetricSitesLock, memory_order_release);
+    return found;
+}
+#endif
+
+static inline uint32_t taskStatsBucket(uint64_t microseconds)
+{
+    if (microseconds == 0) {
+        return 0;
+    }
+    const uint32_t value = (microseconds > UINT32_MAX) ? UINT32_MAX : (uint32_t)microseconds;
+    return minU32(32 - clz32(value), kTaskStatsBuckets - 1);
+}
+
+// Find or create the statistics slot for a task name
+//
+static uint32_t taskStatsFind(LdcTaskStats* stats, uint32_t* statsCount, const char* name)
+{
+    for (uint32_t idx = 0; idx < *statsCount; ++idx) {
+        if (stats[idx].name == name || strcmp(stats[idx].name, name) == 0) {
+            return idx;
+        }
+    }
+
+    if (*statsCount < kTaskPoolMaxStatsNames - 1) {
+        stats[*statsCount].name = name;
+        return (*statsCount)++;
+    }
+
+    // Table is full - use the last slot for everything else
+    const uint32_t other = kTaskPoolMaxStatsNames - 1;
+    if (*statsCount < kTaskPoolMaxStatsNames) {
+        stats[other].name = "other";
+        *statsCount = kTaskPoolMaxStatsNames;
+    }
+    return other;
+}
+
+// The statistics table for the calling thread
+//
+static inline LdcTaskStatsTable* taskStatsTable(LdcTaskPool* pool)
+{
+    LdcTaskThread* current = poolCurrentWorker(pool);
+    return current ? &current->stats : &pool->stats;
+}
+
+// Add one table's statistics into a merged set, by name
+//
+// NB: Called with table locked
+//
+static void taskStatsAdd(LdcTaskStats* merged, uint32_t* mergedCount,
+                         const LdcTaskStatsTable* table)
+{
+    for (uint32_t idx = 0; idx < table->count; ++idx) {
+        const LdcTaskStats* src = &table->stats[idx];
+        LdcTaskStats* dst = &merged[taskStatsFind(merged, mergedCount, src->name)];
+        dst->count += src->count;
+        dst->waitTotal += src->waitTotal;
+        dst->runTotal += src->runTotal;
+        for (uint32_t bucket = 0; bucket < kTaskStatsBuckets; ++bucket) {
+            dst->waitHistogram[bucket] += src->waitHistogram[bucket];
+            dst->runHistogram[bucket] += src->runHistogram[bucket];
+        }
+    }
+}
+
+// Merge the tables of the pool and every worker - returns the number of names
+//
+// NB: Called with pool's statsMutex locked
+//
+static uint32_t taskStatsMerge(LdcTaskPool* pool, LdcTaskStats merged[kTaskPoolMaxStatsNames])
+{
+    memset(merged, 0, sizeof(LdcTaskStats) * kTaskPoolMaxStatsNames);
+    uint32_t mergedCount = 0;
+
+    threadMutexLock(&pool->stats.mutex);
+    taskStatsAdd(merged, &mergedCount, &pool->stats);
+    threadMutexUnlock(&pool->stats.mutex);
+
+    const uint32_t slotCount = maxU32(1, pool->threadCount);
+    for (uint32_t thr = 0; thr < slotCount; ++thr) {
+        LdcTaskStatsTable* table = &taskThreadGet(pool, thr)->stats;
+        threadMutexLock(&table->mutex);
+        taskStatsAdd(merged, &mergedCount, table);
+        threadMutexUnlock(&table->mutex);
+    }
+
+    return mergedCount;
+}
+
+// Accumulate the timings of a completed task into the calling thread's table
+//
+static void taskStatsRecord(LdcTaskPool* pool, const LdcTask* task, uint64_t now)
+{
+    const uint64_t wait = (task->startTime > task->readyTime) ? task->startTime - task->readyTime : 0;
+    const uint64_t run = (now > task->startTime) ? now - task->startTime : 0;
+
+    LdcTaskStatsTable* table = taskStatsTable(pool);
+    threadMutexLock(&table->mutex);
+
+    const uint32_t idx =
+        taskStatsFind(table->stats, &table->count, task->name ? task->name : "unnamed");
+    LdcTaskStats* stats = &table->stats[idx];
+    stats->count++;
+    stats->waitTotal += wait;
+    stats->runTotal += run;
+    stats->waitHistogram[taskStatsBucket(wait)]++;
+    stats->runHistogram[taskStatsBucket(run)]++;
+
+#if VN_SDK_FEATURE(METRICS)
+    const char* name = stats->name;
+    const bool publish = (stats->count % kTaskStatsPublishInterval == 0);
+    if (publish && !table->sites[idx]) {
+        table->sites[idx] = taskMetricSitesGet(name);
+    }
+    const LdcTaskMetricSites* sites = table->sites[idx];
+#endif
+
+    threadMutexUnlock(&table->mutex);
+
+#if VN_SDK_FEATURE(METRICS)
+    if (!publish || !sites) {
+        return;
+    }
+
+    // Publish percentiles over all the threads
+    LdcTaskStats merged[kTaskPoolMaxStatsNames];
+    threadMutexLock(&pool->statsMutex);
+    uint32_t mergedCount = taskStatsMerge(pool, merged);
+    threadMutexUnlock(&pool->statsMutex);
+
+    const LdcTaskStats* total = &merged[taskStatsFind(merged, &mergedCount, name)];
+    uint32_t values[kTaskMetricCount];
+    values[kTaskMetricWaitP50] = ldcTaskStatsPercentile(total->waitHistogram, 50);
+    values[kTaskMetricWaitP99] = ldcTaskStatsPercentile(total->waitHistogram, 99);
+    values[kTaskMetricRunP50] = ldcTaskStatsPercentile(total->runHistogram, 50);
+    values[kTaskMetricRunP99] = ldcTaskStatsPercentile(total->runHistogram, 99);
+
+    for (uint32_t m = 0; m < kTaskMetricCount; ++m) {
+        ldcMetricUInt32(&sites->sites[m], values[m]);
+    }
+#endif
+}
+
 // Task is done - store any output value, pass on dependency, and clean up
 //
+// NB: Called with task's mutex locked (see taskMutex())
+//
 static inline void finishTask(LdcTaskPool* pool, LdcTask* task, void* value)
 {
+    LdcTaskGroup* group = task->group;
+
     task->outputValue = value;
-    task->state = LdcTaskStateDone;
-    pool->pendingTaskCount--;
+
+    if (task->startTime != 0 && !task->cancelled) {
+        taskStatsRecord(pool, task, threadTimeMicroseconds(0));
+    }
 
     if (task->output != kTaskDependencyInvalid) {
-        assert(task->group);
-        assert(task->output < task->group->dependenciesCount);
-        dependencyMet(task->group, task->output, value);
+        assert(group);
+        assert(task->output < group->dependenciesCount);
+        dependencyMet(group, task->output, value);
+    }
+
+    if (group) {
+        threadMutexLock(&pool->mutex);
     }
 
+    task->state = LdcTaskStateDone;
+    pool->pendingTaskCount--;
+
     // If task will not be waited for - clear it away
     if (task->detached) {
         removeTask(pool, task);
     }
+
+    threadCondVarBroadcast(&pool->condVarCompleted);
+
+    if (group) {
+        threadMutexUnlock(&pool->mutex);
+
+        assert(group->tasksCount > 0);
+        group->tasksCount--;
+        threadCondVarBroadcast(&group->condVar);
+    }
+}
+
+// Finish a cancelled task without running it - once its inputs are met, and no parts are in flight
+//
+// NB: Called with task's group locked
+//
+static void finishCancelledTask(LdcTaskPool* pool, LdcTask* task)
+{
+    LdcTaskGroup* group = task->group;
+    assert(group);
+
+    task->iterationsCompletedCount = task->iterationsTotalCount;
+    if (group->cancelledFunction) {
+        group->cancelledFunction(group->cancelledContext, task);
+    }
+    finishTask(pool, task, NULL);
+}
+
+// Check if a thread's deque of ready parts is empty
+//
+static inline bool readyPartsIsEmpty(LdcTaskThread* taskThread)
+{
+    threadMutexLock(&taskThread->mutex);
+    const bool empty = ldcDequeIsEmpty(&taskThread->readyParts);
+    threadMutexUnlock(&taskThread->mutex);
+    return empty;
 }
 
-// Do the task work
+// Lazy Binary-Splitting
+//
+// Run a part in chunks of at most `maxIterationsPerPart` iterations. Before each chunk, if this
+// worker's own deque is empty (it has been drained, or other workers have stolen from it), then the
+// remaining iterations are split in two, and the upper half is made ready for other workers.
+//
+// Splits happen on multiples of `maxIterationsPerPart` from the start of the part.
 //
-// Task pool mutex should be locked at this point
+// On return, `taskPart` is updated to cover just the iterations that were run by this call.
 //
-static inline void runTask(LdcTaskPool* pool, LdcTaskPart* taskPart)
+static void* runTaskPartSplitting(LdcTaskPool* pool, LdcTaskPart* taskPart)
+{
+    LdcTask* const task = taskPart->task;
+    LdcTaskThread* const self = pool->multiThreaded ? poolCurrentWorker(pool) : NULL;
+    const uint32_t grain = task->maxIterationsPerPart;
+    assert(grain > 0);
+
+    void* value = NULL;
+    uint32_t start = taskPart->start;
+    uint32_t remaining = taskPart->count;
+
+    while (remaining > 0) {
+        if (self && remaining > grain && readyPartsIsEmpty(self)) {
+            // Keep the lower half of the remaining chunks, and push the upper half
+            const uint32_t chunks = (remaining + grain - 1) / grain;
+            const uint32_t keepCount = (chunks - chunks / 2) * grain;
+            const LdcTaskPart split = {task, start + keepCount, remaining - keepCount};
+            readyPartsPush(pool, &split, 1);
+            remaining = keepCount;
+        }
+
+        const LdcTaskPart chunk = {task, start, minU32(remaining, grain)};
+        value = task->taskFunction(task, &chunk);
+
+        start += chunk.count;
+        remaining -= chunk.count;
+    }
+
+    taskPart->count = start - taskPart->start;
+    return value;
+}
+
+// Do the work for one part of a task
+//
+// Called with no locks held
+//
+static void runTask(LdcTaskPool* pool, LdcTaskPart* taskPart)
 {
     assert(pool);
     assert(taskPart);
@@ -272,22 +833,37 @@ static inline void runTask(LdcTaskPool* pool, LdcTaskPart* taskPart)
     void* value = 0;
 
     LdcTask* const task = taskPart->task;
+    ThreadMutex* const mutex = taskMutex(pool, task->group);
+
+    threadMutexLock(mutex);
 
     if (task->activeParts == 0) {
         assert(task->state == LdcTaskStateReady);
         task->state = LdcTaskStateRunning;
+        if (task->startTime == 0) {
+            task->startTime = threadTimeMicroseconds(0);
+        }
     } else {
         assert(task->state == LdcTaskStateRunning);
     }
     task->activeParts += 1;
 
-    if (task->taskFunction) {
-        // Do the work with pool unlocked
-        threadMutexUnlock(&pool->mutex);
-        value = task->taskFunction(task, taskPart);
-        threadMutexLock(&pool->mutex);
+    // Parts that were taken from the deques just before the task was cancelled are drained
+    // without running
+    const bool cancelled = task->cancelled;
+
+    threadMutexUnlock(mutex);
+
+    if (task->taskFunction && !cancelled) {
+        if (task->maxIterationsPerPart != 0 && taskPart->count > task->maxIterationsPerPart) {
+            value = runTaskPartSplitting(pool, taskPart);
+        } else {
+            value = task->taskFunction(task, taskPart);
+        }
     }
 
+    threadMutexLock(mutex);
+
     task->activeParts -= 1;
     if (task->activeParts == 0) {
         task->state = LdcTaskStateReady;
@@ -301,21 +877,129 @@ static inline void runTask(LdcTaskPool* pool, LdcTaskPart* taskPart)
         // Task is done
         //
 
+        if (cancelled) {
+            finishCancelledTask(pool, task);
+            threadMutexUnlock(mutex);
+            return;
+        }
+
         if (task->completionFunction) {
-            // Do the completion with pool unlocked
+            // Do the completion with task unlocked - no other parts can be in flight
             LdcTaskPart part = {task, task->iterationsTotalCount, 0};
-            threadMutexUnlock(&pool->mutex);
+            threadMutexUnlock(mutex);
             value = task->completionFunction(task, &part);
-            threadMutexLock(&pool->mutex);
+            threadMutexLock(mutex);
         }
 
         finishTask(pool, task, value);
     }
+
+    threadMutexUnlock(mutex);
+}
+
+// Check if any workers are idle
+//
+static inline bool poolHasIdleWorkers(const LdcTaskPool* pool)
+{
+    return atomic_load_explicit(idleThreadCount(pool), memory_order_relaxed) > 0;
+}
+
+// Run a part that has been taken from a deque by a worker, applying any client quota
+//
+// If the part's client is over quota, no workers are idle, and `deferrable` is set, the part is
+// deferred until another part of the same client finishes, or a worker runs out of other work.
+//
+// Called with no locks held
+//
+static void runPart(LdcTaskPool* pool, LdcTaskPart* taskPart, bool deferrable)
+{
+    LdcTaskPoolClient* const client = taskPart->task->group ? taskPart->task->group->client : NULL;
+
+    if (!client) {
+        runTask(pool, taskPart);
+        return;
+    }
+
+    threadMutexLock(&client->mutex);
+    if (deferrable && client->runningParts >= client->quota && !poolHasIdleWorkers(pool)) {
+        ldcDequeBackPush(&client->deferredParts, taskPart);
+        threadMutexUnlock(&client->mutex);
+        return;
+    }
+    client->runningParts++;
+    threadMutexUnlock(&client->mutex);
+
+    // NB: task may be released by this call
+    runTask(pool, taskPart);
+
+    // Release deferred parts - all of them if there are workers with nothing to do, otherwise
+    // up to the client's quota
+    const bool idle = poolHasIdleWorkers(pool);
+    LdcTaskPart part = {0};
+
+    threadMutexLock(&client->mutex);
+    client->runningParts--;
+    uint32_t releaseCount = idle ? ldcDequeSize(&client->deferredParts)
+                                 : (client->quota - minU32(client->runningParts, client->quota));
+    while (releaseCount > 0 && ldcDequeFrontPop(&client->deferredParts, &part)) {
+        threadMutexUnlock(&client->mutex);
+        readyPartsPush(pool, &part, 1);
+        threadMutexLock(&client->mutex);
+        releaseCount--;
+    }
+    threadMutexUnlock(&client->mutex);
+}
+
+// Take a deferred part from any client - used by workers that have run out of other work, as
+// quotas only apply whilst no workers are idle
+//
+// Called with no locks held
+//
+static bool clientsDeferredTake(LdcTaskPool* pool, LdcTaskPart* part)
+{
+    bool gotPart = false;
+
+    threadMutexLock(&pool->mutex);
+    for (LdcTaskPoolClient* client = pool->clients; client && !gotPart; client = client->next) {
+        threadMutexLock(&client->mutex);
+        gotPart = ldcDequeFrontPop(&client->deferredParts, part);
+        threadMutexUnlock(&client->mutex);
+    }
+    threadMutexUnlock(&pool->mutex);
+
+    return gotPart;
+}
+
+// Run any ready parts on the calling thread - used when the pool has no worker threads
+//
+// Called with no locks held
+//
+static void runInline(LdcTaskPool* pool)
+{
+    if (pool->multiThreaded) {
+        return;
+    }
+
+    LdcTaskThread* taskThread = taskThreadGet(pool, 0);
+    LdcTaskPart part = {0};
+
+    for (;;) {
+        threadMutexLock(&taskThread->mutex);
+        const bool gotPart = readyPartsTake(&taskThread->readyParts, &part, false);
+        readySnapshotUpdate(pool, taskThread);
+        threadMutexUnlock(&taskThread->mutex);
+
+        if (!gotPart) {
+            break;
+        }
+
+        runTask(pool, &part);
+    }
 }
 
 // Task is ready to run
 //
-// Task pool mutex should be locked at this point
+// NB: Called with task's mutex locked (see taskMutex())
 //
 static inline void readyTask(LdcTaskPool* pool, LdcTask* task, bool grouped)
 {
@@ -323,49 +1007,47 @@ static inline void readyTask(LdcTaskPool* pool, LdcTask* task, bool grouped)
                  grouped ? "Group" : "Standalone", (void*)task, task->name);
 
     task->state = LdcTaskStateReady;
+    task->deadline = task->group ? task->group->deadline : UINT64_MAX;
+    task->readyTime = threadTimeMicroseconds(0);
+    if (task->cancelled) {
+        finishCancelledTask(pool, task);
+        return;
+    }
+
     if (!task->taskFunction && !task->completionFunction) {
         // Null task - just finish it
         // (This is a shortcut for connecting a bunch of input dependencies to a single output)
         task->iterationsCompletedCount = task->iterationsTotalCount;
         finishTask(pool, task, NULL);
-    } else if (pool->multiThreaded) {
-        LdcTaskPart part = {0};
-        part.task = task;
-        part.start = 0;
-
-        // Multithreaded - add to ready list and kick workers
-        if (task->iterationsTotalCount == 1) {
-            // Simple task - single part
-            part.count = task->iterationsTotalCount;
-            ldcDequeBackPush(&pool->readyParts, &part);
-        } else {
-            // Split by number of threads
-            // NB: THis should really happen dynamically at thread level via work stealing
-            const uint32_t perPart =
-                (task->iterationsTotalCount + pool->threadCount - 1) / pool->threadCount;
-            uint32_t remaining = task->iterationsTotalCount;
-            while (remaining > 0) {
-                part.count = minU32(remaining, perPart);
-                ldcDequeBackPush(&pool->readyParts, &part);
-
-                part.start += part.count;
-                remaining -= part.count;
-            }
-        }
-        threadCondVarBroadcast(&pool->condVarReady);
-    } else {
-        // Single threaded - run task now
-        LdcTaskPart part = {0};
-        part.task = task;
-        part.start = 0;
-        part.count = task->iterationsTotalCount;
-        runTask(pool, &part);
+        return;
+    }
+
+    // Add parts to ready deques and kick workers - if single threaded, the parts will be run by
+    // runInline() once locks are released.
+    //
+    // Tasks that limit the iterations per part start as a single part, and are split lazily as
+    // they run - see runTaskPartSplitting(). Other multithreaded tasks are initially split by
+    // number of threads - further balancing comes from threads stealing parts from each other.
+    const uint32_t threadCount =
+        (pool->multiThreaded && task->maxIterationsPerPart == 0) ? pool->threadCount : 1;
+    const uint32_t perPart = (task->iterationsTotalCount + threadCount - 1) / threadCount;
+    const uint32_t partsCount = (task->iterationsTotalCount + perPart - 1) / perPart;
+
+    LdcTaskPart* parts = alloca(partsCount * sizeof(LdcTaskPart));
+    uint32_t start = 0;
+    for (uint32_t i = 0; i < partsCount; ++i) {
+        parts[i].task = task;
+        parts[i].start = start;
+        parts[i].count = minU32(task->iterationsTotalCount - start, perPart);
+        start += parts[i].count;
     }
+
+    readyPartsPush(pool, parts, partsCount);
 }
 
 // Update task's list and state
 //
-// Task pool mutex should be locked at this point
+// NB: Called with task's mutex locked (see taskMutex())
 //
 static void scheduleTask(LdcTaskPool* pool, LdcTask* task, LdcTask** head)
 {
@@ -385,7 +1067,7 @@ static void scheduleTask(LdcTaskPool* pool, LdcTask* task, LdcTask** head)
 
     // Task is part of a group ...
     //
-    if (task->group->blocked) {
+    if (task->group->blockedCount > 0) {
         // Group is blocked - add to blocked list
         task->state = LdcTaskStateBlocked;
         task->nextTask = task->group->blockedTasks;
@@ -441,6 +1123,44 @@ static void scheduleTask(LdcTaskPool* pool, LdcTask* task, LdcTask** head)
 
 // The per thread worker function
 //
+// Wait a while for a part to become ready, without parking the worker
+//
+// Spins with pause hints until `spinMicroseconds` has passed, then yields the time slice until
+// `yieldMicroseconds` more has passed, polling the ready deques between each batch. Returns true
+// if a part was taken.
+//
+// Called with no locks held
+//
+#define kIdleSpinPauses 64 // NOLINT
+
+static bool idleSpin(LdcTaskPool* pool, LdcTaskThread* self, uint32_t spinMicroseconds,
+                     uint32_t yieldMicroseconds)
+{
+    if (spinMicroseconds == 0 && yieldMicroseconds == 0) {
+        return false;
+    }
+
+    const uint64_t spinEnd = threadTimeMicroseconds(0) + spinMicroseconds;
+    const uint64_t yieldEnd = spinEnd + yieldMicroseconds;
+
+    for (;;) {
+        const uint64_t now = threadTimeMicroseconds(0);
+        if (now < spinEnd) {
+            for (uint32_t i = 0; i < kIdleSpinPauses; ++i) {
+                threadPause();
+            }
+        } else if (now < yieldEnd) {
+            threadYield();
+        } else {
+            return false;
+        }
+
+        if (readyPartsPop(pool, self, &self->part)) {
+            return true;
+        }
+    }
+}
+
 static intptr_t taskThreadWorker(void* argument)
 {
     // Private thread data
@@ -449,50 +1169,97 @@ static intptr_t taskThreadWorker(void* argument)
     LdcTaskPool* pool = taskThread->taskPool;
     assert(pool);
 
+    tlsTaskThread = taskThread;
+
+    if (pool->affinitySet && threadSetAffinity(&pool->affinity) != ThreadResultSuccess) {
+        VNLogWarning("Cannot set task pool worker affinity");
+    }
+
+    // Local copy of idle policy - refreshed each time the worker parks
+    threadMutexLock(&pool->idleMutex);
+    uint32_t spinMicroseconds = pool->idleSpinMicroseconds;
+    uint32_t yieldMicroseconds = pool->idleYieldMicroseconds;
+    threadMutexUnlock(&pool->idleMutex);
+
     for (;;) {
-        threadMutexLock(&pool->mutex);
+        if (readyPartsPop(pool, taskThread, &taskThread->part) ||
+            idleSpin(pool, taskThread, spinMicroseconds, yieldMicroseconds)) {
+            // Run it
+            runPart(pool, &taskThread->part, true);
+            taskThread->part.task = NULL;
+            continue;
+        }
+
+        // Nothing else to do - run any parts that clients deferred whilst over quota
+        if (clientsDeferredTake(pool, &taskThread->part)) {
+            runPart(pool, &taskThread->part, false);
+            taskThread->part.task = NULL;
+            continue;
+        }
+
+        // Nothing to do - go idle
+        threadMutexLock(&pool->idleMutex);
 
         // Closing down?
         if (!pool->running) {
-            threadMutexUnlock(&pool->mutex);
+            threadMutexUnlock(&pool->idleMutex);
             break;
         }
 
-        const bool gotPart = ldcDequeFrontPop(&pool->readyParts, &taskThread->part);
-
-        if (!gotPart) {
+        // Register as idle, then check again before waiting - anything pushed after this point
+        // will signal the condition variable.
+        atomic_fetch_add_explicit(idleThreadCount(pool), 1, memory_order_relaxed);
+        if (!readyPartsAvailable(pool)) {
             // Wait for something to be ready ...
-            threadCondVarWait(&pool->condVarReady, &pool->mutex);
-        } else {
-            // Run it
-            runTask(pool, &taskThread->part);
-            taskThread->part.task = NULL;
-            threadCondVarBroadcast(&pool->condVarCompleted);
+            taskThread->parkCount++;
+            threadCondVarWait(&pool->condVarReady, &pool->idleMutex);
         }
+        atomic_fetch_sub_explicit(idleThreadCount(pool), 1, memory_order_relaxed);
 
-        threadMutexUnlock(&pool->mutex);
+        spinMicroseconds = pool->idleSpinMicroseconds;
+        yieldMicroseconds = pool->idleYieldMicroseconds;
+
+        threadMutexUnlock(&pool->idleMutex);
     }
 
+    tlsTaskThread = NULL;
+
     return 0;
 }
 
 bool ldcTaskPoolInitialize(LdcTaskPool* pool, LdcMemoryAllocator* longTermAllocator,
                            LdcMemoryAllocator* shortTermAllocator, uint32_t threadCount,
                            uint32_t reservedTaskCount)
+{
+    return ldcTaskPoolInitializeAffinity(pool, longTermAllocator, shortTermAllocator, threadCount,
+                                         reservedTaskCount, NULL);
+}
+
+bool ldcTaskPoolInitializeAffinity(LdcTaskPool* pool, LdcMemoryAllocator* longTermAllocator,
+                                   LdcMemoryAllocator* shortTermAllocator, uint32_t threadCount,
+                                   uint32_t reservedTaskCount, const ThreadCpuSet* affinity)
 {
     VNClear(pool);
 
     pool->longTermAllocator = longTermAllocator;
     pool->shortTermAllocator = shortTermAllocator;
 
+    if (affinity && !threadCpuSetIsEmpty(affinity)) {
+        pool->affinity = *affinity;
+        pool->affinitySet = true;
+    }
+
     // Reserved slots for tasks
     ldcVectorInitialize(&pool->tasks, sizeof(LdcMemoryAllocation), maxU32(1, reservedTaskCount),
                         pool->longTermAllocator);
 
     // Mutexes for thread sync.
     VNCheck(threadMutexInitialize(&pool->mutex) == ThreadResultSuccess);
-    VNCheck(threadCondVarInitialize(&pool->condVarReady) == ThreadResultSuccess);
     VNCheck(threadCondVarInitialize(&pool->condVarCompleted) == ThreadResultSuccess);
+    VNCheck(threadMutexInitialize(&pool->idleMutex) == ThreadResultSuccess);
+    VNCheck(threadCondVarInitialize(&pool->condVarReady) == ThreadResultSuccess);
+    VNCheck(threadMutexInitialize(&pool->statsMutex) == ThreadResultSuccess);
+    VNCheck(threadMutexInitialize(&pool->stats.mutex) == ThreadResultSuccess);
 
     // Threads
     pool->multiThreaded = (threadCount > 0);
@@ -500,21 +1267,50 @@ bool ldcTaskPoolInitialize(LdcTaskPool* pool, LdcMemoryAllocator* longTermAlloca
     pool->threadCount = threadCount;
     pool->running = true;
 
-    if (pool->multiThreaded) {
-        threadMutexLock(&pool->mutex);
+    // Per thread state - if single threaded, one slot is used to hold parts to be run inline
+    const uint32_t slotCount = maxU32(1, threadCount);
+    LdcTaskThread* taskThreads =
+        VNAllocateZeroArray(longTermAllocator, &pool->threads, LdcTaskThread, slotCount);
+    if (!taskThreads) {
+        VNLogError("Cannot allocate task threads.");
+        return false;
+    }
 
-        VNAllocateZeroArray(longTermAllocator, &pool->threads, LdcTaskThread, threadCount);
+    ReadySnapshot* snapshots =
+        VNAllocateAlignedArray(longTermAllocator, &pool->readySnapshots, ReadySnapshot,
+                               kReadySnapshotCacheLine, slotCount);
+    if (!snapshots) {
+        VNLogError("Cannot allocate task thread snapshots.");
+        VNFree(longTermAllocator, &pool->threads);
+        return false;
+    }
 
-        ldcDequeInitialize(&pool->readyParts, threadCount * 2, sizeof(LdcTaskPart), pool->longTermAllocator);
+    IdleThreadCount* idle = VNAllocateAligned(longTermAllocator, &pool->idleThreadCount,
+                                              IdleThreadCount, kReadySnapshotCacheLine);
+    if (!idle) {
+        VNLogError("Cannot allocate task pool idle count.");
+        VNFree(longTermAllocator, &pool->readySnapshots);
+        VNFree(longTermAllocator, &pool->threads);
+        return false;
+    }
+    atomic_init(&idle->count, 0);
+
+    for (uint32_t thr = 0; thr < slotCount; ++thr) {
+        atomic_init(&snapshots[thr].deadline, UINT64_MAX);
+        atomic_init(&snapshots[thr].count, 0);
+        taskThreads[thr].taskPool = pool;
+        taskThreads[thr].index = thr;
+        taskThreads[thr].part.task = NULL;
+        ldcDequeInitialize(&taskThreads[thr].readyParts, 16, sizeof(LdcTaskPart),
+                           pool->longTermAllocator);
+        VNCheck(threadMutexInitialize(&taskThreads[thr].mutex) == ThreadResultSuccess);
+        VNCheck(threadMutexInitialize(&taskThreads[thr].stats.mutex) == ThreadResultSuccess);
+    }
 
-        LdcTaskThread* taskThreads = VNAllocationPtr(pool->threads, LdcTaskThread);
+    if (pool->multiThreaded) {
         for (uint32_t thr = 0; thr < threadCount; ++thr) {
-            taskThreads[thr].taskPool = pool;
-            taskThreads[thr].part.task = NULL;
             threadCreate(&taskThreads[thr].thread, taskThreadWorker, &taskThreads[thr]);
         }
-
-        threadMutexUnlock(&pool->mutex);
     }
 
     return true;
@@ -522,8 +1318,10 @@ bool ldcTaskPoolInitialize(LdcTaskPool* pool, LdcMemoryAllocator* longTermAlloca
 
 void ldcTaskPoolDestroy(struct LdcTaskPool* pool)
 {
+    LdcTaskThread* taskThreads = VNAllocationPtr(pool->threads, LdcTaskThread);
+
     if (pool->multiThreaded) {
-        threadMutexLock(&pool->mutex);
+        threadMutexLock(&pool->idleMutex);
 
         assert(pool->running);
 
@@ -533,20 +1331,26 @@ void ldcTaskPoolDestroy(struct LdcTaskPool* pool)
         // Kick all the threads to say something is happening
         threadCondVarBroadcast(&pool->condVarReady);
 
-        threadMutexUnlock(&pool->mutex);
+        threadMutexUnlock(&pool->idleMutex);
 
         // Wait for threads to stop
-        LdcTaskThread* taskThreads = VNAllocationPtr(pool->threads, LdcTaskThread);
         for (uint32_t thr = 0; thr < pool->threadCount; ++thr) {
             threadJoin(&taskThreads[thr].thread, NULL);
         }
-        VNFree(pool->longTermAllocator, &pool->threads);
-
-        ldcDequeDestroy(&pool->readyParts);
     }
 
     // At this point - there will be no other threads sharing the data
     //
+    const uint32_t slotCount = maxU32(1, pool->threadCount);
+    for (uint32_t thr = 0; thr < slotCount; ++thr) {
+        ldcDequeDestroy(&taskThreads[thr].readyParts);
+        threadMutexDestroy(&taskThreads[thr].mutex);
+        threadMutexDestroy(&taskThreads[thr].stats.mutex);
+    }
+    VNFree(pool->longTermAllocator, &pool->threads);
+    VNFree(pool->longTermAllocator, &pool->readySnapshots);
+    VNFree(pool->longTermAllocator, &pool->idleThreadCount);
+
     // Release any remaining tasks
     //
     for (uint32_t task = 0; task < ldcVectorSize(&pool->tasks); ++task) {
@@ -554,12 +1358,22 @@ void ldcTaskPoolDestroy(struct LdcTaskPool* pool)
     }
 
     ldcVectorDestroy(&pool->tasks);
+
+    threadCondVarDestroy(&pool->condVarReady);
+    threadMutexDestroy(&pool->idleMutex);
+    threadCondVarDestroy(&pool->condVarCompleted);
+    threadMutexDestroy(&pool->stats.mutex);
+    threadMutexDestroy(&pool->statsMutex);
+    threadMutexDestroy(&pool->mutex);
 }
 
 void ldcTaskPoolWait(struct LdcTaskPool* pool)
 {
     assert(pool);
 
+    // Workers should not block on other tasks
+    assert(poolCurrentWorker(pool) == NULL);
+
     if (pool->multiThreaded) {
         threadMutexLock(&pool->mutex);
         assert(pool->running);
@@ -575,6 +1389,7 @@ void ldcTaskPoolWait(struct LdcTaskPool* pool)
         threadMutexUnlock(&pool->mutex);
     } else {
         assert(pool->running);
+        runInline(pool);
     }
 }
 
@@ -584,6 +1399,74 @@ uint32_t ldcTaskPoolGetNumThreads(const struct LdcTaskPool* pool)
     return pool->threadCount;
 }
 
+void ldcTaskPoolSetIdlePolicy(LdcTaskPool* pool, uint32_t spinMicroseconds, uint32_t yieldMicroseconds)
+{
+    threadMutexLock(&pool->idleMutex);
+    pool->idleSpinMicroseconds = spinMicroseconds;
+    pool->idleYieldMicroseconds = yieldMicroseconds;
+    threadMutexUnlock(&pool->idleMutex);
+}
+
+uint32_t ldcTaskPoolGetStats(LdcTaskPool* pool, LdcTaskStats* stats, uint32_t statsCount)
+{
+    LdcTaskStats merged[kTaskPoolMaxStatsNames];
+
+    threadMutexLock(&pool->statsMutex);
+    const uint32_t count = taskStatsMerge(pool, merged);
+    threadMutexUnlock(&pool->statsMutex);
+
+    for (uint32_t idx = 0; idx < minU32(count, statsCount); ++idx) {
+        stats[idx] = merged[idx];
+    }
+
+    return count;
+}
+
+// Clear a statistics table - keeping the names, so that slots stay attached to their metric sites
+//
+static void taskStatsClear(LdcTaskStatsTable* table)
+{
+    threadMutexLock(&table->mutex);
+    for (uint32_t idx = 0; idx < table->count; ++idx) {
+        const char* name = table->stats[idx].name;
+        VNClear(&table->stats[idx]);
+        table->stats[idx].name = name;
+    }
+    threadMutexUnlock(&table->mutex);
+}
+
+void ldcTaskPoolResetStats(LdcTaskPool* pool)
+{
+    threadMutexLock(&pool->statsMutex);
+    taskStatsClear(&pool->stats);
+    const uint32_t slotCount = maxU32(1, pool->threadCount);
+    for (uint32_t thr = 0; thr < slotCount; ++thr) {
+        taskStatsClear(&taskThreadGet(pool, thr)->stats);
+    }
+    threadMutexUnlock(&pool->statsMutex);
+}
+
+uint32_t ldcTaskStatsPercentile(const uint32_t histogram[kTaskStatsBuckets], uint32_t percent)
+{
+    uint64_t total = 0;
+    for (uint32_t bucket = 0; bucket < kTaskStatsBuckets; ++bucket) {
+        total += histogram[bucket];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    const uint64_t target = maxU64(1, (total * minU32(percent, 100) + 99) / 100);
+    uint64_t accumulated = 0;
+    for (uint32_t bucket = 0; bucket < kTaskStatsBuckets; ++bucket) {
+        accumulated += histogram[bucket];
+        if (accumulated >= target) {
+            return 1U << bucket;
+        }
+    }
+    return 1U << (kTaskStatsBuckets - 1);
+}
+
 // Task that is not part of any group - no dependencies involved.
 //
 LdcTask* ldcTaskPoolAdd(LdcTaskPool* pool, LdcTaskFunction function, LdcTaskFunction completion,
@@ -595,15 +1478,39 @@ LdcTask* ldcTaskPoolAdd(LdcTaskPool* pool, LdcTaskFunction function, LdcTaskFunc
 
     // No group or inputs/outputs
     LdcTask* task = addTask(pool, NULL, NULL, 0, kTaskDependencyInvalid, function, completion,
-                            iterations, iterations, dataSize, data, name);
+                            iterations, 0, dataSize, data, name, false);
 
     threadMutexUnlock(&pool->mutex);
 
+    runInline(pool);
+
     return task;
 }
 
 // Task that is part of a group - with 0 or more input and 0 or 1 output dependencies.
 //
+// Add a task to a group
+//
+// NB: Called with group locked
+//
+static bool groupAddTask(LdcTaskGroup* group, const LdcTaskDependency* inputs, uint32_t inputsCount,
+                         LdcTaskDependency output, LdcTaskFunction function, LdcTaskFunction completion,
+                         uint32_t iterations, uint32_t maxIterationsPerPart, size_t dataSize,
+                         const void* data, const char* name)
+{
+    // Group tasks don't use ldcTaskWait - pick up outputs from the group
+    const LdcTask* task = addTask(group->pool, group, inputs, inputsCount, output, function,
+                                  completion, iterations, maxIterationsPerPart, dataSize, data,
+                                  name, true);
+
+    return task != NULL;
+}
+
+static void graphRecord(LdcTaskGraph* graph, const LdcTaskDependency* inputs, uint32_t inputsCount,
+                        LdcTaskDependency output, LdcTaskFunction function, LdcTaskFunction completion,
+                        uint32_t iterations, uint32_t maxIterationsPerPart, size_t dataSize,
+                        const void* data, const char* name);
+
 bool ldcTaskGroupAdd(LdcTaskGroup* group, const LdcTaskDependency* inputs, uint32_t inputsCount,
                      LdcTaskDependency output, LdcTaskFunction function, LdcTaskFunction completion,
                      uint32_t iterations, uint32_t maxIterationsPerPart, size_t dataSize,
@@ -612,23 +1519,21 @@ bool ldcTaskGroupAdd(LdcTaskGroup* group, const LdcTaskDependency* inputs, uint3
     assert(group);
     assert(group->pool);
 
-    // For later used by work stealing
-    VNUnused(maxIterationsPerPart);
+    threadMutexLock(&group->mutex);
 
-    threadMutexLock(&group->pool->mutex);
+    if (group->recordGraph) {
+        graphRecord(group->recordGraph, inputs, inputsCount, output, function, completion,
+                    iterations, maxIterationsPerPart, dataSize, data, name);
+    }
 
-    LdcTask* task = addTask(group->pool, group, inputs, inputsCount, output, function, completion,
-                            iterations, iterations, dataSize, data, name);
+    const bool added = groupAddTask(group, inputs, inputsCount, output, function, completion,
+                                    iterations, maxIterationsPerPart, dataSize, data, name);
 
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(&group->mutex);
 
-    if (!task) {
-        return false;
-    }
+    runInline(group->pool);
 
-    // Group tasks don't use ldcTaskWait - pick up outputs from the group
-    ldcTaskNoWait(task);
-    return true;
+    return added;
 }
 
 // Mark task as not needing a wait to clear up
@@ -637,19 +1542,26 @@ void ldcTaskNoWait(LdcTask* task)
     assert(task != NULL);
     assert(task->pool);
     LdcTaskPool* pool = task->pool;
+    LdcTaskGroup* group = task->group;
 
-    if (threadMutexLock(&pool->mutex) != 0) {
+    if (group && threadMutexLock(&group->mutex) != ThreadResultSuccess) {
         return;
     }
 
-    if (task->state == LdcTaskStateDone) {
-        // Done already
-        removeTask(pool, task);
-    } else {
-        task->detached = true;
+    if (threadMutexLock(&pool->mutex) == ThreadResultSuccess) {
+        if (task->state == LdcTaskStateDone) {
+            // Done already
+            removeTask(pool, task);
+        } else {
+            task->detached = true;
+        }
+
+        threadMutexUnlock(&pool->mutex);
     }
 
-    threadMutexUnlock(&pool->mutex);
+    if (group) {
+        threadMutexUnlock(&group->mutex);
+    }
 }
 
 // Wait for task to finish
@@ -661,14 +1573,26 @@ bool ldcTaskWait(LdcTask* task, void** outputPtr)
 
     assert(task->pool);
     LdcTaskPool* pool = task->pool;
+    LdcTaskGroup* group = task->group;
+
+    runInline(pool);
+
+    // Workers must not block on other tasks - use a parent task and deferred outputs instead.
+    if (poolCurrentWorker(pool)) {
+        VNLogError("ldcTaskWait: called from a worker thread of the pool: %s", task->name);
+        return false;
+    }
+
+    ThreadMutex* mutex = taskMutex(pool, group);
+    ThreadCondVar* condVar = group ? &group->condVar : &pool->condVarCompleted;
 
-    if (threadMutexLock(&pool->mutex) != 0) {
+    if (threadMutexLock(mutex) != ThreadResultSuccess) {
         return false;
     }
 
     // Wait for task to move to done
     while (task->state != LdcTaskStateDone) {
-        threadCondVarWait(&pool->condVarCompleted, &pool->mutex);
+        threadCondVarWait(condVar, mutex);
     }
 
     // Save the output value if required
@@ -676,9 +1600,17 @@ bool ldcTaskWait(LdcTask* task, void** outputPtr)
         *outputPtr = task->outputValue;
     }
 
+    if (group) {
+        threadMutexLock(&pool->mutex);
+    }
+
     removeTask(pool, task);
 
-    threadMutexUnlock(&pool->mutex);
+    if (group) {
+        threadMutexUnlock(&pool->mutex);
+    }
+
+    threadMutexUnlock(mutex);
     return true;
 }
 
@@ -708,19 +1640,17 @@ void ldcTaskGroupBlock(LdcTaskGroup* group)
 {
     assert(group);
     assert(group->pool);
-    LdcTaskPool* pool = group->pool;
 
-    if (threadMutexLock(&pool->mutex) != ThreadResultSuccess) {
+    if (threadMutexLock(&group->mutex) != ThreadResultSuccess) {
         return;
     }
 
-    if (!group->blocked) {
-        group->blocked = true;
+    if (group->blockedCount++ == 0) {
         assert(group->blockedTasksCount == 0);
         assert(group->blockedTasks == NULL);
     }
 
-    threadMutexUnlock(&pool->mutex);
+    threadMutexUnlock(&group->mutex);
 }
 
 void ldcTaskGroupUnblock(LdcTaskGroup* group)
@@ -729,13 +1659,13 @@ void ldcTaskGroupUnblock(LdcTaskGroup* group)
     assert(group->pool);
     LdcTaskPool* pool = group->pool;
 
-    if (threadMutexLock(&pool->mutex) != ThreadResultSuccess) {
+    if (threadMutexLock(&group->mutex) != ThreadResultSuccess) {
         return;
     }
 
-    if (group->blocked) {
-        group->blocked = false;
+    assert(group->blockedCount > 0);
 
+    if (group->blockedCount > 0 && --group->blockedCount == 0) {
         // Go through blocked tasks and schedule them
         LdcTask* task = group->blockedTasks;
         while (task != NULL) {
@@ -747,24 +1677,325 @@ void ldcTaskGroupUnblock(LdcTaskGroup* group)
             task = next;
         }
 
+        group->blockedTasks = NULL;
         group->blockedTasksCount = 0;
     }
 
+    threadMutexUnlock(&group->mutex);
+
+    runInline(pool);
+}
+
+// Check if no part of a task has been run yet
+//
+static inline bool taskNotStarted(const LdcTask* task)
+{
+    return task->state != LdcTaskStateRunning && task->state != LdcTaskStateDone &&
+           task->activeParts == 0 && task->iterationsCompletedCount == 0;
+}
+
+// Cancel the not started tasks of a group
+//
+// Waiting, blocked and ready tasks that could be cancelled are marked, then the producers of
+// the unmet inputs of every task that will still run are unmarked, working back from those tasks.
+// Ready parts of marked tasks are removed from the worker deques and client deferred parts, and
+// those tasks are finished - marked tasks that are still waiting are finished as they become
+// ready (see readyTask()).
+//
+// Mark a task as cancelled if it could be, and record it as the producer of its output
+//
+// NB: Called with group locked
+//
+static void cancelMark(LdcTask* task, LdcTaskGroupKeepFunction keep, void* context,
+                       LdcTask** producers, uint32_t* cancelledCount)
+{
+    if (!task->cancelled && taskNotStarted(task) && !task->completionFunction &&
+        !(keep && keep(context, task->taskFunction, task->data, task->dataSize))) {
+        task->cancelled = true;
+        (*cancelledCount)++;
+    }
+
+    if (task->cancelled && task->output != kTaskDependencyInvalid) {
+        producers[task->output] = task;
+    }
+}
+
+// Keep the cancelled producers of a task's unmet inputs, and in turn their producers
+//
+// NB: Called with group locked
+//
+static void cancelKeepProducers(LdcTask* task, LdcTask** producers, LdcTask** stack,
+                                uint32_t* cancelledCount)
+{
+    const LdcTaskGroup* group = task->group;
+    uint32_t stackSize = 0;
+    stack[stackSize++] = task;
+
+    while (stackSize > 0) {
+        const LdcTask* consumer = stack[--stackSize];
+        for (uint32_t i = 0; i < consumer->inputsCount; ++i) {
+            const LdcTaskDependency input = consumer->inputs[i];
+            LdcTask* producer = producers[input];
+            if (producer && producer->cancelled && !dependencyMetBitGet(group, input)) {
+                producer->cancelled = false;
+                (*cancelledCount)--;
+                stack[stackSize++] = producer;
+            }
+        }
+    }
+}
+
+// Remove the parts of a group's cancelled tasks from a deque - tasks that have no parts left
+// anywhere are appended to `finished`
+//
+// NB: Called with group, and deque's owner, locked
+//
+static void cancelRemoveParts(const LdcTaskGroup* group, LdcDeque* deque, LdcTask** finished,
+                              uint32_t* finishedCount)
+{
+    const uint32_t size = ldcDequeSize(deque);
+    uint32_t keptCount = 0;
+
+    for (uint32_t idx = 0; idx < size; ++idx) {
+        const LdcTaskPart* part = (const LdcTaskPart*)ldcDequeAt(deque, idx);
+        LdcTask* task = part->task;
+        if (task->group != group || !task->cancelled) {
+            if (keptCount != idx) {
+                *(LdcTaskPart*)ldcDequeAt(deque, keptCount) = *part;
+            }
+            keptCount++;
+            continue;
+        }
+
+        task->iterationsCompletedCount += part->count;
+        if (task->iterationsCompletedCount == task->iterationsTotalCount) {
+            finished[(*finishedCount)++] = task;
+        }
+    }
+
+    LdcTaskPart part = {0};
+    while (ldcDequeSize(deque) > keptCount) {
+        ldcDequeBackPop(deque, &part);
+    }
+}
+
+uint32_t ldcTaskGroupCancel(LdcTaskGroup* group, LdcTaskGroupKeepFunction keep,
+                            LdcTaskGroupCancelledFunction cancelled, void* context)
+{
+    assert(group);
+    assert(group->pool);
+    LdcTaskPool* pool = group->pool;
+    const uint32_t threadCount = pool->multiThreaded ? pool->threadCount : 1;
+
+    if (threadMutexLock(&group->mutex) != ThreadResultSuccess) {
+        return 0;
+    }
+
+    group->cancelledFunction = cancelled;
+    group->cancelledContext = context;
+
+    // Producer of each dependency, and a stack of tasks - used for keeping producers, then for the
+    // tasks that are finished
+    LdcMemoryAllocation allocation = {0};
+    threadMutexLock(&pool->mutex);
+    LdcTask** producers = VNAllocateZeroArray(pool->shortTermAllocator, &allocation, LdcTask*,
+                                              group->dependenciesCount + group->tasksCount + 1);
+    threadMutexUnlock(&pool->mutex);
+    if (!producers) {
+        threadMutexUnlock(&group->mutex);
+        VNLogError("Cannot allocate task cancellation state.");
+        return 0;
+    }
+    LdcTask** stack = producers + group->dependenciesCount;
+
+    // Mark waiting, blocked, then ready tasks
+    uint32_t cancelledCount = 0;
+    for (uint32_t dep = 0; dep < group->dependenciesCount; ++dep) {
+        for (LdcTask* task = group->waitingTasks[dep]; task; task = task->nextTask) {
+            cancelMark(task, keep, context, producers, &cancelledCount);
+        }
+    }
+    for (LdcTask* task = group->blockedTasks; task; task = task->nextTask) {
+        cancelMark(task, keep, context, producers, &cancelledCount);
+    }
+    for (uint32_t thr = 0; thr < threadCount; ++thr) {
+        LdcTaskThread* taskThread = taskThreadGet(pool, thr);
+        threadMutexLock(&taskThread->mutex);
+        for (uint32_t idx = 0; idx < ldcDequeSize(&taskThread->readyParts); ++idx) {
+            LdcTask* task = ((const LdcTaskPart*)ldcDequeAt(&taskThread->readyParts, idx))->task;
+            if (task->group == group) {
+                cancelMark(task, keep, context, producers, &cancelledCount);
+            }
+        }
+        threadMutexUnlock(&taskThread->mutex);
+    }
+    if (group->client) {
+        LdcDeque* deferredParts = &group->client->deferredParts;
+        threadMutexLock(&group->client->mutex);
+        for (uint32_t idx = 0; idx < ldcDequeSize(deferredParts); ++idx) {
+            LdcTask* task = ((const LdcTaskPart*)ldcDequeAt(deferredParts, idx))->task;
+            if (task->group == group) {
+                cancelMark(task, keep, context, producers, &cancelledCount);
+            }
+        }
+        threadMutexUnlock(&group->client->mutex);
+    }
+
+    // Keep anything that a task that will still run depends on - only waiting and blocked tasks
+    // have unmet inputs
+    for (uint32_t dep = 0; dep < group->dependenciesCount; ++dep) {
+        for (LdcTask* task = group->waitingTasks[dep]; task; task = task->nextTask) {
+            if (!task->cancelled) {
+                cancelKeepProducers(task, producers, stack, &cancelledCount);
+            }
+        }
+    }
+    for (LdcTask* task = group->blockedTasks; task; task = task->nextTask) {
+        if (!task->cancelled) {
+            cancelKeepProducers(task, producers, stack, &cancelledCount);
+        }
+    }
+
+    // Take the ready parts of cancelled tasks out of the pool
+    uint32_t finishedCount = 0;
+    for (uint32_t thr = 0; thr < threadCount; ++thr) {
+        LdcTaskThread* taskThread = taskThreadGet(pool, thr);
+        threadMutexLock(&taskThread->mutex);
+        cancelRemoveParts(group, &taskThread->readyParts, stack, &finishedCount);
+        readySnapshotUpdate(pool, taskThread);
+        threadMutexUnlock(&taskThread->mutex);
+    }
+    if (group->client) {
+        threadMutexLock(&group->client->mutex);
+        cancelRemoveParts(group, &group->client->deferredParts, stack, &finishedCount);
+        threadMutexUnlock(&group->client->mutex);
+    }
+
+    // Complete the outputs of the removed tasks - any cancelled tasks that were waiting on them
+    // are finished in turn
+    for (uint32_t idx = 0; idx < finishedCount; ++idx) {
+        finishCancelledTask(pool, stack[idx]);
+    }
+
+    threadMutexLock(&pool->mutex);
+    VNFree(pool->shortTermAllocator, &allocation);
+    threadMutexUnlock(&pool->mutex);
+
+    threadMutexUnlock(&group->mutex);
+
+    VNLogDebug("ldcTaskGroupCancel: Group:%p cancelled:%" PRIu32 " removed:%" PRIu32,
+               (void*)group, cancelledCount, finishedCount);
+    return cancelledCount;
+}
+
+// Pool clients
+//
+// NB: Called with task pool locked
+//
+static void poolClientsUpdateQuotas(LdcTaskPool* pool)
+{
+    const uint32_t threadCount = maxU32(1, pool->threadCount);
+
+    for (LdcTaskPoolClient* client = pool->clients; client; client = client->next) {
+        threadMutexLock(&client->mutex);
+        client->quota =
+            maxU32(1, (threadCount * client->weight + pool->clientsWeight - 1) / pool->clientsWeight);
+        threadMutexUnlock(&client->mutex);
+    }
+}
+
+bool ldcTaskPoolClientAttach(LdcTaskPool* pool, LdcTaskPoolClient* client, uint32_t weight)
+{
+    assert(pool);
+    assert(client);
+
+    VNClear(client);
+    client->pool = pool;
+    client->weight = maxU32(1, weight);
+    ldcDequeInitialize(&client->deferredParts, 16, sizeof(LdcTaskPart), pool->longTermAllocator);
+    VNCheck(threadMutexInitialize(&client->mutex) == ThreadResultSuccess);
+
+    threadMutexLock(&pool->mutex);
+    client->next = pool->clients;
+    pool->clients = client;
+    pool->clientsWeight += client->weight;
+    poolClientsUpdateQuotas(pool);
+    threadMutexUnlock(&pool->mutex);
+
+    return true;
+}
+
+void ldcTaskPoolClientDetach(LdcTaskPoolClient* client)
+{
+    assert(client);
+    assert(client->pool);
+    LdcTaskPool* pool = client->pool;
+
+    threadMutexLock(&pool->mutex);
+    for (LdcTaskPoolClient** ptr = &pool->clients; *ptr; ptr = &(*ptr)->next) {
+        if (*ptr == client) {
+            *ptr = client->next;
+            break;
+        }
+    }
+    pool->clientsWeight -= client->weight;
+    poolClientsUpdateQuotas(pool);
     threadMutexUnlock(&pool->mutex);
+
+    // The last parts of the client's tasks may still be winding down in runPart()
+    threadMutexLock(&client->mutex);
+    while (client->runningParts != 0) {
+        threadMutexUnlock(&client->mutex);
+        threadYield();
+        threadMutexLock(&client->mutex);
+    }
+    assert(ldcDequeIsEmpty(&client->deferredParts));
+    threadMutexUnlock(&client->mutex);
+
+    ldcDequeDestroy(&client->deferredParts);
+    threadMutexDestroy(&client->mutex);
+    client->pool = NULL;
+}
+
+void ldcTaskGroupSetClient(LdcTaskGroup* group, LdcTaskPoolClient* client)
+{
+    assert(group);
+    assert(!client || client->pool == group->pool);
+
+    threadMutexLock(&group->mutex);
+    assert(group->tasksCount == 0);
+    group->client = client;
+    threadMutexUnlock(&group->mutex);
+}
+
+void ldcTaskGroupSetDeadline(LdcTaskGroup* group, uint64_t deadline)
+{
+    assert(group);
+
+    threadMutexLock(&group->mutex);
+    group->deadline = deadline;
+    threadMutexUnlock(&group->mutex);
 }
 
 // Reserve space for a given number of dependencies in the group - moves any previous data into new block
 //
+// NB: Called with group locked
+//
 static void taskGroupReserve(struct LdcTaskGroup* group, uint32_t dependenciesReserved)
 {
     assert(group);
     assert(dependenciesReserved > group->dependenciesReserved);
 
+    LdcTaskPool* pool = group->pool;
+
     const uint32_t newMetSize = (VNAlignSize(dependenciesReserved, 64) / 64) * sizeof(uint64_t);
     const uint32_t newPtrSize = dependenciesReserved * sizeof(void*);
     LdcMemoryAllocation newAllocation = {0};
-    uint8_t* alloc = VNAllocateZeroArray(group->pool->shortTermAllocator, &newAllocation, uint8_t,
+
+    threadMutexLock(&pool->mutex);
+    uint8_t* alloc = VNAllocateZeroArray(pool->shortTermAllocator, &newAllocation, uint8_t,
                                          newMetSize + newPtrSize * 2);
+    threadMutexUnlock(&pool->mutex);
 
     uint64_t* const newDependenciesMet = (uint64_t*)alloc;
     alloc += newMetSize;
@@ -781,7 +2012,9 @@ static void taskGroupReserve(struct LdcTaskGroup* group, uint32_t dependenciesRe
         memcpy(newWaitingTasks, group->waitingTasks, ptrSize);
         memcpy(newDependencyValues, group->dependencyValues, ptrSize);
 
-        VNFree(group->pool->shortTermAllocator, &group->dependencyAllocation);
+        threadMutexLock(&pool->mutex);
+        VNFree(pool->shortTermAllocator, &group->dependencyAllocation);
+        threadMutexUnlock(&pool->mutex);
     }
 
     group->dependencyAllocation = newAllocation;
@@ -798,18 +2031,21 @@ bool ldcTaskGroupInitialize(LdcTaskGroup* group, LdcTaskPool* pool, uint32_t dep
     assert(pool);
     assert(dependenciesReserved <= kTaskPoolMaxDependencies);
 
-    threadMutexLock(&pool->mutex);
-
     // Is pool good?
     assert(pool->running);
 
     // Set up group with no dependencies or tasks (so far)
     VNClear(group);
     group->pool = pool;
+    group->deadline = UINT64_MAX;
+
+    VNCheck(threadMutexInitialize(&group->mutex) == ThreadResultSuccess);
+    VNCheck(threadCondVarInitialize(&group->condVar) == ThreadResultSuccess);
 
+    threadMutexLock(&group->mutex);
     taskGroupReserve(group, dependenciesReserved);
+    threadMutexUnlock(&group->mutex);
 
-    threadMutexUnlock(&pool->mutex);
     return true;
 }
 
@@ -818,43 +2054,50 @@ void ldcTaskGroupDestroy(struct LdcTaskGroup* group)
     assert(group);
     assert(group->pool);
     LdcTaskPool* pool = group->pool;
-    threadMutexLock(&pool->mutex);
 
+    threadMutexLock(&pool->mutex);
     VNFree(pool->shortTermAllocator, &group->dependencyAllocation);
+    threadMutexUnlock(&pool->mutex);
+
+    threadCondVarDestroy(&group->condVar);
+    threadMutexDestroy(&group->mutex);
 
     group->pool = NULL;
     group->dependenciesReserved = 0;
-
-    threadMutexUnlock(&pool->mutex);
 }
 
 void ldcTaskGroupWait(struct LdcTaskGroup* group)
 {
     assert(group);
     assert(group->pool);
-    threadMutexLock(&group->pool->mutex);
+    assert(group->pool->running);
 
-    LdcTaskPool* pool = group->pool;
-    assert(pool->running);
+    // Workers should not block on other tasks
+    assert(poolCurrentWorker(group->pool) == NULL);
+
+    runInline(group->pool);
+
+    threadMutexLock(&group->mutex);
 
     while (group->tasksCount != 0) {
-        threadCondVarWait(&pool->condVarCompleted, &pool->mutex);
+        threadCondVarWait(&group->condVar, &group->mutex);
     }
 
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(&group->mutex);
 }
 
 uint32_t ldcTaskGroupGetTaskCount(const struct LdcTaskGroup* group, uint32_t* waitingPtr)
 {
     assert(group);
     assert(group->pool);
-    threadMutexLock(&group->pool->mutex);
+    ThreadMutex* mutex = (ThreadMutex*)&group->mutex;
+    threadMutexLock(mutex);
 
     uint32_t ret = group->tasksCount;
     if (waitingPtr) {
         *waitingPtr = group->waitingTasksCount;
     }
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(mutex);
     return ret;
 }
 
@@ -862,11 +2105,12 @@ uint32_t ldcTaskGroupGetWaitingCount(const struct LdcTaskGroup* group)
 {
     assert(group);
     assert(group->pool);
-    threadMutexLock(&group->pool->mutex);
+    ThreadMutex* mutex = (ThreadMutex*)&group->mutex;
+    threadMutexLock(mutex);
 
     uint32_t ret = group->waitingTasksCount;
 
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(mutex);
     return ret;
 }
 
@@ -876,8 +2120,10 @@ bool ldcTaskGroupFindOutputSetFromInput(const struct LdcTaskGroup* group, LdcTas
 {
     assert(group);
     assert(group->pool);
-    threadMutexLock(&group->pool->mutex);
+    ThreadMutex* mutex = (ThreadMutex*)&group->mutex;
     LdcTaskPool* taskPool = group->pool;
+    threadMutexLock(mutex);
+    threadMutexLock(&taskPool->mutex);
 
     assert(input < group->dependenciesCount);
 
@@ -904,7 +2150,8 @@ bool ldcTaskGroupFindOutputSetFromInput(const struct LdcTaskGroup* group, LdcTas
         }
     }
 
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(&taskPool->mutex);
+    threadMutexUnlock(mutex);
 
     *outputsCount = count;
     return r;
@@ -916,7 +2163,7 @@ LdcTaskDependency ldcTaskDependencyAdd(LdcTaskGroup* group)
 {
     assert(group);
     assert(group->pool);
-    threadMutexLock(&group->pool->mutex);
+    threadMutexLock(&group->mutex);
 
     LdcTaskDependency dep = group->dependenciesCount;
 
@@ -926,7 +2173,7 @@ LdcTaskDependency ldcTaskDependencyAdd(LdcTaskGroup* group)
 
     group->dependenciesCount++;
 
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(&group->mutex);
     return dep;
 }
 
@@ -934,7 +2181,7 @@ LdcTaskDependency ldcTaskDependencyAddMet(LdcTaskGroup* group, void* value)
 {
     assert(group);
     assert(group->pool);
-    threadMutexLock(&group->pool->mutex);
+    threadMutexLock(&group->mutex);
 
     const LdcTaskDependency dependency = group->dependenciesCount;
 
@@ -947,7 +2194,7 @@ LdcTaskDependency ldcTaskDependencyAddMet(LdcTaskGroup* group, void* value)
     group->dependencyValues[dependency] = value;
     dependencyMetBitSet(group, dependency);
 
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(&group->mutex);
     return dependency;
 }
 
@@ -955,13 +2202,14 @@ bool ldcTaskDependencyIsMet(const LdcTaskGroup* group, LdcTaskDependency depende
 {
     assert(group);
     assert(group->pool);
-    threadMutexLock(&group->pool->mutex);
+    ThreadMutex* mutex = (ThreadMutex*)&group->mutex;
+    threadMutexLock(mutex);
 
     assert(dependency < group->dependenciesCount);
 
     bool ret = dependencyMetBitGet(group, dependency);
 
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(mutex);
     return ret;
 }
 
@@ -969,19 +2217,20 @@ bool ldcTaskDependencySetIsMet(const LdcTaskGroup* group, const LdcTaskDependenc
 {
     assert(group);
     assert(group->pool);
-    threadMutexLock(&group->pool->mutex);
+    ThreadMutex* mutex = (ThreadMutex*)&group->mutex;
+    threadMutexLock(mutex);
 
     for (uint32_t i = 0; i < depsCount; ++i) {
         const LdcTaskDependency dep = deps[i];
         assert(dep < group->dependenciesCount);
 
         if (!dependencyMetBitGet(group, dep)) {
-            threadMutexUnlock(&group->pool->mutex);
+            threadMutexUnlock(mutex);
             return false;
         }
     }
 
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(mutex);
 
     return true;
 }
@@ -990,14 +2239,15 @@ void* ldcTaskDependencyGet(const LdcTaskGroup* group, LdcTaskDependency dependen
 {
     assert(group);
     assert(group->pool);
+    ThreadMutex* mutex = (ThreadMutex*)&group->mutex;
 
-    threadMutexLock(&group->pool->mutex);
+    threadMutexLock(mutex);
     assert(dependency < group->dependenciesCount);
     assert(dependencyMetBitGet(group, dependency));
 
     void* ret = group->dependencyValues[dependency];
 
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(mutex);
 
     return ret;
 }
@@ -1007,28 +2257,37 @@ void ldcTaskDependencyMet(LdcTaskGroup* group, LdcTaskDependency dependency, voi
     assert(group);
     assert(group->pool);
 
-    threadMutexLock(&group->pool->mutex);
+    threadMutexLock(&group->mutex);
 
     dependencyMet(group, dependency, value);
 
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(&group->mutex);
+
+    runInline(group->pool);
 }
 
 void* ldcTaskDependencyWait(const LdcTaskGroup* group, LdcTaskDependency dependency)
 {
     assert(group);
     assert(group->pool);
+    ThreadMutex* mutex = (ThreadMutex*)&group->mutex;
+    ThreadCondVar* condVar = (ThreadCondVar*)&group->condVar;
 
-    threadMutexLock(&group->pool->mutex);
+    // Workers should not block on other tasks
+    assert(poolCurrentWorker(group->pool) == NULL);
+
+    runInline(group->pool);
+
+    threadMutexLock(mutex);
     assert(dependency < group->dependenciesCount);
 
     while (!dependencyMetBitGet(group, dependency)) {
-        threadCondVarWait(&group->pool->condVarCompleted, &group->pool->mutex);
+        threadCondVarWait(condVar, mutex);
     }
 
     void* ret = group->dependencyValues[dependency];
 
-    threadMutexUnlock(&group->pool->mutex);
+    threadMutexUnlock(mutex);
 
     return ret;
 }
@@ -1039,12 +2298,12 @@ bool ldcTaskCollectInputs(const LdcTask* task, size_t numInputs, void** inputs)
     assert(task);
     assert(task->pool);
     assert(task->group);
-    const LdcTaskGroup* group = task->group;
+    LdcTaskGroup* group = task->group;
 
     assert(task->inputs != 0);
     assert(numInputs <= task->inputsCount);
 
-    threadMutexLock(&task->pool->mutex);
+    threadMutexLock(&group->mutex);
 
     unsigned int idx = 0;
     for (; idx < numInputs; ++idx) {
@@ -1053,7 +2312,7 @@ bool ldcTaskCollectInputs(const LdcTask* task, size_t numInputs, void** inputs)
         inputs[idx] = group->dependencyValues[dep];
     }
 
-    threadMutexUnlock(&task->pool->mutex);
+    threadMutexUnlock(&group->mutex);
 
     return idx == numInputs;
 }
@@ -1062,11 +2321,12 @@ LdcTaskDependency ldcTaskRemoveOutput(LdcTask* task)
 {
     assert(task);
     assert(task->pool);
+    ThreadMutex* mutex = taskMutex(task->pool, task->group);
 
-    threadMutexLock(&task->pool->mutex);
+    threadMutexLock(mutex);
     const LdcTaskDependency output = task->output;
     task->output = kTaskDependencyInvalid;
-    threadMutexUnlock(&task->pool->mutex);
+    threadMutexUnlock(mutex);
 
     return output;
 }
@@ -1104,10 +2364,17 @@ static void* taskWrapperSlicedDeferComplete(LdcTask* task, const LdcTaskPart* pa
 bool ldcTaskPoolAddSlicedDeferred(LdcTaskPool* pool, LdcTask* parent,
                                   bool (*function)(void* argument, uint32_t offset, uint32_t count),
                                   bool (*completion)(void* argument, uint32_t count),
-                                  void* argument, uint32_t argumentSize, uint32_t totalSize)
+                                  void* argument, uint32_t argumentSize, uint32_t totalSize,
+                                  uint32_t minSliceSize)
 {
     assert(pool);
 
+    // Without a parent, the new task is waited for - which workers must not do
+    if (!parent && poolCurrentWorker(pool)) {
+        VNLogError("ldcTaskPoolAddSlicedDeferred: no parent task from a worker thread of the pool");
+        return false;
+    }
+
     LdcTaskGroup* group = NULL;
     const LdcTaskDependency* inputs = 0;
     uint32_t inputsCount = 0;
@@ -1117,8 +2384,8 @@ bool ldcTaskPoolAddSlicedDeferred(LdcTaskPool* pool, LdcTask* parent,
         assert(parent->group);
         // Take dependencies from parent task and lock until the new task has
         // been added to avoid other threads seeing the parent with no output
-        threadMutexLock(&pool->mutex);
         group = parent->group;
+        threadMutexLock(&group->mutex);
         inputs = parent->inputs;
         inputsCount = parent->inputsCount;
         output = parent->output;
@@ -1137,29 +2404,242 @@ bool ldcTaskPoolAddSlicedDeferred(LdcTaskPool* pool, LdcTask* parent,
         threadMutexLock(&pool->mutex);
     }
 
+    // If deferred from a parent task, it is not waited for
     LdcTask* task = addTask(pool, group, inputs, inputsCount, output, taskWrapperSlicedDefer,
                             completion ? taskWrapperSlicedDeferComplete : NULL, totalSize,
-                            totalSize, dataSize, dataAllocation, "slicedDefer");
+                            minSliceSize, dataSize, dataAllocation, "slicedDefer", parent != NULL);
 
-    threadMutexUnlock(&pool->mutex);
+    threadMutexUnlock(taskMutex(pool, group));
+
+    runInline(pool);
 
     if (task == NULL) {
         return false;
     }
 
-    // It is deferred from a parent ask - don't wait
+    // It is deferred from a parent task - don't wait
     if (parent) {
-        ldcTaskNoWait(task);
         return true;
     }
 
     // No parent - wait for task to finish
     if (!ldcTaskWait(task, NULL)) {
         VNLogError("ldcTaskWait failed");
+        return false;
     }
     return true;
 }
 
+// Task graphs
+//
+typedef struct LdcTaskGraphNode
+{
+    LdcTaskFunction function;
+    LdcTaskFunction completion;
+    const char* name;
+    LdcTaskDependency output;
+    uint32_t inputsCount;
+    uint32_t iterations;
+    uint32_t maxIterationsPerPart;
+    uint32_t dataSize;
+    uint32_t nodeSize; // Total size of node, including inputs and data
+    // Followed by inputs, then data
+} LdcTaskGraphNode;
+
+static inline LdcTaskDependency* graphNodeInputs(LdcTaskGraphNode* node)
+{
+    return (LdcTaskDependency*)(node + 1);
+}
+
+// Data is aligned so that it can be patched in place
+static inline size_t graphNodeDataOffset(uint32_t inputsCount)
+{
+    return VNAlignSize(sizeof(LdcTaskGraphNode) + inputsCount * sizeof(LdcTaskDependency),
+                       sizeof(void*));
+}
+
+static inline uint8_t* graphNodeData(LdcTaskGraphNode* node)
+{
+    return (uint8_t*)node + graphNodeDataOffset(node->inputsCount);
+}
+
+static inline LdcTaskGraphNode* graphNodeNext(LdcTaskGraphNode* node)
+{
+    return (LdcTaskGraphNode*)((uint8_t*)node + node->nodeSize);
+}
+
+// Append a node to a graph being recorded
+//
+// NB: Called with recording group locked
+//
+static void graphRecord(LdcTaskGraph* graph, const LdcTaskDependency* inputs, uint32_t inputsCount,
+                        LdcTaskDependency output, LdcTaskFunction function, LdcTaskFunction completion,
+                        uint32_t iterations, uint32_t maxIterationsPerPart, size_t dataSize,
+                        const void* data, const char* name)
+{
+    if (!graph->valid) {
+        return;
+    }
+
+    const size_t nodeSize = VNAlignSize(graphNodeDataOffset(inputsCount) + dataSize, sizeof(void*));
+
+    if (graph->nodesSize + nodeSize > graph->nodes.size) {
+        const size_t reserved = maxSize(graph->nodesSize + nodeSize, graph->nodes.size * 2);
+        if (VNIsAllocated(graph->nodes)) {
+            VNReallocateArray(graph->allocator, &graph->nodes, uint8_t, reserved);
+        } else {
+            VNAllocateArray(graph->allocator, &graph->nodes, uint8_t, reserved);
+        }
+        if (!VNIsAllocated(graph->nodes)) {
+            VNLogError("Cannot allocate task graph node.");
+            graph->valid = false;
+            return;
+        }
+    }
+
+    LdcTaskGraphNode* node =
+        (LdcTaskGraphNode*)(VNAllocationPtr(graph->nodes, uint8_t) + graph->nodesSize);
+    node->function = function;
+    node->completion = completion;
+    node->name = name;
+    node->output = output;
+    node->inputsCount = inputsCount;
+    node->iterations = iterations;
+    node->maxIterationsPerPart = maxIterationsPerPart;
+    node->dataSize = (uint32_t)dataSize;
+    node->nodeSize = (uint32_t)nodeSize;
+    if (inputsCount) {
+        memcpy(graphNodeInputs(node), inputs, inputsCount * sizeof(LdcTaskDependency));
+    }
+    if (dataSize) {
+        memcpy(graphNodeData(node), data, dataSize);
+    }
+
+    graph->nodesSize += nodeSize;
+    graph->nodesCount++;
+    graph->maxDataSize = maxU32(graph->maxDataSize, (uint32_t)dataSize);
+}
+
+void ldcTaskGraphInitialize(LdcTaskGraph* graph, LdcMemoryAllocator* allocator)
+{
+    assert(graph);
+    assert(allocator);
+
+    VNClear(graph);
+    graph->allocator = allocator;
+}
+
+void ldcTaskGraphDestroy(LdcTaskGraph* graph)
+{
+    assert(graph);
+
+    if (VNIsAllocated(graph->nodes)) {
+        VNFree(graph->allocator, &graph->nodes);
+    }
+    graph->nodesSize = 0;
+    graph->nodesCount = 0;
+    graph->valid = false;
+}
+
+void ldcTaskGraphPatch(LdcTaskGraph* graph, LdcTaskGraphPatchFunction patch, void* context)
+{
+    assert(graph);
+    assert(patch);
+
+    LdcTaskGraphNode* node = VNAllocationPtr(graph->nodes, LdcTaskGraphNode);
+    for (uint32_t i = 0; i < graph->nodesCount; ++i) {
+        patch(context, node->function, graphNodeData(node), node->dataSize);
+        node = graphNodeNext(node);
+    }
+}
+
+void ldcTaskGroupRecordBegin(LdcTaskGroup* group, LdcTaskGraph* graph)
+{
+    assert(group);
+    assert(graph);
+
+    threadMutexLock(&group->mutex);
+    assert(!group->recordGraph);
+
+    graph->nodesSize = 0;
+    graph->nodesCount = 0;
+    graph->maxDataSize = 0;
+    graph->firstDependency = group->dependenciesCount;
+    graph->dependenciesCount = group->dependenciesCount;
+    graph->valid = true;
+    group->recordGraph = graph;
+
+    threadMutexUnlock(&group->mutex);
+}
+
+bool ldcTaskGroupRecordEnd(LdcTaskGroup* group)
+{
+    assert(group);
+
+    threadMutexLock(&group->mutex);
+
+    LdcTaskGraph* graph = group->recordGraph;
+    assert(graph);
+    graph->dependenciesCount = group->dependenciesCount;
+    group->recordGraph = NULL;
+
+    threadMutexUnlock(&group->mutex);
+
+    return graph->valid;
+}
+
+bool ldcTaskGroupInstantiate(LdcTaskGroup* group, const LdcTaskGraph* graph,
+                             LdcTaskGraphPatchFunction patch, void* context)
+{
+    assert(group);
+    assert(group->pool);
+    assert(graph);
+
+    if (!graph->valid) {
+        return false;
+    }
+
+    threadMutexLock(&group->mutex);
+
+    if (group->dependenciesCount != graph->firstDependency) {
+        threadMutexUnlock(&group->mutex);
+        VNLogError("Task graph expects %u dependencies, group has %u", graph->firstDependency,
+                   group->dependenciesCount);
+        return false;
+    }
+
+    // Add all the graph's dependencies at once
+    if (graph->dependenciesCount > group->dependenciesReserved) {
+        taskGroupReserve(group, maxU32(graph->dependenciesCount, group->dependenciesReserved * 2));
+    }
+    group->dependenciesCount = graph->dependenciesCount;
+
+    // Add the tasks - data is copied so that it can be patched
+    uint8_t* patched = alloca(graph->maxDataSize);
+    bool ok = true;
+    LdcTaskGraphNode* node = VNAllocationPtr(graph->nodes, LdcTaskGraphNode);
+
+    for (uint32_t i = 0; i < graph->nodesCount && ok; ++i) {
+        uint8_t* data = graphNodeData(node);
+        if (patch && node->dataSize) {
+            memcpy(patched, data, node->dataSize);
+            patch(context, node->function, patched, node->dataSize);
+            data = patched;
+        }
+
+        ok = groupAddTask(group, graphNodeInputs(node), node->inputsCount, node->output,
+                          node->function, node->completion, node->iterations,
+                          node->maxIterationsPerPart, node->dataSize, data, node->name);
+        node = graphNodeNext(node);
+    }
+
+    threadMutexUnlock(&group->mutex);
+
+    runInline(group->pool);
+
+    return ok;
+}
+
 // Debugging
 //
 #ifdef VN_SDK_LOG_ENABLE_DEBUG
@@ -1202,8 +2682,12 @@ static void taskPoolDump(LdcTaskPool* pool, const LdcTaskGroup* group)
     }
 
     // Current tasks
+    uint32_t readyCount = 0;
+    for (uint32_t id = 0; id < maxU32(1, pool->threadCount); ++id) {
+        readyCount += ldcDequeSize(&threads[id].readyParts);
+    }
     VNLogDebugF("  Tasks: allocated:%d pending:%d ready:%d", ldcVectorSize(&pool->tasks),
-                pool->pendingTaskCount, ldcDequeSize(&pool->readyParts));
+                pool->pendingTaskCount, readyCount);
     for (uint32_t id = 0; id < ldcVectorSize(&pool->tasks); ++id) {
         LdcMemoryAllocation* taskAllocation = ldcVectorAt(&pool->tasks, id);
         LdcTask* task = VNAllocationPtr(*taskAllocation, LdcTask);
@@ -1242,6 +2726,23 @@ static void taskPoolDump(LdcTaskPool* pool, const LdcTaskGroup* group)
         char tmp[256];
         VNLogDebugF("     Met:[ %s]", depsSetAsString(tmp, sizeof(tmp), metDeps, metDepsCount, 0));
     }
+
+    // Latency statistics
+    LdcTaskStats merged[kTaskPoolMaxStatsNames];
+    threadMutexLock(&pool->statsMutex);
+    const uint32_t mergedCount = taskStatsMerge(pool, merged);
+    threadMutexUnlock(&pool->statsMutex);
+    for (uint32_t idx = 0; idx < mergedCount; ++idx) {
+        const LdcTaskStats* stats = &merged[idx];
+        if (stats->count == 0) {
+            continue;
+        }
+        VNLogDebugF("  Stats: %-24s count:%" PRIu64 " wait avg:%" PRIu64 " p99:%u run avg:%" PRIu64
+                    " p99:%u",
+                    stats->name, stats->count, stats->waitTotal / stats->count,
+                    ldcTaskStatsPercentile(stats->waitHistogram, 99), stats->runTotal / stats->count,
+                    ldcTaskStatsPercentile(stats->runHistogram, 99));
+    }
 }
 
 void ldcTaskPoolDump(LdcTaskPool* taskPool, const LdcTaskGroup* taskGroup)
@@ -0,0 +1,85 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Platform independent parts of CPU set handling - see threads_pthread.c and threads_win32.c for
+// the platform queries.
+//
+#include <LCEVC/common/threads.h>
+
+static bool parseCpuNumber(const char** str, uint32_t* value)
+{
+    const char* s = *str;
+    if (*s < '0' || *s > '9') {
+        return false;
+    }
+
+    uint32_t v = 0;
+    while (*s >= '0' && *s <= '9') {
+        v = v * 10 + (uint32_t)(*s - '0');
+        if (v >= kThreadCpuSetMax) {
+            return false;
+        }
+        s++;
+    }
+
+    *value = v;
+    *str = s;
+    return true;
+}
+
+bool threadCpuSetParse(ThreadCpuSet* set, const char* list)
+{
+    threadCpuSetClear(set);
+    if (!list) {
+        return false;
+    }
+
+    const char* s = list;
+    for (;;) {
+        while (*s == ' ' || *s == '\t') {
+            s++;
+        }
+        // Allow a trailing newline, as found in sysfs files
+        if (*s == '\0' || *s == '\n') {
+            break;
+        }
+
+        uint32_t first = 0;
+        uint32_t last = 0;
+        if (!parseCpuNumber(&s, &first)) {
+            return false;
+        }
+        last = first;
+        if (*s == '-') {
+            s++;
+            if (!parseCpuNumber(&s, &last) || last < first) {
+                return false;
+            }
+        }
+        for (uint32_t cpu = first; cpu <= last; ++cpu) {
+            threadCpuSetAdd(set, cpu);
+        }
+
+        while (*s == ' ' || *s == '\t') {
+            s++;
+        }
+        if (*s == ',') {
+            s++;
+        } else if (*s != '\0' && *s != '\n') {
+            return false;
+        }
+    }
+
+    return true;
+}
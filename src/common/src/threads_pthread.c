@@ -20,6 +20,7 @@
 #include <assert.h>
 #include <pthread.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <time.h>
 
 // Threads
@@ -39,6 +40,139 @@ int32_t threadNumCores(void)
 #endif
 }
 
+// CPU sets
+//
+#if VN_OS(LINUX) || VN_OS(ANDROID)
+// Read a CPU list file from sysfs - returns false if it is missing or empty
+static bool readCpuList(ThreadCpuSet* set, const char* path)
+{
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+    char line[1024];
+    const bool ok = fgets(line, sizeof(line), file) != NULL && threadCpuSetParse(set, line);
+    fclose(file);
+    return ok && !threadCpuSetIsEmpty(set);
+}
+
+// Read a numeric per-CPU value from sysfs
+static bool readCpuValue(uint32_t cpu, const char* name, uint64_t* value)
+{
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/%s", cpu, name);
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+    unsigned long long v = 0;
+    const bool ok = fscanf(file, "%llu", &v) == 1;
+    fclose(file);
+    *value = v;
+    return ok;
+}
+
+// Select the CPUs with the highest (performance) or lowest (efficiency) value of a sysfs metric
+static bool cpuSetFromMetric(ThreadCpuSet* set, const ThreadCpuSet* online, const char* metric,
+                             bool highest)
+{
+    uint64_t best = highest ? 0 : UINT64_MAX;
+    bool found = false;
+    for (uint32_t cpu = 0; cpu < kThreadCpuSetMax; ++cpu) {
+        uint64_t value = 0;
+        if (threadCpuSetContains(online, cpu) && readCpuValue(cpu, metric, &value)) {
+            best = highest ? (value > best ? value : best) : (value < best ? value : best);
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    threadCpuSetClear(set);
+    for (uint32_t cpu = 0; cpu < kThreadCpuSetMax; ++cpu) {
+        uint64_t value = 0;
+        if (threadCpuSetContains(online, cpu) && readCpuValue(cpu, metric, &value) && value == best) {
+            threadCpuSetAdd(set, cpu);
+        }
+    }
+    return true;
+}
+#endif
+
+bool threadCpuSetFromCoreClass(ThreadCpuSet* set, ThreadCoreClass coreClass)
+{
+#if VN_OS(LINUX) || VN_OS(ANDROID)
+    ThreadCpuSet online;
+    if (!readCpuList(&online, "/sys/devices/system/cpu/online")) {
+        threadCpuSetClear(set);
+        return false;
+    }
+    if (coreClass == ThreadCoreClassAny) {
+        *set = online;
+        return true;
+    }
+
+    // Intel hybrid parts describe each core type as a separate PMU
+    const bool performance = (coreClass == ThreadCoreClassPerformance);
+    if (readCpuList(set, performance ? "/sys/devices/cpu_core/cpus" : "/sys/devices/cpu_atom/cpus")) {
+        threadCpuSetIntersect(set, &online);
+        if (!threadCpuSetIsEmpty(set)) {
+            return true;
+        }
+    }
+
+    // Otherwise use relative capacity (ARM big.LITTLE), then maximum frequency
+    if (cpuSetFromMetric(set, &online, "cpu_capacity", performance) ||
+        cpuSetFromMetric(set, &online, "cpufreq/cpuinfo_max_freq", performance)) {
+        return true;
+    }
+
+    // Cores are not distinguishable
+    *set = online;
+    return true;
+#else
+    VNUnused(coreClass);
+    threadCpuSetClear(set);
+    return false;
+#endif
+}
+
+bool threadCpuSetFromNumaNode(ThreadCpuSet* set, uint32_t node)
+{
+#if VN_OS(LINUX) || VN_OS(ANDROID)
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+    if (!readCpuList(set, path)) {
+        threadCpuSetClear(set);
+        return false;
+    }
+    return true;
+#else
+    VNUnused(node);
+    threadCpuSetClear(set);
+    return false;
+#endif
+}
+
+int threadSetAffinity(const ThreadCpuSet* set)
+{
+    if (threadCpuSetIsEmpty(set)) {
+        return ThreadResultError;
+    }
+#if VN_OS(LINUX) || VN_OS(ANDROID)
+    // Use the syscall directly, as cpu_set_t needs _GNU_SOURCE. The kernel mask is an array of
+    // longs, which has the same layout as the 64 bit words of ThreadCpuSet on little endian targets.
+    if (syscall(SYS_sched_setaffinity, 0, sizeof(set->bits), set->bits) != 0) {
+        return errno;
+    }
+    return ThreadResultSuccess;
+#else
+    // No thread affinity control on macOS/iOS or emscripten
+    return ThreadResultError;
+#endif
+}
+
 static void* threadWrapper(void* arg)
 {
     Thread* thread = (Thread*)arg;
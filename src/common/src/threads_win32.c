@@ -48,6 +48,82 @@ int32_t threadNumCores(void)
     return (int32_t)sysinfo.dwNumberOfProcessors;
 }
 
+// CPU sets
+//
+// Only processor group 0 is described - ThreadCpuSet bits beyond 64 are ignored.
+//
+bool threadCpuSetFromCoreClass(ThreadCpuSet* set, ThreadCoreClass coreClass)
+{
+    threadCpuSetClear(set);
+
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, NULL, &length);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER || length == 0) {
+        return false;
+    }
+    uint8_t* buffer = (uint8_t*)malloc(length);
+    if (!buffer) {
+        return false;
+    }
+    if (!GetLogicalProcessorInformationEx(
+            RelationProcessorCore, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer, &length)) {
+        free(buffer);
+        return false;
+    }
+
+    // Find range of efficiency classes - higher classes are faster cores
+    BYTE minClass = 0xff;
+    BYTE maxClass = 0;
+    for (DWORD offset = 0; offset < length;) {
+        const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info =
+            (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer + offset);
+        const BYTE efficiencyClass = info->Processor.EfficiencyClass;
+        minClass = (efficiencyClass < minClass) ? efficiencyClass : minClass;
+        maxClass = (efficiencyClass > maxClass) ? efficiencyClass : maxClass;
+        offset += info->Size;
+    }
+
+    for (DWORD offset = 0; offset < length;) {
+        const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info =
+            (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer + offset);
+        const BYTE efficiencyClass = info->Processor.EfficiencyClass;
+        if ((coreClass == ThreadCoreClassAny) ||
+            (coreClass == ThreadCoreClassPerformance && efficiencyClass == maxClass) ||
+            (coreClass == ThreadCoreClassEfficiency && efficiencyClass == minClass)) {
+            if (info->Processor.GroupMask[0].Group == 0) {
+                set->bits[0] |= (uint64_t)info->Processor.GroupMask[0].Mask;
+            }
+        }
+        offset += info->Size;
+    }
+
+    free(buffer);
+    return !threadCpuSetIsEmpty(set);
+}
+
+bool threadCpuSetFromNumaNode(ThreadCpuSet* set, uint32_t node)
+{
+    threadCpuSetClear(set);
+
+    GROUP_AFFINITY affinity = {0};
+    if (node > USHRT_MAX || !GetNumaNodeProcessorMaskEx((USHORT)node, &affinity) ||
+        affinity.Group != 0) {
+        return false;
+    }
+    set->bits[0] = (uint64_t)affinity.Mask;
+    return !threadCpuSetIsEmpty(set);
+}
+
+int threadSetAffinity(const ThreadCpuSet* set)
+{
+    if (set->bits[0] == 0) {
+        return ThreadResultError;
+    }
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)set->bits[0]) != 0
+               ? ThreadResultSuccess
+               : ThreadResultError;
+}
+
 static DWORD WINAPI threadWrapper(LPVOID arg)
 {
     Thread* thread = (Thread*)arg;
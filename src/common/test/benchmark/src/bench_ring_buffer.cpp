@@ -0,0 +1,155 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Benchmarks transferring values through a small ring buffer between producer and consumer
+// threads, in each ring buffer mode.
+
+#include <benchmark/benchmark.h>
+#include <LCEVC/common/diagnostics.h>
+#include <LCEVC/common/memory.h>
+#include <LCEVC/common/ring_buffer.h>
+#include <LCEVC/common/threads.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kRingSize = 256;
+constexpr uint64_t kItems = 1000000;
+
+struct TransferThread
+{
+    LdcRingBuffer* ringBuffer;
+    uint64_t first;
+    uint64_t count;
+    bool blocking;
+    uint64_t sum;
+    Thread thread;
+};
+
+intptr_t transferProducer(void* argument)
+{
+    auto* data = static_cast<TransferThread*>(argument);
+    for (uint64_t value = data->first; value < data->first + data->count; ++value) {
+        if (data->blocking) {
+            ldcRingBufferPush(data->ringBuffer, &value);
+        } else {
+            while (!ldcRingBufferTryPush(data->ringBuffer, &value)) {
+                threadYield();
+            }
+        }
+    }
+    return 0;
+}
+
+intptr_t transferConsumer(void* argument)
+{
+    auto* data = static_cast<TransferThread*>(argument);
+    for (uint64_t i = 0; i < data->count; ++i) {
+        uint64_t value = 0;
+        if (data->blocking) {
+            ldcRingBufferPop(data->ringBuffer, &value);
+        } else {
+            while (!ldcRingBufferTryPop(data->ringBuffer, &value)) {
+                threadYield();
+            }
+        }
+        data->sum += value;
+    }
+    return 0;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+
+static void ringBufferTransfer(benchmark::State& state)
+{
+    const auto mode = static_cast<LdcRingBufferMode>(state.range(0));
+    const auto producerCount = static_cast<uint32_t>(state.range(1));
+    const auto consumerCount = static_cast<uint32_t>(state.range(2));
+    const bool blocking = state.range(3) != 0;
+
+    const uint64_t perProducer = kItems / producerCount;
+    const uint64_t total = perProducer * producerCount;
+
+    for (auto _ : state) {
+        LdcRingBuffer ringBuffer;
+        ldcRingBufferInitializeMode(&ringBuffer, kRingSize, sizeof(uint64_t),
+                                    ldcMemoryAllocatorMalloc(), mode);
+
+        std::vector<TransferThread> producers(producerCount);
+        std::vector<TransferThread> consumers(consumerCount);
+
+        for (uint32_t i = 0; i < consumerCount; ++i) {
+            // Split total between consumers, with any remainder going to the first
+            const uint64_t count = total / consumerCount + (i == 0 ? total % consumerCount : 0);
+            consumers[i] = TransferThread{&ringBuffer, 0, count, blocking, 0, {}};
+            threadCreate(&consumers[i].thread, transferConsumer, &consumers[i]);
+        }
+        for (uint32_t i = 0; i < producerCount; ++i) {
+            producers[i] =
+                TransferThread{&ringBuffer, i * perProducer, perProducer, blocking, 0, {}};
+            threadCreate(&producers[i].thread, transferProducer, &producers[i]);
+        }
+
+        for (auto& producer : producers) {
+            threadJoin(&producer.thread, nullptr);
+        }
+        uint64_t sum = 0;
+        for (auto& consumer : consumers) {
+            threadJoin(&consumer.thread, nullptr);
+            sum += consumer.sum;
+        }
+        benchmark::DoNotOptimize(sum);
+
+        ldcRingBufferDestroy(&ringBuffer);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(total));
+}
+
+BENCHMARK(ringBufferTransfer)
+    ->ArgNames({"Mode", "Producers", "Consumers", "Blocking"})
+    ->Args({LdcRingBufferModeLocked, 1, 1, 1})
+    ->Args({LdcRingBufferModeSPSC, 1, 1, 1})
+    ->Args({LdcRingBufferModeSPSC, 1, 1, 0})
+    ->Args({LdcRingBufferModeLocked, 4, 4, 1})
+    ->Args({LdcRingBufferModeMPMC, 1, 1, 1})
+    ->Args({LdcRingBufferModeMPMC, 4, 4, 1})
+    ->Args({LdcRingBufferModeMPMC, 4, 4, 0})
+    ->Args({LdcRingBufferModeMPMC, 7, 2, 1})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// -----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    ldcDiagnosticsInitialize(nullptr);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    ldcDiagnosticsRelease();
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
@@ -16,6 +16,7 @@ list(
     APPEND
     SOURCES
     "src/diagnostics_ostream.cpp"
+    "src/test_acceleration.cpp"
     "src/test_configure.cpp"
     "src/test_cpp_tools.cpp"
     "src/test_deque.cpp"
@@ -0,0 +1,114 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#include <gtest/gtest.h>
+#include <LCEVC/common/acceleration.h>
+
+class AccelerationTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { ldcAccelerationInitialize(true); }
+
+    void TearDown() override
+    {
+        for (int32_t kernel = 0; kernel < LdcKernelCount; ++kernel) {
+            ldcAccelerationSetKernelLevel(static_cast<LdcAccelerationKernel>(kernel),
+                                          LdcAccelerationLevelAuto);
+        }
+        ldcAccelerationInitialize(true);
+    }
+};
+
+TEST_F(AccelerationTest, WiderImpliesNarrower)
+{
+    const LdcAcceleration* acceleration = ldcAccelerationGet();
+
+    EXPECT_TRUE(!acceleration->AVX2 || acceleration->SSE);
+    EXPECT_TRUE(!acceleration->AVX512 || acceleration->AVX2);
+    EXPECT_TRUE(!acceleration->SVE || acceleration->NEON);
+}
+
+TEST_F(AccelerationTest, AutoKernelsMatchDetected)
+{
+    const LdcAcceleration* acceleration = ldcAccelerationGet();
+
+    for (int32_t kernel = 0; kernel < LdcKernelCount; ++kernel) {
+        const LdcAccelerationFeatures* features =
+            ldcAccelerationGetKernel(static_cast<LdcAccelerationKernel>(kernel));
+        EXPECT_EQ(features->SSE, acceleration->SSE);
+        EXPECT_EQ(features->AVX2, acceleration->AVX2);
+        EXPECT_EQ(features->AVX512, acceleration->AVX512);
+        EXPECT_EQ(features->BMI2, acceleration->BMI2);
+        EXPECT_EQ(features->NEON, acceleration->NEON);
+        EXPECT_EQ(features->SVE, acceleration->SVE);
+    }
+}
+
+TEST_F(AccelerationTest, KernelLevelOnlyAffectsThatKernel)
+{
+    const LdcAcceleration* acceleration = ldcAccelerationGet();
+
+    ASSERT_TRUE(ldcAccelerationSetKernelLevel(LdcKernelUpscale, LdcAccelerationLevelBaseline));
+
+    const LdcAccelerationFeatures* upscale = ldcAccelerationGetKernel(LdcKernelUpscale);
+    EXPECT_EQ(upscale->SSE, acceleration->SSE);
+    EXPECT_EQ(upscale->NEON, acceleration->NEON);
+    EXPECT_FALSE(upscale->AVX2);
+    EXPECT_FALSE(upscale->AVX512);
+    EXPECT_FALSE(upscale->BMI2);
+
+    EXPECT_EQ(ldcAccelerationGetKernel(LdcKernelBlit)->AVX2, acceleration->AVX2);
+}
+
+TEST_F(AccelerationTest, ScalarKernelLevel)
+{
+    ASSERT_TRUE(ldcAccelerationSetKernelLevel(LdcKernelBlit, LdcAccelerationLevelScalar));
+
+    const LdcAccelerationFeatures* blit = ldcAccelerationGetKernel(LdcKernelBlit);
+    EXPECT_FALSE(blit->SSE);
+    EXPECT_FALSE(blit->AVX2);
+    EXPECT_FALSE(blit->AVX512);
+    EXPECT_FALSE(blit->BMI2);
+    EXPECT_FALSE(blit->NEON);
+    EXPECT_FALSE(blit->SVE);
+}
+
+TEST_F(AccelerationTest, KernelLevelSurvivesInitialize)
+{
+    ASSERT_TRUE(ldcAccelerationSetKernelLevel(LdcKernelBlit, LdcAccelerationLevelScalar));
+
+    ldcAccelerationInitialize(false);
+    ldcAccelerationInitialize(true);
+
+    EXPECT_FALSE(ldcAccelerationGetKernel(LdcKernelBlit)->SSE);
+    EXPECT_FALSE(ldcAccelerationGetKernel(LdcKernelBlit)->NEON);
+}
+
+TEST_F(AccelerationTest, DisabledClearsKernels)
+{
+    ldcAccelerationInitialize(false);
+
+    for (int32_t kernel = 0; kernel < LdcKernelCount; ++kernel) {
+        const LdcAccelerationFeatures* features =
+            ldcAccelerationGetKernel(static_cast<LdcAccelerationKernel>(kernel));
+        EXPECT_FALSE(features->SSE || features->AVX2 || features->AVX512 || features->BMI2 ||
+                     features->NEON || features->SVE);
+    }
+}
+
+TEST_F(AccelerationTest, InvalidKernelLevel)
+{
+    EXPECT_FALSE(ldcAccelerationSetKernelLevel(LdcKernelCount, LdcAccelerationLevelAuto));
+    EXPECT_FALSE(ldcAccelerationSetKernelLevel(LdcKernelBlit, LdcAccelerationLevelCount));
+}
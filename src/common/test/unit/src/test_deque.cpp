@@ -120,6 +120,35 @@ TEST_F(TestDeque, PushPop)
     EXPECT_EQ(ldcDequeSize(&deque), 0);
 }
 
+TEST_F(TestDeque, At)
+{
+    // Front pushes wrap around start of storage
+    for (uint32_t i = 0; i < 3; ++i) {
+        const Element e{i, 0};
+        ldcDequeFrontPush(&deque, &e);
+    }
+    for (uint32_t i = 0; i < 3; ++i) {
+        const Element e{i, 1};
+        ldcDequeBackPush(&deque, &e);
+    }
+
+    EXPECT_EQ(ldcDequeSize(&deque), 6);
+
+    const uint32_t expected[][2] = {{2, 0}, {1, 0}, {0, 0}, {0, 1}, {1, 1}, {2, 1}};
+    for (uint32_t i = 0; i < 6; ++i) {
+        const Element* ep = static_cast<const Element*>(ldcDequeAt(&deque, i));
+        EXPECT_EQ(ep->a, expected[i][0]);
+        EXPECT_EQ(ep->b, expected[i][1]);
+    }
+
+    // Elements can be modified in place
+    static_cast<Element*>(ldcDequeAt(&deque, 5))->a = 42;
+
+    Element ep = {0, 0};
+    ldcDequeBackPop(&deque, &ep);
+    EXPECT_EQ(ep.a, 42);
+}
+
 TEST_F(TestDeque, Grow)
 {
     for (uint32_t i = 0; i < kSize * 4; ++i) {
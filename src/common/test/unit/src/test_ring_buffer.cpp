@@ -17,7 +17,9 @@
 #include <LCEVC/common/ring_buffer.h>
 #include <LCEVC/common/threads.h>
 
-class TestRingBuffer : public testing::Test
+#include <vector>
+
+class TestRingBuffer : public testing::TestWithParam<LdcRingBufferMode>
 {
 public:
     const uint32_t kRingSize = 8;
@@ -39,7 +41,7 @@ public:
     void SetUp() override
     {
         allocator = ldcMemoryAllocatorMalloc();
-        ldcRingBufferInitialize(&ringBuffer, kRingSize, sizeof(Element), allocator);
+        ldcRingBufferInitializeMode(&ringBuffer, kRingSize, sizeof(Element), allocator, GetParam());
     }
 
     void TearDown() override { ldcRingBufferDestroy(&ringBuffer); }
@@ -48,7 +50,7 @@ public:
     LdcRingBuffer ringBuffer;
 };
 
-TEST_F(TestRingBuffer, CreateDestroy)
+TEST_P(TestRingBuffer, CreateDestroy)
 {
     EXPECT_EQ(ldcRingBufferCapacity(&ringBuffer), kRingSize - 1);
     EXPECT_EQ(ldcRingBufferSize(&ringBuffer), 0);
@@ -56,7 +58,7 @@ TEST_F(TestRingBuffer, CreateDestroy)
     EXPECT_EQ(ldcRingBufferIsFull(&ringBuffer), false);
 }
 
-TEST_F(TestRingBuffer, PushPop)
+TEST_P(TestRingBuffer, PushPop)
 {
     EXPECT_EQ(ldcRingBufferIsEmpty(&ringBuffer), true);
     EXPECT_EQ(ldcRingBufferIsFull(&ringBuffer), false);
@@ -79,7 +81,7 @@ TEST_F(TestRingBuffer, PushPop)
     EXPECT_EQ(ldcRingBufferSize(&ringBuffer), 0);
 }
 
-TEST_F(TestRingBuffer, PushPopFull)
+TEST_P(TestRingBuffer, PushPopFull)
 {
     for (uint32_t i = 0; i < kRingSize - 1; ++i) {
         const Element e{i, 2 * i};
@@ -112,7 +114,7 @@ TEST_F(TestRingBuffer, PushPopFull)
     EXPECT_EQ(ldcRingBufferSize(&ringBuffer), 0);
 }
 
-TEST_F(TestRingBuffer, PushPopFullWrapped)
+TEST_P(TestRingBuffer, PushPopFullWrapped)
 {
     // Move halfway through ring
     for (uint32_t i = 0; i < kRingSize / 2; ++i) {
@@ -159,3 +161,132 @@ TEST_F(TestRingBuffer, PushPopFullWrapped)
     EXPECT_EQ(ldcRingBufferIsFull(&ringBuffer), false);
     EXPECT_EQ(ldcRingBufferSize(&ringBuffer), 0);
 }
+
+INSTANTIATE_TEST_SUITE_P(RingBufferModes, TestRingBuffer,
+                         testing::Values(LdcRingBufferModeLocked, LdcRingBufferModeSPSC,
+                                         LdcRingBufferModeMPMC));
+
+// Transfer - producers push a known sequence of values through a small ring, consumers pop and
+// record them. Checks every value is received exactly once.
+//
+namespace {
+struct TransferParam
+{
+    LdcRingBufferMode mode;
+    uint32_t producers;
+    uint32_t consumers;
+    bool blocking;
+};
+
+struct TransferThread
+{
+    LdcRingBuffer* ringBuffer;
+    uint32_t first;
+    uint32_t count;
+    bool blocking;
+    std::vector<uint32_t> received;
+    Thread thread;
+};
+
+constexpr uint32_t kTransferRingSize = 16;
+constexpr uint32_t kTransferItems = 20000;
+
+intptr_t transferProducer(void* argument)
+{
+    auto* data = static_cast<TransferThread*>(argument);
+    for (uint32_t value = data->first; value < data->first + data->count; ++value) {
+        if (data->blocking) {
+            ldcRingBufferPush(data->ringBuffer, &value);
+        } else {
+            while (!ldcRingBufferTryPush(data->ringBuffer, &value)) {
+                threadYield();
+            }
+        }
+    }
+    return 0;
+}
+
+intptr_t transferConsumer(void* argument)
+{
+    auto* data = static_cast<TransferThread*>(argument);
+    data->received.reserve(data->count);
+    for (uint32_t i = 0; i < data->count; ++i) {
+        uint32_t value = 0;
+        if (data->blocking) {
+            ldcRingBufferPop(data->ringBuffer, &value);
+        } else {
+            while (!ldcRingBufferTryPop(data->ringBuffer, &value)) {
+                threadYield();
+            }
+        }
+        data->received.push_back(value);
+    }
+    return 0;
+}
+} // namespace
+
+class TestRingBufferTransfer : public testing::TestWithParam<TransferParam>
+{};
+
+TEST_P(TestRingBufferTransfer, ExactlyOnce)
+{
+    const TransferParam param = GetParam();
+    LdcRingBuffer ringBuffer;
+    ldcRingBufferInitializeMode(&ringBuffer, kTransferRingSize, sizeof(uint32_t),
+                                ldcMemoryAllocatorMalloc(), param.mode);
+
+    std::vector<TransferThread> producers(param.producers);
+    std::vector<TransferThread> consumers(param.consumers);
+
+    const uint32_t perProducer = kTransferItems / param.producers;
+    const uint32_t total = perProducer * param.producers;
+
+    for (uint32_t i = 0; i < param.consumers; ++i) {
+        // Split total between consumers, with any remainder going to the first
+        const uint32_t count = total / param.consumers + (i == 0 ? total % param.consumers : 0);
+        consumers[i] = TransferThread{&ringBuffer, 0, count, param.blocking, {}, {}};
+        ASSERT_EQ(threadCreate(&consumers[i].thread, transferConsumer, &consumers[i]),
+                  ThreadResultSuccess);
+    }
+    for (uint32_t i = 0; i < param.producers; ++i) {
+        producers[i] =
+            TransferThread{&ringBuffer, i * perProducer, perProducer, param.blocking, {}, {}};
+        ASSERT_EQ(threadCreate(&producers[i].thread, transferProducer, &producers[i]),
+                  ThreadResultSuccess);
+    }
+
+    for (auto& producer : producers) {
+        EXPECT_EQ(threadJoin(&producer.thread, nullptr), ThreadResultSuccess);
+    }
+
+    std::vector<uint32_t> timesReceived(total, 0);
+    for (auto& consumer : consumers) {
+        EXPECT_EQ(threadJoin(&consumer.thread, nullptr), ThreadResultSuccess);
+        for (const uint32_t value : consumer.received) {
+            EXPECT_LT(value, total);
+            if (value < total) {
+                timesReceived[value]++;
+            }
+        }
+    }
+
+    for (uint32_t value = 0; value < total; ++value) {
+        EXPECT_EQ(timesReceived[value], 1) << "value " << value;
+    }
+    EXPECT_EQ(ldcRingBufferSize(&ringBuffer), 0);
+
+    ldcRingBufferDestroy(&ringBuffer);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    RingBufferTransfer, TestRingBufferTransfer,
+    testing::Values(
+        // clang-format off
+        // mode, producers, consumers, blocking
+        TransferParam{LdcRingBufferModeSPSC, 1, 1, true},
+        TransferParam{LdcRingBufferModeSPSC, 1, 1, false},
+        TransferParam{LdcRingBufferModeMPMC, 4, 4, true},
+        TransferParam{LdcRingBufferModeMPMC, 4, 4, false},
+        TransferParam{LdcRingBufferModeMPMC, 7, 2, true}
+        // clang-format on
+        ));
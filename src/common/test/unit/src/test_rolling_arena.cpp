@@ -412,6 +412,125 @@ TEST_F(RollingArenaSmall, AllocateAlignedNEON)
 }
 #endif
 
+TEST_F(RollingArenaSmall, FreeEmpty)
+{
+    LdcMemoryAllocation mem{};
+    VNFree(allocator, &mem);
+    VNRollingArenaFree(allocator, &mem);
+    EXPECT_EQ(mem.ptr, nullptr);
+
+    checkEmpty();
+}
+
+TEST_F(RollingArenaSmall, ReallocateEmpty)
+{
+    LdcMemoryAllocation mem{};
+    uint8_t* ptr = VNReallocateArray(allocator, &mem, uint8_t, 100);
+    EXPECT_NE(ptr, nullptr);
+    EXPECT_EQ(ptr, mem.ptr);
+    EXPECT_EQ(mem.size, 100);
+    memset(ptr, 42, 100);
+    VNFree(allocator, &mem);
+
+    checkEmpty();
+}
+
+TEST_F(RollingArenaSmall, AllocateInline)
+{
+    const int kCount = 40;
+    LdcMemoryAllocation ma[kCount] = {};
+
+    // Enough allocations to need further buffers
+    for (int i = 0; i < kCount; ++i) {
+        S* ptr = (i % 3) ? VNRollingArenaAllocateZero(allocator, &ma[i], S)
+                         : VNRollingArenaAllocateArray(allocator, &ma[i], S, 3);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(ptr, ma[i].ptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % kRollingArenaMinAlignment, 0);
+        if (i % 3) {
+            EXPECT_EQ(ptr->a, 0);
+            EXPECT_EQ(ptr->d, 0);
+        }
+        memset(ptr, i, ma[i].size);
+    }
+
+    for (int i = 0; i < kCount; ++i) {
+        const uint8_t* ptr = static_cast<const uint8_t*>(ma[i].ptr);
+        for (size_t j = 0; j < ma[i].size; ++j) {
+            ASSERT_EQ(ptr[j], i);
+        }
+        VNRollingArenaFree(allocator, &ma[i]);
+        EXPECT_EQ(ma[i].ptr, nullptr);
+    }
+
+    checkEmpty();
+}
+
+TEST_F(RollingArenaSmall, ReallocateInPlace)
+{
+    LdcMemoryAllocation first{};
+    LdcMemoryAllocation mem{};
+    VNRollingArenaAllocateArray(allocator, &first, uint8_t, 64);
+
+    uint8_t* ptr = VNRollingArenaAllocateArray(allocator, &mem, uint8_t, 100);
+    ASSERT_NE(ptr, nullptr);
+    memset(ptr, 7, 100);
+
+    // Most recent allocation grows and shrinks without moving
+    EXPECT_EQ(VNRollingArenaReallocateArray(allocator, &mem, uint8_t, 100, 400), ptr);
+    EXPECT_EQ(mem.size, 400);
+    memset(ptr + 100, 8, 300);
+    EXPECT_EQ(VNRollingArenaReallocateArray(allocator, &mem, uint8_t, 400, 50), ptr);
+    EXPECT_EQ(mem.size, 50);
+    EXPECT_EQ(ptr[49], 7);
+
+    // Older allocation cannot grow into the next one
+    uint8_t* firstPtr = static_cast<uint8_t*>(first.ptr);
+    memset(firstPtr, 9, 64);
+    uint8_t* movedPtr = VNRollingArenaReallocateArray(allocator, &first, uint8_t, 64, 300);
+    EXPECT_NE(movedPtr, firstPtr);
+    EXPECT_EQ(movedPtr[63], 9);
+    EXPECT_EQ(ptr[0], 7);
+
+    VNRollingArenaFree(allocator, &first);
+    VNRollingArenaFree(allocator, &mem);
+
+    checkEmpty();
+}
+
+TEST_F(RollingArenaSmall, ReallocateWrapped)
+{
+    // Move buffer front and back most of the way along the buffer
+    LdcMemoryAllocation mem{};
+    VNAllocateArray(allocator, &mem, uint8_t, 600);
+    VNFree(allocator, &mem);
+
+    // Too big for the remainder of the buffer, so wraps to the start
+    LdcMemoryAllocation wrapped{};
+    uint8_t* wrappedPtr = VNAllocateArray(allocator, &wrapped, uint8_t, 300);
+    ASSERT_NE(wrappedPtr, nullptr);
+    EXPECT_EQ(wrappedPtr, arena.buffers[arena.bufferActive].memory.ptr);
+
+    LdcMemoryAllocation next{};
+    uint8_t* nextPtr = VNAllocateArray(allocator, &next, uint8_t, 100);
+    ASSERT_NE(nextPtr, nullptr);
+    EXPECT_GT(nextPtr, wrappedPtr);
+    memset(nextPtr, 3, 100);
+
+    // Growing the wrapped allocation must not overwrite the next one
+    wrappedPtr = VNReallocateArray(allocator, &wrapped, uint8_t, 500);
+    ASSERT_NE(wrappedPtr, nullptr);
+    memset(wrappedPtr, 4, 500);
+    for (uint32_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(nextPtr[i], 3);
+    }
+
+    VNFree(allocator, &wrapped);
+    VNFree(allocator, &next);
+
+    checkEmpty();
+}
+
 using RollingArenaLarge = RollingArena<512, 1024 * 1024>;
 
 TEST_F(RollingArenaLarge, RandomAllocations)
@@ -17,6 +17,10 @@
 #include <LCEVC/common/task_pool.h>
 #include <LCEVC/common/threads.h>
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 namespace {
 
 void* intToPtr(int v) { return reinterpret_cast<void*>(static_cast<intptr_t>(v)); }
@@ -85,3 +89,387 @@ TEST(TaskGroup, DependencyReserveGrowth)
     ldcTaskGroupDestroy(&group);
     ldcTaskPoolDestroy(&pool);
 }
+
+// Blocks nest - tasks are not scheduled until every block has been released
+//
+TEST(TaskGroup, BlockNests)
+{
+    LdcTaskPool pool;
+    ASSERT_TRUE(ldcTaskPoolInitialize(&pool, ldcMemoryAllocatorMalloc(), ldcMemoryAllocatorMalloc(), 1, 8));
+
+    LdcTaskGroup group;
+    ASSERT_TRUE(ldcTaskGroupInitialize(&group, &pool, 4));
+
+    LdcTaskDependency in = ldcTaskDependencyAdd(&group);
+    LdcTaskDependency out = ldcTaskDependencyAdd(&group);
+
+    ldcTaskGroupBlock(&group);
+    ldcTaskGroupBlock(&group);
+
+    IncData data{1};
+    EXPECT_TRUE(ldcTaskGroupAdd(&group, &in, 1, out, incTask, NULL, 1, 1, sizeof(data), &data, "inc"));
+    ldcTaskDependencyMet(&group, in, intToPtr(0));
+
+    // Inner unblock leaves the task held back
+    ldcTaskGroupUnblock(&group);
+    EXPECT_EQ(group.blockedTasksCount, 1);
+    EXPECT_EQ(ldcTaskGroupGetTaskCount(&group, NULL), 1);
+
+    ldcTaskGroupUnblock(&group);
+    EXPECT_EQ(ptrToInt(ldcTaskDependencyWait(&group, out)), 1);
+    EXPECT_EQ(group.blockedTasksCount, 0);
+
+    ldcTaskGroupDestroy(&group);
+    ldcTaskPoolDestroy(&pool);
+}
+
+// Ready parts from the group with the earlier deadline are run first
+//
+namespace {
+
+struct OrderData
+{
+    int groupIndex;
+    std::mutex* mutex;
+    std::vector<int>* order;
+};
+
+void* orderTask(LdcTask* task, const LdcTaskPart*)
+{
+    const OrderData& data = VNTaskData(task, OrderData);
+    std::scoped_lock lock(*data.mutex);
+    data.order->push_back(data.groupIndex);
+    return nullptr;
+}
+
+} // namespace
+
+TEST(TaskGroup, DeadlineOrder)
+{
+    const int kNumTasks = 8;
+
+    LdcTaskPool pool;
+    ASSERT_TRUE(ldcTaskPoolInitialize(&pool, ldcMemoryAllocatorMalloc(), ldcMemoryAllocatorMalloc(), 1, 8));
+
+    LdcTaskGroup groups[2];
+    ASSERT_TRUE(ldcTaskGroupInitialize(&groups[0], &pool, 4));
+    ASSERT_TRUE(ldcTaskGroupInitialize(&groups[1], &pool, 4));
+    ldcTaskGroupSetDeadline(&groups[0], 2000);
+    ldcTaskGroupSetDeadline(&groups[1], 1000);
+
+    // Keep the only worker busy whilst the group tasks are added
+    std::atomic_bool started{false};
+    std::atomic_bool release{false};
+    std::atomic_bool* flags[] = {&started, &release};
+    LdcTask* gate = ldcTaskPoolAdd(
+        &pool,
+        [](LdcTask* task, const LdcTaskPart*) -> void* {
+            std::atomic_bool** gateFlags = &VNTaskData(task, std::atomic_bool*);
+            gateFlags[0]->store(true);
+            while (!gateFlags[1]->load()) {
+                threadYield();
+            }
+            return nullptr;
+        },
+        NULL, 1, sizeof(flags), flags, "gate");
+    ASSERT_NE(gate, nullptr);
+    while (!started.load()) {
+        threadYield();
+    }
+
+    std::mutex mutex;
+    std::vector<int> order;
+    for (int i = 0; i < kNumTasks; ++i) {
+        for (int g = 0; g < 2; ++g) {
+            OrderData data{g, &mutex, &order};
+            EXPECT_TRUE(ldcTaskGroupAdd(&groups[g], NULL, 0, kTaskDependencyInvalid, orderTask,
+                                        NULL, 1, 1, sizeof(data), &data, "order"));
+        }
+    }
+
+    release.store(true);
+    EXPECT_TRUE(ldcTaskWait(gate, NULL));
+    ldcTaskGroupWait(&groups[0]);
+    ldcTaskGroupWait(&groups[1]);
+
+    ASSERT_EQ(order.size(), 2 * kNumTasks);
+    for (int i = 0; i < 2 * kNumTasks; ++i) {
+        EXPECT_EQ(order[i], i < kNumTasks ? 1 : 0);
+    }
+
+    ldcTaskGroupDestroy(&groups[0]);
+    ldcTaskGroupDestroy(&groups[1]);
+    ldcTaskPoolDestroy(&pool);
+}
+
+// A recorded graph can be added to another group, with task data patched on the way
+//
+TEST(TaskGroup, GraphInstantiate)
+{
+    const int kNumTasks = 16;
+
+    LdcTaskPool pool;
+    ASSERT_TRUE(ldcTaskPoolInitialize(&pool, ldcMemoryAllocatorMalloc(), ldcMemoryAllocatorMalloc(), 2, 8));
+
+    LdcTaskGraph graph;
+    ldcTaskGraphInitialize(&graph, ldcMemoryAllocatorMalloc());
+
+    // Record a chain of tasks that each add 1, after an input dependency that is not part of graph
+    LdcTaskGroup group1;
+    ASSERT_TRUE(ldcTaskGroupInitialize(&group1, &pool, 4));
+    const LdcTaskDependency input = ldcTaskDependencyAdd(&group1);
+
+    ldcTaskGroupRecordBegin(&group1, &graph);
+    LdcTaskDependency dep = input;
+    for (int i = 0; i < kNumTasks; ++i) {
+        IncData data{1};
+        const LdcTaskDependency out = ldcTaskDependencyAdd(&group1);
+        EXPECT_TRUE(ldcTaskGroupAdd(&group1, &dep, 1, out, incTask, NULL, 1, 1, sizeof(data), &data, "inc"));
+        dep = out;
+    }
+    EXPECT_TRUE(ldcTaskGroupRecordEnd(&group1));
+    const LdcTaskDependency output = dep;
+
+    EXPECT_EQ(graph.nodesCount, kNumTasks);
+    EXPECT_EQ(graph.firstDependency, 1);
+    EXPECT_EQ(graph.dependenciesCount, kNumTasks + 1);
+
+    ldcTaskDependencyMet(&group1, input, intToPtr(0));
+    EXPECT_EQ(ptrToInt(ldcTaskDependencyWait(&group1, output)), kNumTasks);
+    ldcTaskGroupDestroy(&group1);
+
+    // Each task in the copy adds 3
+    LdcTaskGroup group2;
+    ASSERT_TRUE(ldcTaskGroupInitialize(&group2, &pool, 4));
+    EXPECT_EQ(ldcTaskDependencyAdd(&group2), input);
+
+    int value = 3;
+    EXPECT_TRUE(ldcTaskGroupInstantiate(
+        &group2, &graph,
+        [](void* context, LdcTaskFunction function, void* data, size_t dataSize) {
+            EXPECT_EQ(function, incTask);
+            EXPECT_EQ(dataSize, sizeof(IncData));
+            static_cast<IncData*>(data)->value = *static_cast<int*>(context);
+        },
+        &value));
+    EXPECT_EQ(group2.dependenciesCount, kNumTasks + 1);
+
+    ldcTaskDependencyMet(&group2, input, intToPtr(0));
+    EXPECT_EQ(ptrToInt(ldcTaskDependencyWait(&group2, output)), kNumTasks * 3);
+
+    // Group with the wrong number of dependencies is rejected
+    EXPECT_FALSE(ldcTaskGroupInstantiate(&group2, &graph, NULL, NULL));
+
+    ldcTaskGroupWait(&group2);
+    ldcTaskGroupDestroy(&group2);
+    ldcTaskGraphDestroy(&graph);
+    ldcTaskPoolDestroy(&pool);
+}
+
+// Cancelled tasks are not run, but still pass on their output once their inputs are met
+//
+namespace {
+
+struct CountData
+{
+    std::atomic_int* count;
+};
+
+void* countTask(LdcTask* task, const LdcTaskPart*)
+{
+    VNTaskData(task, CountData).count->fetch_add(1);
+    return intToPtr(1);
+}
+
+void* keepCountTask(LdcTask* task, const LdcTaskPart*)
+{
+    VNTaskData(task, CountData).count->fetch_add(1);
+    return intToPtr(2);
+}
+
+} // namespace
+
+TEST(TaskGroup, Cancel)
+{
+    LdcTaskPool pool;
+    ASSERT_TRUE(ldcTaskPoolInitialize(&pool, ldcMemoryAllocatorMalloc(), ldcMemoryAllocatorMalloc(), 2, 8));
+
+    LdcTaskGroup group;
+    ASSERT_TRUE(ldcTaskGroupInitialize(&group, &pool, 8));
+
+    const LdcTaskDependency input = ldcTaskDependencyAdd(&group);
+    const LdcTaskDependency produced = ldcTaskDependencyAdd(&group);
+    const LdcTaskDependency dropped = ldcTaskDependencyAdd(&group);
+    const LdcTaskDependency kept = ldcTaskDependencyAdd(&group);
+
+    // input -> producer -> dropped
+    //                   -> kept
+    // dropped, kept -> sink
+    std::atomic_int producerCount{0};
+    std::atomic_int droppedCount{0};
+    std::atomic_int keptCount{0};
+    std::atomic_int sinkCount{0};
+
+    CountData data{&producerCount};
+    EXPECT_TRUE(ldcTaskGroupAdd(&group, &input, 1, produced, countTask, NULL, 1, 1, sizeof(data),
+                                &data, "producer"));
+    data.count = &droppedCount;
+    EXPECT_TRUE(ldcTaskGroupAdd(&group, &produced, 1, dropped, countTask, NULL, 1, 1, sizeof(data),
+                                &data, "dropped"));
+    data.count = &keptCount;
+    EXPECT_TRUE(ldcTaskGroupAdd(&group, &produced, 1, kept, keepCountTask, NULL, 1, 1,
+                                sizeof(data), &data, "kept"));
+    data.count = &sinkCount;
+    const LdcTaskDependency sinkInputs[] = {dropped, kept};
+    EXPECT_TRUE(ldcTaskGroupAdd(&group, sinkInputs, 2, kTaskDependencyInvalid, countTask, NULL, 1,
+                                1, sizeof(data), &data, "sink"));
+
+    // Only the tasks that nothing that runs depends on are cancelled
+    std::atomic_int cancelledCount{0};
+    EXPECT_EQ(ldcTaskGroupCancel(
+                  &group,
+                  [](void*, LdcTaskFunction function, const void*, size_t) {
+                      return function == keepCountTask;
+                  },
+                  [](void* context, LdcTask*) {
+                      static_cast<std::atomic_int*>(context)->fetch_add(1);
+                  },
+                  &cancelledCount),
+              2);
+
+    ldcTaskDependencyMet(&group, input, intToPtr(0));
+    ldcTaskGroupWait(&group);
+
+    EXPECT_EQ(producerCount.load(), 1);
+    EXPECT_EQ(droppedCount.load(), 0);
+    EXPECT_EQ(keptCount.load(), 1);
+    EXPECT_EQ(sinkCount.load(), 0);
+    EXPECT_EQ(cancelledCount.load(), 2);
+
+    EXPECT_EQ(ldcTaskDependencyGet(&group, dropped), nullptr);
+    EXPECT_EQ(ptrToInt(ldcTaskDependencyGet(&group, kept)), 2);
+
+    // Without a keep function, everything is cancelled
+    const LdcTaskDependency input2 = ldcTaskDependencyAdd(&group);
+    const LdcTaskDependency output2 = ldcTaskDependencyAdd(&group);
+    data.count = &producerCount;
+    EXPECT_TRUE(ldcTaskGroupAdd(&group, &input2, 1, output2, keepCountTask, NULL, 1, 1,
+                                sizeof(data), &data, "producer2"));
+    EXPECT_EQ(ldcTaskGroupCancel(&group, NULL, NULL, NULL), 1);
+
+    ldcTaskDependencyMet(&group, input2, intToPtr(0));
+    EXPECT_EQ(ldcTaskDependencyWait(&group, output2), nullptr);
+    ldcTaskGroupWait(&group);
+    EXPECT_EQ(producerCount.load(), 1);
+
+    ldcTaskGroupDestroy(&group);
+    ldcTaskPoolDestroy(&pool);
+}
+
+// A kept sink keeps the chain of tasks that feeds it
+//
+TEST(TaskGroup, CancelKeepsSinkProducers)
+{
+    LdcTaskPool pool;
+    ASSERT_TRUE(ldcTaskPoolInitialize(&pool, ldcMemoryAllocatorMalloc(), ldcMemoryAllocatorMalloc(), 2, 8));
+
+    LdcTaskGroup group;
+    ASSERT_TRUE(ldcTaskGroupInitialize(&group, &pool, 8));
+
+    // input -> first -> second -> sink
+    const LdcTaskDependency input = ldcTaskDependencyAdd(&group);
+    const LdcTaskDependency first = ldcTaskDependencyAdd(&group);
+    const LdcTaskDependency second = ldcTaskDependencyAdd(&group);
+
+    std::atomic_int count{0};
+    std::atomic_int sinkCount{0};
+    CountData data{&count};
+    EXPECT_TRUE(ldcTaskGroupAdd(&group, &input, 1, first, countTask, NULL, 1, 1, sizeof(data),
+                                &data, "first"));
+    EXPECT_TRUE(ldcTaskGroupAdd(&group, &first, 1, second, countTask, NULL, 1, 1, sizeof(data),
+                                &data, "second"));
+    data.count = &sinkCount;
+    EXPECT_TRUE(ldcTaskGroupAdd(&group, &second, 1, kTaskDependencyInvalid, keepCountTask, NULL,
+                                1, 1, sizeof(data), &data, "sink"));
+
+    EXPECT_EQ(ldcTaskGroupCancel(
+                  &group,
+                  [](void*, LdcTaskFunction function, const void*, size_t) {
+                      return function == keepCountTask;
+                  },
+                  NULL, NULL),
+              0);
+
+    ldcTaskDependencyMet(&group, input, intToPtr(0));
+    ldcTaskGroupWait(&group);
+
+    EXPECT_EQ(count.load(), 2);
+    EXPECT_EQ(sinkCount.load(), 1);
+
+    ldcTaskGroupDestroy(&group);
+    ldcTaskPoolDestroy(&pool);
+}
+
+// Parts of cancelled tasks that are already ready are taken out of the pool, and their outputs
+// are met by the time the cancel returns
+//
+TEST(TaskGroup, CancelReady)
+{
+    LdcTaskPool pool;
+    ASSERT_TRUE(ldcTaskPoolInitialize(&pool, ldcMemoryAllocatorMalloc(), ldcMemoryAllocatorMalloc(), 1, 8));
+
+    LdcTaskGroup group;
+    ASSERT_TRUE(ldcTaskGroupInitialize(&group, &pool, 8));
+
+    // Keep the only worker busy, so the group's task stays ready
+    std::atomic_bool started{false};
+    std::atomic_bool release{false};
+    std::atomic_bool* flags[] = {&started, &release};
+    LdcTask* gate = ldcTaskPoolAdd(
+        &pool,
+        [](LdcTask* task, const LdcTaskPart*) -> void* {
+            std::atomic_bool** gateFlags = &VNTaskData(task, std::atomic_bool*);
+            gateFlags[0]->store(true);
+            while (!gateFlags[1]->load()) {
+                threadYield();
+            }
+            return nullptr;
+        },
+        NULL, 1, sizeof(flags), flags, "gate");
+    ASSERT_NE(gate, nullptr);
+    while (!started.load()) {
+        threadYield();
+    }
+
+    // ready -> waiting
+    const LdcTaskDependency ready = ldcTaskDependencyAdd(&group);
+    const LdcTaskDependency waiting = ldcTaskDependencyAdd(&group);
+    std::atomic_int count{0};
+    CountData data{&count};
+    EXPECT_TRUE(ldcTaskGroupAdd(&group, NULL, 0, ready, countTask, NULL, 4, 1, sizeof(data),
+                                &data, "ready"));
+    EXPECT_TRUE(ldcTaskGroupAdd(&group, &ready, 1, waiting, countTask, NULL, 1, 1, sizeof(data),
+                                &data, "waiting"));
+    EXPECT_FALSE(ldcTaskDependencyIsMet(&group, ready));
+
+    std::atomic_int cancelledCount{0};
+    EXPECT_EQ(ldcTaskGroupCancel(
+                  &group, NULL,
+                  [](void* context, LdcTask*) {
+                      static_cast<std::atomic_int*>(context)->fetch_add(1);
+                  },
+                  &cancelledCount),
+              2);
+
+    EXPECT_TRUE(ldcTaskDependencyIsMet(&group, ready));
+    EXPECT_TRUE(ldcTaskDependencyIsMet(&group, waiting));
+    EXPECT_EQ(cancelledCount.load(), 2);
+
+    release.store(true);
+    EXPECT_TRUE(ldcTaskWait(gate, NULL));
+    ldcTaskGroupWait(&group);
+    EXPECT_EQ(count.load(), 0);
+
+    ldcTaskGroupDestroy(&group);
+    ldcTaskPoolDestroy(&pool);
+}
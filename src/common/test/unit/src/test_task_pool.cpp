@@ -21,8 +21,10 @@
 #include <LCEVC/common/task_pool.h>
 #include <LCEVC/common/threads.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cstdio>
+#include <cstring>
 
 // Utility functions for testing with void*
 namespace {
@@ -45,6 +47,90 @@ TEST(TaskPool, Create)
     ldcTaskPoolDestroy(&taskPool);
 }
 
+// Waiting for a task from a worker thread fails rather than blocking the worker
+TEST(TaskPool, WaitFromWorker)
+{
+    LdcTaskPool pool;
+    ASSERT_TRUE(ldcTaskPoolInitialize(&pool, ldcMemoryAllocatorMalloc(), ldcMemoryAllocatorMalloc(), 2, 8));
+
+    LdcTask* outer = ldcTaskPoolAdd(
+        &pool,
+        [](LdcTask* thisTask, const LdcTaskPart* /*part*/) -> void* {
+            LdcTask* inner = ldcTaskPoolAdd(
+                thisTask->pool,
+                [](LdcTask* /*task*/, const LdcTaskPart* /*part*/) -> void* {
+                    return intToVoidPtr(42);
+                },
+                NULL, 1, 0, NULL, "inner");
+            EXPECT_FALSE(ldcTaskWait(inner, NULL));
+            return inner;
+        },
+        NULL, 1, 0, NULL, "outer");
+    ASSERT_NE(outer, nullptr);
+
+    void* inner = nullptr;
+    EXPECT_TRUE(ldcTaskWait(outer, &inner));
+    ASSERT_NE(inner, nullptr);
+
+    void* output = nullptr;
+    EXPECT_TRUE(ldcTaskWait(static_cast<LdcTask*>(inner), &output));
+    EXPECT_EQ(intFromVoidPtr(output), 42);
+
+    ldcTaskPoolDestroy(&pool);
+}
+
+// A sliced task without a parent would have to be waited for, so is refused from a worker thread
+TEST(TaskPool, SlicedDeferredFromWorker)
+{
+    LdcTaskPool pool;
+    ASSERT_TRUE(ldcTaskPoolInitialize(&pool, ldcMemoryAllocatorMalloc(),
+                                      ldcMemoryAllocatorMalloc(), 2, 8));
+
+    std::atomic_int iterationCount = 0;
+    std::atomic_int* countPtr = &iterationCount;
+
+    LdcTask* task = ldcTaskPoolAdd(
+        &pool,
+        [](LdcTask* thisTask, const LdcTaskPart* /*part*/) -> void* {
+            std::atomic_int* thisCountPtr = VNTaskData(thisTask, std::atomic_int*);
+            const bool added = ldcTaskPoolAddSlicedDeferred(
+                thisTask->pool, NULL,
+                [](void* argument, uint32_t /*offset*/, uint32_t count) -> bool {
+                    (*static_cast<std::atomic_int**>(argument))->fetch_add(static_cast<int>(count));
+                    return true;
+                },
+                NULL, &thisCountPtr, sizeof(thisCountPtr), 64, 4);
+            return intToVoidPtr(added ? 1 : 0);
+        },
+        NULL, 1, sizeof(countPtr), &countPtr, "outer");
+    ASSERT_NE(task, nullptr);
+
+    void* output = nullptr;
+    EXPECT_TRUE(ldcTaskWait(task, &output));
+    EXPECT_EQ(intFromVoidPtr(output), 0);
+
+    // Nothing was added to run later
+    ldcTaskPoolWait(&pool);
+    EXPECT_EQ(iterationCount, 0);
+
+    ldcTaskPoolDestroy(&pool);
+}
+
+TEST(TaskPool, StatsPercentile)
+{
+    uint32_t histogram[kTaskStatsBuckets] = {0};
+    EXPECT_EQ(ldcTaskStatsPercentile(histogram, 50), 0);
+
+    // 90 samples in [2,4)us, 10 samples in [512,1024)us
+    histogram[2] = 90;
+    histogram[10] = 10;
+    EXPECT_EQ(ldcTaskStatsPercentile(histogram, 0), 4);
+    EXPECT_EQ(ldcTaskStatsPercentile(histogram, 50), 4);
+    EXPECT_EQ(ldcTaskStatsPercentile(histogram, 90), 4);
+    EXPECT_EQ(ldcTaskStatsPercentile(histogram, 91), 1024);
+    EXPECT_EQ(ldcTaskStatsPercentile(histogram, 100), 1024);
+}
+
 struct TestParam
 {
     unsigned numThreads;
@@ -306,6 +392,56 @@ TEST_P(TaskPoolTest, SubTasks)
     EXPECT_EQ(taskCount, numTasks * kNumSubTasks);
 }
 
+// Tasks that hand their work on to multi-part subtasks - idle workers steal the parts.
+TEST_P(TaskPoolTest, DeferInTask)
+{
+    // Tasks hand their work on to a nested sliced task rather than waiting for it
+    const int numTasks = GetParam().count;
+    static constexpr uint32_t kNumIterations = 64;
+
+    std::atomic_int iterationCount = 0;
+
+    LdcTaskGroup group;
+    EXPECT_TRUE(ldcTaskGroupInitialize(&group, &taskPool, numTasks * 2));
+
+    std::vector<LdcTaskDependency> outputs(numTasks);
+
+    for (int i = 0; i < numTasks; ++i) {
+        std::atomic_int* countPtr = &iterationCount;
+        outputs[i] = ldcTaskDependencyAdd(&group);
+
+        ldcTaskGroupAdd(
+            &group, NULL, 0, outputs[i],
+            [](LdcTask* thisTask, const LdcTaskPart* /*part*/) -> void* {
+                std::atomic_int* thisCountPtr = VNTaskData(thisTask, std::atomic_int*);
+
+                EXPECT_TRUE(ldcTaskPoolAddSlicedDeferred(
+                    thisTask->pool, thisTask,
+                    [](void* argument, uint32_t /*offset*/, uint32_t count) -> bool {
+                        (*static_cast<std::atomic_int**>(argument))->fetch_add(static_cast<int>(count));
+                        return true;
+                    },
+                    NULL, &thisCountPtr, sizeof(thisCountPtr), kNumIterations, 4));
+
+                return nullptr;
+            },
+            NULL, 1, 1, sizeof(countPtr), &countPtr, "test");
+    }
+
+    // Outputs are only met once the nested tasks have completed
+    for (int i = 0; i < numTasks; ++i) {
+        ldcTaskDependencyWait(&group, outputs[i]);
+    }
+    EXPECT_EQ(iterationCount, numTasks * static_cast<int>(kNumIterations));
+
+    ldcTaskGroupWait(&group);
+    ldcTaskGroupDestroy(&group);
+
+    // Is pool really empty?
+    EXPECT_EQ(taskPool.tasks.size, 0);
+    EXPECT_EQ(taskPool.pendingTaskCount, 0);
+}
+
 //
 TEST_P(TaskPoolTest, TaskGroupInit)
 {
@@ -360,6 +496,62 @@ TEST_P(TaskPoolTest, TaskGroupSimple)
     ldcTaskGroupDestroy(&group);
 }
 
+// Two clients sharing the pool with different weights
+TEST_P(TaskPoolTest, TaskGroupClients)
+{
+    const int numTasks = GetParam().count;
+    const uint32_t numThreads = std::max(1U, GetParam().numThreads);
+
+    LdcTaskPoolClient client1;
+    LdcTaskPoolClient client2;
+    EXPECT_TRUE(ldcTaskPoolClientAttach(&taskPool, &client1, 1));
+    EXPECT_TRUE(ldcTaskPoolClientAttach(&taskPool, &client2, 3));
+
+    EXPECT_EQ(client1.quota, std::max(1U, (numThreads * 1 + 3) / 4));
+    EXPECT_EQ(client2.quota, std::max(1U, (numThreads * 3 + 3) / 4));
+
+    LdcTaskGroup group1;
+    LdcTaskGroup group2;
+    EXPECT_TRUE(ldcTaskGroupInitialize(&group1, &taskPool, 10));
+    EXPECT_TRUE(ldcTaskGroupInitialize(&group2, &taskPool, 10));
+    ldcTaskGroupSetClient(&group1, &client1);
+    ldcTaskGroupSetClient(&group2, &client2);
+
+    std::atomic_int count1 = 0;
+    std::atomic_int count2 = 0;
+
+    auto countTask = [](LdcTask* task, const LdcTaskPart* part) -> void* {
+        VNTaskData(task, std::atomic_int*)->fetch_add(static_cast<int>(part->count));
+        return nullptr;
+    };
+
+    for (int i = 0; i < numTasks; ++i) {
+        std::atomic_int* countPtr1 = &count1;
+        std::atomic_int* countPtr2 = &count2;
+        EXPECT_TRUE(ldcTaskGroupAdd(&group1, nullptr, 0, kTaskDependencyInvalid, countTask, NULL, 4,
+                                    1, sizeof(countPtr1), &countPtr1, "client1"));
+        EXPECT_TRUE(ldcTaskGroupAdd(&group2, nullptr, 0, kTaskDependencyInvalid, countTask, NULL, 4,
+                                    1, sizeof(countPtr2), &countPtr2, "client2"));
+    }
+
+    ldcTaskGroupWait(&group1);
+    ldcTaskGroupWait(&group2);
+
+    EXPECT_EQ(count1, numTasks * 4);
+    EXPECT_EQ(count2, numTasks * 4);
+
+    ldcTaskGroupDestroy(&group1);
+    ldcTaskGroupDestroy(&group2);
+
+    // Remaining client gets whole pool
+    ldcTaskPoolClientDetach(&client2);
+    EXPECT_EQ(client1.quota, numThreads);
+    ldcTaskPoolClientDetach(&client1);
+
+    EXPECT_EQ(taskPool.tasks.size, 0);
+    EXPECT_EQ(taskPool.pendingTaskCount, 0);
+}
+
 //
 struct TaskTreeData
 {
@@ -445,6 +637,124 @@ TEST_P(TaskPoolTest, TaskGroupTree)
     ldcTaskGroupDestroy(&group);
 }
 
+TEST_P(TaskPoolTest, IdleSpin)
+{
+    ldcTaskPoolSetIdlePolicy(&taskPool, 2000, 2000);
+
+    // Several rounds - with gaps that are shorter and longer than the spin and yield periods
+    const uint32_t gaps[] = {0, 1, 10, 0};
+    std::atomic_int taskCount = 0;
+
+    for (uint32_t gap : gaps) {
+        threadSleep(gap);
+
+        std::vector<LdcTask*> tasks(GetParam().count);
+        for (LdcTask*& task : tasks) {
+            std::atomic_int* countPtr = &taskCount;
+            task = ldcTaskPoolAdd(
+                &taskPool,
+                [](LdcTask* thisTask, const LdcTaskPart* /*part*/) -> void* {
+                    VNTaskData(thisTask, std::atomic_int*)->fetch_add(1);
+                    return nullptr;
+                },
+                NULL, 1, sizeof(countPtr), &countPtr, "spin");
+            EXPECT_NE(task, nullptr);
+        }
+        for (LdcTask* task : tasks) {
+            EXPECT_TRUE(ldcTaskWait(task, nullptr));
+        }
+    }
+
+    EXPECT_EQ(taskCount, static_cast<int>(VNArraySize(gaps) * GetParam().count));
+}
+
+// A worker that is given work within its spin period picks it up without parking
+TEST(TaskPool, IdleSpinWithoutParking)
+{
+    LdcTaskPool pool;
+    ASSERT_TRUE(ldcTaskPoolInitialize(&pool, ldcMemoryAllocatorMalloc(),
+                                      ldcMemoryAllocatorMalloc(), 1, 8));
+
+    const auto parkCount = [&pool]() {
+        threadMutexLock(&pool.idleMutex);
+        const uint32_t count = VNAllocationPtr(pool.threads, LdcTaskThread)->parkCount;
+        threadMutexUnlock(&pool.idleMutex);
+        return count;
+    };
+    const auto addAndWait = [&pool]() {
+        LdcTask* task = ldcTaskPoolAdd(
+            &pool, [](LdcTask* /*task*/, const LdcTaskPart* /*part*/) -> void* { return nullptr; },
+            NULL, 1, 0, NULL, "spin");
+        ASSERT_NE(task, nullptr);
+        EXPECT_TRUE(ldcTaskWait(task, nullptr));
+    };
+
+    // With the default policy the worker parks straight away - once it has, set a policy that
+    // it picks up when woken by the first task
+    while (parkCount() == 0) {
+        threadSleep(1);
+    }
+    ldcTaskPoolSetIdlePolicy(&pool, 200000, 0);
+    addAndWait();
+    const uint32_t parked = parkCount();
+
+    for (int i = 0; i < 10; ++i) {
+        threadSleep(1);
+        addAndWait();
+    }
+    EXPECT_EQ(parkCount(), parked);
+
+    ldcTaskPoolDestroy(&pool);
+}
+
+TEST_P(TaskPoolTest, TaskStats)
+{
+    LdcTaskGroup group;
+    EXPECT_TRUE(ldcTaskGroupInitialize(&group, &taskPool, 1));
+
+    const auto work = [](LdcTask* /*task*/, const LdcTaskPart* /*part*/) -> void* {
+        threadSleep(1);
+        return nullptr;
+    };
+    for (int i = 0; i < 10; ++i) {
+        ldcTaskGroupAdd(&group, nullptr, 0, kTaskDependencyInvalid, work, nullptr, 1, 1, 0,
+                        nullptr, "statsA");
+    }
+    for (int i = 0; i < 5; ++i) {
+        ldcTaskGroupAdd(&group, nullptr, 0, kTaskDependencyInvalid, work, nullptr, 1, 1, 0,
+                        nullptr, "statsB");
+    }
+    ldcTaskGroupWait(&group);
+    ldcTaskGroupDestroy(&group);
+
+    LdcTaskStats stats[kTaskPoolMaxStatsNames];
+    const uint32_t count = ldcTaskPoolGetStats(&taskPool, stats, kTaskPoolMaxStatsNames);
+    ASSERT_EQ(count, 2);
+
+    for (uint32_t idx = 0; idx < count; ++idx) {
+        const uint64_t expected = (strcmp(stats[idx].name, "statsA") == 0) ? 10 : 5;
+        EXPECT_EQ(stats[idx].count, expected);
+
+        uint64_t waitCount = 0;
+        uint64_t runCount = 0;
+        for (uint32_t bucket = 0; bucket < kTaskStatsBuckets; ++bucket) {
+            waitCount += stats[idx].waitHistogram[bucket];
+            runCount += stats[idx].runHistogram[bucket];
+        }
+        EXPECT_EQ(waitCount, expected);
+        EXPECT_EQ(runCount, expected);
+
+        // Each task sleeps for at least 1ms
+        EXPECT_GE(stats[idx].runTotal, expected * 1000);
+        EXPECT_GE(ldcTaskStatsPercentile(stats[idx].runHistogram, 50), 1024);
+    }
+
+    ldcTaskPoolResetStats(&taskPool);
+    EXPECT_EQ(ldcTaskPoolGetStats(&taskPool, stats, kTaskPoolMaxStatsNames), 2);
+    EXPECT_EQ(stats[0].count, 0);
+    EXPECT_EQ(ldcTaskStatsPercentile(stats[0].runHistogram, 50), 0);
+}
+
 INSTANTIATE_TEST_SUITE_P(TaskPool, TaskPoolTest,
                          testing::Values(
                              // clang-format off
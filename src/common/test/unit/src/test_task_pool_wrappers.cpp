@@ -116,7 +116,7 @@ TEST_P(TaskPoolWrapperTest, Sliced)
     SlicedTaskData data = {this, 0xf00dfade, count};
 
     const bool r =
-        ldcTaskPoolAddSlicedDeferred(&taskPool, NULL, slicedFn, NULL, &data, sizeof(data), count);
+        ldcTaskPoolAddSlicedDeferred(&taskPool, NULL, slicedFn, NULL, &data, sizeof(data), count, 0);
     EXPECT_EQ(taskPool.pendingTaskCount, 0);
     EXPECT_TRUE(r);
 
@@ -133,7 +133,7 @@ TEST_P(TaskPoolWrapperTest, SlicedWithCompletion)
     SlicedTaskData data = {this, 0xf00dfade, count};
 
     const bool r = ldcTaskPoolAddSlicedDeferred(&taskPool, NULL, slicedFn, completionFn, &data,
-                                                sizeof(data), count);
+                                                sizeof(data), count, 0);
 
     EXPECT_EQ(taskPool.pendingTaskCount, 0);
     EXPECT_TRUE(r);
@@ -151,6 +151,38 @@ TEST_P(TaskPoolWrapperTest, SlicedWithCompletion)
     }
 }
 
+static constexpr uint32_t kSliceGrain = 7;
+
+static bool slicedGrainFn(void* argument, uint32_t offset, uint32_t count)
+{
+    // Lazily split slices are no bigger than the grain, and start on a multiple of it
+    EXPECT_LE(count, kSliceGrain);
+    EXPECT_EQ(offset % kSliceGrain, 0);
+
+    return slicedFn(argument, offset, count);
+}
+
+TEST_P(TaskPoolWrapperTest, SlicedGrain)
+{
+    const uint32_t count = GetParam().count;
+    SlicedTaskData data = {this, 0xf00dfade, count};
+
+    const bool r = ldcTaskPoolAddSlicedDeferred(&taskPool, NULL, slicedGrainFn, completionFn, &data,
+                                                sizeof(data), count, kSliceGrain);
+
+    EXPECT_EQ(taskPool.pendingTaskCount, 0);
+    EXPECT_TRUE(r);
+
+    // visited whole domain?
+    EXPECT_EQ(calledSet.size(), count);
+    for (uint32_t i = 0; i < count; ++i) {
+        EXPECT_EQ(calledSet.count(i), 1);
+    }
+
+    // completed whole domain?
+    EXPECT_EQ(completedSet.size(), count);
+}
+
 INSTANTIATE_TEST_SUITE_P(TaskPoolWrapper, TaskPoolWrapperTest,
                          testing::Values(
                              // clang-format off
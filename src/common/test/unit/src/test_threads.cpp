@@ -532,3 +532,41 @@ TEST(ThreadsTest, CondVarManyProdConsBroadcast)
     }
     EXPECT_EQ(threadJoin(&threadConsume, NULL), ThreadResultSuccess);
 }
+
+TEST(ThreadsTest, CpuSetParse)
+{
+    ThreadCpuSet set;
+
+    EXPECT_TRUE(threadCpuSetParse(&set, "0-3,8, 10-11\n"));
+    for (uint32_t cpu = 0; cpu < 16; ++cpu) {
+        const bool expected = cpu <= 3 || cpu == 8 || cpu == 10 || cpu == 11;
+        EXPECT_EQ(threadCpuSetContains(&set, cpu), expected) << cpu;
+    }
+
+    EXPECT_TRUE(threadCpuSetParse(&set, "200"));
+    EXPECT_TRUE(threadCpuSetContains(&set, 200));
+    EXPECT_FALSE(threadCpuSetContains(&set, 0));
+
+    EXPECT_TRUE(threadCpuSetParse(&set, ""));
+    EXPECT_TRUE(threadCpuSetIsEmpty(&set));
+
+    EXPECT_FALSE(threadCpuSetParse(&set, "3-1"));
+    EXPECT_FALSE(threadCpuSetParse(&set, "1,,2"));
+    EXPECT_FALSE(threadCpuSetParse(&set, "x"));
+    EXPECT_FALSE(threadCpuSetParse(&set, "9999"));
+}
+
+TEST(ThreadsTest, CpuSetAffinity)
+{
+    ThreadCpuSet all;
+    if (!threadCpuSetFromCoreClass(&all, ThreadCoreClassAny)) {
+        GTEST_SKIP() << "CPU sets not supported on this platform";
+    }
+    EXPECT_FALSE(threadCpuSetIsEmpty(&all));
+
+    ThreadCpuSet performance;
+    EXPECT_TRUE(threadCpuSetFromCoreClass(&performance, ThreadCoreClassPerformance));
+    EXPECT_FALSE(threadCpuSetIsEmpty(&performance));
+
+    EXPECT_EQ(threadSetAffinity(&all), ThreadResultSuccess);
+}
@@ -29,6 +29,7 @@ list(
     "src/dimensions.c"
     "src/entropy.c"
     "src/huffman.c"
+    "src/huffman_bmi2.c"
     "src/log_utilities.c"
     "src/tile_parser.c"
     "src/transform.c"
@@ -45,10 +46,14 @@ list(
     "src/dequant.h"
     "src/entropy.h"
     "src/huffman.h"
+    "src/huffman_triple_decode.h"
     "src/log_utilities.h"
     "src/tile_parser.h"
     "src/transform.h")
 
+# Sources that are compiled with BMI2 enabled, and only called when it is detected at runtime.
+list(APPEND SOURCES_BMI2 "src/huffman_bmi2.c")
+
 list(
     APPEND
     INTERFACES
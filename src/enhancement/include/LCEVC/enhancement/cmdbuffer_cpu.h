@@ -42,6 +42,7 @@ enum LdeCmdBufferCpuConstants
     CBCKDDLayerSize = 8,    /**< layer size (bytes) for a DD buffer */
     CBCKBigJumpSignal = 62, /**< Max 6-bit value where skip can be combined with the command */
     CBCKExtraBigJumpSignal = 63, /**< 6 binary 1s to signal to read the next 3 bytes for the jump value */
+    CBCKMaxEntryPoints = 16,     /**< Maximum number of entry points */
 };
 
 /*! \brief A struct indicating how to apply a slice of a command buffer.
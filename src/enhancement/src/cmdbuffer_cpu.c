@@ -22,7 +22,6 @@ enum CmdBufferCpuConfig
     CBCKStoreGrowFactor = 2, /**< The factory multiply current capacity by when growing the buffer. */
     CBCKInitialCapacity = 32768,   /**< The default initial capacity of a cmdbuffer. */
     CBCKExtraBigJump = UINT16_MAX, /**< Max 16-bit value before overflowing to a 24-bit jump value */
-    CBCKMaxEntryPoints = 16,       /**< Maximum number of entry points */
 };
 
 /*------------------------------------------------------------------------------*/
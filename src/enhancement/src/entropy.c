@@ -164,6 +164,7 @@ bool entropyInitialize(EntropyDecoder* state, const LdeChunk* chunk, const Entro
     state->rleData = NULL;
     state->entropyEnabled = true;
     state->type = type;
+    state->comboHuffmanDecode = huffmanTripleGetDecodeFunction();
 
     /* Syntax specific setup. */
     VNCheckB(chunkInitialize(state, chunk, bitstreamVersion));
@@ -260,7 +261,7 @@ int32_t entropyDecode(EntropyDecoder* state, int16_t* out)
         return entropyDecode_getNextSymbolRLEOnly(state, out);
     }
 
-    return huffmanTripleDecode(&state->comboHuffman, &state->hstream, out);
+    return state->comboHuffmanDecode(&state->comboHuffman, &state->hstream, out);
 }
 
 int32_t entropyDecodeTemporal(EntropyDecoder* state, TemporalSignal* out)
@@ -51,6 +51,7 @@ typedef struct EntropyDecoder
     uint32_t rawOffset;
     HuffmanSingleDecoder_t huffman[HuffTemporalCount]; // Note that HuffTemporalCount == HuffSizeCount
     HuffmanTripleDecodeState comboHuffman;
+    HuffmanTripleDecodeFunction comboHuffmanDecode;
     HuffmanStream hstream;
     bool rleOnly;
     const uint8_t* rleData;
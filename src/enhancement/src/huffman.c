@@ -17,6 +17,7 @@
 #include "chunk_parser.h"
 
 #include <assert.h>
+#include <LCEVC/common/acceleration.h>
 #include <LCEVC/common/check.h>
 #include <LCEVC/common/limit.h>
 #include <LCEVC/common/log.h>
@@ -27,24 +28,6 @@
 
 /*- General utility functions -------------------------------------------------------------------*/
 
-static inline uint8_t clz(uint32_t streamData, uint8_t numBits)
-{
-#if VN_COMPILER(MSVC)
-    return (uint8_t)(_lzcnt_u32(streamData) + numBits - 32);
-#elif VN_COMPILER(GCC) && (__GNUC__ >= 14)
-    /* Annoyingly, it's undefined behaviour if you provide 0 to __builtin_clz. To match the Windows
-     * behaviour (where 0 is just another leading zero), we need clzg, with sizeof(streamData) as
-     * the default arg. */
-    return (uint8_t)(__builtin_clzg(streamData, (int)(sizeof(streamData) * 8)) + numBits - 32);
-#else
-    /* clzg is only available in GCC version 14 or later. Outside that, we just do it manually. */
-    if (streamData == 0) {
-        return numBits;
-    }
-    return (uint8_t)(__builtin_clz(streamData) + numBits - 32);
-#endif
-}
-
 static int8_t bitWidth(uint8_t x, uint8_t bitstreamVersion)
 {
     /* Lengths are ceil(log2(length + 1)), as per 9.2.1 of the standard. This table is indexed by
@@ -80,25 +63,6 @@ static int8_t bitWidth(uint8_t x, uint8_t bitstreamVersion)
     return kTable[table][x];
 }
 
-static void generateCodesAndIndices(HuffmanListEntry entriesInOut[VN_MAX_NUM_SYMBOLS],
-                                    uint16_t idxOfEachBitSize[VN_MAX_CODE_LENGTH], int16_t maxIdx,
-                                    uint8_t maxCodeLength)
-{
-    uint8_t currLength = maxCodeLength;
-    uint8_t currCode = 0;
-
-    idxOfEachBitSize[currLength] = maxIdx;
-
-    for (int16_t idx = maxIdx - 1; idx > -1; idx--) {
-        if (entriesInOut[idx].bits < currLength) {
-            currCode >>= (currLength - entriesInOut[idx].bits);
-            currLength = entriesInOut[idx].bits;
-            idxOfEachBitSize[currLength] = idx + 1;
-        }
-        entriesInOut[idx].code = currCode++;
-    }
-}
-
 /* Generate codes, without setting the idxOfEachBitSize array. This is because the final LSB list
  * will be quite different from the one created here. */
 static void generateCodes(HuffmanListEntry entriesInOut[VN_MAX_NUM_SYMBOLS], int16_t maxIdx,
@@ -120,13 +84,13 @@ static void generateCodes(HuffmanListEntry entriesInOut[VN_MAX_NUM_SYMBOLS], int
  * for the run-length huffman stream, but in principle it could be used for the temporal layer too
  * (although attempts at this have sometimes worsened performance: it seems that the existing
  * tableAssign may actually be faster, but would be awkward to change its interface). */
-static uint8_t generateCodesAndLut(HuffmanListEntry entriesIn[VN_MAX_NUM_SYMBOLS],
-                                   HuffmanTable* tableOut, uint8_t maxIdx, uint8_t maxCodeLength)
+static uint16_t generateCodesAndLut(HuffmanListEntry entriesIn[VN_MAX_NUM_SYMBOLS],
+                                    HuffmanTable* tableOut, uint16_t maxIdx, uint8_t maxCodeLength)
 {
     memset(tableOut->code, 0, sizeof(tableOut->code));
     uint8_t currLength = maxCodeLength;
     uint8_t currCode = 0;
-    uint8_t minOversizedCodeIdx = maxIdx;
+    uint16_t minOversizedCodeIdx = maxIdx;
 
     /* This list is sorted from large to small, so start by assigning list entries for codes which
      * are too long for the look-up table */
@@ -141,7 +105,7 @@ static uint8_t generateCodesAndLut(HuffmanListEntry entriesIn[VN_MAX_NUM_SYMBOLS
 
         if (entry->bits > VN_SMALL_TABLE_MAX_SIZE) {
             entry->code = currCode;
-            minOversizedCodeIdx = (uint8_t)idx;
+            minOversizedCodeIdx = (uint16_t)idx;
         } else {
             uint16_t tableIdx = currCode << (VN_SMALL_TABLE_MAX_SIZE - entry->bits);
             const uint16_t tableIdxEnd = tableIdx + (1 << (VN_SMALL_TABLE_MAX_SIZE - entry->bits));
@@ -159,7 +123,7 @@ static uint8_t generateCodesAndLut(HuffmanListEntry entriesIn[VN_MAX_NUM_SYMBOLS
 static void determineIdxOfEachBitSize(HuffmanList* listInOut)
 {
     uint8_t bitSize = listInOut->list[0].bits;
-    for (uint8_t idx = 0; idx < listInOut->size; idx++) {
+    for (uint16_t idx = 0; idx < listInOut->size; idx++) {
         if (listInOut->list[idx].bits > bitSize) {
             listInOut->idxOfEachBitSize[bitSize] = idx;
             bitSize = listInOut->list[idx].bits;
@@ -180,14 +144,6 @@ static int listEntrySizeOrder(const void* left, const void* right)
     return (int)rightEntry->symbol - leftEntry->symbol;
 }
 
-/* Utility functions for HuffmanTriple's contents memvar */
-static inline uint8_t getBits(uint8_t contents) { return contents >> 3; }
-static inline bool lsbOverflowed(uint8_t contents) { return (getBits(contents) == 0); }
-static inline bool isIncomplete(uint8_t contents)
-{
-    return lsbOverflowed(contents) || (contents & 0B00000011);
-}
-
 /*- Initialisation functions --------------------------------------------------------------------*/
 
 /* \brief  Initialize a HuffmanManualDecodeState
@@ -379,12 +335,103 @@ static uint16_t huffmanIterateRls(HuffmanTripleTable* huffmanTableOut, const Huf
     return minU16(parentStartIdx, lowestValidlySetIdx);
 }
 
+static void huffmanFillTriples(HuffmanTripleTable* huffmanTableOut, uint16_t startIdx,
+                               uint16_t endIdx, uint8_t lsbSymbol, uint16_t rlSymbol,
+                               uint8_t contents)
+{
+    for (uint16_t idx = startIdx; idx < endIdx; idx++) {
+        huffmanTableOut->code[idx].lsb = lsbSymbol;
+        huffmanTableOut->code[idx].rl = rlSymbol;
+        huffmanTableOut->code[idx].contents = contents;
+    }
+}
+
+/* Assign codes for an MSB (that follows an LSB) in the triple-table, along with the run-length
+ * that follows it, if any. The MSB goes in the top half of rl. The run-length is limited to 1 code
+ * (a longer run-length is vanishingly rare after an MSB), so a run-length which is followed by
+ * another is stored as an rl overflow, with the first part of the run already in rl. */
+static void huffmanAssignMsb(HuffmanTripleTable* huffmanTableOut, const HuffmanTable* rlTable,
+                             uint16_t parentStartIdx, uint16_t parentEndIdx, uint8_t lsbSymbol,
+                             uint8_t msbSymbol, uint8_t codeSizeInStream)
+{
+    const uint16_t msbRl = (uint16_t)((msbSymbol & 0x7f) << 7);
+    if (!nextSymbolIsRL(msbSymbol)) {
+        huffmanFillTriples(huffmanTableOut, parentStartIdx, parentEndIdx, lsbSymbol, msbRl,
+                           codeSizeInStream << 3);
+        return;
+    }
+
+    /* Default to the run-length overflowing, then overwrite the indices where one fits. */
+    huffmanFillTriples(huffmanTableOut, parentStartIdx, parentEndIdx, lsbSymbol, msbRl,
+                       (codeSizeInStream << 3) | 0x01);
+
+    const uint8_t codeSizeInTable =
+        codeSizeInStream - (parentStartIdx >> VN_BIG_TABLE_MAX_CODE_SIZE);
+    const uint8_t bitsLeft = VN_BIG_TABLE_MAX_CODE_SIZE - codeSizeInTable;
+    uint8_t rlBits = 0;
+    for (int16_t rlIdx = (1 << VN_SMALL_TABLE_MAX_SIZE) - 1; rlIdx >= 0;
+         rlIdx -= (1 << (VN_SMALL_TABLE_MAX_SIZE - rlBits))) {
+        const HuffmanEntry* rlEntry = &rlTable->code[rlIdx];
+        rlBits = rlEntry->bits;
+        if (rlBits == 0 || rlBits > bitsLeft) {
+            break;
+        }
+        const uint16_t rlCode = rlIdx >> (VN_SMALL_TABLE_MAX_SIZE - rlBits);
+        const uint8_t bitsLeftByRl = bitsLeft - rlBits;
+        const uint16_t startIdx = parentStartIdx | (rlCode << bitsLeftByRl);
+        const uint8_t contents = ((codeSizeInStream + rlBits) << 3) |
+                                 (nextSymbolIsRL(rlEntry->symbol) ? 0x01 : 0x00);
+        huffmanFillTriples(huffmanTableOut, startIdx, startIdx + (1 << bitsLeftByRl), lsbSymbol,
+                           msbRl | (rlEntry->symbol & 0x7f), contents);
+    }
+}
+
+/* Assign codes for an LSB which is followed by an MSB, in the triple-table. MSBs are taken from
+ * the MSB LUT, from shortest to longest, until they no longer fit. Indices where no MSB fits are
+ * MSB overflows, which fall back to the MSB LUT (or the manual decoder) at decode time. */
+static void huffmanIterateMsbs(HuffmanTripleTable* huffmanTableOut,
+                               const HuffmanTripleDecodeState* huffmanState,
+                               uint16_t parentStartIdx, uint16_t parentEndIdx, uint8_t lsbSymbol,
+                               uint8_t codeSizeInStream)
+{
+    uint8_t msbSymbol = 0;
+    if (huffmanGetSingleSymbol(&huffmanState->manualStates[HuffMSB], &msbSymbol)) {
+        /* A single-symbol MSB takes up no bits at all, so it always fits. */
+        huffmanAssignMsb(huffmanTableOut, &huffmanState->rlTable, parentStartIdx, parentEndIdx,
+                         lsbSymbol, msbSymbol, codeSizeInStream);
+        return;
+    }
+
+    huffmanFillTriples(huffmanTableOut, parentStartIdx, parentEndIdx, lsbSymbol, 0,
+                       (codeSizeInStream << 3) | 0x02);
+
+    const uint8_t codeSizeInTable =
+        codeSizeInStream - (parentStartIdx >> VN_BIG_TABLE_MAX_CODE_SIZE);
+    const uint8_t bitsLeft = VN_BIG_TABLE_MAX_CODE_SIZE - codeSizeInTable;
+    const HuffmanTable* msbTable = &huffmanState->msbTable;
+    uint8_t msbBits = 0;
+    for (int16_t msbIdx = (1 << VN_SMALL_TABLE_MAX_SIZE) - 1; msbIdx >= 0;
+         msbIdx -= (1 << (VN_SMALL_TABLE_MAX_SIZE - msbBits))) {
+        const HuffmanEntry* msbEntry = &msbTable->code[msbIdx];
+        msbBits = msbEntry->bits;
+        if (msbBits == 0 || msbBits > bitsLeft) {
+            break;
+        }
+        const uint16_t msbCode = msbIdx >> (VN_SMALL_TABLE_MAX_SIZE - msbBits);
+        const uint8_t bitsLeftByMsb = bitsLeft - msbBits;
+        const uint16_t startIdx = parentStartIdx | (msbCode << bitsLeftByMsb);
+        huffmanAssignMsb(huffmanTableOut, &huffmanState->rlTable, startIdx,
+                         startIdx + (1 << bitsLeftByMsb), lsbSymbol, msbEntry->symbol,
+                         codeSizeInStream + msbBits);
+    }
+}
+
 static void huffmanTripleTableAssign(HuffmanTripleTable* huffmanTableOut,
                                      HuffmanTripleDecodeState* huffmanState, const HuffmanList* fullLsbListIn,
                                      const HuffmanTable* rlTable, const HuffmanList* rlList)
 {
     HuffmanList* overflowLsbListOut = &huffmanState->manualStates[HuffLSB].list;
-    uint8_t lsbIdx = 0;
+    uint16_t lsbIdx = 0;
     for (; lsbIdx < fullLsbListIn->size; lsbIdx++) {
         const HuffmanListEntry* lsbEntry = &fullLsbListIn->list[lsbIdx];
         uint8_t leadingZeroes = clz(lsbEntry->code, lsbEntry->bits);
@@ -398,10 +445,8 @@ static void huffmanTripleTableAssign(HuffmanTripleTable* huffmanTableOut,
         startIdx |= (leadingZeroes << VN_BIG_TABLE_MAX_CODE_SIZE);
         const uint16_t endIdx = startIdx + (1 << bitsLeftByLsb);
         if (nextSymbolIsMSB(lsbEntry->symbol)) {
-            for (uint16_t outIdx = startIdx; outIdx < endIdx; outIdx++) {
-                huffmanTableOut->code[outIdx].lsb = lsbEntry->symbol;
-                huffmanTableOut->code[outIdx].contents = (lsbEntry->bits << 3) | 0x02;
-            }
+            huffmanIterateMsbs(huffmanTableOut, huffmanState, startIdx, endIdx, lsbEntry->symbol,
+                               lsbEntry->bits);
             continue;
         }
 
@@ -420,7 +465,7 @@ static void huffmanTripleTableAssign(HuffmanTripleTable* huffmanTableOut,
     /* These are all the entries where the LSB is too long to fit in a LUT entry. Some may be
      * shorter than expected, if the max num of leading zeroes is low enough. */
     if (fullLsbListIn->size > lsbIdx) {
-        const uint8_t additionalEntries = (fullLsbListIn->size - lsbIdx);
+        const uint16_t additionalEntries = (fullLsbListIn->size - lsbIdx);
         const uint16_t curSize = overflowLsbListOut->size;
         memcpy(overflowLsbListOut->list + curSize, (fullLsbListIn->list + lsbIdx),
                additionalEntries * sizeof(HuffmanListEntry));
@@ -453,16 +498,8 @@ bool huffmanTripleInitialize(HuffmanTripleDecodeState* state, HuffmanStream* str
     generateCodes(lsbList.list, lsbList.size, state->manualStates[HuffLSB].maxCodeLength);
 
     /* MSB */
-    res = huffmanManualInitializeCommon(&state->manualStates[HuffMSB], stream, bitstreamVersion,
-                                        state->manualStates[HuffMSB].list.list);
-    if (res < 0) {
-        VNLogError("Failed to initialize huffman state");
-        return false;
-    }
-    state->manualStates[HuffMSB].list.size = res;
-    generateCodesAndIndices(
-        state->manualStates[HuffMSB].list.list, state->manualStates[HuffMSB].list.idxOfEachBitSize,
-        state->manualStates[HuffMSB].list.size, state->manualStates[HuffMSB].maxCodeLength);
+    huffmanManualInitializeWithLut(&state->manualStates[HuffMSB], &state->msbTable, stream,
+                                   bitstreamVersion);
 
     /* RL */
     huffmanManualInitializeWithLut(&state->manualStates[HuffRL], &state->rlTable, stream, bitstreamVersion);
@@ -501,12 +538,13 @@ void huffmanManualInitializeWithLut(HuffmanManualDecodeState* state, HuffmanTabl
     HuffmanListEntry codes[VN_MAX_NUM_SYMBOLS];
     const int16_t size = huffmanManualInitializeCommon(state, stream, bitstreamVersion, codes);
     if (size <= 0) {
-        // Early exit if there's no work to do
+        // Early exit if there's no work to do, other than making sure that the LUT is empty
+        memset(table->code, 0, sizeof(table->code));
         return;
     }
 
-    const uint8_t minIdxOfOversizedCodes =
-        generateCodesAndLut(codes, table, (uint8_t)size, state->maxCodeLength);
+    const uint16_t minIdxOfOversizedCodes =
+        generateCodesAndLut(codes, table, (uint16_t)size, state->maxCodeLength);
 
     state->list.size = size - minIdxOfOversizedCodes;
     if (state->list.size > 0) {
@@ -569,8 +607,8 @@ bool huffmanManualDecode(const HuffmanManualDecodeState* state, HuffmanStream* s
     return false;
 }
 
-static bool huffmanManualDecodeMaybeSingleSymbol(const HuffmanManualDecodeState* state,
-                                                 HuffmanStream* stream, uint8_t* symbolOut)
+bool huffmanManualDecodeMaybeSingleSymbol(const HuffmanManualDecodeState* state,
+                                          HuffmanStream* stream, uint8_t* symbolOut)
 {
     /* This function allows us to do the LUT check FIRST, for huffman types which are usually in
      * the LUT, and rarely (but sometimes) single-symbol. */
@@ -609,99 +647,20 @@ bool huffmanLutDecode(const HuffmanTable* rlTable, HuffmanStream* stream, uint8_
 
 /*- HuffmanTripleDecodeState --------------------------------------------------------------------*/
 
-int32_t huffmanTripleDecode(const HuffmanTripleDecodeState* state, HuffmanStream* stream, int16_t* valueOut)
-{
-    assert(state && stream && (stream->wordStartBit <= stream->wordEndBit) &&
-           (stream->wordStartBit + VN_BIG_TABLE_CODE_SIZE_TO_READ >= stream->wordEndBit));
-
-    /* Top up our HuffmanStream_t until we have VN_BIG_TABLE_CODE_SIZE_TO_READ bits of data,
-     * and then grab those bits of data. Later, we'll find out how much of it, if any, is useful.*/
-    huffmanStreamAdvanceByNBits(stream, VN_BIG_TABLE_CODE_SIZE_TO_READ -
-                                            (stream->wordEndBit - stream->wordStartBit));
-    const uint32_t code = extractBits(stream->word, stream->wordStartBit, stream->wordEndBit);
-
-    /* We now have a number, of size VN_BIG_TABLE_CODE_SIZE_TO_READ. Count the number of leading
-     * zeroes in this number. This count will form the first few bits of our lutIdx. We have to
-     * take the min because 0 is a valid code (always the longest one), and because there's a limit
-     * to the number of bits we can fit at the front of lutIdx.*/
-    uint8_t lsbLeadingZeros = clz((int32_t)code, VN_BIG_TABLE_CODE_SIZE_TO_READ);
-    lsbLeadingZeros = minU8(lsbLeadingZeros, state->manualStates[HuffLSB].maxCodeLength);
-    lsbLeadingZeros = minU8(lsbLeadingZeros, VN_BIG_TABLE_MAX_NUM_LEADING_ZEROES);
-
-    /* Now assemble the lutIdx by replacing the leading zeroes in `code` with the actual count of
-     * leading zeros (lsbLzs).*/
-    const uint8_t plausiblyUsefulBits = (VN_BIG_TABLE_MAX_CODE_SIZE + lsbLeadingZeros);
-    uint16_t lutIdx = (uint16_t)(code >> (VN_BIG_TABLE_CODE_SIZE_TO_READ - plausiblyUsefulBits));
-    assert(lutIdx <= VN_BIG_HUFFMAN_CODE_MASK);
-    lutIdx |= (lsbLeadingZeros << VN_BIG_TABLE_MAX_CODE_SIZE);
-
-    /* Seek symbols in huffman table.*/
-    const HuffmanTripleTable* table = &state->tripleTable;
-    HuffmanTriple triplet = table->code[lutIdx];
-    uint8_t bits = getBits(triplet.contents);
-    stream->wordStartBit += bits;
-    assert(stream->wordStartBit <= 32);
-
-    /* Quickly dismiss the fast case: */
-    if (!isIncomplete(triplet.contents)) {
-        *valueOut = ((int16_t)(triplet.lsb & 0x7e) - 0x40) >> 1;
-        return triplet.rl;
-    }
-
-    /* Seek run lengths if:
-     * (1) the lsb overflowed, and either
-     *      (a) is followed by an RL, or
-     *      (b) is followed by and MSB, and THAT is followed by an RL
-     * or
-     * (2) the msb overflowed, and it's followed by an RL,
-     * or
-     * (3) the rl itself overflowed (which is always true if the other true aren't, since this
-     *     block of code is only reachable when SOME part overflowed).
-     */
-    bool seekRunLengths = true;
+#define huffmanTripleDecodeTemplate huffmanTripleDecode
+#include "huffman_triple_decode.h"
 
-    /* LSB */
-    if (lsbOverflowed(triplet.contents)) {
-        if (!huffmanManualDecodeMaybeSingleSymbol(&state->manualStates[HuffLSB], stream, (uint8_t*)valueOut)) {
-            return -1;
-        }
-        seekRunLengths = nextSymbolIsRL((uint8_t)*valueOut);
-    } else {
-        *valueOut = triplet.lsb;
-    }
+HuffmanTripleDecodeFunction huffmanTripleGetDecodeFunctionBMI2(void);
 
-    /* MSB */
-    if (nextSymbolIsMSB((uint8_t)*valueOut)) {
-        uint8_t msb = 0;
-        if (!huffmanManualDecodeMaybeSingleSymbol(&state->manualStates[HuffMSB], stream, &msb)) {
-            return -1;
-        }
-        seekRunLengths = nextSymbolIsRL(msb);
-
-        *valueOut = (int16_t)(*valueOut & 0xfe);
-
-        int32_t exp = (msb & 0x7f) << 8 | *valueOut;
-        *valueOut = (int16_t)(exp - 0x4000);
-    } else {
-        *valueOut = (int16_t)((*valueOut & 0x7e) - 0x40);
-    }
-    *valueOut >>= 1;
+HuffmanTripleDecodeFunction huffmanTripleGetDecodeFunction(void)
+{
+    HuffmanTripleDecodeFunction res = NULL;
 
-    /* RL */
-    int32_t zeros = triplet.rl;
-    const HuffmanManualDecodeState* rlState = &state->manualStates[HuffRL];
-    uint8_t rlDetectionSymbol = 0;
-    while (seekRunLengths) {
-        if (!huffmanLutDecode(&state->rlTable, stream, &rlDetectionSymbol)) {
-            if (!huffmanManualDecodeMaybeSingleSymbol(rlState, stream, &rlDetectionSymbol)) {
-                return -1;
-            }
-        }
-        zeros = (zeros << 7) | (rlDetectionSymbol & 0x7f);
-        seekRunLengths = nextSymbolIsRL(rlDetectionSymbol);
+    if (ldcAccelerationGetKernel(LdcKernelEntropy)->BMI2) {
+        res = huffmanTripleGetDecodeFunctionBMI2();
     }
 
-    return zeros;
+    return res ? res : &huffmanTripleDecode;
 }
 
 /*------------------------------------------------------------------------------*/
@@ -17,6 +17,12 @@
 
 #include "bitstream.h"
 
+#include <LCEVC/build_config.h>
+
+#if VN_CORE_FEATURE(BMI2)
+#include <immintrin.h>
+#endif
+
 /* These must add up to VN_BIG_TABLE_MAX_SIZE*/
 #define VN_BIG_TABLE_LEADING_ZEROES_BITS 4
 #define VN_BIG_TABLE_MAX_CODE_SIZE 8
@@ -117,13 +123,15 @@ typedef struct HuffmanTable
  *  any number of subsequent run-lengths (up to 4 are possible). However, such sequences (3 or 4
  *  run-lengths, with a total code length less than 12) are vanishingly rare. Meanwhile,
  *  accommodating them imposes costs.
+ *  If the lsb is followed by an msb which fits in the table (i.e. msbOverflowed is clear), then rl
+ *  holds { uint7_t msb, uint7_t runLength }, where the run-length is derived from 0 or 1 codes. So,
+ *  a whole coefficient and its run-length, which may be 3 codes in the stream, is one look-up.
  * contents works like this:
  * { uint5_t bitsTotal, [blank x 1], bool msbOverflowed, bool rlOverflowed}
  *  - bitsTotal is a number from 1 to 31 (or 0 for invalid) indicating the combined number of bits
  *    taken up (in the stream) by the codes for all parts of the HuffmanTriplet which are present
- *  - the overflows tell us which symbol (if any) was unable to fit on this triple. Note that we
- *    never store the msb in this table, so even a 1bit msb code is "overflow". Note also that we
- *    don't need an "lsbOverflowed" bit: this is indicated by having 0 bitsTotal.
+ *  - the overflows tell us which symbol (if any) was unable to fit on this triple. Note also that
+ *    we don't need an "lsbOverflowed" bit: this is indicated by having 0 bitsTotal.
  */
 typedef struct HuffmanTriple
 {
@@ -137,6 +145,15 @@ typedef struct HuffmanTripleTable
     HuffmanTriple code[1 << VN_BIG_TABLE_MAX_SIZE];
 } HuffmanTripleTable;
 
+/* Utility functions for HuffmanTriple's contents memvar */
+static inline uint8_t getBits(uint8_t contents) { return contents >> 3; }
+static inline bool lsbOverflowed(uint8_t contents) { return (getBits(contents) == 0); }
+static inline bool msbOverflowed(uint8_t contents) { return (contents & 0B00000010); }
+static inline bool isIncomplete(uint8_t contents)
+{
+    return lsbOverflowed(contents) || (contents & 0B00000011);
+}
+
 /*! \brief Huffman "manual" decoder state. This is used when look-up tables are insufficient. */
 typedef struct HuffmanManualDecodeState
 {
@@ -150,6 +167,7 @@ typedef struct HuffmanManualDecodeState
 typedef struct HuffmanTripleDecodeState
 {
     HuffmanTripleTable tripleTable;                   /**< TripleTable, for short triplets */
+    HuffmanTable msbTable;                            /**< Fallback lookup-table for MSBs */
     HuffmanTable rlTable;                             /**< Fallback lookup-table for Run-lengths */
     HuffmanManualDecodeState manualStates[HuffCount]; /**< Individual decoders, as a double-fallback */
 } HuffmanTripleDecodeState;
@@ -170,7 +188,11 @@ bool huffmanTripleInitialize(HuffmanTripleDecodeState* state, HuffmanStream* str
  *  \param valueOut Output coefficient (lsb, possibly with msb)
  *
  *  \return run-length, or -1 for error */
-int32_t huffmanTripleDecode(const HuffmanTripleDecodeState* state, HuffmanStream* stream, int16_t* valueOut);
+typedef int32_t (*HuffmanTripleDecodeFunction)(const HuffmanTripleDecodeState* state,
+                                               HuffmanStream* stream, int16_t* valueOut);
+
+/*! \brief Get the triple-decode function to use, i.e. the BMI2 one if the CPU supports it. */
+HuffmanTripleDecodeFunction huffmanTripleGetDecodeFunction(void);
 
 /*------------------------------------------------------------------------------*/
 
@@ -201,8 +223,31 @@ static inline size_t huffmanStreamGetRemainingBits(const HuffmanStream* stream)
  */
 static inline uint32_t extractBits(uint32_t data, uint8_t startBit, uint8_t endBit)
 {
+#if VN_CORE_FEATURE(BMI2)
+    return _bzhi_u32(data >> (32 - endBit), endBit - startBit);
+#else
     const uint32_t mask = (1 << (endBit - startBit)) - 1;
     return (data >> (32 - endBit)) & mask;
+#endif
+}
+
+/*! \brief Count the leading zeroes of a number which is numBits wide. */
+static inline uint8_t clz(uint32_t streamData, uint8_t numBits)
+{
+#if VN_COMPILER(MSVC)
+    return (uint8_t)(_lzcnt_u32(streamData) + numBits - 32);
+#elif VN_COMPILER(GCC) && (__GNUC__ >= 14)
+    /* Annoyingly, it's undefined behaviour if you provide 0 to __builtin_clz. To match the Windows
+     * behaviour (where 0 is just another leading zero), we need clzg, with sizeof(streamData) as
+     * the default arg. */
+    return (uint8_t)(__builtin_clzg(streamData, (int)(sizeof(streamData) * 8)) + numBits - 32);
+#else
+    /* clzg is only available in GCC version 14 or later. Outside that, we just do it manually. */
+    if (streamData == 0) {
+        return numBits;
+    }
+    return (uint8_t)(__builtin_clz(streamData) + numBits - 32);
+#endif
 }
 
 /*! \brief Advance the Huffman stream BY a certain number of bits. Can be used directly, if you
@@ -324,6 +369,17 @@ bool huffmanLutDecode(const HuffmanTable* rlTable, HuffmanStream* stream, uint8_
  *  \return True on success, otherwise false. */
 bool huffmanManualDecode(const HuffmanManualDecodeState* state, HuffmanStream* stream, uint8_t* symbolOut);
 
+/*! \brief Decode the next huffman symbol using a manual-decoder, unless it's a single-symbol
+ *         decoder, in which case that symbol is decoded without reading the stream.
+ *
+ *  \param state     Manual-decoder to use.
+ *  \param stream    HuffmanStream to decode from
+ *  \param symbolOut Decoded symbol
+ *
+ *  \return True on success, otherwise false. */
+bool huffmanManualDecodeMaybeSingleSymbol(const HuffmanManualDecodeState* state,
+                                          HuffmanStream* stream, uint8_t* symbolOut);
+
 /*! \brief Get the single-symbol associated with the manual-decoder, if it's a single-symbol decoder.
  *
  *  \param state     Manual-decoder to use.
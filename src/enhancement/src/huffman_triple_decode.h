@@ -0,0 +1,150 @@
+/* Copyright (c) V-Nova International Limited 2022-2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#ifndef VN_LCEVC_ENHANCEMENT_HUFFMAN_TRIPLE_DECODE_H
+#define VN_LCEVC_ENHANCEMENT_HUFFMAN_TRIPLE_DECODE_H
+
+/* The triple-decode function, shared by the portable and BMI2 implementations: the BMI2 one is the
+ * same code, compiled so that bit-extraction and variable shifts are single instructions. Before
+ * including this file, the implementation must define:
+ *
+ *    huffmanTripleDecodeTemplate  Name of the triple-decode function.
+ */
+
+#include "huffman.h"
+
+#include <assert.h>
+#include <LCEVC/common/limit.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------*/
+
+static inline int16_t coefficientFromLsbAndMsb(uint8_t lsb, uint8_t msb)
+{
+    const int32_t exp = (msb & 0x7f) << 8 | (lsb & 0xfe);
+    return (int16_t)((int16_t)(exp - 0x4000) >> 1);
+}
+
+static inline int16_t coefficientFromLsb(uint8_t lsb)
+{
+    return (int16_t)(((int16_t)(lsb & 0x7e) - 0x40) >> 1);
+}
+
+static int32_t huffmanTripleDecodeTemplate(const HuffmanTripleDecodeState* state,
+                                           HuffmanStream* stream, int16_t* valueOut)
+{
+    assert(state && stream && (stream->wordStartBit <= stream->wordEndBit) &&
+           (stream->wordStartBit + VN_BIG_TABLE_CODE_SIZE_TO_READ >= stream->wordEndBit));
+
+    /* Top up our HuffmanStream_t until we have VN_BIG_TABLE_CODE_SIZE_TO_READ bits of data,
+     * and then grab those bits of data. Later, we'll find out how much of it, if any, is useful.*/
+    huffmanStreamAdvanceByNBits(stream, VN_BIG_TABLE_CODE_SIZE_TO_READ -
+                                            (stream->wordEndBit - stream->wordStartBit));
+    const uint32_t code = extractBits(stream->word, stream->wordStartBit, stream->wordEndBit);
+
+    /* We now have a number, of size VN_BIG_TABLE_CODE_SIZE_TO_READ. Count the number of leading
+     * zeroes in this number. This count will form the first few bits of our lutIdx. We have to
+     * take the min because 0 is a valid code (always the longest one), and because there's a limit
+     * to the number of bits we can fit at the front of lutIdx.*/
+    uint8_t lsbLeadingZeros = clz((int32_t)code, VN_BIG_TABLE_CODE_SIZE_TO_READ);
+    lsbLeadingZeros = minU8(lsbLeadingZeros, state->manualStates[HuffLSB].maxCodeLength);
+    lsbLeadingZeros = minU8(lsbLeadingZeros, VN_BIG_TABLE_MAX_NUM_LEADING_ZEROES);
+
+    /* Now assemble the lutIdx by replacing the leading zeroes in `code` with the actual count of
+     * leading zeros (lsbLzs).*/
+    const uint8_t plausiblyUsefulBits = (VN_BIG_TABLE_MAX_CODE_SIZE + lsbLeadingZeros);
+    uint16_t lutIdx = (uint16_t)(code >> (VN_BIG_TABLE_CODE_SIZE_TO_READ - plausiblyUsefulBits));
+    assert(lutIdx <= VN_BIG_HUFFMAN_CODE_MASK);
+    lutIdx |= (lsbLeadingZeros << VN_BIG_TABLE_MAX_CODE_SIZE);
+
+    /* Seek symbols in huffman table.*/
+    const HuffmanTripleTable* table = &state->tripleTable;
+    HuffmanTriple triplet = table->code[lutIdx];
+    uint8_t bits = getBits(triplet.contents);
+    stream->wordStartBit += bits;
+    assert(stream->wordStartBit <= 32);
+
+    /* Quickly dismiss the fast cases, where the whole coefficient and run-length were in the
+     * table: either an lsb, or an lsb and msb (in which case the msb is at the top of rl). */
+    if (!isIncomplete(triplet.contents)) {
+        if (!nextSymbolIsMSB(triplet.lsb)) {
+            *valueOut = coefficientFromLsb(triplet.lsb);
+            return triplet.rl;
+        }
+        *valueOut = coefficientFromLsbAndMsb(triplet.lsb, (uint8_t)(triplet.rl >> 7));
+        return triplet.rl & 0x7f;
+    }
+
+    /* Seek run lengths if:
+     * (1) the lsb overflowed, and either
+     *      (a) is followed by an RL, or
+     *      (b) is followed by and MSB, and THAT is followed by an RL
+     * or
+     * (2) the msb overflowed, and it's followed by an RL,
+     * or
+     * (3) the rl itself overflowed (which is always true if the other true aren't, since this
+     *     block of code is only reachable when SOME part overflowed).
+     */
+    bool seekRunLengths = true;
+    int32_t zeros = triplet.rl;
+
+    /* LSB */
+    uint8_t lsb = triplet.lsb;
+    if (lsbOverflowed(triplet.contents)) {
+        if (!huffmanManualDecodeMaybeSingleSymbol(&state->manualStates[HuffLSB], stream, &lsb)) {
+            return -1;
+        }
+        seekRunLengths = nextSymbolIsRL(lsb);
+    }
+
+    /* MSB */
+    if (nextSymbolIsMSB(lsb)) {
+        uint8_t msb = 0;
+        if (lsbOverflowed(triplet.contents) || msbOverflowed(triplet.contents)) {
+            const HuffmanManualDecodeState* msbState = &state->manualStates[HuffMSB];
+            if (!huffmanLutDecode(&state->msbTable, stream, &msb) &&
+                !huffmanManualDecodeMaybeSingleSymbol(msbState, stream, &msb)) {
+                return -1;
+            }
+            seekRunLengths = nextSymbolIsRL(msb);
+        } else {
+            /* The msb was in the table, and so was the first part of the run, if any. */
+            msb = (uint8_t)(triplet.rl >> 7);
+            zeros = triplet.rl & 0x7f;
+        }
+        *valueOut = coefficientFromLsbAndMsb(lsb, msb);
+    } else {
+        *valueOut = coefficientFromLsb(lsb);
+    }
+
+    /* RL */
+    const HuffmanManualDecodeState* rlState = &state->manualStates[HuffRL];
+    uint8_t rlDetectionSymbol = 0;
+    while (seekRunLengths) {
+        if (!huffmanLutDecode(&state->rlTable, stream, &rlDetectionSymbol)) {
+            if (!huffmanManualDecodeMaybeSingleSymbol(rlState, stream, &rlDetectionSymbol)) {
+                return -1;
+            }
+        }
+        zeros = (zeros << 7) | (rlDetectionSymbol & 0x7f);
+        seekRunLengths = nextSymbolIsRL(rlDetectionSymbol);
+    }
+
+    return zeros;
+}
+
+/*------------------------------------------------------------------------------*/
+
+#endif // VN_LCEVC_ENHANCEMENT_HUFFMAN_TRIPLE_DECODE_H
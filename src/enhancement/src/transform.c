@@ -671,8 +671,9 @@ TransformFunction transformGetFunction(LdeTransformType transform, LdeScalingMod
     TransformFunction res = NULL;
 
     const int32_t scalingIndex = (scaling == Scale1D) ? 1 : 0;
+    const LdcAccelerationFeatures* acceleration = ldcAccelerationGetKernel(LdcKernelTransform);
 
-    if (!forceScalar && (ldcAccelerationGet()->SSE || ldcAccelerationGet()->NEON)) {
+    if (!forceScalar && (acceleration->SSE || acceleration->NEON)) {
         res = kTableSIMD[transform][scalingIndex];
     }
 
@@ -711,8 +712,9 @@ DequantTransformFunction dequantTransformGetFunction(LdeTransformType transform,
 {
     const int32_t scalingIndex = (scaling == Scale1D) ? 1 : 0;
     DequantTransformFunction res = NULL;
+    const LdcAccelerationFeatures* acceleration = ldcAccelerationGetKernel(LdcKernelTransform);
 
-    if (!forceScalar && (ldcAccelerationGet()->SSE || ldcAccelerationGet()->NEON)) {
+    if (!forceScalar && (acceleration->SSE || acceleration->NEON)) {
         res = kDequantTableSIMD[transform][scalingIndex];
     }
 
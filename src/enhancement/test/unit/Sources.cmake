@@ -18,6 +18,7 @@ set(SOURCES
     "src/test_cmdbuffer_gpu.cpp"
     "src/test_config_pool.cpp"
     "src/test_decode.cpp"
+    "src/test_entropy.cpp"
     "src/test_config_parser.cpp"
     "src/test_transform.cpp"
     "src/test_transform_unit.cpp")
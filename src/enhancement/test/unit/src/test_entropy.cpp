@@ -0,0 +1,339 @@
+/* Copyright (c) V-Nova International Limited 2023-2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Round-trips coefficients and zero-runs through a minimal Huffman encoder and the entropy decoder,
+// to check that every path through the triple-table (and its fallbacks) decodes the same.
+
+#include <gtest/gtest.h>
+#include <LCEVC/common/acceleration.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+extern "C"
+{
+#include "entropy.h"
+}
+
+// -----------------------------------------------------------------------------
+
+enum class Distribution
+{
+    Sparse,       // Small coefficients, long runs.
+    Dense,        // Frequent MSBs, short runs, like a high bitrate LOQ0 layer.
+    Wide,         // Every LSB and MSB, so codes are long.
+    Skewed,       // Geometric, so some codes are very long.
+    SingleMsb,    // A single-symbol MSB table.
+    ShortMsbRuns, // Short LSB, MSB and multi-part RL codes.
+};
+
+namespace {
+
+struct Coefficient
+{
+    int16_t value;
+    int32_t zeros;
+};
+
+class BitWriter
+{
+public:
+    void write(uint32_t value, uint32_t numBits)
+    {
+        for (uint32_t bit = numBits; bit > 0; --bit) {
+            if ((m_numBits & 7) == 0) {
+                m_data.push_back(0);
+            }
+            if ((value >> (bit - 1)) & 1) {
+                m_data.back() |= static_cast<uint8_t>(0x80 >> (m_numBits & 7));
+            }
+            m_numBits++;
+        }
+    }
+
+    const std::vector<uint8_t>& data() const { return m_data; }
+
+private:
+    std::vector<uint8_t> m_data;
+    uint64_t m_numBits = 0;
+};
+
+struct Code
+{
+    uint8_t bits = 0;
+    uint32_t code = 0;
+};
+
+using Frequencies = std::vector<uint64_t>;
+
+// Huffman code lengths, by repeatedly merging the two least frequent nodes.
+std::vector<uint8_t> codeLengths(const Frequencies& frequencies)
+{
+    std::vector<std::vector<uint16_t>> nodes;
+    std::vector<uint64_t> weights;
+    for (uint16_t symbol = 0; symbol < frequencies.size(); ++symbol) {
+        if (frequencies[symbol] != 0) {
+            nodes.push_back({symbol});
+            weights.push_back(frequencies[symbol]);
+        }
+    }
+
+    std::vector<uint8_t> lengths(frequencies.size(), 0);
+    while (nodes.size() > 1) {
+        for (uint32_t merge = 0; merge < 2; ++merge) {
+            const auto least = std::min_element(weights.begin() + merge, weights.end());
+            std::iter_swap(weights.begin() + merge, least);
+            std::swap(nodes[merge], nodes[least - weights.begin()]);
+        }
+        for (uint32_t merge = 0; merge < 2; ++merge) {
+            for (const uint16_t symbol : nodes[merge]) {
+                lengths[symbol]++;
+            }
+        }
+        nodes[0].insert(nodes[0].end(), nodes[1].begin(), nodes[1].end());
+        weights[0] += weights[1];
+        nodes.erase(nodes.begin() + 1);
+        weights.erase(weights.begin() + 1);
+    }
+    return lengths;
+}
+
+// Write a code table to the stream, and get the canonical codes that the decoder will assign.
+std::vector<Code> writeCodeTable(BitWriter& writer, const Frequencies& frequencies,
+                                 bool presenceBitmap)
+{
+    std::vector<Code> codes(frequencies.size());
+    std::vector<uint16_t> symbols;
+    for (uint16_t symbol = 0; symbol < frequencies.size(); ++symbol) {
+        if (frequencies[symbol] != 0) {
+            symbols.push_back(symbol);
+        }
+    }
+
+    if (symbols.empty()) {
+        writer.write(31, 5);
+        writer.write(31, 5);
+        return codes;
+    }
+    if (symbols.size() == 1) {
+        writer.write(0, 5);
+        writer.write(0, 5);
+        writer.write(symbols[0], 8);
+        return codes;
+    }
+
+    const std::vector<uint8_t> lengths = codeLengths(frequencies);
+    uint8_t minLength = 31;
+    uint8_t maxLength = 0;
+    for (const uint16_t symbol : symbols) {
+        minLength = std::min(minLength, lengths[symbol]);
+        maxLength = std::max(maxLength, lengths[symbol]);
+    }
+    EXPECT_LT(maxLength, 31);
+
+    uint32_t lengthBits = 0;
+    while ((1U << lengthBits) <= static_cast<uint32_t>(maxLength - minLength)) {
+        lengthBits++;
+    }
+
+    writer.write(minLength, 5);
+    writer.write(maxLength, 5);
+    presenceBitmap = presenceBitmap || (symbols.size() > 31);
+    writer.write(presenceBitmap ? 1 : 0, 1);
+    if (presenceBitmap) {
+        for (uint16_t symbol = 0; symbol < frequencies.size(); ++symbol) {
+            writer.write(frequencies[symbol] != 0 ? 1 : 0, 1);
+            if (frequencies[symbol] != 0) {
+                writer.write(lengths[symbol] - minLength, lengthBits);
+            }
+        }
+    } else {
+        writer.write(static_cast<uint32_t>(symbols.size()), 5);
+        for (const uint16_t symbol : symbols) {
+            writer.write(symbol, 8);
+            writer.write(lengths[symbol] - minLength, lengthBits);
+        }
+    }
+
+    // Codes count up from the longest code, with the lowest symbol first.
+    std::sort(symbols.begin(), symbols.end(), [&lengths](uint16_t a, uint16_t b) {
+        return (lengths[a] != lengths[b]) ? (lengths[a] > lengths[b]) : (a < b);
+    });
+    uint8_t currentLength = maxLength;
+    uint32_t currentCode = 0;
+    for (const uint16_t symbol : symbols) {
+        currentCode >>= (currentLength - lengths[symbol]);
+        currentLength = lengths[symbol];
+        codes[symbol] = {currentLength, currentCode++};
+    }
+    return codes;
+}
+
+// The LSB, MSB and RL symbols for a coefficient and its zero-run.
+void coefficientSymbols(const Coefficient& coefficient, std::vector<uint8_t> symbols[HuffCount])
+{
+    const uint8_t runFlag = (coefficient.zeros > 0) ? 0x80 : 0x00;
+    if (coefficient.value >= -32 && coefficient.value < 32) {
+        symbols[HuffLSB].push_back(static_cast<uint8_t>(((coefficient.value + 32) << 1) | runFlag));
+    } else {
+        const uint32_t value = static_cast<uint32_t>(coefficient.value * 2 + 0x4000);
+        symbols[HuffLSB].push_back(static_cast<uint8_t>((value & 0xfe) | 0x01));
+        symbols[HuffMSB].push_back(static_cast<uint8_t>(((value >> 8) & 0x7f) | runFlag));
+    }
+
+    uint32_t groups = 0;
+    while ((coefficient.zeros >> (7 * groups)) != 0) {
+        groups++;
+    }
+    for (; groups > 0; --groups) {
+        const uint8_t more = (groups > 1) ? 0x80 : 0x00;
+        symbols[HuffRL].push_back(
+            static_cast<uint8_t>(((coefficient.zeros >> (7 * (groups - 1))) & 0x7f) | more));
+    }
+}
+
+std::vector<uint8_t> encodeLayer(const std::vector<Coefficient>& coefficients, bool presenceBitmap)
+{
+    Frequencies frequencies[HuffCount];
+    for (Frequencies& table : frequencies) {
+        table.assign(256, 0);
+    }
+    std::vector<std::vector<uint8_t>> symbols;
+    for (const Coefficient& coefficient : coefficients) {
+        std::vector<uint8_t> coefficientSyms[HuffCount];
+        coefficientSymbols(coefficient, coefficientSyms);
+        for (uint32_t type = 0; type < HuffCount; ++type) {
+            for (const uint8_t symbol : coefficientSyms[type]) {
+                frequencies[type][symbol]++;
+            }
+            symbols.push_back(coefficientSyms[type]);
+        }
+    }
+
+    BitWriter writer;
+    std::vector<Code> codes[HuffCount];
+    for (uint32_t type = 0; type < HuffCount; ++type) {
+        codes[type] = writeCodeTable(writer, frequencies[type], presenceBitmap);
+    }
+    for (size_t idx = 0; idx < symbols.size(); ++idx) {
+        for (const uint8_t symbol : symbols[idx]) {
+            const Code& code = codes[idx % HuffCount][symbol];
+            writer.write(code.code, code.bits);
+        }
+    }
+
+    // Pad, since the decoder reads ahead.
+    std::vector<uint8_t> data = writer.data();
+    data.resize(data.size() + 8, 0);
+    return data;
+}
+
+std::vector<Coefficient> generate(Distribution distribution, std::mt19937& rng, size_t count)
+{
+    std::vector<Coefficient> coefficients(count);
+    for (Coefficient& coefficient : coefficients) {
+        const uint32_t x = rng();
+        int16_t value = 0;
+        int32_t zeros = 0;
+        switch (distribution) {
+            case Distribution::Sparse:
+                value = static_cast<int16_t>(static_cast<int32_t>(x % 7) - 3);
+                zeros = ((x >> 8) % 4) ? static_cast<int32_t>((x >> 10) % 300) : 0;
+                break;
+            case Distribution::Dense:
+                value = (x & 1) ? static_cast<int16_t>(static_cast<int32_t>((x >> 1) % 400) - 200)
+                                : static_cast<int16_t>(static_cast<int32_t>((x >> 1) % 21) - 10);
+                zeros = ((x >> 12) % 3) ? 0 : static_cast<int32_t>((x >> 14) % 5);
+                break;
+            case Distribution::Wide:
+                value = static_cast<int16_t>(static_cast<int32_t>(x % 16384) - 8192);
+                zeros = static_cast<int32_t>((x >> 14) % 20000);
+                break;
+            case Distribution::Skewed: {
+                int16_t bits = 0;
+                while (((x >> bits) & 1) && bits < 24) {
+                    bits++;
+                }
+                value = static_cast<int16_t>(bits * (((x >> 25) % 3 == 0) ? 37 : 1));
+                value = ((x >> 28) & 1) ? static_cast<int16_t>(-value) : value;
+                zeros = ((x >> 26) & 1) ? (bits * bits * 3) : 0;
+                break;
+            }
+            case Distribution::SingleMsb:
+                value = (x & 3) ? 40 : static_cast<int16_t>(static_cast<int32_t>(x % 11) - 5);
+                zeros = static_cast<int32_t>((x >> 4) % 2);
+                break;
+            case Distribution::ShortMsbRuns:
+                value = (x & 1) ? 100 : -100;
+                zeros = ((x >> 1) & 3) ? 200 : 3;
+                break;
+        }
+        coefficient = {value, zeros};
+    }
+    return coefficients;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+
+class EntropyTest
+    : public testing::TestWithParam<std::tuple<Distribution, LdcAccelerationLevel>>
+{
+public:
+    void SetUp() override
+    {
+        ldcAccelerationInitialize(true);
+        ldcAccelerationSetKernelLevel(LdcKernelEntropy, std::get<1>(GetParam()));
+    }
+
+    void TearDown() override
+    {
+        ldcAccelerationSetKernelLevel(LdcKernelEntropy, LdcAccelerationLevelAuto);
+    }
+};
+
+TEST_P(EntropyTest, RoundTrip)
+{
+    std::mt19937 rng(static_cast<uint32_t>(std::get<0>(GetParam())));
+    std::vector<EntropyDecoder> decoder(1);
+
+    for (uint32_t layer = 0; layer < 8; ++layer) {
+        const std::vector<Coefficient> coefficients =
+            generate(std::get<0>(GetParam()), rng, 100 + rng() % 3000);
+        const std::vector<uint8_t> data = encodeLayer(coefficients, (layer & 1) != 0);
+
+        decoder[0] = {};
+        const LdeChunk chunk = {0, data.size(), data.data(), true};
+        ASSERT_TRUE(entropyInitialize(&decoder[0], &chunk, EDTDefault, BitstreamVersionCurrent));
+
+        for (const Coefficient& expected : coefficients) {
+            int16_t value = 0;
+            const int32_t zeros = entropyDecode(&decoder[0], &value);
+            ASSERT_EQ(value, expected.value);
+            ASSERT_EQ(zeros, expected.zeros);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    EntropyDistributions, EntropyTest,
+    testing::Combine(testing::Values(Distribution::Sparse, Distribution::Dense, Distribution::Wide,
+                                     Distribution::Skewed, Distribution::SingleMsb,
+                                     Distribution::ShortMsbRuns),
+                     testing::Values(LdcAccelerationLevelAuto, LdcAccelerationLevelBaseline)));
+
+// -----------------------------------------------------------------------------
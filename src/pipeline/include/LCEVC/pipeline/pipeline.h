@@ -70,6 +70,10 @@ private:
 //
 // Interface between API and decoder pipelines.
 //
+// Called when a pipeline has finished with enhancement data it did not copy
+//
+using EnhancementDataReleaseFunction = void (*)(const uint8_t* data, uint32_t byteSize, void* userData);
+
 class Pipeline
 {
 protected:
@@ -83,6 +87,12 @@ public:
                                           uint32_t timeoutUs, void* userData) = 0;
     virtual LdcReturnCode sendEnhancementData(uint64_t timestamp, const uint8_t* data,
                                               uint32_t byteSize) = 0;
+    // As sendEnhancementData(), but if successful, the pipeline may reference the data until it
+    // calls the release function. The default implementation copies the data and releases it.
+    virtual LdcReturnCode sendEnhancementDataExternal(uint64_t timestamp, const uint8_t* data,
+                                                      uint32_t byteSize,
+                                                      EnhancementDataReleaseFunction release,
+                                                      void* releaseUserData);
     virtual LdcReturnCode sendOutputPicture(LdpPicture* outputPicture) = 0;
 
     virtual LdpPicture* receiveOutputPicture(LdpDecodeInformation& decodeInfoOut) = 0;
@@ -20,4 +20,16 @@ PipelineBuilder::~PipelineBuilder() = default;
 
 Pipeline::~Pipeline() = default;
 
+LdcReturnCode Pipeline::sendEnhancementDataExternal(uint64_t timestamp, const uint8_t* data,
+                                                    uint32_t byteSize,
+                                                    EnhancementDataReleaseFunction release,
+                                                    void* releaseUserData)
+{
+    const LdcReturnCode ret = sendEnhancementData(timestamp, data, byteSize);
+    if (ret == LdcReturnCodeSuccess) {
+        release(data, byteSize, releaseUserData);
+    }
+    return ret;
+}
+
 } // namespace lcevc_dec::pipeline
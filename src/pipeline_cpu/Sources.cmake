@@ -19,7 +19,8 @@ list(
     "src/picture_cpu.cpp"
     "src/picture_lock_cpu.cpp"
     "src/pipeline_builder_cpu.cpp"
-    "src/pipeline_cpu.cpp")
+    "src/pipeline_cpu.cpp"
+    "src/shared_task_pool.cpp")
 
 list(
     APPEND
@@ -30,7 +31,8 @@ list(
     "src/picture_lock_cpu.h"
     "src/pipeline_builder_cpu.h"
     "src/pipeline_config_cpu.h"
-    "src/pipeline_cpu.h")
+    "src/pipeline_cpu.h"
+    "src/shared_task_pool.h")
 
 list(APPEND INTERFACES "include/LCEVC/pipeline_cpu/create_pipeline.h")
 
@@ -21,6 +21,7 @@
 #include <LCEVC/common/memory.h>
 #include <LCEVC/common/platform.h>
 #include <LCEVC/common/return_code.h>
+#include <LCEVC/common/rolling_arena.h>
 #include <LCEVC/enhancement/bitstream_types.h>
 #include <LCEVC/enhancement/cmdbuffer_cpu.h>
 #include <LCEVC/enhancement/config_parser.h>
@@ -28,6 +29,7 @@
 #include <LCEVC/enhancement/dimensions.h>
 #include <LCEVC/pipeline/buffer.h>
 #include <LCEVC/pipeline/types.h>
+#include <LCEVC/pixel_processing/upscale.h>
 
 #include <algorithm>
 #include <cstdint>
@@ -46,6 +48,7 @@ FrameCPU::FrameCPU(PipelineCPU* pipeline, uint64_t timestamp)
     // Set up the task group
     unsigned maxDependencies = kTaskPoolMaxDependencies;
     ldcTaskGroupInitialize(&m_taskGroup, pipeline->taskPool(), maxDependencies);
+    ldcTaskGroupSetClient(&m_taskGroup, pipeline->taskPoolClient());
 
     // Generate task dependencies for inputs
     m_depBasePicture = ldcTaskDependencyAdd(&m_taskGroup); // NOLINT(cppcoreguidelines-prefer-member-initializer)
@@ -115,7 +118,7 @@ void FrameCPU::release(bool wait)
 
     ldcTaskGroupDestroy(&m_taskGroup);
 
-    VNFree(m_pipeline->allocator(), &m_enhancementData);
+    releaseEnhancementData();
 
     ldeConfigsReleaseFrame(&config);
 
@@ -123,6 +126,36 @@ void FrameCPU::release(bool wait)
     releaseIntermediateBuffers();
 }
 
+const uint8_t* FrameCPU::enhancementData() const
+{
+    return m_externalEnhancementData ? m_externalEnhancementData
+                                     : VNAllocationPtr(m_enhancementData, uint8_t);
+}
+
+uint32_t FrameCPU::enhancementDataSize() const
+{
+    return m_externalEnhancementData
+               ? m_externalEnhancementDataSize
+               : static_cast<uint32_t>(VNAllocationSize(m_enhancementData, uint8_t));
+}
+
+// Drop the enhancement data - any client data is handed back via its release function
+//
+void FrameCPU::releaseEnhancementData()
+{
+    if (m_externalEnhancementData) {
+        m_externalEnhancementDataRelease(m_externalEnhancementData, m_externalEnhancementDataSize,
+                                         m_externalEnhancementDataUserData);
+        m_externalEnhancementData = nullptr;
+        m_externalEnhancementDataSize = 0;
+    }
+
+    if (VNIsAllocated(m_enhancementData)) {
+        VNRollingArenaFree(m_pipeline->frameAllocator(), &m_enhancementData);
+        m_enhancementData = {};
+    }
+}
+
 // Set up command buffers
 //
 bool FrameCPU::initializeCommandBuffers()
@@ -150,12 +183,24 @@ bool FrameCPU::initializeCommandBuffers()
         return true;
     }
 
-    enhancementTiles = VNAllocateArray(m_pipeline->allocator(), &m_enhancementTilesAllocation,
-                                       LdpEnhancementTile, enhancementTileCount);
+    enhancementTiles = VNRollingArenaAllocateArray(m_pipeline->frameAllocator(),
+                                                   &m_enhancementTilesAllocation,
+                                                   LdpEnhancementTile, enhancementTileCount);
     if (!enhancementTiles) {
         return false;
     }
 
+    // Split each command buffer into entry points that can be applied in parallel - by default, one
+    // per thread. A single entry point is the same as no split.
+    uint32_t numEntryPoints = m_pipeline->configuration().cmdBufferEntryPoints;
+    if (numEntryPoints == 0) {
+        numEntryPoints = m_pipeline->configuration().numThreads;
+    }
+    numEntryPoints = std::min(numEntryPoints, static_cast<uint32_t>(CBCKMaxEntryPoints));
+    if (numEntryPoints == 1) {
+        numEntryPoints = 0;
+    }
+
     LdpEnhancementTile* et = enhancementTiles;
 
     // Fill in locations for command buffers
@@ -182,7 +227,8 @@ bool FrameCPU::initializeCommandBuffers()
                 et->planeWidth = planeWidth;
                 et->planeHeight = planeHeight;
 
-                if (!ldeCmdBufferCpuInitialize(m_pipeline->allocator(), &et->buffer, 0)) {
+                if (!ldeCmdBufferCpuInitialize(m_pipeline->frameAllocator(), &et->buffer,
+                                               static_cast<uint16_t>(numEntryPoints))) {
                     return false;
                 }
                 if (!ldeCmdBufferCpuReset(&et->buffer, globalConfig->numLayers)) {
@@ -203,7 +249,7 @@ void FrameCPU::releaseCommandBuffers()
     for (uint32_t i = 0; i < enhancementTileCount; ++i) {
         ldeCmdBufferCpuFree(&enhancementTiles[i].buffer);
     }
-    VNFree(m_pipeline->allocator(), &m_enhancementTilesAllocation);
+    VNRollingArenaFree(m_pipeline->frameAllocator(), &m_enhancementTilesAllocation);
 }
 
 // Set up intermediate buffers
@@ -214,6 +260,9 @@ bool FrameCPU::initializeIntermediateBuffers()
 {
     const LdpColorFormat format = getBaseColorFormat();
 
+    // Buffers are borrowed from the pipeline's pool, which is trimmed if the frame size changes
+    uint32_t generation = 0;
+
     // Allocate buffers starting at LOQ0, down to LOQ2 - As we go down, if there is no scaling
     // between layers, then the buffer will be shared with lower LOQ.
     for (int8_t loq = LOQ0; loq <= LOQ2; loq++) {
@@ -229,26 +278,39 @@ bool FrameCPU::initializeIntermediateBuffers()
         ldpInternalPictureLayoutInitialize(&m_intermediateLayout[loq], format, width, height,
                                            kBufferRowAlignment);
 
+        if (loq == LOQ0) {
+            generation = m_pipeline->intermediateBufferGeneration(format, width, height);
+        }
+
         const uint8_t numPlanes = std::min(ldpPictureLayoutPlanes(&m_intermediateLayout[loq]),
                                            static_cast<uint8_t>(RCMaxPlanes));
 
         for (uint8_t plane = 0; plane < numPlanes; plane++) {
             if (needsIntermediateBuffer(static_cast<LdeLOQIndex>(loq), plane)) {
                 // Create internal buffer for this LoQ/plane
-                const uint32_t loqSize = ldpPictureLayoutPlaneSize(&m_intermediateLayout[loq], plane);
-                if (!VNAllocateAlignedArray(m_pipeline->allocator(),
-                                            &m_intermediateBufferAllocation[plane][loq], uint8_t,
-                                            kBufferRowAlignment, loqSize)) {
+                IntermediateBufferKey& key{m_intermediateBufferKey[plane][loq]};
+                key.format = format;
+                key.width = ldpPictureLayoutPlaneWidth(&m_intermediateLayout[loq], plane);
+                key.height = ldpPictureLayoutPlaneHeight(&m_intermediateLayout[loq], plane);
+                key.rowStride = ldpPictureLayoutRowStride(&m_intermediateLayout[loq], plane);
+                key.generation = generation;
+
+                // Deferred until the output picture is known not to be usable instead
+                if (loq == LOQ0 && mayUpscaleToOutput(plane)) {
+                    m_intermediateBufferPtr[plane][loq] = nullptr;
+                    continue;
+                }
+
+                // Deferred until the base picture is known not to be usable instead
+                if (loq == firstUpscaleLoq() &&
+                    mayUpscaleFromBase(static_cast<LdeLOQIndex>(loq), plane)) {
+                    m_intermediateBufferPtr[plane][loq] = nullptr;
+                    continue;
+                }
+
+                if (!allocateIntermediateBuffer(static_cast<LdeLOQIndex>(loq), plane)) {
                     return false;
                 }
-                m_intermediateBufferPtr[plane][loq] =
-                    VNAllocationPtr(m_intermediateBufferAllocation[plane][loq], uint8_t);
-
-                VNLogVerbose("Intermediate buffer %" PRIx64 ": LoQ:%d Plane:%d %ux%u:%d %p", timestamp,
-                             loq, plane, ldpPictureLayoutPlaneWidth(&m_intermediateLayout[loq], plane),
-                             ldpPictureLayoutPlaneHeight(&m_intermediateLayout[loq], plane),
-                             (int)ldpPictureLayoutFormat(&m_intermediateLayout[loq]),
-                             (void*)m_intermediateBufferPtr[plane][loq]);
             } else {
                 // Share internal buffer from higher LoQ
                 if (loq != LOQ0) {
@@ -263,13 +325,32 @@ bool FrameCPU::initializeIntermediateBuffers()
     return true;
 }
 
+bool FrameCPU::allocateIntermediateBuffer(LdeLOQIndex loq, uint32_t plane)
+{
+    const uint32_t loqSize = ldpPictureLayoutPlaneSize(&m_intermediateLayout[loq], plane);
+    if (!m_pipeline->allocateIntermediateBuffer(m_intermediateBufferKey[plane][loq], loqSize,
+                                                m_intermediateBufferAllocation[plane][loq])) {
+        return false;
+    }
+    m_intermediateBufferPtr[plane][loq] =
+        VNAllocationPtr(m_intermediateBufferAllocation[plane][loq], uint8_t);
+
+    VNLogVerbose("Intermediate buffer %" PRIx64 ": LoQ:%d Plane:%d %ux%u:%d %p", timestamp, (int)loq,
+                 plane, ldpPictureLayoutPlaneWidth(&m_intermediateLayout[loq], plane),
+                 ldpPictureLayoutPlaneHeight(&m_intermediateLayout[loq], plane),
+                 (int)ldpPictureLayoutFormat(&m_intermediateLayout[loq]),
+                 (void*)m_intermediateBufferPtr[plane][loq]);
+    return true;
+}
+
 void FrameCPU::releaseIntermediateBuffers()
 {
-    // Release intermediate buffers
+    // Return intermediate buffers to pipeline
     for (uint8_t plane = 0; plane < RCMaxPlanes; plane++) {
         for (int8_t loq = LOQ0; loq <= LOQ2; loq++) {
             if (VNIsAllocated(m_intermediateBufferAllocation[plane][loq])) {
-                VNFree(m_pipeline->allocator(), &m_intermediateBufferAllocation[plane][loq]);
+                m_pipeline->releaseIntermediateBuffer(m_intermediateBufferKey[plane][loq],
+                                                      m_intermediateBufferAllocation[plane][loq]);
             }
         }
     }
@@ -282,7 +363,7 @@ bool FrameCPU::needsIntermediateBuffer(LdeLOQIndex loq, uint8_t plane) const
     VNUnused(plane);
 
     if (loq == LOQ0) {
-        return true;
+        return !isStripeFused(plane);
     }
 
     if (globalConfig->scalingModes[loq - 1] != Scale0D) {
@@ -292,6 +373,125 @@ bool FrameCPU::needsIntermediateBuffer(LdeLOQIndex loq, uint8_t plane) const
     return false;
 }
 
+// Return true if the plane's LOQ0 reconstruction is done on stripes, without a LOQ0 intermediate buffer
+//
+bool FrameCPU::isStripeFused(uint32_t plane) const
+{
+    if (!m_pipeline->configuration().stripeFused || !globalConfig->initialized ||
+        globalConfig->scalingModes[LOQ0] == Scale0D) {
+        return false;
+    }
+
+    // Residuals applied directly to LOQ0 (rather than to a temporal buffer) need the whole plane
+    const bool temporal = globalConfig->temporalEnabled && !m_passthrough;
+    return temporal || !isEnhanced(LOQ0, plane);
+}
+
+LdeLOQIndex FrameCPU::firstUpscaleLoq() const
+{
+    return (globalConfig->scalingModes[LOQ1] != Scale0D) ? LOQ2 : LOQ1;
+}
+
+// Return true if the plane's upscale from the given LoQ may read the base picture directly, rather
+// than the fixed point copy made by ConvertToInternal.
+//
+// Only the first upscale of a plane can do this, and only if no LOQ1 residuals are applied
+// before it. Such upscales are made dependent on the base picture, so that it is not released
+// whilst they run.
+//
+bool FrameCPU::mayUpscaleFromBase(LdeLOQIndex fromLoq, uint32_t plane) const
+{
+    if (!m_pipeline->configuration().upscaleFromBase || !globalConfig->initialized ||
+        fromLoq != firstUpscaleLoq() || globalConfig->scalingModes[fromLoq - 1] == Scale0D) {
+        return false;
+    }
+
+    return fromLoq == LOQ2 || !(isEnhanced(LOQ1, plane) || isStripeFused(plane));
+}
+
+// Return true if the plane's upscale from the given LoQ reads the base picture directly.
+//
+// The base picture's layout is only checked once it is present, so the task graph does not
+// depend on it.
+//
+bool FrameCPU::upscalesFromBase(LdeLOQIndex fromLoq, uint32_t plane) const
+{
+    if (!basePicture || !mayUpscaleFromBase(fromLoq, plane)) {
+        return false;
+    }
+
+    // Base must have the same layout as the intermediate plane it replaces
+    const LdpPictureLayout& baseLayout{basePicture->layout};
+    const LdpPictureLayout& loqLayout{m_intermediateLayout[fromLoq]};
+    if (ldpPictureLayoutFormat(&baseLayout) != getBaseColorFormat() ||
+        ldpPictureLayoutWidth(&baseLayout) != ldpPictureLayoutWidth(&loqLayout) ||
+        ldpPictureLayoutHeight(&baseLayout) != ldpPictureLayoutHeight(&loqLayout) ||
+        baseLayout.layoutInfo->interleave[plane] != 1) {
+        return false;
+    }
+
+    return ldppUpscalePromotionSupported(baseLayout.layoutInfo->fixedPoint,
+                                         m_pipeline->configuration().forceScalar);
+}
+
+// Return true if the plane's final upscale, from LOQ1 to LOQ0, may write the output picture
+// directly, rather than an intermediate plane that is then converted to the output.
+//
+// Only planes that would otherwise be converted after the upscale can do this. Any LOQ0 residuals
+// are then applied to the output picture at its bit-depth, which is not bit-exact, so enhanced
+// planes are only included if configured. Such upscales are made dependent on the output picture,
+// unless they also read the base picture, and the plane's LOQ0 intermediate buffer is only
+// allocated if the output picture is not usable.
+//
+bool FrameCPU::mayUpscaleToOutput(uint32_t plane) const
+{
+    if (!m_pipeline->configuration().upscaleToOutput || !globalConfig->initialized ||
+        globalConfig->scalingModes[LOQ0] == Scale0D || isStripeFused(plane)) {
+        return false;
+    }
+
+    // Temporal add writes the output picture itself
+    if (globalConfig->temporalEnabled && !m_passthrough && plane < globalConfig->numPlanes) {
+        return false;
+    }
+
+    return !isEnhanced(LOQ0, plane) || m_pipeline->configuration().residualsToOutput;
+}
+
+// Return true if the plane's final upscale can write the output picture directly.
+//
+// As with the base picture, the output picture's layout is only checked once it is present. An
+// upscale that reads the base picture does not wait for the output picture, as the base picture
+// would then be held until the client sends one - it only writes the output picture if that has
+// already been connected.
+//
+bool FrameCPU::upscalesToOutput(uint32_t plane) const
+{
+    if (!mayUpscaleToOutput(plane) || !ldcTaskDependencyIsMet(&m_taskGroup, m_depOutputPicture)) {
+        return false;
+    }
+
+    // Output must have the same plane dimensions as the intermediate plane it replaces
+    const LdpPictureLayout& outputLayout{outputPicture->layout};
+    const LdpPictureLayout& loqLayout{m_intermediateLayout[LOQ0]};
+    if (plane >= ldpPictureLayoutPlanes(&outputLayout) ||
+        ldpPictureLayoutPlaneWidth(&outputLayout, plane) != ldpPictureLayoutPlaneWidth(&loqLayout, plane) ||
+        ldpPictureLayoutPlaneHeight(&outputLayout, plane) !=
+            ldpPictureLayoutPlaneHeight(&loqLayout, plane) ||
+        outputLayout.layoutInfo->interleave[plane] != 1) {
+        return false;
+    }
+
+    // A 1D upscale from the base picture would have to convert both ways
+    if (globalConfig->scalingModes[LOQ0] == Scale1D && upscalesFromBase(LOQ1, plane)) {
+        return false;
+    }
+
+    return ldppUpscaleDemotionSupported(loqLayout.layoutInfo->fixedPoint,
+                                        outputLayout.layoutInfo->fixedPoint,
+                                        m_pipeline->configuration().forceScalar);
+}
+
 LdcReturnCode FrameCPU::setBase(LdpPicture* picture, uint64_t deadline, void* baseUserData)
 {
     // Can only set base once
@@ -310,6 +510,9 @@ LdcReturnCode FrameCPU::setBase(LdpPicture* picture, uint64_t deadline, void* ba
 
     m_deadline = deadline;
 
+    // Frame tasks are scheduled earliest deadline first
+    ldcTaskGroupSetDeadline(&m_taskGroup, deadline);
+
     // Set base and mark dependency as met
     ldcTaskDependencyMet(&m_taskGroup, m_depBasePicture, basePicture);
     return LdcReturnCodeSuccess;
@@ -500,7 +703,7 @@ size_t FrameCPU::longDescription(char* buffer, size_t bufferSize) const
                     "depO:%d depT:%d tbd:%" PRIx64 ",%d,%d,%d "
                     "tb:%p rdy:%d skp:%d, pass:%d",
                     timestamp, globalConfig, basePicture, outputPicture, enhancementTileCount,
-                    m_enhancementData.size, m_state.load(), m_taskGroup.tasksCount,
+                    (size_t)enhancementDataSize(), m_state.load(), m_taskGroup.tasksCount,
                     m_taskGroup.waitingTasksCount, m_taskGroup.dependenciesCount,
                     m_taskGroup.dependenciesMet[0], m_depBasePicture, m_depOutputPicture,
                     m_depTemporalBuffer[0], m_temporalBufferDesc[0].timestamp,
@@ -56,10 +56,17 @@ public:
     // Tidy up
     void release(bool wait);
 
+    // Enhancement data, either copied by the pipeline or referenced from the client
+    const uint8_t* enhancementData() const;
+    uint32_t enhancementDataSize() const;
+    // Give up the enhancement data, once the configuration has been parsed from it
+    void releaseEnhancementData();
+
     bool initializeCommandBuffers();
     void releaseCommandBuffers();
 
     bool initializeIntermediateBuffers();
+    bool allocateIntermediateBuffer(LdeLOQIndex loq, uint32_t plane);
     void releaseIntermediateBuffers();
 
     // Find command buffer given the tile index
@@ -80,6 +87,27 @@ public:
     // Return true if frame need an intermediate buffer for given loq/plane
     bool needsIntermediateBuffer(LdeLOQIndex loq, uint8_t plane) const;
 
+    // Return true if the plane's LOQ0 reconstruction is fused and run on stripes
+    bool isStripeFused(uint32_t plane) const;
+
+    // LoQ that the plane's first upscale reads from
+    LdeLOQIndex firstUpscaleLoq() const;
+
+    // Return true if the plane's upscale from the given LoQ may read the base picture directly,
+    // depending on the base picture's layout
+    bool mayUpscaleFromBase(LdeLOQIndex fromLoq, uint32_t plane) const;
+
+    // Return true if the plane's upscale from the given LoQ reads the base picture directly
+    bool upscalesFromBase(LdeLOQIndex fromLoq, uint32_t plane) const;
+
+    // Return true if the plane's final upscale may write the output picture directly, depending
+    // on the output picture's layout
+    bool mayUpscaleToOutput(uint32_t plane) const;
+
+    // Return true if the plane's final upscale can write the output picture directly - only used by
+    // that upscale, which records the result in m_upscaledToOutput for the tasks that follow it
+    bool upscalesToOutput(uint32_t plane) const;
+
     // Return true if the frame has everything such that it will complete without further inputs
     bool canComplete() const;
 
@@ -126,16 +154,26 @@ private:
     // Allocation for un-encapsulated enhancement data
     LdcMemoryAllocation m_enhancementData{};
 
+    // Client's enhancement data when it is referenced rather than copied, and how to release it
+    const uint8_t* m_externalEnhancementData{};
+    uint32_t m_externalEnhancementDataSize{};
+    pipeline::EnhancementDataReleaseFunction m_externalEnhancementDataRelease{};
+    void* m_externalEnhancementDataUserData{};
+
     // An array of LdpEnhancementTile
     LdcMemoryAllocation m_enhancementTilesAllocation{};
 
     // Internal buffers for residual application
     LdcMemoryAllocation m_intermediateBufferAllocation[RCMaxPlanes][LOQMaxCount] = {};
+    IntermediateBufferKey m_intermediateBufferKey[RCMaxPlanes][LOQMaxCount] = {};
     LdpPictureLayout m_intermediateLayout[LOQMaxCount] = {};
 
     // Pointers to buffer to use for each LOQ - may share buffers between LoQs depending on scaling modes
     uint8_t* m_intermediateBufferPtr[RCMaxPlanes][LOQMaxCount] = {};
 
+    // True if the plane's final upscale wrote the output picture directly
+    bool m_upscaledToOutput[RCMaxPlanes] = {};
+
     // Dependencies in task group
     LdcTaskDependency m_depBasePicture{kTaskDependencyInvalid};
     LdcTaskDependency m_depOutputPicture{kTaskDependencyInvalid};
@@ -160,6 +198,13 @@ private:
     // True if this frame should be copied to output with no processing (but optionally scaled)
     bool m_passthrough{false};
 
+    // True if the passthrough task graph may alias the base picture from the output picture
+    bool m_passthroughZeroCopy{false};
+
+    // True if the output picture aliases the base picture's planes rather than holding a copy - the
+    // base picture is handed back once the output picture is released.
+    bool m_baseAliased{false};
+
     // Deadline for this frame in microseconds relative to threadTimeMicroseconds()
     uint64_t m_deadline{UINT64_MAX};
 
@@ -121,6 +121,10 @@ bool PictureCPU::setDesc(const LdpPictureDesc& newDesc)
 
 bool PictureCPU::getBufferDesc(LdpPictureBufferDesc& bufferDescOut) const
 {
+    if (m_alias) {
+        return static_cast<const PictureCPU*>(m_alias)->getBufferDesc(bufferDescOut);
+    }
+
     if (!m_external) {
         return false;
     }
@@ -130,6 +134,10 @@ bool PictureCPU::getBufferDesc(LdpPictureBufferDesc& bufferDescOut) const
 
 bool PictureCPU::getPlaneDescArr(LdpPicturePlaneDesc planeDescArrOut[kLdpPictureMaxNumPlanes]) const
 {
+    if (m_alias) {
+        return static_cast<const PictureCPU*>(m_alias)->getPlaneDescArr(planeDescArrOut);
+    }
+
     if (!m_external) {
         return false;
     }
@@ -257,7 +265,9 @@ void PictureCPU::getPlaneDescInternal(uint32_t plane, LdpPicturePlaneDesc& desc)
 {
     assert(plane < kLdpPictureMaxNumPlanes);
 
-    if (!m_external) {
+    if (m_alias) {
+        static_cast<const PictureCPU*>(m_alias)->getPlaneDescInternal(plane, desc);
+    } else if (!m_external) {
         assert(buffer);
         const BufferCPU* bufferCPU = static_cast<const BufferCPU*>(buffer);
         desc.firstSample = bufferCPU->ptr() + ldpPictureLayoutPlaneOffset(&layout, plane);
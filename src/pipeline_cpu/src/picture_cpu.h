@@ -55,6 +55,11 @@ public:
 
     // Buffer management
     void setExternal(const LdpPicturePlaneDesc* planeDescArr, const LdpPictureBufferDesc* buffer);
+    bool isExternal() const { return m_external; }
+
+    // Use the planes of another picture in place of this picture's own buffer
+    void setAlias(LdpPicture* picture) { m_alias = picture; }
+    LdpPicture* getAlias() const { return m_alias; }
 
     uint32_t getRequiredSize() const;
 
@@ -91,6 +96,9 @@ private:
     bool m_external = false;
     LdpPicturePlaneDesc m_externalPlaneDescs[kLdpPictureMaxNumPlanes] = {};
     LdpPictureBufferDesc m_externaBufferDesc = {};
+
+    // Any picture whose planes are being used in place of this picture's own
+    LdpPicture* m_alias = nullptr;
 };
 
 } // namespace lcevc_dec::pipeline_cpu
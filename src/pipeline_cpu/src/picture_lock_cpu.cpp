@@ -35,6 +35,16 @@ bool PictureLock::getBufferDesc(LdpPictureBufferDesc* desc) const
 {
     assert(desc);
 
+    // An aliased picture's data is in the picture it aliases
+    const LdpPicture* alias{static_cast<const PictureCPU*>(picture)->getAlias()};
+    if (alias) {
+        if (!static_cast<const PictureCPU*>(alias)->getBufferDesc(*desc)) {
+            return false;
+        }
+        desc->access = access;
+        return true;
+    }
+
     if (mapping.ptr == nullptr) {
         return false;
     }
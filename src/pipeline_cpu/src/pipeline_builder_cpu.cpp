@@ -28,6 +28,8 @@ using namespace common;
 //
 static const ConfigMemberMap<PipelineConfigCPU> kConfigMemberMap = {
     {"allow_dithering", makeBinding(&PipelineConfigCPU::ditherEnabled)},
+    {"cmdbuffer_entry_points", makeBinding(&PipelineConfigCPU::cmdBufferEntryPoints)},
+    {"cpu_affinity", makeBinding(&PipelineConfigCPU::cpuAffinity)},
     {"default_max_reorder", makeBinding(&PipelineConfigCPU::defaultMaxReorder)},
     {"dither_seed", makeBinding(&PipelineConfigCPU::setDitherSeed)},
     {"dither_strength", makeBinding(&PipelineConfigCPU::ditherOverrideStrength)},
@@ -35,13 +37,29 @@ static const ConfigMemberMap<PipelineConfigCPU> kConfigMemberMap = {
     {"force_bitstream_version", makeBinding(&PipelineConfigCPU::forceBitstreamVersion)},
     {"force_scalar", makeBinding(&PipelineConfigCPU::forceScalar)},
     {"highlight_residuals", makeBinding(&PipelineConfigCPU::highlightResiduals)},
+    {"idle_spin_us", makeBinding(&PipelineConfigCPU::idleSpinMicroseconds)},
+    {"idle_yield_us", makeBinding(&PipelineConfigCPU::idleYieldMicroseconds)},
+    {"initial_arena_count", makeBinding(&PipelineConfigCPU::initialArenaCount)},
+    {"initial_arena_size", makeBinding(&PipelineConfigCPU::initialArenaSize)},
+    {"intermediate_buffers", makeBinding(&PipelineConfigCPU::intermediateBufferLimit)},
     {"log_tasks", makeBinding(&PipelineConfigCPU::showTasks)},
     {"max_latency", makeBinding(&PipelineConfigCPU::maxLatency)},
     {"min_latency", makeBinding(&PipelineConfigCPU::minLatency)},
+    {"numa_node", makeBinding(&PipelineConfigCPU::numaNode)},
     {"temporal_buffers", makeBinding(&PipelineConfigCPU::numTemporalBuffers)},
     {"passthrough_mode", makeBinding(&PipelineConfigCPU::setPassthroughMode)},
+    {"passthrough_zero_copy", makeBinding(&PipelineConfigCPU::passthroughZeroCopy)},
+    {"performance_cores", makeBinding(&PipelineConfigCPU::preferPerformanceCores)},
+    {"residuals_to_output", makeBinding(&PipelineConfigCPU::residualsToOutput)},
     {"s_filter_strength", makeBinding(&PipelineConfigCPU::sharpeningOverrideStrength)},
+    {"shared_pool", makeBinding(&PipelineConfigCPU::sharedPool)},
+    {"shared_pool_weight", makeBinding(&PipelineConfigCPU::sharedPoolWeight)},
+    {"stripe_bytes", makeBinding(&PipelineConfigCPU::stripeBytes)},
+    {"stripe_fused", makeBinding(&PipelineConfigCPU::stripeFused)},
+    {"task_graph_cache", makeBinding(&PipelineConfigCPU::taskGraphCache)},
     {"threads", makeBinding(&PipelineConfigCPU::numThreads)},
+    {"upscale_from_base", makeBinding(&PipelineConfigCPU::upscaleFromBase)},
+    {"upscale_to_output", makeBinding(&PipelineConfigCPU::upscaleToOutput)},
 };
 
 PipelineBuilderCPU::PipelineBuilderCPU(LdcMemoryAllocator* allocator)
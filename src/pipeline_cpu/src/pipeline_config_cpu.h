@@ -21,6 +21,7 @@
 #define VN_LCEVC_PIPELINE_CPU_PIPELINE_CONFIG_CPU_H
 
 #include <cstdint>
+#include <string>
 
 namespace lcevc_dec::pipeline_cpu {
 
@@ -52,6 +53,53 @@ struct PipelineConfigCPU
     // Initial Number of slots reserved in task pool
     uint32_t numReservedTasks = 32;
 
+    // Use a task pool shared with other pipelines in the process, rather than a private pool
+    bool sharedPool = false;
+
+    // Relative weight of this pipeline's tasks when sharing a task pool
+    uint32_t sharedPoolWeight = 1;
+
+    // CPUs to run task pool workers on, as a list eg: "0-3,8" - empty for no restriction
+    std::string cpuAffinity;
+
+    // Run task pool workers on performance cores, if the processor has several core classes
+    bool preferPerformanceCores = false;
+
+    // NUMA node for task pool workers and large buffer allocations, or -1 for no preference
+    int32_t numaNode = -1;
+
+    // How long idle task pool workers spin, then yield, before parking
+    uint32_t idleSpinMicroseconds = 0;
+    uint32_t idleYieldMicroseconds = 0;
+
+    // Reuse recorded enhancement task graphs for frames with the same configuration
+    bool taskGraphCache = true;
+
+    // Run the final upscale, temporal add and output conversion on horizontal stripes, without a
+    // full LOQ0 intermediate plane
+    bool stripeFused = false;
+
+    // Target working set in bytes of each stripe - should fit in a core's L2 cache
+    uint32_t stripeBytes = 512 * 1024;
+
+    // First upscale of each plane reads the base picture directly, rather than a converted copy
+    bool upscaleFromBase = true;
+
+    // Final upscale of each plane writes the output picture directly, rather than an intermediate
+    // plane that is converted afterwards
+    bool upscaleToOutput = true;
+
+    // Allow upscaleToOutput for planes with LOQ0 residuals - not bit-exact, as the residuals are
+    // added at the output bit-depth
+    bool residualsToOutput = false;
+
+    // Number of entry points each command buffer is split into, so that residuals are applied in
+    // parallel - 0 for one per thread
+    uint32_t cmdBufferEntryPoints = 0;
+
+    // Maximum number of spare intermediate plane buffers kept for reuse by later frames
+    uint32_t intermediateBufferLimit = 16;
+
     // Default maximum reorder
     uint32_t defaultMaxReorder = 16;
 
@@ -70,6 +118,9 @@ struct PipelineConfigCPU
     // How passthrough is handled by pipeline
     PassthroughMode passthroughMode = PassthroughMode::Scale;
 
+    // Let passthrough output pictures use the base picture's memory, rather than copying it
+    bool passthroughZeroCopy = false;
+
     // Dither settings
     bool ditherEnabled = true;
     int32_t ditherOverrideStrength = -1;
@@ -17,6 +17,7 @@
 #include "frame_cpu.h"
 #include "picture_cpu.h"
 #include "pipeline_config_cpu.h"
+#include "shared_task_pool.h"
 
 #include <LCEVC/common/check.h>
 #include <LCEVC/common/constants.h>
@@ -24,6 +25,7 @@
 #include <LCEVC/common/limit.h>
 #include <LCEVC/common/log.h>
 #include <LCEVC/common/memory.h>
+#include <LCEVC/common/memory_numa.h>
 #include <LCEVC/common/return_code.h>
 #include <LCEVC/common/task_pool.h>
 #include <LCEVC/common/threads.h>
@@ -35,6 +37,7 @@
 #include <LCEVC/pixel_processing/blit.h>
 #include <LCEVC/pixel_processing/upscale.h>
 //
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -86,6 +89,54 @@ namespace {
         return compareTimestamps(ets, ts);
     }
 
+    // Work out the CPUs that task pool workers should run on from the configuration - returns
+    // false if workers are not restricted.
+    bool taskPoolAffinity(const PipelineConfigCPU& configuration, ThreadCpuSet& cpus)
+    {
+        bool restricted = false;
+        for (uint64_t& bits : cpus.bits) {
+            bits = ~0ULL;
+        }
+
+        if (!configuration.cpuAffinity.empty()) {
+            ThreadCpuSet list;
+            if (threadCpuSetParse(&list, configuration.cpuAffinity.c_str())) {
+                threadCpuSetIntersect(&cpus, &list);
+                restricted = true;
+            } else {
+                VNLogWarning("Cannot parse cpu_affinity \"%s\"", configuration.cpuAffinity.c_str());
+            }
+        }
+
+        if (configuration.numaNode >= 0) {
+            ThreadCpuSet node;
+            if (threadCpuSetFromNumaNode(&node, static_cast<uint32_t>(configuration.numaNode))) {
+                threadCpuSetIntersect(&cpus, &node);
+                restricted = true;
+            } else {
+                VNLogWarning("Cannot find CPUs for NUMA node %d", configuration.numaNode);
+            }
+        }
+
+        // Performance cores are a preference - ignored if nothing is left after applying it
+        if (configuration.preferPerformanceCores) {
+            ThreadCpuSet performance;
+            if (threadCpuSetFromCoreClass(&performance, ThreadCoreClassPerformance)) {
+                threadCpuSetIntersect(&performance, &cpus);
+                if (!threadCpuSetIsEmpty(&performance)) {
+                    cpus = performance;
+                    restricted = true;
+                }
+            }
+        }
+
+        if (restricted && threadCpuSetIsEmpty(&cpus)) {
+            VNLogWarning("No CPUs left for task pool affinity - workers are unrestricted");
+            return false;
+        }
+        return restricted;
+    }
+
 } // namespace
 
 // PipelineCPU
@@ -105,13 +156,23 @@ PipelineCPU::PipelineCPU(const PipelineBuilderCPU& builder, pipeline::EventSink*
     , m_basePictureOutBuffer(nextPowerOfTwoU32(builder.configuration().maxLatency + 1), builder.allocator())
     , m_outputPictureAvailableBuffer(nextPowerOfTwoU32(builder.configuration().maxLatency + 1),
                                      builder.allocator())
+    , m_intermediateBuffers(std::max(builder.configuration().intermediateBufferLimit, 1U),
+                            builder.allocator())
+    , m_stripeBands(nextPowerOfTwoU32(builder.configuration().numThreads + 1), builder.allocator())
 {
+    // Prefer a NUMA node for this pipeline's buffers
+    if (m_configuration.numaNode >= 0) {
+        m_allocator = ldcMemoryAllocatorNumaInitialize(&m_numaAllocator, m_allocator,
+                                                       static_cast<uint32_t>(m_configuration.numaNode));
+    }
+
     // Set up dithering
     ldppDitherGlobalInitialize(m_allocator, &m_dither, m_configuration.ditherSeed);
 
     // Set up an allocator for per frame data
-    ldcRollingArenaInitialize(&m_rollingArena, m_allocator, m_configuration.initialArenaCount,
-                              m_configuration.initialArenaSize);
+    ldcRollingArenaInitialize(&m_rollingArena, m_allocator,
+                              nextPowerOfTwoU32(std::max(m_configuration.initialArenaCount, 2U)),
+                              nextPowerOfTwoU32(std::max(m_configuration.initialArenaSize, 1024U)));
 
     // Configuration pool
     LdeBitstreamVersion bitstreamVersion = BitstreamVersionUnspecified;
@@ -123,8 +184,27 @@ PipelineCPU::PipelineCPU(const PipelineBuilderCPU& builder, pipeline::EventSink*
 
     // Start task pool - pool threads is 1 less than configured threads
     VNCheck(m_configuration.numThreads >= 1);
-    ldcTaskPoolInitialize(&m_taskPool, m_allocator, m_allocator, m_configuration.numThreads - 1,
-                          m_configuration.numReservedTasks);
+    ThreadCpuSet affinity;
+    const ThreadCpuSet* affinityPtr{taskPoolAffinity(m_configuration, affinity) ? &affinity : nullptr};
+    if (m_configuration.sharedPool && m_configuration.numThreads > 1) {
+        m_taskPool = sharedTaskPoolAcquire(m_configuration.numThreads - 1,
+                                           m_configuration.numReservedTasks, affinityPtr);
+    }
+    if (m_taskPool) {
+        ldcTaskPoolClientAttach(m_taskPool, &m_taskPoolClient, m_configuration.sharedPoolWeight);
+    } else {
+        ldcTaskPoolInitializeAffinity(&m_ownTaskPool, m_allocator, m_allocator,
+                                      m_configuration.numThreads - 1,
+                                      m_configuration.numReservedTasks, affinityPtr);
+        m_taskPool = &m_ownTaskPool;
+    }
+
+    // A shared pool keeps its idle policy unless this pipeline asks for spinning
+    if (m_taskPool == &m_ownTaskPool || m_configuration.idleSpinMicroseconds > 0 ||
+        m_configuration.idleYieldMicroseconds > 0) {
+        ldcTaskPoolSetIdlePolicy(m_taskPool, m_configuration.idleSpinMicroseconds,
+                                 m_configuration.idleYieldMicroseconds);
+    }
 
     // Fill in empty temporal buffer anchors
     TemporalBuffer buf{};
@@ -135,6 +215,11 @@ PipelineCPU::PipelineCPU(const PipelineBuilderCPU& builder, pipeline::EventSink*
         m_temporalBuffers.append(buf);
     }
 
+    // Task graph cache
+    for (TaskGraphTemplate& tg : m_taskGraphs) {
+        ldcTaskGraphInitialize(&tg.graph, m_allocator);
+    }
+
     m_eventSink->generate(pipeline::EventCanSendEnhancement);
     m_eventSink->generate(pipeline::EventCanSendBase);
     m_eventSink->generate(pipeline::EventCanSendPicture);
@@ -156,7 +241,7 @@ PipelineCPU::~PipelineCPU()
         frame->release(false);
         // Call destructor directly, as we are doing in-place construct/destruct
         frame->~FrameCPU();
-        VNFree(m_allocator, &m_frames[i]);
+        VNRollingArenaFree(frameAllocator(), &m_frames[i]);
     }
 
     // Release any temporal buffers
@@ -166,6 +251,22 @@ PipelineCPU::~PipelineCPU()
             VNFree(m_allocator, &tb->allocation);
         }
     }
+    // Release task graphs
+    for (TaskGraphTemplate& tg : m_taskGraphs) {
+        ldcTaskGraphDestroy(&tg.graph);
+    }
+
+    // Release spare intermediate buffers - after frames have returned theirs
+    for (uint32_t i = 0; i < m_intermediateBuffers.size(); ++i) {
+        VNFree(m_allocator, &m_intermediateBuffers[i].allocation);
+    }
+
+    // Release stripe band buffers
+    LdcMemoryAllocation band{};
+    while (m_stripeBands.tryPop(band)) {
+        VNFree(m_allocator, &band);
+    }
+
     // Release dither
     ldppDitherGlobalRelease(&m_dither);
 
@@ -174,7 +275,12 @@ PipelineCPU::~PipelineCPU()
     ldcRollingArenaDestroy(&m_rollingArena);
 
     // Close down task pool
-    ldcTaskPoolDestroy(&m_taskPool);
+    if (m_taskPool == &m_ownTaskPool) {
+        ldcTaskPoolDestroy(&m_ownTaskPool);
+    } else {
+        ldcTaskPoolClientDetach(&m_taskPoolClient);
+        sharedTaskPoolRelease(m_taskPool);
+    }
 
     m_eventSink->generate(pipeline::EventExit);
 }
@@ -186,6 +292,31 @@ LdcReturnCode PipelineCPU::sendEnhancementData(uint64_t timestamp, const uint8_t
     VNLogDebug("sendEnhancementData: %" PRIx64 " %d", timestamp, byteSize);
     VNTraceInstant("sendEnhancementData", timestamp);
 
+    return addEnhancementData(timestamp, data, byteSize, nullptr, nullptr);
+}
+
+LdcReturnCode PipelineCPU::sendEnhancementDataExternal(uint64_t timestamp, const uint8_t* data,
+                                                       uint32_t byteSize,
+                                                       pipeline::EnhancementDataReleaseFunction release,
+                                                       void* releaseUserData)
+{
+    VNLogDebug("sendEnhancementDataExternal: %" PRIx64 " %d", timestamp, byteSize);
+    VNTraceInstant("sendEnhancementDataExternal", timestamp);
+
+    if (!data || !release) {
+        return LdcReturnCodeInvalidParam;
+    }
+
+    return addEnhancementData(timestamp, data, byteSize, release, releaseUserData);
+}
+
+// Make a new frame for some enhancement data - the data is copied unless there is a release
+// function, in which case it is referenced until the frame's configuration has been parsed.
+//
+LdcReturnCode PipelineCPU::addEnhancementData(uint64_t timestamp, const uint8_t* data, uint32_t byteSize,
+                                              pipeline::EnhancementDataReleaseFunction release,
+                                              void* releaseUserData)
+{
     // Invalid if this timestamp is already present in decoder.
     //
     // NB: API clients are expected to make distinct timestamps over discontinuities using utility library
@@ -204,10 +335,18 @@ LdcReturnCode PipelineCPU::sendEnhancementData(uint64_t timestamp, const uint8_t
         return LdcReturnCodeError;
     }
 
-    LdcMemoryAllocation enhancementDataAllocation{};
-    uint8_t* const enhancement{VNAllocateArray(m_allocator, &enhancementDataAllocation, uint8_t, byteSize)};
-    memcpy(enhancement, data, byteSize);
-    frame->m_enhancementData = enhancementDataAllocation;
+    if (release) {
+        frame->m_externalEnhancementData = data;
+        frame->m_externalEnhancementDataSize = byteSize;
+        frame->m_externalEnhancementDataRelease = release;
+        frame->m_externalEnhancementDataUserData = releaseUserData;
+    } else {
+        LdcMemoryAllocation enhancementDataAllocation{};
+        uint8_t* const enhancement{VNRollingArenaAllocateArray(
+            frameAllocator(), &enhancementDataAllocation, uint8_t, byteSize)};
+        memcpy(enhancement, data, byteSize);
+        frame->m_enhancementData = enhancementDataAllocation;
+    }
     frame->m_state = FrameStateReorder;
 
     // Add frame to reorder table sorted by timestamp
@@ -294,6 +433,9 @@ LdcReturnCode PipelineCPU::sendOutputPicture(LdpPicture* outputPicture)
     VNLogDebug("sendOutputPicture: %p", (void*)outputPicture);
     VNTraceInstant("sendOutputPicture", (void*)outputPicture);
 
+    // Picture is no longer in use by the client - so it can let go of any aliased base
+    releaseAliasedBase(static_cast<PictureCPU*>(outputPicture));
+
     // Add to available queue
     if (m_outputPictureAvailableBuffer.size() > m_configuration.maxLatency ||
         !m_outputPictureAvailableBuffer.tryPush(outputPicture)) {
@@ -336,7 +478,7 @@ LdpPicture* PipelineCPU::receiveOutputPicture(LdpDecodeInformation& decodeInfoOu
             }
             VNLogWarning("receiveOutputPicture wait timed out");
 #ifdef VN_SDK_LOG_ENABLE_DEBUG
-            ldcTaskPoolDump(&m_taskPool, nullptr);
+            ldcTaskPoolDump(m_taskPool, nullptr);
 #endif
         } else {
             break;
@@ -447,9 +589,15 @@ LdcReturnCode PipelineCPU::skip(uint64_t timestamp)
             // Mark frame as skippable and flushable
             frame->m_skip = true;
             frame->m_ready = true;
+            cancelFrameTasks(frame);
         }
     }
 
+    {
+        common::ScopedLock lock(m_interTaskMutex);
+        m_seekTime = threadTimeMicroseconds(0);
+    }
+
     startReadyFrames();
     return LdcReturnCodeSuccess;
 }
@@ -464,6 +612,13 @@ LdcReturnCode PipelineCPU::synchronize(bool dropPending)
     for (uint32_t i = 0; i < m_frames.size(); ++i) {
         FrameCPU* const frame{VNAllocationPtr(m_frames[i], FrameCPU)};
         frame->m_skip = dropPending;
+        if (dropPending) {
+            cancelFrameTasks(frame);
+        }
+    }
+    if (dropPending) {
+        common::ScopedLock lock(m_interTaskMutex);
+        m_seekTime = threadTimeMicroseconds(0);
     }
     startReadyFrames();
 
@@ -518,6 +673,80 @@ void PipelineCPU::releaseBuffer(BufferCPU* buffer)
     m_buffers.removeReorder(pAlloc);
 }
 
+// Intermediate buffers
+//
+// Frames borrow intermediate plane buffers from a pool held by the pipeline, rather than allocating
+// and freeing several large buffers per frame. When the frame size changes, the generation is bumped
+// and buffers of the old size are freed as they come back.
+//
+uint32_t PipelineCPU::intermediateBufferGeneration(LdpColorFormat format, uint32_t width, uint32_t height)
+{
+    common::ScopedLock lock(m_intermediateBuffersMutex);
+
+    if (format != m_intermediateBufferFormat || width != m_intermediateBufferWidth ||
+        height != m_intermediateBufferHeight) {
+        VNLogDebug("Intermediate buffers trimmed: %ux%u:%d -> %ux%u:%d", m_intermediateBufferWidth,
+                   m_intermediateBufferHeight, (int)m_intermediateBufferFormat, width, height, (int)format);
+
+        for (uint32_t i = 0; i < m_intermediateBuffers.size(); ++i) {
+            VNFree(m_allocator, &m_intermediateBuffers[i].allocation);
+        }
+        while (!m_intermediateBuffers.isEmpty()) {
+            m_intermediateBuffers.removeIndex(m_intermediateBuffers.size() - 1);
+        }
+
+        m_intermediateBufferFormat = format;
+        m_intermediateBufferWidth = width;
+        m_intermediateBufferHeight = height;
+        m_intermediateBufferGeneration++;
+    }
+
+    return m_intermediateBufferGeneration;
+}
+
+static bool intermediateBufferKeyEqual(const IntermediateBufferKey& lhs, const IntermediateBufferKey& rhs)
+{
+    return lhs.format == rhs.format && lhs.width == rhs.width && lhs.height == rhs.height &&
+           lhs.rowStride == rhs.rowStride && lhs.generation == rhs.generation;
+}
+
+bool PipelineCPU::allocateIntermediateBuffer(const IntermediateBufferKey& key, uint32_t size,
+                                             LdcMemoryAllocation& allocation)
+{
+    {
+        common::ScopedLock lock(m_intermediateBuffersMutex);
+
+        // Most recently returned buffer first - it is the most likely to still be in cache. The
+        // list is kept in the order buffers were returned, so later searches stay MRU first.
+        for (uint32_t i = m_intermediateBuffers.size(); i > 0; --i) {
+            IntermediateBuffer& spare{m_intermediateBuffers[i - 1]};
+            if (intermediateBufferKeyEqual(spare.key, key) && spare.allocation.size >= size) {
+                allocation = spare.allocation;
+                m_intermediateBuffers.removeIndex(i - 1);
+                return true;
+            }
+        }
+    }
+
+    return VNAllocateAlignedArray(m_allocator, &allocation, uint8_t, kBufferRowAlignment, size) != nullptr;
+}
+
+void PipelineCPU::releaseIntermediateBuffer(const IntermediateBufferKey& key, LdcMemoryAllocation& allocation)
+{
+    {
+        common::ScopedLock lock(m_intermediateBuffersMutex);
+
+        if (key.generation == m_intermediateBufferGeneration &&
+            m_intermediateBuffers.size() < m_configuration.intermediateBufferLimit) {
+            m_intermediateBuffers.append(IntermediateBuffer{key, allocation});
+            allocation = {};
+            return;
+        }
+    }
+
+    VNFree(m_allocator, &allocation);
+}
+
 // Pictures
 //
 
@@ -582,6 +811,7 @@ void PipelineCPU::freePicture(LdpPicture* ldpPicture)
     PictureCPU* picture{static_cast<PictureCPU*>(ldpPicture)};
     assert(ldpPicture);
 
+    releaseAliasedBase(picture);
     releasePicture(picture);
 }
 
@@ -602,7 +832,7 @@ FrameCPU* PipelineCPU::allocateFrame(uint64_t timestamp)
 
     // Allocate frame with in place construction
     LdcMemoryAllocation frameAllocation = {};
-    FrameCPU* const frame{VNAllocateZero(m_allocator, &frameAllocation, FrameCPU)};
+    FrameCPU* const frame{VNRollingArenaAllocateZero(frameAllocator(), &frameAllocation, FrameCPU)};
     if (!frame) {
         return nullptr;
     }
@@ -646,7 +876,7 @@ void PipelineCPU::freeFrame(FrameCPU* frame)
     frame->~FrameCPU();
 
     // Release memory
-    VNFree(m_allocator, frameAlloc);
+    VNRollingArenaFree(frameAllocator(), frameAlloc);
 
     m_frames.removeReorder(frameAlloc);
 }
@@ -701,9 +931,8 @@ void PipelineCPU::startReadyFrames()
         if (!frame->m_passthrough) {
             // Parse the LCEVC configuration into distinct per-frame data
             // Switch to pass-through if configuration parse failed.
-            goodConfig = ldeConfigPoolFrameInsert(&m_configPool, timestamp,
-                                                  VNAllocationPtr(frame->m_enhancementData, uint8_t),
-                                                  VNAllocationSize(frame->m_enhancementData, uint8_t),
+            goodConfig = ldeConfigPoolFrameInsert(&m_configPool, timestamp, frame->enhancementData(),
+                                                  frame->enhancementDataSize(),
                                                   &frame->globalConfig, &frame->config);
 
             if (!goodConfig) {
@@ -711,6 +940,9 @@ void PipelineCPU::startReadyFrames()
             }
         }
 
+        // Configuration parser has its own copy of anything it needs
+        frame->releaseEnhancementData();
+
         if (frame->m_passthrough) {
             // Set up enough frame configuration to support pass-through
             ldeConfigPoolFramePassthrough(&m_configPool, &frame->globalConfig, &frame->config);
@@ -739,6 +971,9 @@ void PipelineCPU::startReadyFrames()
         }
 
         frame->generateTasks(m_lastGoodTimestamp);
+        if (frame->m_skip) {
+            cancelFrameTasks(frame);
+        }
 
         // Remember timestamps for next time
         m_previousTimestamp = timestamp;
@@ -800,6 +1035,10 @@ void PipelineCPU::connectOutputPictures()
         // Poke it into the frame's task group
         frame->outputPicture = ldpPicture;
 
+        if (frame->m_passthroughZeroCopy) {
+            frame->m_baseAliased = aliasPassthroughBase(frame);
+        }
+
         VNLogDebug("connectOutputPicture: %" PRIx64 " %p %ux%u (r:%d p:%d o:%d)", frame->timestamp,
                    (void*)ldpPicture, desc.width, desc.height, m_reorderIndex.size(),
                    m_processingIndex.size(), m_outputPictureAvailableBuffer.size());
@@ -811,6 +1050,57 @@ void PipelineCPU::connectOutputPictures()
     }
 }
 
+// Make a passthrough frame's output picture use the base picture's planes directly, rather than
+// copying them. The base picture is then held until the output picture is sent back to the
+// pipeline, or freed.
+//
+// Only done for managed output pictures with exactly the same format, size and row strides as the
+// base, so that the output picture's layout describes the aliased planes.
+//
+bool PipelineCPU::aliasPassthroughBase(FrameCPU* frame)
+{
+    PictureCPU* const outputPicture{static_cast<PictureCPU*>(frame->outputPicture)};
+    const LdpPicture* const basePicture{frame->basePicture};
+
+    if (!basePicture || outputPicture->isExternal() || outputPicture->getAlias()) {
+        return false;
+    }
+
+    if (ldpPictureLayoutFormat(&basePicture->layout) != ldpPictureLayoutFormat(&outputPicture->layout) ||
+        ldpPictureLayoutWidth(&basePicture->layout) != ldpPictureLayoutWidth(&outputPicture->layout) ||
+        ldpPictureLayoutHeight(&basePicture->layout) != ldpPictureLayoutHeight(&outputPicture->layout)) {
+        return false;
+    }
+
+    for (uint32_t plane = 0; plane < ldpPictureLayoutPlanes(&outputPicture->layout); ++plane) {
+        LdpPicturePlaneDesc basePlane{};
+        static_cast<const PictureCPU*>(basePicture)->getPlaneDescInternal(plane, basePlane);
+        if (basePlane.rowByteStride != ldpPictureLayoutRowStride(&outputPicture->layout, plane)) {
+            return false;
+        }
+    }
+
+    VNLogDebug("aliasPassthroughBase: %" PRIx64 " %p -> %p", frame->timestamp,
+               (void*)outputPicture, (void*)basePicture);
+
+    outputPicture->setAlias(frame->basePicture);
+    return true;
+}
+
+void PipelineCPU::releaseAliasedBase(PictureCPU* picture)
+{
+    LdpPicture* const basePicture{picture->getAlias()};
+    if (!basePicture) {
+        return;
+    }
+
+    picture->setAlias(nullptr);
+
+    // Send base picture back to API
+    m_eventSink->generate(pipeline::EventBasePictureDone, basePicture);
+    m_basePictureOutBuffer.push(basePicture);
+}
+
 //// Temporal
 //
 // Mark a frame as needing a temporal buffer of given timestamp and dimensions
@@ -822,6 +1112,16 @@ LdcTaskDependency PipelineCPU::requireTemporalBuffer(FrameCPU* frame, uint64_t t
 {
     LdcTaskDependency dep{ldcTaskDependencyAdd(&frame->m_taskGroup)};
 
+    connectTemporalBuffer(frame, timestamp, plane, dep);
+
+    return dep;
+}
+
+// Fill in the temporal buffer requirements for an existing dependency
+//
+void PipelineCPU::connectTemporalBuffer(FrameCPU* frame, uint64_t timestamp, uint32_t plane,
+                                        LdcTaskDependency dep)
+{
     uint32_t width = frame->globalConfig->width;
     uint32_t height = frame->globalConfig->height;
     width >>= ldpColorFormatPlaneWidthShift(frame->baseFormat, plane);
@@ -844,8 +1144,6 @@ LdcTaskDependency PipelineCPU::requireTemporalBuffer(FrameCPU* frame, uint64_t t
     if (TemporalBuffer* temporalBuffer = matchTemporalBuffer(frame, plane)) {
         ldcTaskDependencyMet(&frame->m_taskGroup, dep, temporalBuffer);
     }
-
-    return dep;
 }
 
 TemporalBuffer* PipelineCPU::matchTemporalBuffer(FrameCPU* frame, uint32_t plane)
@@ -1016,6 +1314,23 @@ void* PipelineCPU::taskConvertToInternal(LdcTask* task, const LdcTaskPart* /*par
         return nullptr;
     }
 
+    // The plane's first upscale reads the base picture itself
+    const LdeLOQIndex firstLoq = frame->firstUpscaleLoq();
+    if (frame->upscalesFromBase(firstLoq, data.planeIndex)) {
+        return nullptr;
+    }
+
+    // The first upscale's source buffer is deferred whilst the base picture might be read instead
+    if (!frame->m_intermediateBufferPtr[data.planeIndex][firstLoq]) {
+        if (!frame->allocateIntermediateBuffer(firstLoq, data.planeIndex)) {
+            VNLogError("Could not allocate intermediate buffer: %" PRIx64, frame->timestamp);
+            return nullptr;
+        }
+        // LOQ2 shares the buffer when there is no scaling between LOQ2 and LOQ1
+        frame->m_intermediateBufferPtr[data.planeIndex][LOQ2] =
+            frame->m_intermediateBufferPtr[data.planeIndex][firstLoq];
+    }
+
     bool isNV12 = frame->basePicture->layout.layoutInfo->format == LdpColorFormatNV12_8;
     uint32_t srcPlaneIndex = (isNV12 && data.planeIndex == 2) ? 1 : data.planeIndex;
     LdpPicturePlaneDesc srcPlane;
@@ -1029,7 +1344,7 @@ void* PipelineCPU::taskConvertToInternal(LdcTask* task, const LdcTaskPart* /*par
     VNLogDebug("taskConvertToInternal timestamp:%" PRIx64 " plane:%d enhanced:%d",
                data.frame->timestamp, data.planeIndex);
 
-    if (!ldppPlaneBlit(&pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
+    if (!ldppPlaneBlit(pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
                        data.planeIndex, &frame->basePicture->layout,
                        &frame->m_intermediateLayout[LOQ2], &srcPlane, &dstPlane, BMCopy)) {
         VNLogError("ldppPlaneBlit In failed");
@@ -1073,7 +1388,9 @@ void* PipelineCPU::taskConvertFromInternal(LdcTask* task, const LdcTaskPart* /*p
     PipelineCPU* const pipeline{data.pipeline};
     FrameCPU* const frame{data.frame};
 
-    if (frame->m_skip) {
+    // Nothing to do if the final upscale wrote the output picture, or could not run
+    if (frame->m_skip || frame->m_upscaledToOutput[data.planeIndex] ||
+        !frame->m_intermediateBufferPtr[data.planeIndex][LOQ0]) {
         return nullptr;
     }
 
@@ -1088,7 +1405,7 @@ void* PipelineCPU::taskConvertFromInternal(LdcTask* task, const LdcTaskPart* /*p
     VNLogDebug("taskConvertFromInternal timestamp:%" PRIx64 " plane:%d", data.frame->timestamp,
                data.planeIndex);
 
-    if (!ldppPlaneBlit(&pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
+    if (!ldppPlaneBlit(pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
                        data.planeIndex, &frame->m_intermediateLayout[LOQ0],
                        &frame->outputPicture->layout, &srcPlane, &dstPlane, BMCopy)) {
         VNLogError("ldppPlaneBlit out failed");
@@ -1116,6 +1433,8 @@ LdcTaskDependency PipelineCPU::addTaskConvertFromInternal(FrameCPU* frame, uint3
 // Upscale (1D or 2D) for one plane of picture.
 //
 // Inputs and outputs may be fixed point or 'external' format if no residuals are being applied.
+// The first upscale of a plane may read the base picture directly, promoting it to fixed point,
+// and the final upscale may write the output picture directly, demoting it from fixed point.
 //
 struct TaskUpsampleData
 {
@@ -1142,11 +1461,30 @@ void* PipelineCPU::taskUpsample(LdcTask* task, const LdcTaskPart* /*part*/)
 
     const LdeLOQIndex loq = data.fromLoq;
     assert(loq > LOQ0);
-    upscaleArgs.srcLayout = &frame->m_intermediateLayout[loq];
-    frame->getIntermediatePlaneDesc(data.plane, loq, upscaleArgs.srcPlane);
-
-    upscaleArgs.dstLayout = &frame->m_intermediateLayout[loq - 1];
-    frame->getIntermediatePlaneDesc(data.plane, static_cast<LdeLOQIndex>(loq - 1), upscaleArgs.dstPlane);
+    if (frame->upscalesFromBase(loq, data.plane)) {
+        upscaleArgs.srcLayout = &frame->basePicture->layout;
+        frame->getBasePlaneDesc(data.plane, upscaleArgs.srcPlane);
+    } else {
+        upscaleArgs.srcLayout = &frame->m_intermediateLayout[loq];
+        frame->getIntermediatePlaneDesc(data.plane, loq, upscaleArgs.srcPlane);
+    }
+
+    const LdeLOQIndex toLoq = static_cast<LdeLOQIndex>(loq - 1);
+    if (toLoq == LOQ0 && frame->upscalesToOutput(data.plane)) {
+        frame->m_upscaledToOutput[data.plane] = true;
+        upscaleArgs.dstLayout = &frame->outputPicture->layout;
+        frame->getOutputPlaneDesc(data.plane, upscaleArgs.dstPlane);
+        // Base to output is unsigned to unsigned, so say which precision to upscale at
+        upscaleArgs.signedPrecision = frame->upscalesFromBase(loq, data.plane);
+    } else {
+        if (!frame->m_intermediateBufferPtr[data.plane][toLoq] &&
+            !frame->allocateIntermediateBuffer(toLoq, data.plane)) {
+            VNLogError("Could not allocate intermediate buffer: %" PRIx64, frame->timestamp);
+            return nullptr;
+        }
+        upscaleArgs.dstLayout = &frame->m_intermediateLayout[toLoq];
+        frame->getIntermediatePlaneDesc(data.plane, toLoq, upscaleArgs.dstPlane);
+    }
 
     upscaleArgs.planeIndex = data.plane;
     upscaleArgs.applyPA = frame->globalConfig->predictedAverageEnabled;
@@ -1158,7 +1496,7 @@ void* PipelineCPU::taskUpsample(LdcTask* task, const LdcTaskPart* /*part*/)
     VNLogDebug("taskUpsample timestamp:%" PRIx64 " loq:%d plane:%d", frame->timestamp,
                (uint32_t)data.fromLoq, data.plane);
 
-    if (!ldppUpscale(pipeline->allocator(), &pipeline->m_taskPool, task,
+    if (!ldppUpscale(pipeline->allocator(), pipeline->m_taskPool, task,
                      &frame->globalConfig->kernel, &upscaleArgs)) {
         VNLogError("Upsample failed");
     }
@@ -1173,11 +1511,20 @@ LdcTaskDependency PipelineCPU::addTaskUpsample(FrameCPU* frame, LdeLOQIndex from
     assert(frame->globalConfig->scalingModes[fromLoq - 1] != Scale0D);
 
     const TaskUpsampleData data{this, frame, fromLoq, plane};
-    const LdcTaskDependency inputs[] = {src};
+    // Hold on to the base picture if the upscale may read it directly. Otherwise, wait for the
+    // output picture if the upscale may write it directly - waiting whilst holding the base picture
+    // would stop it being sent back until the client sends an output picture.
+    LdcTaskDependency inputs[2] = {src};
+    uint32_t inputsCount = 1;
+    if (frame->mayUpscaleFromBase(fromLoq, plane)) {
+        inputs[inputsCount++] = frame->m_depBasePicture;
+    } else if (fromLoq == LOQ1 && frame->mayUpscaleToOutput(plane)) {
+        inputs[inputsCount++] = frame->m_depOutputPicture;
+    }
     const LdcTaskDependency output{ldcTaskDependencyAdd(&frame->m_taskGroup)};
 
-    ldcTaskGroupAdd(&frame->m_taskGroup, inputs, VNArraySize(inputs), output, taskUpsample, nullptr,
-                    1, 1, sizeof(data), &data, "Upsample");
+    ldcTaskGroupAdd(&frame->m_taskGroup, inputs, inputsCount, output, taskUpsample, nullptr, 1, 1,
+                    sizeof(data), &data, "Upsample");
 
     return output;
 }
@@ -1229,7 +1576,8 @@ LdcTaskDependency PipelineCPU::addTaskGenerateCmdBuffer(FrameCPU* frame, LdpEnha
 //
 // Apply a generated CPU command buffer to directly to output plane. (No Temporal)
 //
-// NB: The output plane will be in 'internal' fixed point format
+// NB: The output plane will be in 'internal' fixed point format, unless the final upscale wrote
+// the output picture directly.
 //
 struct TaskApplyCmdBufferDirectData
 {
@@ -1255,13 +1603,24 @@ void* PipelineCPU::taskApplyCmdBufferDirect(LdcTask* task, const LdcTaskPart* /*
                (uint32_t)data.enhancementTile->loq, data.enhancementTile->plane);
 
     LdpPicturePlaneDesc ppDesc{};
-
-    frame->getIntermediatePlaneDesc(data.enhancementTile->plane, data.enhancementTile->loq, ppDesc);
+    LdpFixedPoint fixedPoint = LdpFPS14;
+
+    if (data.enhancementTile->loq == LOQ0 &&
+        frame->m_upscaledToOutput[data.enhancementTile->plane]) {
+        // Residuals are added to the output picture written by the final upscale
+        frame->getOutputPlaneDesc(data.enhancementTile->plane, ppDesc);
+        fixedPoint = frame->outputPicture->layout.layoutInfo->fixedPoint;
+    } else if (frame->m_intermediateBufferPtr[data.enhancementTile->plane][data.enhancementTile->loq]) {
+        frame->getIntermediatePlaneDesc(data.enhancementTile->plane, data.enhancementTile->loq, ppDesc);
+    } else {
+        VNLogError("taskApplyCmdBufferDirect: no intermediate buffer: %" PRIx64, frame->timestamp);
+        return nullptr;
+    }
 
     const bool tuRasterOrder =
         !frame->globalConfig->temporalEnabled && frame->globalConfig->tileDimensions == TDTNone;
 
-    if (!ldppApplyCmdBuffer(&pipeline->m_taskPool, NULL, data.enhancementTile, LdpFPS14, &ppDesc,
+    if (!ldppApplyCmdBuffer(pipeline->m_taskPool, task, data.enhancementTile, fixedPoint, &ppDesc,
                             tuRasterOrder, pipeline->m_configuration.forceScalar,
                             pipeline->m_configuration.highlightResiduals)) {
         VNLogError("taskApplyCmdBufferDirect failed");
@@ -1312,7 +1671,7 @@ void* PipelineCPU::taskApplyCmdBufferTemporal(LdcTask* task, const LdcTaskPart*
 
     LdpPicturePlaneDesc ppDesc{frame->m_temporalBuffer[data.enhancementTile->plane]->planeDesc};
 
-    if (!ldppApplyCmdBuffer(&pipeline->m_taskPool, NULL, data.enhancementTile, LdpFPS14, &ppDesc,
+    if (!ldppApplyCmdBuffer(pipeline->m_taskPool, task, data.enhancementTile, LdpFPS14, &ppDesc,
                             false, pipeline->m_configuration.forceScalar,
                             pipeline->m_configuration.highlightResiduals)) {
         VNLogError("ldppApplyCmdBufferTemporal failed");
@@ -1338,7 +1697,8 @@ LdcTaskDependency PipelineCPU::addTaskApplyCmdBufferTemporal(FrameCPU* frame,
 
 //// ApplyAddTemporal
 //
-// Add a temporal buffer to a picture plane.
+// Add a temporal buffer to a picture plane, and convert the sum to the output picture pixel format
+// in the same pass.
 //
 struct TaskApplyAddTemporalData
 {
@@ -1356,19 +1716,33 @@ void* PipelineCPU::taskApplyAddTemporal(LdcTask* task, const LdcTaskPart* /*part
     PipelineCPU* const pipeline{data.pipeline};
     FrameCPU* const frame{data.frame};
 
-    if (frame->m_skip || frame->m_passthrough) {
+    if (frame->m_skip) {
         pipeline->releaseTemporalBuffer(frame, data.planeIndex);
         return nullptr;
     }
 
     VNLogDebug("taskApplyAddTemporal timestamp:%" PRIx64 " plane:%d", data.frame->timestamp, data.planeIndex);
 
+    LdpPicturePlaneDesc srcPlane{};
+    frame->getIntermediatePlaneDesc(data.planeIndex, LOQ0, srcPlane);
+
+    const bool isNV12 = frame->outputPicture->layout.layoutInfo->format == LdpColorFormatNV12_8;
     LdpPicturePlaneDesc dstPlane{};
-    frame->getIntermediatePlaneDesc(data.planeIndex, LOQ0, dstPlane);
+    frame->getOutputPlaneDesc((isNV12 && data.planeIndex == 2) ? 1 : data.planeIndex, dstPlane);
 
-    if (!ldppPlaneBlit(&pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar, data.planeIndex,
-                       &frame->m_intermediateLayout[LOQ0], &frame->m_intermediateLayout[LOQ0],
-                       &frame->m_temporalBuffer[data.planeIndex]->planeDesc, &dstPlane, BMAdd)) {
+    bool ok = false;
+    if (frame->m_passthrough) {
+        pipeline->releaseTemporalBuffer(frame, data.planeIndex);
+        ok = ldppPlaneBlit(pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
+                           data.planeIndex, &frame->m_intermediateLayout[LOQ0],
+                           &frame->outputPicture->layout, &srcPlane, &dstPlane, BMCopy);
+    } else {
+        ok = ldppPlaneBlitAdd(pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
+                              data.planeIndex, &frame->m_intermediateLayout[LOQ0],
+                              &frame->outputPicture->layout, &srcPlane,
+                              &frame->m_temporalBuffer[data.planeIndex]->planeDesc, &dstPlane);
+    }
+    if (!ok) {
         VNLogError("ldppPlaneBlit out failed");
     }
 
@@ -1376,12 +1750,13 @@ void* PipelineCPU::taskApplyAddTemporal(LdcTask* task, const LdcTaskPart* /*part
 }
 
 LdcTaskDependency PipelineCPU::addTaskApplyAddTemporal(FrameCPU* frame, uint32_t planeIndex,
+                                                       LdcTaskDependency dst,
                                                        LdcTaskDependency temporalBuffer,
                                                        LdcTaskDependency imageBuffer)
 {
     const TaskApplyAddTemporalData data{this, frame, planeIndex};
 
-    const LdcTaskDependency inputs[] = {temporalBuffer, imageBuffer};
+    const LdcTaskDependency inputs[] = {dst, temporalBuffer, imageBuffer};
     const LdcTaskDependency output{ldcTaskDependencyAdd(&frame->m_taskGroup)};
 
     ldcTaskGroupAdd(&frame->m_taskGroup, inputs, VNArraySize(inputs), output, taskApplyAddTemporal,
@@ -1390,6 +1765,209 @@ LdcTaskDependency PipelineCPU::addTaskApplyAddTemporal(FrameCPU* frame, uint32_t
     return output;
 }
 
+//// ReconstructStriped
+//
+// Final upscale, temporal add and conversion to output for one plane, fused and run on stripes of
+// LOQ0 rows. Each stripe is upscaled into a band buffer that is still in cache for the temporal add
+// and output conversion, so no full LOQ0 intermediate plane is written. Halo rows needed by the
+// upscale kernel are read directly from the LOQ1 plane.
+//
+struct TaskReconstructStripedData
+{
+    PipelineCPU* pipeline;
+    FrameCPU* frame;
+    uint32_t planeIndex;
+    bool temporal;
+};
+
+// Shared state for all stripes of a plane
+struct StripeJobContext
+{
+    PipelineCPU* pipeline;
+    FrameCPU* frame;
+    uint32_t planeIndex;
+    bool temporal;
+    LdppUpscaleArgs upscaleArgs{};
+    LdpPicturePlaneDesc temporalPlane;
+    LdpPicturePlaneDesc outputPlane;
+    uint32_t height;             // LOQ0 plane height
+    uint32_t stripeRows;         // LOQ0 rows per stripe - always even
+    uint32_t bandStride;         // Row stride of band
+    uint32_t intermediateStride; // Row stride of the 2D upscale's intermediate rows
+    size_t bandSize;
+};
+
+// Smallest number of LOQ0 rows in a stripe
+static constexpr uint32_t kStripeMinRows = 16;
+
+// Address a buffer holding rows from `row` onwards with plane row indices. Rows before `row` are
+// never accessed.
+static inline uint8_t* bandRowBase(uint8_t* band, uint32_t row, uint32_t rowStride)
+{
+    return reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(band) -
+                                      static_cast<uintptr_t>(row) * rowStride);
+}
+
+LdcMemoryAllocation PipelineCPU::acquireStripeBand(size_t size)
+{
+    LdcMemoryAllocation band{};
+    if (m_stripeBands.tryPop(band) && band.size < size) {
+        VNFree(m_allocator, &band);
+    }
+    if (!VNIsAllocated(band)) {
+        VNAllocateAlignedArray(m_allocator, &band, uint8_t, kBufferRowAlignment, size);
+    }
+    return band;
+}
+
+void PipelineCPU::releaseStripeBand(LdcMemoryAllocation& band)
+{
+    if (!m_stripeBands.tryPush(band)) {
+        VNFree(m_allocator, &band);
+    }
+}
+
+bool PipelineCPU::stripeSlicedJob(void* argument, uint32_t offset, uint32_t count)
+{
+    VNTraceScoped();
+
+    const StripeJobContext& context{*static_cast<const StripeJobContext*>(argument)};
+    PipelineCPU* const pipeline{context.pipeline};
+    const FrameCPU* const frame{context.frame};
+    const bool forceScalar{pipeline->m_configuration.forceScalar};
+    const bool is2D{context.upscaleArgs.mode == Scale2D};
+
+    LdcMemoryAllocation band{pipeline->acquireStripeBand(context.bandSize)};
+    if (!VNIsAllocated(band)) {
+        VNLogError("Cannot allocate stripe band");
+        return false;
+    }
+    uint8_t* const bandRows{VNAllocationPtr(band, uint8_t)};
+    uint8_t* const intermediateRows{bandRows + static_cast<size_t>(context.stripeRows) * context.bandStride};
+
+    bool ok = true;
+    for (uint32_t stripe = offset; stripe < offset + count && ok; ++stripe) {
+        const uint32_t row = stripe * context.stripeRows;
+        const uint32_t rows = std::min(context.stripeRows, context.height - row);
+
+        // Band holds LOQ0 rows [row, row + rows)
+        LdpPicturePlaneDesc bandPlane{bandRowBase(bandRows, row, context.bandStride), context.bandStride};
+
+        // Upscale from LOQ1 into band
+        LdppUpscaleArgs upscaleArgs{context.upscaleArgs};
+        upscaleArgs.dstPlane = bandPlane;
+        const LdpPicturePlaneDesc intermediatePlane{
+            bandRowBase(intermediateRows, row, context.intermediateStride), context.intermediateStride};
+        ok = ldppUpscaleRows(&frame->globalConfig->kernel, &upscaleArgs, &intermediatePlane,
+                             is2D ? row / 2 : row, is2D ? (rows + 1) / 2 : rows);
+
+        // Add temporal buffer and convert to output
+        if (ok) {
+            LdpPicturePlaneDesc srcPlane{bandPlane};
+            LdpPicturePlaneDesc outputPlane{context.outputPlane};
+            if (context.temporal) {
+                LdpPicturePlaneDesc temporalPlane{context.temporalPlane};
+                ok = ldppPlaneBlitAddRows(forceScalar, context.planeIndex,
+                                          &frame->m_intermediateLayout[LOQ0],
+                                          &frame->outputPicture->layout, &srcPlane, &temporalPlane,
+                                          &outputPlane, row, rows);
+            } else {
+                ok = ldppPlaneBlitRows(forceScalar, context.planeIndex, &frame->m_intermediateLayout[LOQ0],
+                                       &frame->outputPicture->layout, &srcPlane, &outputPlane,
+                                       BMCopy, row, rows);
+            }
+        }
+    }
+
+    pipeline->releaseStripeBand(band);
+
+    if (!ok) {
+        VNLogError("Stripe reconstruction failed");
+    }
+    return ok;
+}
+
+void* PipelineCPU::taskReconstructStriped(LdcTask* task, const LdcTaskPart* /*part*/)
+{
+    VNTraceScoped();
+    assert(task->dataSize == sizeof(TaskReconstructStripedData));
+
+    const TaskReconstructStripedData& data{VNTaskData(task, TaskReconstructStripedData)};
+    PipelineCPU* const pipeline{data.pipeline};
+    FrameCPU* const frame{data.frame};
+
+    if (frame->m_skip) {
+        if (data.temporal) {
+            pipeline->releaseTemporalBuffer(frame, data.planeIndex);
+        }
+        return nullptr;
+    }
+
+    VNLogDebug("taskReconstructStriped timestamp:%" PRIx64 " plane:%d", frame->timestamp,
+               data.planeIndex);
+
+    StripeJobContext context{};
+    context.pipeline = pipeline;
+    context.frame = frame;
+    context.planeIndex = data.planeIndex;
+    context.temporal = data.temporal;
+
+    LdppUpscaleArgs& upscaleArgs{context.upscaleArgs};
+    upscaleArgs.srcLayout = &frame->m_intermediateLayout[LOQ1];
+    frame->getIntermediatePlaneDesc(data.planeIndex, LOQ1, upscaleArgs.srcPlane);
+    upscaleArgs.dstLayout = &frame->m_intermediateLayout[LOQ0];
+    upscaleArgs.planeIndex = data.planeIndex;
+    upscaleArgs.applyPA = frame->globalConfig->predictedAverageEnabled;
+    upscaleArgs.frameDither = frame->m_frameDither.strength ? &frame->m_frameDither : NULL;
+    upscaleArgs.mode = frame->globalConfig->scalingModes[LOQ0];
+    upscaleArgs.forceScalar = pipeline->m_configuration.forceScalar;
+    assert(upscaleArgs.mode != Scale0D);
+
+    if (data.temporal) {
+        context.temporalPlane = frame->m_temporalBuffer[data.planeIndex]->planeDesc;
+    }
+
+    const bool isNV12 = frame->outputPicture->layout.layoutInfo->format == LdpColorFormatNV12_8;
+    frame->getOutputPlaneDesc((isNV12 && data.planeIndex == 2) ? 1 : data.planeIndex, context.outputPlane);
+
+    // Size stripes so that each one's band, intermediate rows, temporal rows and output rows fit
+    // in the configured working set
+    const LdpPictureLayout* loq0Layout{&frame->m_intermediateLayout[LOQ0]};
+    context.height = ldpPictureLayoutPlaneHeight(loq0Layout, data.planeIndex);
+    context.bandStride = ldpPictureLayoutRowStride(loq0Layout, data.planeIndex);
+    context.intermediateStride = ldppUpscaleIntermediateRowStride(&upscaleArgs);
+
+    const uint32_t rowBytes = context.bandStride * (data.temporal ? 2 : 1) + context.intermediateStride +
+                              context.outputPlane.rowByteStride;
+    context.stripeRows = std::max(kStripeMinRows, (pipeline->m_configuration.stripeBytes / rowBytes) & ~1U);
+    context.bandSize = static_cast<size_t>(context.stripeRows) *
+                       (context.bandStride + context.intermediateStride);
+
+    const uint32_t stripeCount = (context.height + context.stripeRows - 1) / context.stripeRows;
+
+    if (!ldcTaskPoolAddSlicedDeferred(pipeline->m_taskPool, task, stripeSlicedJob, nullptr, &context,
+                                      sizeof(context), stripeCount, 1)) {
+        VNLogError("taskReconstructStriped failed");
+    }
+
+    return nullptr;
+}
+
+LdcTaskDependency PipelineCPU::addTaskReconstructStriped(FrameCPU* frame, uint32_t planeIndex,
+                                                         LdcTaskDependency dst, LdcTaskDependency src,
+                                                         LdcTaskDependency temporal)
+{
+    const bool hasTemporal = temporal != kTaskDependencyInvalid;
+    const TaskReconstructStripedData data{this, frame, planeIndex, hasTemporal};
+    const LdcTaskDependency inputs[] = {dst, src, temporal};
+    const LdcTaskDependency output{ldcTaskDependencyAdd(&frame->m_taskGroup)};
+
+    ldcTaskGroupAdd(&frame->m_taskGroup, inputs, hasTemporal ? 3 : 2, output, taskReconstructStriped,
+                    nullptr, 1, 1, sizeof(data), &data, "ReconstructStriped");
+
+    return output;
+}
+
 //// Passthrough
 //
 // Copy incoming picture plane to output picture
@@ -1410,7 +1988,7 @@ void* PipelineCPU::taskPassthrough(LdcTask* task, const LdcTaskPart* /*part*/)
     PipelineCPU* const pipeline{data.pipeline};
     const FrameCPU* const frame{data.frame};
 
-    if (frame->m_skip) {
+    if (frame->m_skip || frame->m_baseAliased) {
         return nullptr;
     }
 
@@ -1427,7 +2005,7 @@ void* PipelineCPU::taskPassthrough(LdcTask* task, const LdcTaskPart* /*part*/)
 
     VNLogDebug("taskPassthrough timestamp:%" PRIx64 " plane:%d", data.frame->timestamp, data.planeIndex);
 
-    if (!ldppPlaneBlit(&pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
+    if (!ldppPlaneBlit(pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
                        data.planeIndex, &frame->basePicture->layout, &frame->outputPicture->layout,
                        &srcPlane, &dstPlane, BMCopy)) {
         VNLogError("ldppPlaneBlit In failed");
@@ -1503,11 +2081,14 @@ void* PipelineCPU::taskBaseDone(LdcTask* task, const LdcTaskPart* /*part*/)
     VNLogDebug("taskBaseDone timestamp:%" PRIx64, data.frame->timestamp);
     assert(data.frame->basePicture);
 
-    // Generate event
-    data.pipeline->m_eventSink->generate(pipeline::EventBasePictureDone, data.frame->basePicture);
+    // An aliased base is sent back once the output picture is released
+    if (!data.frame->m_baseAliased) {
+        // Generate event
+        data.pipeline->m_eventSink->generate(pipeline::EventBasePictureDone, data.frame->basePicture);
 
-    // Send base picture back to API
-    data.pipeline->m_basePictureOutBuffer.push(data.frame->basePicture);
+        // Send base picture back to API
+        data.pipeline->m_basePictureOutBuffer.push(data.frame->basePicture);
+    }
 
     // Frame no longer has access to base picture
     data.frame->basePicture = nullptr;
@@ -1551,6 +2132,21 @@ void* PipelineCPU::taskOutputDone(LdcTask* task, const LdcTaskPart* /*part*/)
         common::ScopedLock lock(pipeline->m_interTaskMutex);
         frame->m_state = FrameStateDone;
 
+        if (threadTimeMicroseconds(0) > frame->m_deadline) {
+            pipeline->m_deadlineMissCount++;
+            VNLogDebug("taskOutputDone timestamp:%" PRIx64 " missed deadline", frame->timestamp);
+            VNMetricUInt32("frameDeadlineMisses", pipeline->m_deadlineMissCount);
+        }
+
+        if (pipeline->m_seekTime != 0 && !frame->m_skip) {
+            const uint64_t timeToFirstFrame{threadTimeMicroseconds(0) - pipeline->m_seekTime};
+            pipeline->m_seekTime = 0;
+            VNLogDebug("taskOutputDone timestamp:%" PRIx64 " first frame after seek: %" PRIu64 "us",
+                       frame->timestamp, timeToFirstFrame);
+            VNMetricUInt32("timeToFirstFrameAfterSeek",
+                           static_cast<uint32_t>(std::min<uint64_t>(timeToFirstFrame, UINT32_MAX)));
+        }
+
         // Build the decode info for the frame
         frame->m_decodeInfo.timestamp = frame->timestamp;
         frame->m_decodeInfo.hasBase = true;
@@ -1620,12 +2216,174 @@ void PipelineCPU::addTaskTemporalRelease(FrameCPU* frame, const LdcTaskDependenc
                     taskTemporalRelease, nullptr, 1, 1, sizeof(data), &data, "TemporalRelease");
 }
 
-// Fill out a task group given a frame configuration
+//// Task graph cache
+//
+// The enhancement task graph only depends on a few configuration values - the graph is recorded
+// the first time a configuration is seen, and later frames with the same configuration add the
+// recorded tasks in one step.
+//
+// Task data that refers to the frame is patched as the graph is added. Recorded enhancement tile
+// pointers are replaced by tile indices.
+//
+void PipelineCPU::makeTaskGraphKey(const FrameCPU* frame, TaskGraphKey& key)
+{
+    memset(&key, 0, sizeof(key));
+
+    const LdeFrameConfig& frameConfig{frame->config};
+    const LdeGlobalConfig& globalConfig{*frame->globalConfig};
+
+    key.numImagePlanes = frame->numImagePlanes();
+    key.numPlanes = globalConfig.numPlanes;
+    key.temporalEnabled = globalConfig.temporalEnabled;
+    key.passthrough = frame->m_passthrough;
+    key.frameConfigSet = frameConfig.frameConfigSet;
+    key.baseDepth = globalConfig.baseDepth;
+    key.enhancedDepth = globalConfig.enhancedDepth;
+    for (uint32_t loq = 0; loq < LOQEnhancedCount; ++loq) {
+        key.loqEnabled[loq] = frameConfig.loqEnabled[loq];
+        key.scalingModes[loq] = globalConfig.scalingModes[loq];
+        for (uint32_t plane = 0; plane < RCMaxPlanes; ++plane) {
+            key.numTiles[plane][loq] = globalConfig.numTiles[plane][loq];
+        }
+    }
+    key.enhancementTileCount = frame->enhancementTileCount;
+}
+
+TaskGraphTemplate* PipelineCPU::findTaskGraph(const TaskGraphKey& key)
+{
+    for (TaskGraphTemplate& tg : m_taskGraphs) {
+        if (tg.valid && memcmp(&tg.key, &key, sizeof(key)) == 0) {
+            tg.lastUsed = ++m_taskGraphsUseCount;
+            return &tg;
+        }
+    }
+    return nullptr;
+}
+
+TaskGraphTemplate* PipelineCPU::replaceTaskGraph(const TaskGraphKey& key)
+{
+    TaskGraphTemplate* tg = &m_taskGraphs[0];
+    for (TaskGraphTemplate& candidate : m_taskGraphs) {
+        if (!candidate.valid) {
+            tg = &candidate;
+            break;
+        }
+        if (candidate.lastUsed < tg->lastUsed) {
+            tg = &candidate;
+        }
+    }
+
+    tg->key = key;
+    tg->valid = false;
+    tg->lastUsed = ++m_taskGraphsUseCount;
+    return tg;
+}
+
+// Every task's data starts with these members
+struct TaskFrameData
+{
+    PipelineCPU* pipeline;
+    FrameCPU* frame;
+    LdpEnhancementTile* enhancementTile; // Only for tile tasks
+};
+
+static_assert(offsetof(TaskBaseDoneData, frame) == offsetof(TaskFrameData, frame));
+static_assert(offsetof(TaskGenerateCmdBufferData, enhancementTile) ==
+              offsetof(TaskFrameData, enhancementTile));
+static_assert(offsetof(TaskApplyCmdBufferDirectData, enhancementTile) ==
+              offsetof(TaskFrameData, enhancementTile));
+static_assert(offsetof(TaskApplyCmdBufferTemporalData, enhancementTile) ==
+              offsetof(TaskFrameData, enhancementTile));
+
+bool PipelineCPU::isTileTask(LdcTaskFunction function)
+{
+    return function == taskGenerateCmdBuffer || function == taskApplyCmdBufferDirect ||
+           function == taskApplyCmdBufferTemporal;
+}
+
+void PipelineCPU::taskGraphUnbind(void* context, LdcTaskFunction function, void* data, size_t dataSize)
+{
+    const FrameCPU* frame{static_cast<const FrameCPU*>(context)};
+    TaskFrameData& frameData{*static_cast<TaskFrameData*>(data)};
+    assert(dataSize >= offsetof(TaskFrameData, enhancementTile));
+    VNUnused(dataSize);
+
+    frameData.frame = nullptr;
+
+    if (isTileTask(function)) {
+        assert(dataSize >= sizeof(TaskFrameData));
+        const uintptr_t tileIdx{
+            static_cast<uintptr_t>(frameData.enhancementTile - frame->getEnhancementTile(0))};
+        frameData.enhancementTile = reinterpret_cast<LdpEnhancementTile*>(tileIdx);
+    }
+}
+
+void PipelineCPU::taskGraphBind(void* context, LdcTaskFunction function, void* data, size_t dataSize)
+{
+    FrameCPU* frame{static_cast<FrameCPU*>(context)};
+    TaskFrameData& frameData{*static_cast<TaskFrameData*>(data)};
+    VNUnused(dataSize);
+
+    frameData.frame = frame;
+
+    if (isTileTask(function)) {
+        const uintptr_t tileIdx = reinterpret_cast<uintptr_t>(frameData.enhancementTile);
+        frameData.enhancementTile = frame->getEnhancementTile(static_cast<uint32_t>(tileIdx));
+    }
+}
+
+// Fill out a task group given a frame configuration - either from a cached graph, or by adding
+// tasks one by one.
 //
 void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTimestamp)
 {
     VNTraceScoped();
 
+    if (frame->config.sharpenType != STDisabled && frame->config.sharpenStrength != 0.0f) {
+        VNLogWarning("S-Filter is configured in stream, but not supported by decoder.");
+    }
+
+    if (!m_configuration.taskGraphCache) {
+        buildTasksEnhancement(frame, previousTimestamp);
+        return;
+    }
+
+    TaskGraphKey key;
+    makeTaskGraphKey(frame, key);
+
+    if (TaskGraphTemplate* tg = findTaskGraph(key)) {
+        if (ldcTaskGroupInstantiate(&frame->m_taskGroup, &tg->graph, taskGraphBind, frame)) {
+            for (uint32_t plane = 0; plane < RCMaxPlanes; ++plane) {
+                if (tg->temporalDeps[plane] != kTaskDependencyInvalid) {
+                    connectTemporalBuffer(frame, previousTimestamp, plane, tg->temporalDeps[plane]);
+                }
+            }
+            return;
+        }
+        VNLogError("Cannot instantiate task graph for %" PRIx64, frame->timestamp);
+        tg->valid = false;
+    }
+
+    // Record a new graph whilst adding tasks
+    //
+    // The group is held whilst recording, so that no tasks are done before the users of the base
+    // picture are looked up - otherwise the recorded BaseDone task could miss some of them.
+    TaskGraphTemplate* tg = replaceTaskGraph(key);
+
+    ldcTaskGroupBlock(&frame->m_taskGroup);
+    ldcTaskGroupRecordBegin(&frame->m_taskGroup, &tg->graph);
+    buildTasksEnhancement(frame, previousTimestamp);
+    tg->valid = ldcTaskGroupRecordEnd(&frame->m_taskGroup);
+    ldcTaskGroupUnblock(&frame->m_taskGroup);
+
+    ldcTaskGraphPatch(&tg->graph, taskGraphUnbind, frame);
+    for (uint32_t plane = 0; plane < RCMaxPlanes; ++plane) {
+        tg->temporalDeps[plane] = frame->m_depTemporalBuffer[plane];
+    }
+}
+
+void PipelineCPU::buildTasksEnhancement(FrameCPU* frame, uint64_t previousTimestamp)
+{
     // Convenience values for readability
     const LdeFrameConfig& frameConfig{frame->config};
     const LdeGlobalConfig& globalConfig{*frame->globalConfig};
@@ -1633,10 +2391,6 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
 
     uint32_t enhancementTileIdx = 0;
 
-    if (frame->config.sharpenType != STDisabled && frame->config.sharpenStrength != 0.0f) {
-        VNLogWarning("S-Filter is configured in stream, but not supported by decoder.");
-    }
-
     //// LoQ 1
     //
     LdcTaskDependency basePlanes[kLdpPictureMaxNumPlanes] = {};
@@ -1701,7 +2455,10 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
     LdcTaskDependency upsampledPlanes[kLdpPictureMaxNumPlanes] = {};
 
     for (uint8_t plane = 0; plane < numImagePlanes; ++plane) {
-        if (globalConfig.scalingModes[LOQ0] != Scale0D) {
+        if (frame->isStripeFused(plane)) {
+            // Upscale is part of the fused reconstruction below
+            upsampledPlanes[plane] = basePlanes[plane];
+        } else if (globalConfig.scalingModes[LOQ0] != Scale0D) {
             upsampledPlanes[plane] = addTaskUpsample(frame, LOQ1, plane, basePlanes[plane]);
         } else {
             upsampledPlanes[plane] = basePlanes[plane];
@@ -1711,6 +2468,8 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
     //// LoQ 0
     //
     LdcTaskDependency reconstructedPlanes[kLdpPictureMaxNumPlanes] = {};
+    LdcTaskDependency outputPlanes[kLdpPictureMaxNumPlanes] = {};
+    std::fill_n(outputPlanes, kLdpPictureMaxNumPlanes, kTaskDependencyInvalid);
 
     for (uint8_t plane = 0; plane < numImagePlanes; ++plane) {
         const bool isEnhanced = frame->isEnhanced(LOQ0, plane);
@@ -1754,12 +2513,27 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
             }
 
             // Always add temporal buffer, even if no enhancement this frame
-            if (plane < globalConfig.numPlanes) {
-                reconstructedPlanes[plane] = addTaskApplyAddTemporal(frame, plane, temporal, recon);
+            if (frame->isStripeFused(plane)) {
+                reconstructedPlanes[plane] = addTaskReconstructStriped(
+                    frame, plane, frame->m_depOutputPicture, recon, temporal);
+                outputPlanes[plane] = reconstructedPlanes[plane];
+                if (plane < globalConfig.numPlanes) {
+                    addTaskTemporalRelease(frame, reconstructedPlanes, plane);
+                }
+            } else if (plane < globalConfig.numPlanes) {
+                // Temporal add also converts to output
+                reconstructedPlanes[plane] = addTaskApplyAddTemporal(
+                    frame, plane, frame->m_depOutputPicture, temporal, recon);
+                outputPlanes[plane] = reconstructedPlanes[plane];
                 addTaskTemporalRelease(frame, reconstructedPlanes, plane);
             } else {
                 reconstructedPlanes[plane] = recon;
             }
+        } else if (frame->isStripeFused(plane)) {
+            // No LOQ0 residuals to apply to the whole plane
+            reconstructedPlanes[plane] = addTaskReconstructStriped(
+                frame, plane, frame->m_depOutputPicture, recon, kTaskDependencyInvalid);
+            outputPlanes[plane] = reconstructedPlanes[plane];
         } else {
             if (isEnhanced && frameConfig.loqEnabled[LOQ0]) {
                 // Enhancement residuals
@@ -1793,10 +2567,12 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
 
     assert(enhancementTileIdx == frame->enhancementTileCount);
 
-    LdcTaskDependency outputPlanes[kLdpPictureMaxNumPlanes] = {};
-
     // Convert any enhanced planes back to output
     for (uint8_t plane = 0; plane < numImagePlanes; ++plane) {
+        if (outputPlanes[plane] != kTaskDependencyInvalid) {
+            // Already written by stripe reconstruction or temporal add
+            continue;
+        }
         outputPlanes[plane] =
             addTaskConvertFromInternal(frame, plane, globalConfig.baseDepth, globalConfig.enhancedDepth,
                                        frame->m_depOutputPicture, reconstructedPlanes[plane]);
@@ -1805,11 +2581,15 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
     // Send output when all planes are ready
     addTaskOutputDone(frame, outputPlanes, numImagePlanes);
 
-    // Send base when all tasks that use it have completed
-    LdcTaskDependency deps[kLdpPictureMaxNumPlanes] = {};
+    // Send base when all tasks that use it have completed - per plane, that can be a conversion
+    // and upscales reading the base directly
+    LdcTaskDependency deps[kLdpPictureMaxNumPlanes * LOQMaxCount] = {};
     uint32_t depsCount = 0;
-    ldcTaskGroupFindOutputSetFromInput(&frame->m_taskGroup, frame->m_depBasePicture, deps,
-                                       kLdpPictureMaxNumPlanes, &depsCount);
+    if (!ldcTaskGroupFindOutputSetFromInput(&frame->m_taskGroup, frame->m_depBasePicture, deps,
+                                            VNArraySize(deps), &depsCount)) {
+        VNLogError("Too many tasks using base picture: %" PRIx64, frame->timestamp);
+        depsCount = VNArraySize(deps);
+    }
     addTaskBaseDone(frame, deps, depsCount);
 }
 
@@ -1825,6 +2605,9 @@ void PipelineCPU::generateTasksPassthrough(FrameCPU* frame)
         numImagePlanes = ldpPictureLayoutPlanes(&frame->basePicture->layout);
     }
 
+    // Output picture may alias the base picture when it is connected, making the copies no-ops
+    frame->m_passthroughZeroCopy = m_configuration.passthroughZeroCopy;
+
     LdcTaskDependency outputPlanes[kLdpPictureMaxNumPlanes] = {};
 
     for (uint8_t plane = 0; plane < numImagePlanes; ++plane) {
@@ -1837,6 +2620,41 @@ void PipelineCPU::generateTasksPassthrough(FrameCPU* frame)
     addTaskBaseDone(frame, outputPlanes, numImagePlanes);
 }
 
+// Cancel the tasks of a skipped frame that have not started yet - the cancelled tasks resolve their
+// outputs as soon as their inputs are met, without any parts going through the workers. The tasks
+// that hand back the frame's output picture, base picture and temporal buffers do so from
+// finishCancelledTask().
+//
+void PipelineCPU::cancelFrameTasks(FrameCPU* frame)
+{
+    const uint32_t count{
+        ldcTaskGroupCancel(&frame->m_taskGroup, keepOnCancel, finishCancelledTask, nullptr)};
+    VNLogDebug("cancelFrameTasks timestamp:%" PRIx64 " cancelled:%" PRIu32, frame->timestamp, count);
+    VNUnused(count);
+}
+
+// Residuals are still accumulated into temporal buffers for skipped frames, so that following
+// frames are reconstructed correctly.
+//
+bool PipelineCPU::keepOnCancel(void* /*context*/, LdcTaskFunction function, const void* /*data*/,
+                               size_t /*dataSize*/)
+{
+    return function == taskApplyCmdBufferTemporal;
+}
+
+// Cancelled tasks that release resources still run their skipped frame path - which does nothing
+// but release. Called with the frame's task group locked.
+//
+void PipelineCPU::finishCancelledTask(void* /*context*/, LdcTask* task)
+{
+    if (task->taskFunction == taskOutputDone || task->taskFunction == taskBaseDone ||
+        task->taskFunction == taskTemporalRelease || task->taskFunction == taskApplyAddTemporal ||
+        task->taskFunction == taskReconstructStriped) {
+        const LdcTaskPart part{task, 0, task->iterationsTotalCount};
+        task->taskFunction(task, &part);
+    }
+}
+
 #ifdef VN_SDK_LOG_ENABLE_DEBUG
 // Dump frame and index state
 //
@@ -22,6 +22,7 @@
 #include <LCEVC/common/threads.h>
 //
 #include <LCEVC/common/class_utils.hpp>
+#include <LCEVC/common/memory_numa.h>
 #include <LCEVC/common/ring_buffer.hpp>
 #include <LCEVC/common/rolling_arena.h>
 #include <LCEVC/common/task_pool.h>
@@ -67,6 +68,27 @@ struct TemporalBuffer
     LdcMemoryAllocation allocation;
 };
 
+// Shape of an intermediate plane buffer - spare buffers are only reused for an identical shape
+//
+struct IntermediateBufferKey
+{
+    LdpColorFormat format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t rowStride;
+
+    // Pool generation when the buffer was allocated - bumped when the frame size changes
+    uint32_t generation;
+};
+
+// A spare intermediate plane buffer, held by the pipeline between frames
+//
+struct IntermediateBuffer
+{
+    IntermediateBufferKey key;
+    LdcMemoryAllocation allocation;
+};
+
 // A base picture reference and other arguments from sendBase()
 //
 // Used for pending base pictures, before association with frames.
@@ -79,6 +101,40 @@ struct BasePicture
     void* userData;
 };
 
+// The parts of a frame's configuration that determine the shape of its enhancement task graph
+//
+// Cleared with memset before filling in, so that keys can be compared with memcmp.
+//
+struct TaskGraphKey
+{
+    uint8_t numImagePlanes;
+    uint8_t numPlanes;
+    bool temporalEnabled;
+    bool passthrough;
+    bool frameConfigSet;
+    bool loqEnabled[LOQEnhancedCount];
+    LdeScalingMode scalingModes[LOQEnhancedCount];
+    LdeBitDepth baseDepth;
+    LdeBitDepth enhancedDepth;
+    uint32_t numTiles[RCMaxPlanes][LOQEnhancedCount];
+    uint32_t enhancementTileCount;
+};
+
+// A recorded enhancement task graph, and the frame state needed to instantiate it
+//
+struct TaskGraphTemplate
+{
+    TaskGraphKey key;
+    LdcTaskGraph graph;
+
+    // Temporal buffer dependency for each plane, or kTaskDependencyInvalid
+    LdcTaskDependency temporalDeps[RCMaxPlanes];
+
+    // For picking least recently used template to replace
+    uint64_t lastUsed;
+    bool valid;
+};
+
 // PipelineCPU
 //
 class PipelineCPU : public pipeline::Pipeline
@@ -91,6 +147,9 @@ public:
     LdcReturnCode sendBasePicture(uint64_t timestamp, LdpPicture* basePicture, uint32_t timeoutUs,
                                   void* userData) override;
     LdcReturnCode sendEnhancementData(uint64_t timestamp, const uint8_t* data, uint32_t byteSize) override;
+    LdcReturnCode sendEnhancementDataExternal(uint64_t timestamp, const uint8_t* data, uint32_t byteSize,
+                                              pipeline::EnhancementDataReleaseFunction release,
+                                              void* releaseUserData) override;
     LdcReturnCode sendOutputPicture(LdpPicture* outputPicture) override;
 
     LdpPicture* receiveOutputPicture(LdpDecodeInformation& decodeInfoOut) override;
@@ -112,7 +171,12 @@ public:
     // Accessors for use by frames
     const PipelineConfigCPU& configuration() const { return m_configuration; }
     LdcMemoryAllocator* allocator() const { return m_allocator; }
-    LdcTaskPool* taskPool() { return &m_taskPool; }
+    LdcMemoryAllocator* frameAllocator() { return &m_rollingArena.allocator; }
+    LdcTaskPool* taskPool() { return m_taskPool; }
+    LdcTaskPoolClient* taskPoolClient()
+    {
+        return (m_taskPool != &m_ownTaskPool) ? &m_taskPoolClient : nullptr;
+    }
     LdppDitherGlobal* globalDitherBuffer() { return &m_dither; }
 
     // Buffer allocation
@@ -123,10 +187,23 @@ public:
     PictureCPU* allocatePicture();
     void releasePicture(PictureCPU* picture);
 
+    //// Intermediate buffer pool
+
+    // Note the size of a frame being initialized, and get the pool generation for that size
+    uint32_t intermediateBufferGeneration(LdpColorFormat format, uint32_t width, uint32_t height);
+
+    // Get an intermediate plane buffer, reusing a spare one of the same shape if possible
+    bool allocateIntermediateBuffer(const IntermediateBufferKey& key, uint32_t size,
+                                    LdcMemoryAllocation& allocation);
+
+    // Return an intermediate plane buffer to the pool, or free it
+    void releaseIntermediateBuffer(const IntermediateBufferKey& key, LdcMemoryAllocation& allocation);
+
     //// Temporal buffer management
 
     // Mark a frame as needing a temporal buffer, given possible previous timestamp
     LdcTaskDependency requireTemporalBuffer(FrameCPU* frame, uint64_t timestamp, uint32_t plane);
+    void connectTemporalBuffer(FrameCPU* frame, uint64_t timestamp, uint32_t plane, LdcTaskDependency dep);
 
     // Mark the frame as having finished with it's temporal buffer
     void releaseTemporalBuffer(FrameCPU* frame, uint32_t plane);
@@ -136,6 +213,14 @@ public:
 
     void generateTasksPassthrough(FrameCPU* frame);
 
+    // Cancel the not yet started tasks of a skipped frame
+    void cancelFrameTasks(FrameCPU* frame);
+    static bool keepOnCancel(void* context, LdcTaskFunction function, const void* data, size_t dataSize);
+    static void finishCancelledTask(void* context, LdcTask* task);
+
+    // Add enhancement tasks one by one
+    void buildTasksEnhancement(FrameCPU* frame, uint64_t previousTimestamp);
+
     void updateTemporalBufferDesc(TemporalBuffer* buffer, const TemporalBufferDesc& desc) const;
 
 #ifdef VN_SDK_LOG_ENABLE_DEBUG
@@ -150,6 +235,9 @@ private:
 
     // Given a timestamp, either find existing frame, or create a new one
     FrameCPU* allocateFrame(uint64_t timestamp);
+    LdcReturnCode addEnhancementData(uint64_t timestamp, const uint8_t* data, uint32_t byteSize,
+                                     pipeline::EnhancementDataReleaseFunction release,
+                                     void* releaseUserData);
 
     // Find the Frame associated with a timestamp, or NULL if none.
     FrameCPU* findFrame(uint64_t timestamp);
@@ -167,6 +255,12 @@ private:
     // Assign incoming output pictures to Frames
     void connectOutputPictures();
 
+    // Point a passthrough frame's output picture at the base picture's planes, if compatible
+    bool aliasPassthroughBase(FrameCPU* frame);
+
+    // Hand back any base picture aliased by an output picture that has been returned
+    void releaseAliasedBase(PictureCPU* picture);
+
     // Number of outstanding frames
     uint32_t frameLatency() const;
 
@@ -176,6 +270,14 @@ private:
     // Try to match a frame to current temporal buffer(s)
     TemporalBuffer* matchTemporalBuffer(FrameCPU* frame, uint32_t plane);
 
+    // Cached task graphs
+    static void makeTaskGraphKey(const FrameCPU* frame, TaskGraphKey& key);
+    TaskGraphTemplate* findTaskGraph(const TaskGraphKey& key);
+    TaskGraphTemplate* replaceTaskGraph(const TaskGraphKey& key);
+    static bool isTileTask(LdcTaskFunction function);
+    static void taskGraphUnbind(void* context, LdcTaskFunction function, void* data, size_t dataSize);
+    static void taskGraphBind(void* context, LdcTaskFunction function, void* data, size_t dataSize);
+
     // Create new tasks
     LdcTaskDependency addTaskGenerateCmdBuffer(FrameCPU* frame, LdpEnhancementTile* enhancementTile);
     LdcTaskDependency addTaskConvertToInternal(FrameCPU* frame, uint32_t planeIndex, uint32_t baseDepth,
@@ -195,7 +297,8 @@ private:
                                                     LdcTaskDependency cmdBufferDep);
 
     LdcTaskDependency addTaskApplyAddTemporal(FrameCPU* frame, uint32_t planeIndex,
-                                              LdcTaskDependency temporalDep, LdcTaskDependency sourceDep);
+                                              LdcTaskDependency destDep, LdcTaskDependency temporalDep,
+                                              LdcTaskDependency sourceDep);
 
     LdcTaskDependency addTaskWaitForMany(FrameCPU* frame, const LdcTaskDependency* deps, uint32_t numDeps);
     void addTaskBaseDone(FrameCPU* frame, const LdcTaskDependency* inputDeps, uint32_t inputDepsCount);
@@ -204,6 +307,14 @@ private:
                                          LdcTaskDependency destDep, LdcTaskDependency srcDep);
 
     void addTaskTemporalRelease(FrameCPU* frame, const LdcTaskDependency* deps, uint32_t planeIndex);
+    LdcTaskDependency addTaskReconstructStriped(FrameCPU* frame, uint32_t planeIndex,
+                                                LdcTaskDependency dst, LdcTaskDependency src,
+                                                LdcTaskDependency temporal);
+
+    // Band buffers for stripe-fused reconstruction
+    LdcMemoryAllocation acquireStripeBand(size_t size);
+    void releaseStripeBand(LdcMemoryAllocation& band);
+    static bool stripeSlicedJob(void* argument, uint32_t offset, uint32_t count);
     // // Task bodies
     static void* taskConvertToInternal(LdcTask* task, const LdcTaskPart* part);
     static void* taskConvertFromInternal(LdcTask* task, const LdcTaskPart* part);
@@ -217,6 +328,7 @@ private:
     static void* taskBaseDone(LdcTask* task, const LdcTaskPart* part);
     static void* taskPassthrough(LdcTask* task, const LdcTaskPart* part);
     static void* taskTemporalRelease(LdcTask* task, const LdcTaskPart* part);
+    static void* taskReconstructStriped(LdcTask* task, const LdcTaskPart* part);
 
     // Configuration from builder
     const PipelineConfigCPU m_configuration;
@@ -224,8 +336,9 @@ private:
     // Interface to event mechanism
     pipeline::EventSink* m_eventSink = nullptr;
 
-    // The system allocator to use
+    // The system allocator to use - wrapped by m_numaAllocator if a NUMA node is configured
     LdcMemoryAllocator* m_allocator = nullptr;
+    LdcMemoryAllocatorNuma m_numaAllocator = {};
 
     // A rolling memory allocator for per-frame blocks
     LdcMemoryAllocatorRollingArena m_rollingArena = {};
@@ -233,8 +346,12 @@ private:
     // Enhancement configuration pool
     LdeConfigPool m_configPool = {};
 
-    // Task pool
-    LdcTaskPool m_taskPool = {};
+    // Task pool - either m_ownTaskPool, or the process-wide shared pool
+    LdcTaskPool* m_taskPool = nullptr;
+    LdcTaskPool m_ownTaskPool = {};
+
+    // This pipeline's share of the task pool, if it is shared
+    LdcTaskPoolClient m_taskPoolClient = {};
 
     // Vector of Buffer allocations
     lcevc_dec::common::Vector<LdcMemoryAllocation> m_buffers;
@@ -271,11 +388,26 @@ private:
     // Pending base pictures
     lcevc_dec::common::Vector<BasePicture> m_basePicturePending;
 
-    // Base pictures Out - thread safe FIFO
-    lcevc_dec::common::RingBuffer<LdpPicture*> m_basePictureOutBuffer;
+    // Base pictures Out - thread safe FIFO, pushed from frame tasks on any worker
+    lcevc_dec::common::RingBuffer<LdpPicture*, LdcRingBufferModeMPMC> m_basePictureOutBuffer;
 
     // Output pictures available for rendering - thread safe FIFO
-    lcevc_dec::common::RingBuffer<LdpPicture*> m_outputPictureAvailableBuffer;
+    lcevc_dec::common::RingBuffer<LdpPicture*, LdcRingBufferModeMPMC> m_outputPictureAvailableBuffer;
+
+    // Spare intermediate plane buffers, up to configured limit
+    lcevc_dec::common::Vector<IntermediateBuffer> m_intermediateBuffers;
+
+    // Frame size that spare intermediate buffers are for, and its generation
+    LdpColorFormat m_intermediateBufferFormat{LdpColorFormatUnknown};
+    uint32_t m_intermediateBufferWidth{0};
+    uint32_t m_intermediateBufferHeight{0};
+    uint32_t m_intermediateBufferGeneration{0};
+
+    // Protects m_intermediateBuffers and the intermediate buffer generation
+    common::Mutex m_intermediateBuffersMutex;
+
+    // Spare band buffers for stripe-fused reconstruction - one is taken by each running stripe job
+    lcevc_dec::common::RingBuffer<LdcMemoryAllocation, LdcRingBufferModeMPMC> m_stripeBands;
 
     // Global dither module
     LdppDitherGlobal m_dither;
@@ -288,6 +420,18 @@ private:
 
     // Signalled when frames are done, whilst holding m_interTaskMutex
     common::CondVar m_interTaskFrameDone;
+
+    // Number of frames that were done after their deadline - protected by m_interTaskMutex
+    uint32_t m_deadlineMissCount{0};
+
+    // Time of the last skip or dropping synchronize, until the next frame that is not skipped is
+    // done, 0 otherwise - protected by m_interTaskMutex
+    uint64_t m_seekTime{0};
+
+    // Recorded enhancement task graphs for recently seen frame configurations
+    static constexpr uint32_t kTaskGraphCacheSize = 4;
+    TaskGraphTemplate m_taskGraphs[kTaskGraphCacheSize]{};
+    uint64_t m_taskGraphsUseCount{0};
 };
 
 } // namespace lcevc_dec::pipeline_cpu
@@ -0,0 +1,81 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#include "shared_task_pool.h"
+//
+#include <LCEVC/common/check.h>
+#include <LCEVC/common/log.h>
+#include <LCEVC/common/memory.h>
+//
+#include <cstring>
+#include <mutex>
+
+namespace lcevc_dec::pipeline_cpu {
+
+namespace {
+    // NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+    std::mutex sharedTaskPoolMutex;
+    LdcTaskPool sharedTaskPool = {};
+    uint32_t sharedTaskPoolUsers = 0;
+    // NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+} // namespace
+
+LdcTaskPool* sharedTaskPoolAcquire(uint32_t numThreads, uint32_t numReservedTasks,
+                                   const ThreadCpuSet* affinity)
+{
+    std::scoped_lock lock(sharedTaskPoolMutex);
+
+    if (sharedTaskPoolUsers == 0) {
+        // Pool outlives any one pipeline - so uses the system allocator rather than the pipeline's
+        if (!ldcTaskPoolInitializeAffinity(&sharedTaskPool, ldcMemoryAllocatorMalloc(),
+                                           ldcMemoryAllocatorMalloc(), numThreads,
+                                           numReservedTasks, affinity)) {
+            VNLogError("Cannot create shared task pool");
+            return nullptr;
+        }
+        VNLogDebug("Shared task pool created with %u threads", numThreads);
+    } else {
+        // Later users get the pool as it was created by the first
+        const bool affinitySet = affinity && !threadCpuSetIsEmpty(affinity);
+        if (numThreads != sharedTaskPool.threadCount) {
+            VNLogWarning("Shared task pool has %u threads - ignoring request for %u",
+                         sharedTaskPool.threadCount, numThreads);
+        }
+        if (affinitySet != sharedTaskPool.affinitySet ||
+            (affinitySet &&
+             memcmp(affinity, &sharedTaskPool.affinity, sizeof(ThreadCpuSet)) != 0)) {
+            VNLogWarning("Shared task pool was created with a different CPU affinity - ignoring "
+                         "requested affinity");
+        }
+    }
+
+    sharedTaskPoolUsers++;
+    return &sharedTaskPool;
+}
+
+void sharedTaskPoolRelease(LdcTaskPool* taskPool)
+{
+    std::scoped_lock lock(sharedTaskPoolMutex);
+
+    VNCheck(taskPool == &sharedTaskPool);
+    VNCheck(sharedTaskPoolUsers > 0);
+
+    sharedTaskPoolUsers--;
+    if (sharedTaskPoolUsers == 0) {
+        ldcTaskPoolDestroy(&sharedTaskPool);
+        VNLogDebug("Shared task pool destroyed");
+    }
+}
+
+} // namespace lcevc_dec::pipeline_cpu
@@ -0,0 +1,43 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// SharedTaskPool
+//
+// A process-wide task pool that can be shared between pipelines, rather than each pipeline
+// starting its own set of worker threads.
+//
+#ifndef VN_LCEVC_PIPELINE_CPU_SHARED_TASK_POOL_H
+#define VN_LCEVC_PIPELINE_CPU_SHARED_TASK_POOL_H
+
+#include <LCEVC/common/task_pool.h>
+//
+#include <cstdint>
+
+namespace lcevc_dec::pipeline_cpu {
+
+// Get the shared task pool, creating it with the given number of worker threads and CPU affinity
+// if this is the first user. Later users get the pool as it is, with a warning if they asked for
+// different threads or affinity. Each successful call should be matched by a call to
+// sharedTaskPoolRelease().
+//
+LdcTaskPool* sharedTaskPoolAcquire(uint32_t numThreads, uint32_t numReservedTasks,
+                                   const ThreadCpuSet* affinity);
+
+// Release a reference to the shared task pool - the pool is destroyed when the last user releases it.
+//
+void sharedTaskPoolRelease(LdcTaskPool* taskPool);
+
+} // namespace lcevc_dec::pipeline_cpu
+
+#endif // VN_LCEVC_PIPELINE_CPU_SHARED_TASK_POOL_H
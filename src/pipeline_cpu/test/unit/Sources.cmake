@@ -13,7 +13,7 @@
 # THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE.
 list(APPEND SOURCES "src/test_pipeline_cpu.cpp")
 
-set(HEADERS)
+set(HEADERS "src/data.h")
 
 # Convenience
 set(ALL_FILES "CMakeLists.txt" "Sources.cmake" ${HEADERS} ${SOURCES} ${CONFIG})
@@ -17,10 +17,18 @@
 #include <LCEVC/pipeline/pipeline.h>
 #include <LCEVC/pipeline/types.h>
 #include <LCEVC/pipeline_cpu/create_pipeline.h>
+#include <LCEVC/utility/md5.h>
+//
+#include "data.h"
 //
 #include <gtest/gtest.h>
 //
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 using namespace lcevc_dec::pipeline;
 
@@ -61,3 +69,200 @@ TEST_F(PipelineCPUFixture, AllocatePicturesManaged)
     auto picture = mPipeline->allocPictureManaged(pictureDesc);
     ASSERT_TRUE(picture);
 }
+
+// Decoding - sends a few frames of a 960x540 to 1920x1080 stream through the pipeline
+//
+namespace {
+
+constexpr uint32_t kFrameCount = 3;
+constexpr auto kEventTimeout = std::chrono::seconds(10);
+const LdpPictureDesc kBaseDesc{960, 540, LdpColorFormatI420_8};
+const LdpPictureDesc kOutputDesc{1920, 1080, LdpColorFormatI420_8};
+
+// Counts events from the pipeline, so that tests can wait for them
+class EventCounter : public EventSink
+{
+public:
+    void enableEvents(const std::vector<int32_t>& /*enabledEvents*/) override {}
+    bool isEventEnabled(uint8_t /*eventType*/) const override { return true; }
+
+    void generate(uint8_t eventType, LdpPicture* /*picture*/,
+                  const LdpDecodeInformation* /*decodeInfo*/, const uint8_t* /*data*/,
+                  uint32_t /*dataSize*/) override
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_counts[eventType]++;
+        m_condition.notify_all();
+    }
+
+    // Wait until at least `count` events of the given type have been generated
+    bool waitFor(Event event, uint32_t count)
+    {
+        std::unique_lock lock(m_mutex);
+        return m_condition.wait_for(lock, kEventTimeout, [&] { return m_counts[event] >= count; });
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    uint32_t m_counts[Event_Count] = {};
+};
+
+// Call `function` with each row of visible samples whilst the picture is locked
+template <typename Function>
+bool forEachPictureRow(LdpPicture* picture, LdpAccess access, Function function)
+{
+    LdpPictureLock* lock{};
+    if (!ldpPictureLock(picture, access, &lock)) {
+        return false;
+    }
+    const LdpPictureLayout* layout{&picture->layout};
+    bool ok{true};
+    for (uint32_t plane = 0; ok && plane < ldpPictureLayoutPlanes(layout); ++plane) {
+        LdpPicturePlaneDesc planeDesc{};
+        ok = ldpPictureLockGetPlaneDesc(lock, plane, &planeDesc);
+        for (uint32_t y = 0; ok && y < ldpPictureLayoutPlaneHeight(layout, plane); ++y) {
+            function(planeDesc.firstSample + static_cast<size_t>(y) * planeDesc.rowByteStride,
+                     ldpPictureLayoutRowSize(layout, plane));
+        }
+    }
+    ldpPictureUnlock(picture, lock);
+    return ok;
+}
+
+struct DecodeOptions
+{
+    bool upscaleFromBase;
+    bool upscaleToOutput;
+};
+
+// A pipeline, and the events it has generated
+class Decoder
+{
+public:
+    explicit Decoder(const DecodeOptions& options)
+    {
+        auto pipelineBuilder =
+            CREATE_PIPELINE_CPU_BUILDER_NAME(ldcDiagnosticsStateGet(), (void*)ldcAccelerationGet());
+        EXPECT_TRUE(pipelineBuilder);
+        // Dithering would make outputs differ between pipelines
+        EXPECT_TRUE(pipelineBuilder->configure("allow_dithering", false));
+        EXPECT_TRUE(pipelineBuilder->configure("upscale_from_base", options.upscaleFromBase));
+        EXPECT_TRUE(pipelineBuilder->configure("upscale_to_output", options.upscaleToOutput));
+        m_pipeline = pipelineBuilder->finish(&m_events);
+    }
+
+    bool valid() const { return m_pipeline != nullptr; }
+
+    bool waitFor(Event event, uint32_t count) { return m_events.waitFor(event, count); }
+
+    // Send enhancement data and a base picture for each frame
+    void sendFrames()
+    {
+        for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+            const std::vector<uint8_t>& enhancement{kValidEnhancements[frame]};
+            ASSERT_EQ(m_pipeline->sendEnhancementData(frame, enhancement.data(),
+                                                      static_cast<uint32_t>(enhancement.size())),
+                      LdcReturnCodeSuccess);
+
+            LdpPicture* base = m_pipeline->allocPictureManaged(kBaseDesc);
+            ASSERT_TRUE(base);
+            uint32_t offset{0};
+            ASSERT_TRUE(forEachPictureRow(base, LdpAccessWrite, [&](uint8_t* row, uint32_t size) {
+                for (uint32_t i = 0; i < size; ++i, ++offset) {
+                    row[i] = static_cast<uint8_t>((offset * 7 + frame * 29) >> 3);
+                }
+            }));
+            ASSERT_EQ(m_pipeline->sendBasePicture(frame, base, 0, nullptr), LdcReturnCodeSuccess);
+        }
+    }
+
+    void sendOutputs()
+    {
+        for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+            LdpPicture* output = m_pipeline->allocPictureManaged(kOutputDesc);
+            ASSERT_TRUE(output);
+            ASSERT_EQ(m_pipeline->sendOutputPicture(output), LdcReturnCodeSuccess);
+        }
+    }
+
+    // Receive and free every output and base picture, returning a hash of each output
+    std::vector<std::string> receiveFrames()
+    {
+        std::vector<std::string> hashes;
+        EXPECT_TRUE(waitFor(EventOutputPictureDone, kFrameCount));
+        LdpDecodeInformation decodeInfo{};
+        while (LdpPicture* output = m_pipeline->receiveOutputPicture(decodeInfo)) {
+            EXPECT_TRUE(decodeInfo.enhanced);
+            lcevc_dec::utility::MD5 md5;
+            const auto hashRow = [&md5](uint8_t* row, uint32_t size) { md5.update(row, size); };
+            EXPECT_TRUE(forEachPictureRow(output, LdpAccessRead, hashRow));
+            hashes.push_back(md5.hexDigest());
+            m_pipeline->freePicture(output);
+        }
+
+        EXPECT_TRUE(waitFor(EventBasePictureDone, kFrameCount));
+        while (LdpPicture* base = m_pipeline->receiveFinishedBasePicture()) {
+            m_pipeline->freePicture(base);
+        }
+        return hashes;
+    }
+
+private:
+    EventCounter m_events;
+    std::unique_ptr<Pipeline> m_pipeline;
+};
+
+} // namespace
+
+class PipelineCPUDecode : public testing::TestWithParam<DecodeOptions>
+{};
+
+// Base pictures are handed back without waiting for the client to send output pictures
+TEST_P(PipelineCPUDecode, BasesDoneBeforeOutputs)
+{
+    Decoder decoder(GetParam());
+    ASSERT_TRUE(decoder.valid());
+    decoder.sendFrames();
+    EXPECT_TRUE(decoder.waitFor(EventBasePictureDone, kFrameCount));
+
+    decoder.sendOutputs();
+    EXPECT_EQ(decoder.receiveFrames().size(), kFrameCount);
+}
+
+// Outputs match the pipeline with every direct upscale switched off, whether the output pictures
+// are sent before or after the frames
+TEST_P(PipelineCPUDecode, MatchesConvertedUpscales)
+{
+    Decoder reference(DecodeOptions{false, false});
+    ASSERT_TRUE(reference.valid());
+    reference.sendFrames();
+    reference.sendOutputs();
+    const std::vector<std::string> expected{reference.receiveFrames()};
+    ASSERT_EQ(expected.size(), kFrameCount);
+
+    Decoder outputsFirst(GetParam());
+    ASSERT_TRUE(outputsFirst.valid());
+    outputsFirst.sendOutputs();
+    outputsFirst.sendFrames();
+    EXPECT_EQ(outputsFirst.receiveFrames(), expected);
+
+    Decoder framesFirst(GetParam());
+    ASSERT_TRUE(framesFirst.valid());
+    framesFirst.sendFrames();
+    EXPECT_TRUE(framesFirst.waitFor(EventBasePictureDone, kFrameCount));
+    framesFirst.sendOutputs();
+    EXPECT_EQ(framesFirst.receiveFrames(), expected);
+}
+
+std::string decodeOptionsName(const testing::TestParamInfo<DecodeOptions>& info)
+{
+    static const char* const kNames[2][2] = {{"converted", "toOutput"},
+                                             {"fromBase", "fromBaseToOutput"}};
+    return kNames[info.param.upscaleFromBase][info.param.upscaleToOutput];
+}
+
+INSTANTIATE_TEST_SUITE_P(PipelineCPU, PipelineCPUDecode,
+                         testing::Values(DecodeOptions{false, false}, DecodeOptions{true, false},
+                                         DecodeOptions{false, true}, DecodeOptions{true, true}),
+                         decodeOptionsName);
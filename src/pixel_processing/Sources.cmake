@@ -16,6 +16,7 @@ list(
     APPEND
     SOURCES
     "src/apply_cmdbuffer.c"
+    "src/apply_cmdbuffer_avx2.c"
     "src/apply_cmdbuffer_neon.c"
     "src/apply_cmdbuffer_scalar.c"
     "src/apply_cmdbuffer_sse.c"
@@ -25,6 +26,9 @@ list(
     "src/blit_scalar.c"
     "src/blit_sse.c"
     "src/blit.c"
+    "src/blit_avx2.c"
+    "src/blit_avx512.c"
+    "src/upscale_avx2.c"
     "src/upscale_neon.c"
     "src/upscale_scalar.c"
     "src/upscale_sse.c"
@@ -37,20 +41,34 @@ list(
     HEADERS
     "src/apply_cmdbuffer_applicator.h"
     "src/apply_cmdbuffer_common.h"
+    "src/apply_cmdbuffer_sse.h"
     "src/blit_common.h"
+    "src/blit_wide.h"
     "src/fp_types.h"
+    "src/upscale_avx2.h"
     "src/upscale_common.h"
     "src/upscale_neon.h"
     "src/upscale_scalar.h"
     "src/upscale_sse.h")
 
+# Sources that are compiled with AVX2 enabled, and only called when it is detected at runtime.
+list(APPEND SOURCES_AVX2 "src/apply_cmdbuffer_avx2.c" "src/blit_avx2.c" "src/upscale_avx2.c")
+
+# Sources that are compiled with AVX-512 (F, BW and VL) enabled, and only called when it is detected
+# at runtime.
+list(APPEND SOURCES_AVX512 "src/blit_avx512.c")
+
 list(APPEND INTERFACES "include/LCEVC/pixel_processing/apply_cmdbuffer.h"
      "include/LCEVC/pixel_processing/dither.h" "include/LCEVC/pixel_processing/blit.h"
      "include/LCEVC/pixel_processing/upscale.h")
 
-list(APPEND INTERFACES_DETAIL "include/LCEVC/pixel_processing/detail/apply_dither_scalar.h"
-     "include/LCEVC/pixel_processing/detail/apply_dither_sse.h"
-     "include/LCEVC/pixel_processing/detail/apply_dither_neon.h")
+list(
+    APPEND
+    INTERFACES_DETAIL
+    "include/LCEVC/pixel_processing/detail/apply_dither_scalar.h"
+    "include/LCEVC/pixel_processing/detail/apply_dither_sse.h"
+    "include/LCEVC/pixel_processing/detail/apply_dither_avx2.h"
+    "include/LCEVC/pixel_processing/detail/apply_dither_neon.h")
 
 set(ALL_FILES ${SOURCES} ${HEADERS} ${INTERFACES} "Sources.cmake")
 
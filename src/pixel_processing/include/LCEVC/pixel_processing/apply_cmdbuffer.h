@@ -28,6 +28,9 @@ extern "C"
  *
  * \param[in]    taskPool        A task pool for multi-threaded apply of a cmdbuffer with entrypoints,
  *                               can be null if cmdbuffer doesn't have entrypoints
+ * \param[in]    parent          If not NULL, the calling task - a multi-threaded apply will take over
+ *                               its dependencies and return immediately. If NULL, waits for the apply
+ *                               to finish, so must not be called from a task pool worker.
  * \param[in]    enhancementTile Structure containing CPU cmdbuffer and tile metadata for tiling mode
  * \param[in]    fixedPoint      Datatype of the plane
  * \param[inout] plane           Plane of pixels to apply residuals to
@@ -89,6 +89,14 @@ extern "C"
  * \note The copy does not need to perform conversion since the shift of the radix is
  *       implied by the representation & range of values, this falls back to a normal copy
  *       with the destination having the requested fixed-point representation.
+ *
+ * # Add and copy
+ * ldppPlaneBlitAdd() fuses a BMAdd and a demotion BMCopy: a plane of residuals is added
+ * to a signed source plane, and the saturated sum is written to an unsigned destination
+ * plane in one pass, leaving the source plane untouched.
+ *
+ * Example:
+ * > S8.7 + S8.7 -> U8
  */
 
 /*------------------------------------------------------------------------------*/
@@ -104,6 +112,7 @@ typedef enum LdppBlendingMode
  *         blending mode.
  *
  * \param taskPool       The task pool to create a sliced blit task from
+ * \param parent         If not NULL, task to inherit dependencies from
  * \param forceScalar    Doesn't use SSE or NEON accelerated functions when true.
  * \param planeIndex     The plane index in src/dst layout
  * \param srcLayout      The source plane picture layout
@@ -118,6 +127,53 @@ bool ldppPlaneBlit(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar, uin
                    LdpPicturePlaneDesc* srcPlane, LdpPicturePlaneDesc* dstPlane,
                    LdppBlendingMode blending);
 
+/*! \brief Blits a band of rows from a source plane to a destination plane on the calling thread.
+ *
+ * As ldppPlaneBlit(), but only rows [rowStart, rowStart + rowCount) are processed, clipped to
+ * the plane height. Row indices are relative to each plane's first sample, so a plane that only
+ * holds the band can be described with a first sample `rowStart` rows before the band.
+ *
+ * \param rowStart       The first row to blit.
+ * \param rowCount       The number of rows to blit.
+ *
+ * \return True if the blit operation was successful. */
+bool ldppPlaneBlitRows(bool forceScalar, uint32_t planeIndex, const LdpPictureLayout* srcLayout,
+                       const LdpPictureLayout* dstLayout, LdpPicturePlaneDesc* srcPlane,
+                       LdpPicturePlaneDesc* dstPlane, LdppBlendingMode blending, uint32_t rowStart,
+                       uint32_t rowCount);
+
+/*! \brief Adds a residual plane to a source plane, and blits the sum to a destination plane.
+ *
+ * The source and residual planes share the source layout, and must be signed. The sum is
+ * saturated, then converted as a BMCopy to the unsigned destination.
+ *
+ * \param taskPool       The task pool to create a sliced blit task from
+ * \param parent         If not NULL, task to inherit dependencies from
+ * \param forceScalar    Doesn't use SSE or NEON accelerated functions when true.
+ * \param planeIndex     The plane index in src/dst layout
+ * \param srcLayout      The source and residual plane picture layout
+ * \param dstLayout      The destination picture layout
+ * \param srcPlane       The source plane to blit from.
+ * \param addPlane       The residual plane to add to the source.
+ * \param dstPlane       The destination plane to blit to.
+ *
+ * \return True if the blit operation was successful. */
+bool ldppPlaneBlitAdd(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar, uint32_t planeIndex,
+                      const LdpPictureLayout* srcLayout, const LdpPictureLayout* dstLayout,
+                      LdpPicturePlaneDesc* srcPlane, LdpPicturePlaneDesc* addPlane,
+                      LdpPicturePlaneDesc* dstPlane);
+
+/*! \brief Adds and blits a band of rows on the calling thread.
+ *
+ * As ldppPlaneBlitAdd(), but only rows [rowStart, rowStart + rowCount) are processed, with the
+ * same row addressing as ldppPlaneBlitRows().
+ *
+ * \return True if the blit operation was successful. */
+bool ldppPlaneBlitAddRows(bool forceScalar, uint32_t planeIndex, const LdpPictureLayout* srcLayout,
+                          const LdpPictureLayout* dstLayout, LdpPicturePlaneDesc* srcPlane,
+                          LdpPicturePlaneDesc* addPlane, LdpPicturePlaneDesc* dstPlane,
+                          uint32_t rowStart, uint32_t rowCount);
+
 /*------------------------------------------------------------------------------*/
 
 #ifdef __cplusplus
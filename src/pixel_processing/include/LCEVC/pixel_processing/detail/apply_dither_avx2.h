@@ -0,0 +1,62 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#ifndef VN_LCEVC_PIXEL_PROCESSING_DETAIL_APPLY_DITHER_AVX2_H
+#define VN_LCEVC_PIXEL_PROCESSING_DETAIL_APPLY_DITHER_AVX2_H
+
+#include <LCEVC/build_config.h>
+#if VN_CORE_FEATURE(AVX2)
+#include <LCEVC/common/avx2.h>
+
+/*!
+ * Apply dithering to values using supplied host buffer pointer containing pre-randomised
+ * values.
+ *
+ * This is the 256-bit equivalent of ldppDitherApplySSE, consuming 32 values from the buffer.
+ *
+ * \param values   The values to apply dithering to.
+ * \param buffer   A double pointer to the dither buffer
+ * \param shift    The left shift to apply to the dither to account for the fixed point format of
+ *                 the incoming pixel values (see ldppDitherGetShiftS16)
+ * \param strength Dithering strength to scale the random value by
+ */
+static inline void ldppDitherApplyAVX2(__m256i values[2], const uint16_t** ditherBuffer,
+                                       const uint8_t shift, const uint8_t strength)
+{
+    const __m256i scalar = _mm256_set1_epi16(strength * 2 + 1);
+    const __m256i offset = _mm256_set1_epi16(strength);
+    const __m128i shiftV = _mm_cvtsi32_si128(shift);
+    __m256i dither[2];
+
+    // Load and increment dither buffer pointer
+    dither[0] = _mm256_loadu_si256((const __m256i*)*ditherBuffer);
+    *ditherBuffer += 16;
+    dither[1] = _mm256_loadu_si256((const __m256i*)*ditherBuffer);
+    *ditherBuffer += 16;
+
+    // Multiply by scalar
+    dither[0] = _mm256_mulhi_epu16(dither[0], scalar);
+    dither[1] = _mm256_mulhi_epu16(dither[1], scalar);
+
+    // Subtract offset to get values into -strength to +strength range
+    dither[0] = _mm256_sub_epi16(offset, dither[0]);
+    dither[1] = _mm256_sub_epi16(offset, dither[1]);
+
+    // Add dither pixel values (saturating to avoid overflow)
+    values[0] = _mm256_adds_epi16(values[0], _mm256_sll_epi16(dither[0], shiftV));
+    values[1] = _mm256_adds_epi16(values[1], _mm256_sll_epi16(dither[1], shiftV));
+}
+
+#endif
+#endif // VN_LCEVC_PIXEL_PROCESSING_DETAIL_APPLY_DITHER_AVX2_H
@@ -173,6 +173,7 @@ int8_t ldppDitherGetShiftS16(LdpFixedPoint bitDepth);
 
 /*------------------------------------------------------------------------------*/
 
+#include "detail/apply_dither_avx2.h"
 #include "detail/apply_dither_neon.h"
 #include "detail/apply_dither_scalar.h"
 #include "detail/apply_dither_sse.h"
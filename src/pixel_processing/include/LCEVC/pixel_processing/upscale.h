@@ -47,6 +47,10 @@ typedef struct ldppUpscaleArgs
     LdppDitherFrame* frameDither; /**< Indicates that dithering should be applied  */
     LdeScalingMode mode;          /**< The type of scaling to perform (1D or 2D). */
     bool forceScalar;             /**< Desired CPU acceleration features to use. */
+    bool signedPrecision; /**< Upscale between unsigned planes (2D only) at the precision of the
+                               signed type of the same bit-depth, as if converted before and
+                               after, so an upscale can read a base picture and write an output
+                               picture directly. */
 } LdppUpscaleArgs;
 
 /*------------------------------------------------------------------------------*/
@@ -63,6 +67,59 @@ typedef struct ldppUpscaleArgs
 bool ldppUpscale(LdcMemoryAllocator* allocator, LdcTaskPool* taslPool, LdcTask* parent,
                  const LdeKernel* kernel, const LdppUpscaleArgs* params);
 
+/*! \brief Whether an upscale can read an unsigned source plane directly into the signed
+ *         fixed-point type of the same bit-depth, without a separate conversion pass.
+ *
+ *  Only planar surfaces are supported. When SIMD is in use this also requires SIMD kernels
+ *  for the promotion, so that reading directly is never slower than converting first.
+ *
+ *  \param srcFP          The unsigned fixed-point type of the source plane.
+ *  \param forceScalar    True if the upscale will be run with the non-SIMD kernels.
+ *
+ *  \return True if the direct upscale is supported. */
+bool ldppUpscalePromotionSupported(LdpFixedPoint srcFP, bool forceScalar);
+
+/*! \brief Whether an upscale can write signed fixed-point results directly to an unsigned
+ *         destination plane of the same bit-depth, without a separate conversion pass.
+ *
+ *  Only planar surfaces are supported. When SIMD is in use this also requires SIMD kernels
+ *  for the demotion, so that writing directly is never slower than converting afterwards.
+ *
+ *  \param srcFP          The signed fixed-point type the upscale is computed in.
+ *  \param dstFP          The unsigned fixed-point type of the destination plane.
+ *  \param forceScalar    True if the upscale will be run with the non-SIMD kernels.
+ *
+ *  \return True if the direct upscale is supported. */
+bool ldppUpscaleDemotionSupported(LdpFixedPoint srcFP, LdpFixedPoint dstFP, bool forceScalar);
+
+/*! \brief Row stride in bytes of the intermediate plane used by a 2D upscale.
+ *
+ *  \param params         The arguments to use for upscaling.
+ *
+ *  \return The stride, or 0 if the upscale does not need an intermediate plane. */
+uint32_t ldppUpscaleIntermediateRowStride(const LdppUpscaleArgs* params);
+
+/*! \brief Upscales a band of source rows on the calling thread.
+ *
+ *  Destination rows for source rows [srcRowStart, srcRowStart + srcRowCount) are written - for
+ *  2D that is twice as many rows starting at 2 * srcRowStart. The kernel reads source rows
+ *  either side of the band, so the whole source plane must be valid.
+ *
+ *  Row indices are relative to each plane's first sample, so the destination and intermediate
+ *  planes can hold just the band, described with a first sample that many rows before it.
+ *
+ *  \param kernel            The kernel to use for upscaling.
+ *  \param params            The arguments to use for upscaling.
+ *  \param intermediatePlane The plane used between vertical and horizontal passes (2D only),
+ *                           with a row stride of ldppUpscaleIntermediateRowStride().
+ *  \param srcRowStart       The first source row to upscale.
+ *  \param srcRowCount       The number of source rows to upscale.
+ *
+ *  \return True if the upscale operation was successful. */
+bool ldppUpscaleRows(const LdeKernel* kernel, const LdppUpscaleArgs* params,
+                     const LdpPicturePlaneDesc* intermediatePlane, uint32_t srcRowStart,
+                     uint32_t srcRowCount);
+
 /*------------------------------------------------------------------------------*/
 
 #ifdef __cplusplus
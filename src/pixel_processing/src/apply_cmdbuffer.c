@@ -26,6 +26,11 @@
 
 /*------------------------------------------------------------------------------*/
 
+/* Smallest number of entry points that a command buffer slice will be split down to. */
+static const uint32_t kApplyCmdBufferMinSliceEntryPoints = 1;
+
+/*------------------------------------------------------------------------------*/
+
 typedef struct ApplyCmdBufferSlicedJobContext
 {
     CmdBufferApplicator function;
@@ -65,12 +70,14 @@ bool ldppApplyCmdBuffer(LdcTaskPool* taskPool, LdcTask* parent, LdpEnhancementTi
         return true;
     }
 
-    const LdcAcceleration* acceleration = ldcAccelerationGet();
+    const LdcAccelerationFeatures* acceleration = ldcAccelerationGetKernel(LdcKernelApplyCmdBuffer);
 
     CmdBufferApplicator applicatorFunction = NULL;
     if (rasterOrder) {
         if (!forceScalar && acceleration->NEON) {
             applicatorFunction = (CmdBufferApplicator)cmdBufferApplicatorSurfaceNEON;
+        } else if (!forceScalar && acceleration->AVX2) {
+            applicatorFunction = (CmdBufferApplicator)cmdBufferApplicatorSurfaceAVX2;
         } else if (!forceScalar && acceleration->SSE) {
             applicatorFunction = (CmdBufferApplicator)cmdBufferApplicatorSurfaceSSE;
         }
@@ -81,6 +88,8 @@ bool ldppApplyCmdBuffer(LdcTaskPool* taskPool, LdcTask* parent, LdpEnhancementTi
     } else {
         if (!forceScalar && acceleration->NEON) {
             applicatorFunction = (CmdBufferApplicator)cmdBufferApplicatorBlockNEON;
+        } else if (!forceScalar && acceleration->AVX2) {
+            applicatorFunction = (CmdBufferApplicator)cmdBufferApplicatorBlockAVX2;
         } else if (!forceScalar && acceleration->SSE) {
             applicatorFunction = (CmdBufferApplicator)cmdBufferApplicatorBlockSSE;
         }
@@ -110,7 +119,8 @@ bool ldppApplyCmdBuffer(LdcTaskPool* taskPool, LdcTask* parent, LdpEnhancementTi
 
         return ldcTaskPoolAddSlicedDeferred(taskPool, parent, &applyCmdBufferSlicedJob, NULL,
                                             &slicedJobContext, sizeof(slicedJobContext),
-                                            cmdBuffer->numEntryPoints);
+                                            cmdBuffer->numEntryPoints,
+                                            kApplyCmdBufferMinSliceEntryPoints);
     }
     return true;
 }
@@ -47,8 +47,8 @@
     int32_t cmdOffset = entryPoint->commandOffset;                                                     \
     int32_t dataOffset = entryPoint->dataOffset;                                                       \
     uint8_t* dataPtr = NULL;                                                                           \
-    uint16_t rowPixelStride = (bitdepthFromFixedPoint(fixedPoint) > 8) ? plane->rowByteStride >> 1     \
-                                                                       : plane->rowByteStride;         \
+    uint16_t rowPixelStride = (fixedPointByteSize(fixedPoint) > 1) ? plane->rowByteStride >> 1         \
+                                                                   : plane->rowByteStride;             \
                                                                                                        \
     ApplyCmdBufferArgs args = {                                                                        \
         .firstSample = (int16_t*)VN_PLANE_GETLINE(plane, 0),                                           \
@@ -63,7 +63,7 @@
 
 /*- Highlight -----------------------------------------------------------------------------------*/
 /* Other residual application functions are defined differently for different SIMD implementations,
- * but we don't bother with highlight (since it's just a debug feature) */
+ * but we don't bother with highlight (since it's just a debug feature), other than for pairs */
 
 #define VN_APPLY_CMDBUFFER_HIGHLIGHT(PixelType, transformWidth)                                     \
     PixelType highlightValue = (PixelType)fixedPointHighlightValue(args->fixedPoint);               \
@@ -190,16 +190,60 @@ static uint32_t getJump(const uint8_t* commandPtr, int32_t* cmdOffsetOut)
     return jump;
 }
 
+#ifdef VN_CMDBUFFER_APPLICATOR_PAIRS
+/*- Pairs ---------------------------------------------------------------------------------------*/
+/* Implementations that define VN_CMDBUFFER_APPLICATOR_PAIRS also provide kAddPairTable,
+ * kSetPairTable and kHighlightPairTable. A pair function applies 2 horizontally adjacent TUs
+ * that have the same command, where the residuals of the second TU immediately precede those
+ * of the first (as residuals are consumed from the end of the buffer). */
+
+static ApplyCmdBufferFunction getApplyPairFunction(LdeCmdBufferCpuCmd command,
+                                                   LdeTransformType transformType,
+                                                   LdpFixedPoint fpType, bool highlight)
+{
+    if (highlight) {
+        return (command == CBCCClear) ? NULL : kHighlightPairTable[transformType][fpType];
+    }
+    switch (command) {
+        case CBCCAdd: return kAddPairTable[transformType][fpType];
+        case CBCCSet: return kSetPairTable[transformType];
+        case CBCCSetZero:
+        case CBCCClear: break;
+    }
+    return NULL;
+}
+
+/*! \brief Determine whether the next command is for the TU directly to the right of the current
+ *         TU, with the same command, so that both can be applied by a pair function.
+ *
+ * \param commandPtr  The next command.
+ * \param command     The current command.
+ * \param x           The x coordinate of the current TU.
+ * \param y           The y coordinate of the current TU.
+ * \param nextX       The x coordinate of the TU after the current TU.
+ * \param nextY       The y coordinate of the TU after the current TU.
+ * \param tuSize      The width of a TU in pixels.
+ *
+ * \return True if the next command can be paired with the current command. */
+static inline bool isAdjacentCommand(const uint8_t* commandPtr, LdeCmdBufferCpuCmd command,
+                                     uint32_t x, uint32_t y, uint32_t nextX, uint32_t nextY,
+                                     uint32_t tuSize)
+{
+    return ((*commandPtr & 0x3F) == 1) && ((LdeCmdBufferCpuCmd)(*commandPtr & 0xC0) == command) &&
+           (nextY == y) && (nextX == x + tuSize);
+}
+#endif
+
 /*! \brief This function is the loop to apply residuals in cmdbuffer temporal format to a standard
  *         raster plane. It exists in this .h file separately as it is shared between the scalar,
- *         NEON and SSE implementations.
+ *         NEON, SSE and AVX2 implementations.
  *
  * \param enhancementTile Cmdbuffer and tile location to apply to
  * \param entryPointIdx   An entrypoint index to apply
  * \param plane           Plane to apply to.
  * \param fixedPoint      Plane datatype
  * \param highlight       Set true to use highlight residual functions instead of ADD, SET and
- *                        SETZERO. Highlight mode is not SIMD optimized. */
+ *                        SETZERO. Highlight mode is only SIMD optimized for pairs. */
 bool cmdBufferApplicatorBlockTemplate(const LdpEnhancementTile* enhancementTile,
                                       size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
                                       LdpFixedPoint fixedPoint, bool highlight)
@@ -224,6 +268,29 @@ bool cmdBufferApplicatorBlockTemplate(const LdpEnhancementTile* enhancementTile,
             dataPtr = cmdBuffer->data.currentResidual + dataSize - dataOffset;
             args.residuals = (int16_t*)dataPtr;
         }
+
+#ifdef VN_CMDBUFFER_APPLICATOR_PAIRS
+        const ApplyCmdBufferFunction applyPairFn =
+            getApplyPairFunction(command, transformType, fixedPoint, args.highlight);
+        if (applyPairFn && (count + 1) < entryPoint->count) {
+            uint32_t nextX = 0;
+            uint32_t nextY = 0;
+            ldeTuCoordsBlockAlignedRaster(&tuState, tuIndex + 1, &nextX, &nextY);
+
+            if (isAdjacentCommand(cmdBuffer->data.start + cmdOffset, command, args.x, args.y,
+                                  nextX, nextY, (uint32_t)1 << tuWidthShift)) {
+                cmdOffset++;
+                tuIndex++;
+                count++;
+                if (command == CBCCAdd || command == CBCCSet) {
+                    dataOffset += layerSize;
+                }
+                applyPairFn(&args);
+                continue;
+            }
+        }
+#endif
+
         const ApplyCmdBufferFunction applyFn =
             getApplyFunction(command, transformType, fixedPoint, args.highlight);
         applyFn(&args);
@@ -233,14 +300,14 @@ bool cmdBufferApplicatorBlockTemplate(const LdpEnhancementTile* enhancementTile,
 
 /*! \brief This function is the loop to apply residuals in cmdbuffer surface format to a standard
  *         raster plane. It exists in this .h file separately as it is shared between the scalar,
- *         NEON and SSE implementations.
+ *         NEON, SSE and AVX2 implementations.
  *
  * \param enhancementTile Cmdbuffer and tile location to apply to
  * \param entryPointIdx   An entrypoint index to apply
  * \param plane           Plane to apply to.
  * \param fixedPoint      Plane datatype
  * \param highlight       Set true to use highlight residual functions instead of ADD, SET and
- *                        SETZERO. Highlight mode is not SIMD optimized.
+ *                        SETZERO. Highlight mode is only SIMD optimized for pairs.
  */
 bool cmdBufferApplicatorSurfaceTemplate(const LdpEnhancementTile* enhancementTile,
                                         size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
@@ -255,6 +322,10 @@ bool cmdBufferApplicatorSurfaceTemplate(const LdpEnhancementTile* enhancementTil
      * highlight. */
     const ApplyCmdBufferFunction applyFn = args.highlight ? kHighlightTable[transformType][fixedPoint]
                                                           : kAddTable[transformType][fixedPoint];
+#ifdef VN_CMDBUFFER_APPLICATOR_PAIRS
+    const ApplyCmdBufferFunction applyPairFn =
+        getApplyPairFunction(CBCCAdd, transformType, fixedPoint, args.highlight);
+#endif
 
     const size_t dataSize = ldeCmdBufferCpuGetResidualSize(cmdBuffer);
     for (uint32_t count = 0; count < entryPoint->count; count++) {
@@ -271,6 +342,27 @@ bool cmdBufferApplicatorSurfaceTemplate(const LdpEnhancementTile* enhancementTil
         dataOffset += layerSize;
         dataPtr = cmdBuffer->data.currentResidual + dataSize - dataOffset;
         args.residuals = (int16_t*)dataPtr;
+
+#ifdef VN_CMDBUFFER_APPLICATOR_PAIRS
+        /* Every command is an add, so only the jump of the next command matters. */
+        if (applyPairFn && (count + 1) < entryPoint->count) {
+            const uint8_t* nextCommandPtr = cmdBuffer->data.start + cmdOffset;
+            uint32_t nextX = 0;
+            uint32_t nextY = 0;
+
+            if (ldeTuCoordsSurfaceRaster(&tuState, tuIndex + 1, &nextX, &nextY) == TUMore &&
+                isAdjacentCommand(nextCommandPtr, (LdeCmdBufferCpuCmd)(*nextCommandPtr & 0xC0),
+                                  args.x, args.y, nextX, nextY, (uint32_t)1 << tuWidthShift)) {
+                cmdOffset++;
+                tuIndex++;
+                count++;
+                dataOffset += layerSize;
+                applyPairFn(&args);
+                continue;
+            }
+        }
+#endif
+
         applyFn(&args);
     }
     return true;
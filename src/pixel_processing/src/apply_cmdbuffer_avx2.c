@@ -0,0 +1,286 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#include "apply_cmdbuffer_common.h"
+
+#include <LCEVC/build_config.h>
+
+#if VN_CORE_FEATURE(AVX2)
+
+#include "apply_cmdbuffer_sse.h"
+#include "fp_types.h"
+
+#include <assert.h>
+#include <LCEVC/common/avx2.h>
+
+/*------------------------------------------------------------------------------*/
+
+/* The AVX2 applicators apply 2 horizontally adjacent DDS TUs at once, holding one 8-wide row of
+ * the pair in each 128-bit lane, so a pair of 4x4 TUs takes 2 iterations. DD TUs, and any TU
+ * without an adjacent partner, use the per-TU SSE functions. */
+
+/*!
+ * Load 2 rows of residuals for a pair of adjacent DDS TUs.
+ *
+ * \param residuals  The residuals of the first TU, the second TU's residuals precede them.
+ * \param row        The first row to load.
+ *
+ * \return Row `row` of both TUs in the low lane, and row `row + 1` in the high lane.
+ */
+static inline __m256i loadResidualsDDSPair(const int16_t* residuals, int32_t row)
+{
+    const int16_t* first = residuals + (row * CBCKTUSizeDDS);
+    const int16_t* second = first - CBCKDDSLayers;
+
+    /* {first[row], first[row + 1], second[row], second[row + 1]} as 64-bit rows, reordered to
+     * {first[row], second[row], first[row + 1], second[row + 1]} */
+    return _mm256_permute4x64_epi64(loadu2M128iAVX2(second, first), 0xD8);
+}
+
+static inline __m256i loadRowPairU8(const uint8_t* pixels, size_t stride)
+{
+    const __m128i row0 = _mm_loadl_epi64((const __m128i*)pixels);
+    const __m128i row1 = _mm_loadl_epi64((const __m128i*)(pixels + stride));
+
+    return _mm256_cvtepu8_epi16(_mm_unpacklo_epi64(row0, row1));
+}
+
+static inline void storeRowPairU8(uint8_t* pixels, size_t stride, __m256i values)
+{
+    const __m256i packed = _mm256_packus_epi16(values, values);
+
+    _mm_storel_epi64((__m128i*)pixels, _mm256_castsi256_si128(packed));
+    _mm_storel_epi64((__m128i*)(pixels + stride), _mm256_extracti128_si256(packed, 1));
+}
+
+/*------------------------------------------------------------------------------*/
+/* Apply ADDs */
+/*------------------------------------------------------------------------------*/
+
+static void addDDSPair_U8(const ApplyCmdBufferArgs* args)
+{
+    assert(!fixedPointIsSigned(args->fixedPoint));
+
+    static const int32_t kShift = 7;
+    const __m256i usToSOffset = _mm256_set1_epi16(0x4000);
+    const __m256i fractOffset = _mm256_set1_epi16(0x40);
+    const __m256i signOffset = _mm256_set1_epi16(0x80);
+    const size_t stride = args->rowPixelStride;
+
+    uint8_t* pixels = (uint8_t*)args->firstSample + (args->y * stride) + args->x;
+
+    for (int32_t row = 0; row < CBCKTUSizeDDS; row += 2) {
+        __m256i avxPixels = loadRowPairU8(pixels, stride);
+
+        /* val <<= shift */
+        avxPixels = _mm256_slli_epi16(avxPixels, kShift);
+
+        /* val -= 0x4000 */
+        avxPixels = _mm256_sub_epi16(avxPixels, usToSOffset);
+
+        /* val += src */
+        avxPixels = _mm256_adds_epi16(avxPixels, loadResidualsDDSPair(args->residuals, row));
+
+        /* val += rounding */
+        avxPixels = _mm256_adds_epi16(avxPixels, fractOffset);
+
+        /* val >>= shift */
+        avxPixels = _mm256_srai_epi16(avxPixels, kShift);
+
+        /* val += sign offset */
+        avxPixels = _mm256_add_epi16(avxPixels, signOffset);
+
+        /* Clamp to unsigned range and store */
+        storeRowPairU8(pixels, stride, avxPixels);
+
+        pixels += 2 * stride;
+    }
+}
+
+static inline void addDDSPair_UBase(const ApplyCmdBufferArgs* args, int32_t shift,
+                                    int16_t roundingOffset, int16_t signOffset, int16_t resultMax)
+{
+    assert(!fixedPointIsSigned(args->fixedPoint));
+
+    const __m256i usToSOffset = _mm256_set1_epi16(16384);
+    const __m256i roundingOffsetV = _mm256_set1_epi16(roundingOffset);
+    const __m256i signOffsetV = _mm256_set1_epi16(signOffset);
+    const __m256i minV = _mm256_set1_epi16(0);
+    const __m256i maxV = _mm256_set1_epi16(resultMax);
+    const __m128i shiftV = _mm_cvtsi32_si128(shift);
+    const size_t stride = args->rowPixelStride;
+
+    int16_t* pixels = args->firstSample + (args->y * stride) + args->x;
+
+    for (int32_t row = 0; row < CBCKTUSizeDDS; row += 2) {
+        /* Load as int16_t, source data is maximally unsigned 14-bit so will fit. */
+        __m256i avxPixels = loadu2M128iAVX2(pixels + stride, pixels);
+
+        /* val <<= shift */
+        avxPixels = _mm256_sll_epi16(avxPixels, shiftV);
+
+        /* val -= 0x4000 */
+        avxPixels = _mm256_sub_epi16(avxPixels, usToSOffset);
+
+        /* val += src */
+        avxPixels = _mm256_adds_epi16(avxPixels, loadResidualsDDSPair(args->residuals, row));
+
+        /* val += rounding */
+        avxPixels = _mm256_adds_epi16(avxPixels, roundingOffsetV);
+
+        /* val >>= shift */
+        avxPixels = _mm256_sra_epi16(avxPixels, shiftV);
+
+        /* val += sign offset */
+        avxPixels = _mm256_add_epi16(avxPixels, signOffsetV);
+
+        /* Clamp to unsigned range */
+        avxPixels = _mm256_max_epi16(_mm256_min_epi16(avxPixels, maxV), minV);
+
+        /* Store */
+        storeu2M128iAVX2(pixels + stride, pixels, avxPixels);
+        pixels += 2 * stride;
+    }
+}
+
+static void addDDSPair_U10(const ApplyCmdBufferArgs* args)
+{
+    addDDSPair_UBase(args, 5, 16, 512, 1023);
+}
+
+static void addDDSPair_U12(const ApplyCmdBufferArgs* args)
+{
+    addDDSPair_UBase(args, 3, 4, 2048, 4095);
+}
+
+static void addDDSPair_U14(const ApplyCmdBufferArgs* args)
+{
+    addDDSPair_UBase(args, 1, 1, 8192, 16383);
+}
+
+static void addDDSPair_S16(const ApplyCmdBufferArgs* args)
+{
+    assert(fixedPointIsSigned(args->fixedPoint));
+
+    const size_t stride = args->rowPixelStride;
+    int16_t* pixels = args->firstSample + (args->y * stride) + args->x;
+
+    for (int32_t row = 0; row < CBCKTUSizeDDS; row += 2) {
+        const __m256i avxPixels = loadu2M128iAVX2(pixels + stride, pixels);
+        storeu2M128iAVX2(pixels + stride, pixels,
+                         _mm256_adds_epi16(avxPixels, loadResidualsDDSPair(args->residuals, row)));
+        pixels += 2 * stride;
+    }
+}
+
+/*------------------------------------------------------------------------------*/
+/* Apply SETs */
+/*------------------------------------------------------------------------------*/
+
+static void setDDSPair(const ApplyCmdBufferArgs* args)
+{
+    assert(fixedPointIsSigned(args->fixedPoint));
+
+    const size_t stride = args->rowPixelStride;
+    int16_t* pixels = args->firstSample + (args->y * stride) + args->x;
+
+    for (int32_t row = 0; row < CBCKTUSizeDDS; row += 2) {
+        storeu2M128iAVX2(pixels + stride, pixels, loadResidualsDDSPair(args->residuals, row));
+        pixels += 2 * stride;
+    }
+}
+
+/*------------------------------------------------------------------------------*/
+/* Apply highlights */
+/*------------------------------------------------------------------------------*/
+
+static void highlightDDSPair_U8(const ApplyCmdBufferArgs* args)
+{
+    const __m128i highlight = _mm_set1_epi8((char)fixedPointHighlightValue(args->fixedPoint));
+    const size_t stride = args->rowPixelStride;
+    uint8_t* pixels = (uint8_t*)args->firstSample + (args->y * stride) + args->x;
+
+    for (int32_t row = 0; row < CBCKTUSizeDDS; ++row) {
+        _mm_storel_epi64((__m128i*)pixels, highlight);
+        pixels += stride;
+    }
+}
+
+static void highlightDDSPair_N16(const ApplyCmdBufferArgs* args)
+{
+    const __m256i highlight =
+        _mm256_set1_epi16((int16_t)fixedPointHighlightValue(args->fixedPoint));
+    const size_t stride = args->rowPixelStride;
+    int16_t* pixels = args->firstSample + (args->y * stride) + args->x;
+
+    for (int32_t row = 0; row < CBCKTUSizeDDS; row += 2) {
+        storeu2M128iAVX2(pixels + stride, pixels, highlight);
+        pixels += 2 * stride;
+    }
+}
+
+/*- Constants -----------------------------------------------------------------------------------*/
+
+static const ApplyCmdBufferFunction kAddPairTable[TransformCount][LdpFPCount] = {
+    {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL},
+    {
+        addDDSPair_U8,
+        addDDSPair_U10,
+        addDDSPair_U12,
+        addDDSPair_U14,
+        addDDSPair_S16,
+        addDDSPair_S16,
+        addDDSPair_S16,
+        addDDSPair_S16,
+    },
+};
+
+static const ApplyCmdBufferFunction kSetPairTable[TransformCount] = {NULL, setDDSPair};
+
+static const ApplyCmdBufferFunction kHighlightPairTable[TransformCount][LdpFPCount] = {
+    {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL},
+    {
+        highlightDDSPair_U8,
+        highlightDDSPair_N16,
+        highlightDDSPair_N16,
+        highlightDDSPair_N16,
+        highlightDDSPair_N16,
+        highlightDDSPair_N16,
+        highlightDDSPair_N16,
+        highlightDDSPair_N16,
+    },
+};
+
+#define VN_CMDBUFFER_APPLICATOR_PAIRS
+#define cmdBufferApplicatorBlockTemplate cmdBufferApplicatorBlockAVX2
+#define cmdBufferApplicatorSurfaceTemplate cmdBufferApplicatorSurfaceAVX2
+#include "apply_cmdbuffer_applicator.h"
+
+#else
+
+bool cmdBufferApplicatorBlockAVX2(const LdpEnhancementTile* enhancementTile, size_t entryPointIdx,
+                                  const LdpPicturePlaneDesc* plane, LdpFixedPoint fixedPoint,
+                                  bool highlight)
+{
+    VN_UNUSED_CMDBUFFER_APPLICATOR()
+}
+
+bool cmdBufferApplicatorSurfaceAVX2(const LdpEnhancementTile* enhancementTile,
+                                    size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
+                                    LdpFixedPoint fixedPoint, bool highlight)
+{
+    VN_UNUSED_CMDBUFFER_APPLICATOR()
+}
+
+#endif
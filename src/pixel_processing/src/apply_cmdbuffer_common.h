@@ -69,6 +69,10 @@ bool cmdBufferApplicatorBlockSSE(const LdpEnhancementTile* enhancementTile, size
                                  const LdpPicturePlaneDesc* plane, LdpFixedPoint fixedPoint,
                                  bool highlight);
 
+bool cmdBufferApplicatorBlockAVX2(const LdpEnhancementTile* enhancementTile, size_t entryPointIdx,
+                                  const LdpPicturePlaneDesc* plane, LdpFixedPoint fixedPoint,
+                                  bool highlight);
+
 bool cmdBufferApplicatorSurfaceScalar(const LdpEnhancementTile* enhancementTile,
                                       size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
                                       LdpFixedPoint fixedPoint, bool highlight);
@@ -81,6 +85,10 @@ bool cmdBufferApplicatorSurfaceSSE(const LdpEnhancementTile* enhancementTile, si
                                    const LdpPicturePlaneDesc* plane, LdpFixedPoint fixedPoint,
                                    bool highlight);
 
+bool cmdBufferApplicatorSurfaceAVX2(const LdpEnhancementTile* enhancementTile,
+                                    size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
+                                    LdpFixedPoint fixedPoint, bool highlight);
+
 #define VN_UNUSED_CMDBUFFER_APPLICATOR() \
     VNUnused(enhancementTile);           \
     VNUnused(entryPointIdx);             \
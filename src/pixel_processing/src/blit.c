@@ -24,20 +24,49 @@
 
 /*------------------------------------------------------------------------------*/
 
+/* Smallest number of rows that a blit slice will be split down to. */
+static const uint32_t kBlitMinSliceRows = 32;
+
+/*------------------------------------------------------------------------------*/
+
 PlaneBlitFunction planeBlitGetFunctionScalar(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
                                              LdppBlendingMode blending, uint32_t planeIndex, bool isNV12);
 PlaneBlitFunction planeBlitGetFunctionSSE(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
                                           LdppBlendingMode blending, uint32_t planeIndex, bool isNV12);
+PlaneBlitFunction planeBlitGetFunctionAVX2(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
+                                           LdppBlendingMode blending, uint32_t planeIndex, bool isNV12);
+PlaneBlitFunction planeBlitGetFunctionAVX512(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
+                                             LdppBlendingMode blending, uint32_t planeIndex,
+                                             bool isNV12);
 PlaneBlitFunction planeBlitGetFunctionNEON(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
                                            LdppBlendingMode blending);
+PlaneBlitFunction planeBlitGetAddCopyFunctionScalar(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
+                                                    uint32_t planeIndex, bool isNV12);
+PlaneBlitFunction planeBlitGetAddCopyFunctionSSE(LdpFixedPoint dstFP, uint32_t planeIndex,
+                                                 bool isNV12);
+PlaneBlitFunction planeBlitGetAddCopyFunctionAVX2(LdpFixedPoint dstFP, uint32_t planeIndex,
+                                                  bool isNV12);
+PlaneBlitFunction planeBlitGetAddCopyFunctionAVX512(LdpFixedPoint dstFP, uint32_t planeIndex,
+                                                    bool isNV12);
+PlaneBlitFunction planeBlitGetAddCopyFunctionNEON(LdpFixedPoint dstFP, uint32_t planeIndex,
+                                                  bool isNV12);
 
 PlaneBlitFunction planeBlitGetFunction(LdpFixedPoint srcFP, LdpFixedPoint dstFP, LdppBlendingMode blending,
                                        bool forceScalar, uint32_t planeIndex, bool isNV12)
 {
     PlaneBlitFunction res = NULL;
-    const LdcAcceleration* acceleration = ldcAccelerationGet();
+    const LdcAccelerationFeatures* acceleration = ldcAccelerationGetKernel(LdcKernelBlit);
+
+    /* Widest first - each x86 level has the same table entries as the SSE one */
+    if (!forceScalar && acceleration->AVX512) {
+        res = planeBlitGetFunctionAVX512(srcFP, dstFP, blending, planeIndex, isNV12);
+    }
+
+    if (!forceScalar && !res && acceleration->AVX2) {
+        res = planeBlitGetFunctionAVX2(srcFP, dstFP, blending, planeIndex, isNV12);
+    }
 
-    if (!forceScalar && acceleration->SSE) {
+    if (!forceScalar && !res && acceleration->SSE) {
         res = planeBlitGetFunctionSSE(srcFP, dstFP, blending, planeIndex, isNV12);
     }
 
@@ -54,13 +83,39 @@ PlaneBlitFunction planeBlitGetFunction(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
     return res;
 }
 
+static PlaneBlitFunction planeBlitGetAddCopyFunction(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
+                                                     bool forceScalar, uint32_t planeIndex, bool isNV12)
+{
+    /* The scalar getter checks the formats for all implementations */
+    PlaneBlitFunction res = planeBlitGetAddCopyFunctionScalar(srcFP, dstFP, planeIndex, isNV12);
+    const LdcAccelerationFeatures* acceleration = ldcAccelerationGetKernel(LdcKernelBlit);
+
+    if (!res || forceScalar) {
+        return res;
+    }
+
+    PlaneBlitFunction simd = NULL;
+    if (acceleration->AVX512) {
+        simd = planeBlitGetAddCopyFunctionAVX512(dstFP, planeIndex, isNV12);
+    } else if (acceleration->AVX2) {
+        simd = planeBlitGetAddCopyFunctionAVX2(dstFP, planeIndex, isNV12);
+    } else if (acceleration->SSE) {
+        simd = planeBlitGetAddCopyFunctionSSE(dstFP, planeIndex, isNV12);
+    } else if (acceleration->NEON) {
+        simd = planeBlitGetAddCopyFunctionNEON(dstFP, planeIndex, isNV12);
+    }
+
+    return simd ? simd : res;
+}
+
 /*------------------------------------------------------------------------------*/
 
 typedef struct LdppBlitSlicedJobContext
 {
     PlaneBlitFunction function;
-    const LdpPicturePlaneDesc src;
-    const LdpPicturePlaneDesc dst;
+    LdpPicturePlaneDesc src;
+    LdpPicturePlaneDesc dst;
+    LdpPicturePlaneDesc add;
     uint32_t minWidth;
 } LdppBlitSlicedJobContext;
 
@@ -69,7 +124,8 @@ static bool blitSlicedJob(void* argument, uint32_t offset, uint32_t count)
     VNTraceScopedBegin();
 
     const LdppBlitSlicedJobContext* context = (const LdppBlitSlicedJobContext*)argument;
-    const LdppBlitArgs args = {&context->src, &context->dst, context->minWidth, offset, count};
+    const LdppBlitArgs args = {&context->src, &context->dst, context->minWidth, offset, count,
+                               &context->add};
 
     context->function(&args);
 
@@ -77,9 +133,14 @@ static bool blitSlicedJob(void* argument, uint32_t offset, uint32_t count)
     return true;
 }
 
-bool ldppPlaneBlit(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar, const uint32_t planeIndex,
-                   const LdpPictureLayout* srcLayout, const LdpPictureLayout* dstLayout,
-                   LdpPicturePlaneDesc* srcPlane, LdpPicturePlaneDesc* dstPlane, LdppBlendingMode blending)
+/* Fill out blit context for a plane, returns the number of rows to blit, or 0 on failure.
+ *
+ * If addPlane is not NULL, it is added to the source plane before converting to the destination
+ * format, and `blending` is ignored. */
+static uint32_t blitInitialize(LdppBlitSlicedJobContext* context, bool forceScalar, uint32_t planeIndex,
+                               const LdpPictureLayout* srcLayout, const LdpPictureLayout* dstLayout,
+                               LdpPicturePlaneDesc* srcPlane, LdpPicturePlaneDesc* addPlane,
+                               LdpPicturePlaneDesc* dstPlane, LdppBlendingMode blending)
 {
     const uint32_t width =
         minU32(srcLayout->width >> srcLayout->layoutInfo->planeWidthShift[planeIndex],
@@ -100,18 +161,95 @@ bool ldppPlaneBlit(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar, con
         }
     }
 
-    LdppBlitSlicedJobContext slicedJobContext = {
-        planeBlitGetFunction(srcLayout->layoutInfo->fixedPoint, dstLayout->layoutInfo->fixedPoint,
-                             blending, forceScalar, planeIndex, isNV12),
-        *srcPlane, *dstPlane, width};
+    if (addPlane) {
+        context->function =
+            planeBlitGetAddCopyFunction(srcLayout->layoutInfo->fixedPoint,
+                                        dstLayout->layoutInfo->fixedPoint, forceScalar, planeIndex, isNV12);
+        context->add = *addPlane;
+    } else {
+        context->function = planeBlitGetFunction(srcLayout->layoutInfo->fixedPoint,
+                                                 dstLayout->layoutInfo->fixedPoint, blending,
+                                                 forceScalar, planeIndex, isNV12);
+        context->add.firstSample = NULL;
+        context->add.rowByteStride = 0;
+    }
+    context->src = *srcPlane;
+    context->dst = *dstPlane;
+    context->minWidth = width;
 
-    if (!slicedJobContext.function) {
+    if (!context->function) {
         VNLogError("failed to find function to perform blitting with\n");
+        return 0;
+    }
+
+    return height;
+}
+
+bool ldppPlaneBlit(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar, const uint32_t planeIndex,
+                   const LdpPictureLayout* srcLayout, const LdpPictureLayout* dstLayout,
+                   LdpPicturePlaneDesc* srcPlane, LdpPicturePlaneDesc* dstPlane, LdppBlendingMode blending)
+{
+    LdppBlitSlicedJobContext slicedJobContext;
+    const uint32_t height = blitInitialize(&slicedJobContext, forceScalar, planeIndex, srcLayout,
+                                           dstLayout, srcPlane, NULL, dstPlane, blending);
+    if (height == 0) {
+        return false;
+    }
+
+    return ldcTaskPoolAddSlicedDeferred(taskPool, parent, &blitSlicedJob, NULL, &slicedJobContext,
+                                        sizeof(slicedJobContext), height, kBlitMinSliceRows);
+}
+
+bool ldppPlaneBlitRows(bool forceScalar, uint32_t planeIndex, const LdpPictureLayout* srcLayout,
+                       const LdpPictureLayout* dstLayout, LdpPicturePlaneDesc* srcPlane,
+                       LdpPicturePlaneDesc* dstPlane, LdppBlendingMode blending, uint32_t rowStart,
+                       uint32_t rowCount)
+{
+    LdppBlitSlicedJobContext slicedJobContext;
+    const uint32_t height = blitInitialize(&slicedJobContext, forceScalar, planeIndex, srcLayout,
+                                           dstLayout, srcPlane, NULL, dstPlane, blending);
+    if (height == 0) {
+        return false;
+    }
+    if (rowStart >= height) {
+        return true;
+    }
+
+    return blitSlicedJob(&slicedJobContext, rowStart, minU32(rowCount, height - rowStart));
+}
+
+bool ldppPlaneBlitAdd(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar, uint32_t planeIndex,
+                      const LdpPictureLayout* srcLayout, const LdpPictureLayout* dstLayout,
+                      LdpPicturePlaneDesc* srcPlane, LdpPicturePlaneDesc* addPlane,
+                      LdpPicturePlaneDesc* dstPlane)
+{
+    LdppBlitSlicedJobContext slicedJobContext;
+    const uint32_t height = blitInitialize(&slicedJobContext, forceScalar, planeIndex, srcLayout,
+                                           dstLayout, srcPlane, addPlane, dstPlane, BMCopy);
+    if (height == 0) {
         return false;
     }
 
     return ldcTaskPoolAddSlicedDeferred(taskPool, parent, &blitSlicedJob, NULL, &slicedJobContext,
-                                        sizeof(slicedJobContext), height);
+                                        sizeof(slicedJobContext), height, kBlitMinSliceRows);
+}
+
+bool ldppPlaneBlitAddRows(bool forceScalar, uint32_t planeIndex, const LdpPictureLayout* srcLayout,
+                          const LdpPictureLayout* dstLayout, LdpPicturePlaneDesc* srcPlane,
+                          LdpPicturePlaneDesc* addPlane, LdpPicturePlaneDesc* dstPlane,
+                          uint32_t rowStart, uint32_t rowCount)
+{
+    LdppBlitSlicedJobContext slicedJobContext;
+    const uint32_t height = blitInitialize(&slicedJobContext, forceScalar, planeIndex, srcLayout,
+                                           dstLayout, srcPlane, addPlane, dstPlane, BMCopy);
+    if (height == 0) {
+        return false;
+    }
+    if (rowStart >= height) {
+        return true;
+    }
+
+    return blitSlicedJob(&slicedJobContext, rowStart, minU32(rowCount, height - rowStart));
 }
 
 /*------------------------------------------------------------------------------*/
@@ -0,0 +1,79 @@
+/* Copyright (c) V-Nova International Limited 2022-2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#include "blit_common.h"
+
+#include <LCEVC/build_config.h>
+#include <LCEVC/common/limit.h>
+#include <LCEVC/pipeline/types.h>
+#include <LCEVC/pixel_processing/blit.h>
+
+#if VN_CORE_FEATURE(AVX512)
+
+#include <immintrin.h>
+
+/*------------------------------------------------------------------------------*/
+
+/* 64 pixels per iteration, as 2 registers of 16-bit values. */
+static const uint32_t kStep = 64;
+
+typedef __m512i VnWide;
+#define VN_WIDE(op) _mm512_##op
+
+static inline VnWide loadWide(const void* src) { return _mm512_loadu_si512(src); }
+
+static inline void storeWide(void* dst, VnWide value) { _mm512_storeu_si512(dst, value); }
+
+static inline VnWide loadWideU8(const uint8_t* src)
+{
+    return _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)src));
+}
+
+/* packus works within each 128-bit lane, so reorder the 64-bit quarters to a, then b. */
+static inline VnWide packusWideU8(VnWide a, VnWide b)
+{
+    return _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7),
+                                    _mm512_packus_epi16(a, b));
+}
+
+#define planeBlitGetFunctionTemplate planeBlitGetFunctionAVX512
+#define planeBlitGetAddCopyFunctionTemplate planeBlitGetAddCopyFunctionAVX512
+#include "blit_wide.h"
+
+#else /* VN_CORE_FEATURE(AVX512) */
+
+PlaneBlitFunction planeBlitGetFunctionAVX512(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
+                                             LdppBlendingMode blending, uint32_t planeIndex,
+                                             bool isNV12)
+{
+    VNUnused(srcFP);
+    VNUnused(dstFP);
+    VNUnused(blending);
+    VNUnused(planeIndex);
+    VNUnused(isNV12);
+
+    return NULL;
+}
+
+PlaneBlitFunction planeBlitGetAddCopyFunctionAVX512(LdpFixedPoint dstFP, uint32_t planeIndex,
+                                                    bool isNV12)
+{
+    VNUnused(dstFP);
+    VNUnused(planeIndex);
+    VNUnused(isNV12);
+
+    return NULL;
+}
+
+#endif /* VN_CORE_FEATURE(AVX512) */
@@ -116,6 +116,7 @@ typedef struct LdppBlitArgs
     uint32_t minWidth;                     /**< Minimum plane width. */
     uint32_t offset;                       /**< Row offset to start processing from. */
     uint32_t count;                        /**< Number of rows to process. */
+    const struct LdpPicturePlaneDesc* add; /**< Residual plane added to source (add-copy only). */
 } LdppBlitArgs;
 
 typedef void (*PlaneBlitFunction)(const LdppBlitArgs* args);
@@ -235,6 +235,145 @@ static void addU14_NEON(const LdppBlitArgs* args) { addUN_NEON(args, 1, 1, 8192,
 
 /*------------------------------------------------------------------------------*/
 
+/*! \brief Adds an S16 residual plane to an S16 source plane, and demotes the saturated sum
+ *         to a U8 destination in NEON */
+static void addCopyS16U8_NEON(const LdppBlitArgs* args)
+{
+    const int16x8_t fractOffset = vdupq_n_s16(64);
+    const int16x8_t signOffset = vdupq_n_s16(128);
+    const uint32_t addStride = args->add->rowByteStride / sizeof(int16_t);
+    const int16_t* addRow = (const int16_t*)VN_PLANE_GETLINE(args->add, args->offset);
+
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint8_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const int16_t* srcPixel = srcRow;
+        const int16_t* addPixel = addRow;
+        uint8_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        /* SIMD loop */
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, addPixel += kStep, dstPixel += kStep) {
+            /* Load 16-pixels */
+            int16x8_t val0 = vld1q_s16(srcPixel);
+            int16x8_t val1 = vld1q_s16(srcPixel + 8);
+            const int16x8_t add0 = vld1q_s16(addPixel);
+            const int16x8_t add1 = vld1q_s16(addPixel + 8);
+
+            /* val += add */
+            val0 = vqaddq_s16(val0, add0);
+            val1 = vqaddq_s16(val1, add1);
+
+            /* val += 0x40 */
+            val0 = vqaddq_s16(val0, fractOffset);
+            val1 = vqaddq_s16(val1, fractOffset);
+
+            /* val >>= 7 */
+            val0 = vshrq_n_s16(val0, VN_SHIFT_U8());
+            val1 = vshrq_n_s16(val1, VN_SHIFT_U8());
+
+            /* val += 0x80 */
+            val0 = vaddq_s16(val0, signOffset);
+            val1 = vaddq_s16(val1, signOffset);
+
+            /* Saturated cast to u8 & store 16-pixels */
+            vst1q_u8(dstPixel, vcombine_u8(vqmovun_s16(val0), vqmovun_s16(val1)));
+        }
+
+        /* Remainder */
+        for (; x < width; x += 1, srcPixel += 1, addPixel += 1, dstPixel += 1) {
+            *dstPixel = fpS8ToU8(saturateS16(*srcPixel + *addPixel));
+        }
+
+        srcRow += srcStride;
+        addRow += addStride;
+        dstRow += dstStride;
+    }
+}
+
+/*! \brief Adds an S16 residual plane to an S16 source plane, and demotes the saturated sum
+ *         to a U16 destination in NEON */
+static void addCopyS16UN_NEON(const LdppBlitArgs* args, int16_t shift, int16_t roundingOffset,
+                              int16_t signOffset, int16_t resultMax)
+{
+    const int16x8_t shiftDown = vdupq_n_s16(-shift);
+    const int16x8_t roundingOffsetV = vdupq_n_s16(roundingOffset);
+    const int16x8_t signOffsetV = vdupq_n_s16(signOffset);
+    const int16x8_t minV = vdupq_n_s16(0);
+    const int16x8_t maxV = vdupq_n_s16(resultMax);
+    const uint32_t addStride = args->add->rowByteStride / sizeof(int16_t);
+    const int16_t* addRow = (const int16_t*)VN_PLANE_GETLINE(args->add, args->offset);
+
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint16_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const int16_t* srcPixel = srcRow;
+        const int16_t* addPixel = addRow;
+        uint16_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        /* SIMD loop */
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, addPixel += kStep, dstPixel += kStep) {
+            /* Load 16-pixels */
+            int16x8_t val0 = vld1q_s16(srcPixel);
+            int16x8_t val1 = vld1q_s16(srcPixel + 8);
+            const int16x8_t add0 = vld1q_s16(addPixel);
+            const int16x8_t add1 = vld1q_s16(addPixel + 8);
+
+            /* val += add */
+            val0 = vqaddq_s16(val0, add0);
+            val1 = vqaddq_s16(val1, add1);
+
+            /* val += rounding */
+            val0 = vqaddq_s16(val0, roundingOffsetV);
+            val1 = vqaddq_s16(val1, roundingOffsetV);
+
+            /* val >>= shift */
+            val0 = vshlq_s16(val0, shiftDown);
+            val1 = vshlq_s16(val1, shiftDown);
+
+            /* val += sign offset */
+            val0 = vaddq_s16(val0, signOffsetV);
+            val1 = vaddq_s16(val1, signOffsetV);
+
+            /* clamp to unsigned range */
+            val0 = vmaxq_s16(vminq_s16(val0, maxV), minV);
+            val1 = vmaxq_s16(vminq_s16(val1, maxV), minV);
+
+            /* Store 16-pixels */
+            vst1q_u16(dstPixel, vreinterpretq_u16_s16(val0));
+            vst1q_u16(dstPixel + 8, vreinterpretq_u16_s16(val1));
+        }
+
+        /* Remainder */
+        for (; x < width; x += 1, srcPixel += 1, addPixel += 1, dstPixel += 1) {
+            *dstPixel = fpS16ToU16(saturateS16(*srcPixel + *addPixel), shift, roundingOffset,
+                                   signOffset, (uint16_t)resultMax);
+        }
+
+        srcRow += srcStride;
+        addRow += addStride;
+        dstRow += dstStride;
+    }
+}
+
+static void addCopyS16U10_NEON(const LdppBlitArgs* args)
+{
+    addCopyS16UN_NEON(args, 5, 16, 512, 1023);
+}
+
+static void addCopyS16U12_NEON(const LdppBlitArgs* args)
+{
+    addCopyS16UN_NEON(args, 3, 4, 2048, 4095);
+}
+
+static void addCopyS16U14_NEON(const LdppBlitArgs* args)
+{
+    addCopyS16UN_NEON(args, 1, 1, 8192, 16383);
+}
+
+/*------------------------------------------------------------------------------*/
+
 /* clang-format off */
 
 static const PlaneBlitFunction kAddTable[LdpFPCount] = {
@@ -248,6 +387,17 @@ static const PlaneBlitFunction kAddTable[LdpFPCount] = {
 	&addS16_NEON, /* FP_S14_1 */
 };
 
+static const PlaneBlitFunction kAddCopyTable[LdpFPCount] = {
+	&addCopyS16U8_NEON,  /* FP_U8 */
+	&addCopyS16U10_NEON, /* FP_U10 */
+	&addCopyS16U12_NEON, /* FP_U12 */
+	&addCopyS16U14_NEON, /* FP_U14 */
+	NULL,                /* FP_S8_7 */
+	NULL,                /* FP_S10_5 */
+	NULL,                /* FP_S12_3 */
+	NULL,                /* FP_S14_1 */
+};
+
 /* clang-format on */
 
 /*------------------------------------------------------------------------------*/
@@ -265,6 +415,16 @@ PlaneBlitFunction planeBlitGetFunctionNEON(LdpFixedPoint srcFP, LdpFixedPoint ds
     return NULL;
 }
 
+PlaneBlitFunction planeBlitGetAddCopyFunctionNEON(LdpFixedPoint dstFP, uint32_t planeIndex,
+                                                  bool isNV12)
+{
+    /* Only the interleaved chroma plane of NV12 needs the scalar path */
+    if (isNV12 && planeIndex > 0) {
+        return NULL;
+    }
+    return kAddCopyTable[dstFP];
+}
+
 /*------------------------------------------------------------------------------*/
 
 #else
@@ -277,4 +437,13 @@ PlaneBlitFunction planeBlitGetFunctionNEON(LdpFixedPoint srcFP, LdpFixedPoint ds
     return NULL;
 }
 
+PlaneBlitFunction planeBlitGetAddCopyFunctionNEON(LdpFixedPoint dstFP, uint32_t planeIndex,
+                                                  bool isNV12)
+{
+    VNUnused(dstFP);
+    VNUnused(planeIndex);
+    VNUnused(isNV12);
+    return NULL;
+}
+
 #endif
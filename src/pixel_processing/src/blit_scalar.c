@@ -151,6 +151,73 @@ static void copyS16ToU8Nv12(const LdppBlitArgs* args)
 
 #undef VN_SURFACE_OP
 
+/*------------------------------------------------------------------------------
+ * Add S16 to S16 and copy to UN
+ *------------------------------------------------------------------------------*/
+
+static inline void addCopyS16ToU8(const LdppBlitArgs* args, uint32_t dstPixelStep)
+{
+    const LdpPicturePlaneDesc* src = args->src;
+    const LdpPicturePlaneDesc* add = args->add;
+    const LdpPicturePlaneDesc* dst = args->dst;
+    const uint32_t srcStride = src->rowByteStride / sizeof(int16_t);
+    const uint32_t addStride = add->rowByteStride / sizeof(int16_t);
+    const uint32_t dstStride = dst->rowByteStride / sizeof(uint8_t);
+    const int16_t* srcRow = (const int16_t*)VN_PLANE_GETLINE(src, args->offset);
+    const int16_t* addRow = (const int16_t*)VN_PLANE_GETLINE(add, args->offset);
+    uint8_t* dstRow = VN_PLANE_GETLINE(dst, args->offset);
+    for (uint32_t y = 0; y < args->count; ++y) {
+        for (uint32_t x = 0; x < args->minWidth; ++x) {
+            dstRow[x * dstPixelStep] = fpS8ToU8(saturateS16(srcRow[x] + addRow[x]));
+        }
+        srcRow += srcStride;
+        addRow += addStride;
+        dstRow += dstStride;
+    }
+}
+
+static inline void addCopyS16ToU16(const LdppBlitArgs* args, int16_t shift, int16_t rounding,
+                                   int16_t signOffset, uint16_t maxValue)
+{
+    const LdpPicturePlaneDesc* src = args->src;
+    const LdpPicturePlaneDesc* add = args->add;
+    const LdpPicturePlaneDesc* dst = args->dst;
+    const uint32_t srcStride = src->rowByteStride / sizeof(int16_t);
+    const uint32_t addStride = add->rowByteStride / sizeof(int16_t);
+    const uint32_t dstStride = dst->rowByteStride / sizeof(uint16_t);
+    const int16_t* srcRow = (const int16_t*)VN_PLANE_GETLINE(src, args->offset);
+    const int16_t* addRow = (const int16_t*)VN_PLANE_GETLINE(add, args->offset);
+    uint16_t* dstRow = (uint16_t*)VN_PLANE_GETLINE(dst, args->offset);
+    for (uint32_t y = 0; y < args->count; ++y) {
+        for (uint32_t x = 0; x < args->minWidth; ++x) {
+            dstRow[x] = fpS16ToU16(saturateS16(srcRow[x] + addRow[x]), shift, rounding, signOffset,
+                                   maxValue);
+        }
+        srcRow += srcStride;
+        addRow += addStride;
+        dstRow += dstStride;
+    }
+}
+
+static void addCopyS16ToU8Planar(const LdppBlitArgs* args) { addCopyS16ToU8(args, 1); }
+
+static void addCopyS16ToU8Nv12(const LdppBlitArgs* args) { addCopyS16ToU8(args, 2); }
+
+static void addCopyS16ToU10(const LdppBlitArgs* args)
+{
+    addCopyS16ToU16(args, 5, 0x10, 0x200, 0x3FF);
+}
+
+static void addCopyS16ToU12(const LdppBlitArgs* args)
+{
+    addCopyS16ToU16(args, 3, 0x4, 0x800, 0xFFF);
+}
+
+static void addCopyS16ToU14(const LdppBlitArgs* args)
+{
+    addCopyS16ToU16(args, 1, 0x1, 0x2000, 0x3FFF);
+}
+
 /*------------------------------------------------------------------------------
  * Copy UN to UM (promoting).
  *------------------------------------------------------------------------------*/
@@ -232,6 +299,17 @@ static const PlaneBlitFunction kAddTable[LdpFPCount] = {
 	&addS16, /* FP_S14_1 */
 };
 
+static const PlaneBlitFunction kAddCopyTable[LdpFPCount] = {
+	&addCopyS16ToU8Planar, /* FP_U8 */
+	&addCopyS16ToU10,      /* FP_U10 */
+	&addCopyS16ToU12,      /* FP_U12 */
+	&addCopyS16ToU14,      /* FP_U14 */
+	NULL,                  /* FP_S8_7 */
+	NULL,                  /* FP_S10_5 */
+	NULL,                  /* FP_S12_3 */
+	NULL,                  /* FP_S14_1 */
+};
+
 static const PlaneBlitFunction kCopyTable[LdpFPCount][LdpFPCount] = {
 	/* src/dst   U8            U10            U12                U14                S8.7          S10.5          S12.3          S14.1*/
 	/* U8    */ {NULL,         &copyU8ToU10,  &copyU8ToU12,      &copyU8ToU14,      &copyU8ToS16, &copyU8ToS16,  &copyU8ToS16,  &copyU8ToS16},
@@ -280,3 +358,21 @@ PlaneBlitFunction planeBlitGetFunctionScalar(LdpFixedPoint srcFP, LdpFixedPoint
 }
 
 /*------------------------------------------------------------------------------*/
+
+PlaneBlitFunction planeBlitGetAddCopyFunctionScalar(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
+                                                    uint32_t planeIndex, bool isNV12)
+{
+    /* Source and residuals are both signed, and must be able to hold the destination */
+    if (!fixedPointIsSigned(srcFP) || fixedPointIsSigned(dstFP) ||
+        bitdepthFromFixedPoint(srcFP) > bitdepthFromFixedPoint(dstFP)) {
+        return NULL;
+    }
+
+    if (isNV12 && planeIndex > 0) {
+        return (dstFP == LdpFPU8) ? &addCopyS16ToU8Nv12 : NULL;
+    }
+
+    return kAddCopyTable[dstFP];
+}
+
+/*------------------------------------------------------------------------------*/
@@ -488,6 +488,126 @@ static void copyS16_U16_SSE(const LdppBlitArgs* args, const int16_t shift, const
     }
 }
 
+/*------------------------------------------------------------------------------*/
+
+/* Add S16 to S16 and copy to U8: ((saturate(val + add) + 64) >> 7) + 128 */
+static void addCopyS16_U8_SSE(const LdppBlitArgs* args)
+{
+    const __m128i rounding = _mm_set1_epi16(0x40);
+    const __m128i offset = _mm_set1_epi16(0x80);
+    const uint32_t addStride = args->add->rowByteStride / sizeof(int16_t);
+    const int16_t* addRow = (const int16_t*)VN_PLANE_GETLINE(args->add, args->offset);
+
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint8_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const int16_t* srcPixel = srcRow;
+        const int16_t* addPixel = addRow;
+        uint8_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, addPixel += kStep, dstPixel += kStep) {
+            /* Load 16-pixels */
+            __m128i left = _mm_loadu_si128((const __m128i*)srcPixel);
+            __m128i right = _mm_loadu_si128((const __m128i*)(srcPixel + 8));
+            const __m128i addLeft = _mm_loadu_si128((const __m128i*)addPixel);
+            const __m128i addRight = _mm_loadu_si128((const __m128i*)(addPixel + 8));
+
+            /* val += add */
+            left = _mm_adds_epi16(left, addLeft);
+            right = _mm_adds_epi16(right, addRight);
+
+            /* val += rounding */
+            left = _mm_adds_epi16(left, rounding);
+            right = _mm_adds_epi16(right, rounding);
+
+            /* val >>= shift */
+            left = _mm_srai_epi16(left, 7);
+            right = _mm_srai_epi16(right, 7);
+
+            /* val += signed_offset */
+            left = _mm_add_epi16(left, offset);
+            right = _mm_add_epi16(right, offset);
+
+            /* clamp & store */
+            _mm_storeu_si128((__m128i*)dstPixel, _mm_packus_epi16(left, right));
+        }
+
+        for (; x < width; x++, srcPixel++, addPixel++, dstPixel++) {
+            *dstPixel = fpS8ToU8(saturateS16(*srcPixel + *addPixel));
+        }
+
+        srcRow += srcStride;
+        addRow += addStride;
+        dstRow += dstStride;
+    }
+}
+
+/* Add S16 to S16 and copy to U16: as copyS16_U16_SSE, applied to saturate(val + add) */
+static void addCopyS16_U16_SSE(const LdppBlitArgs* args, const int16_t shift,
+                               const int16_t signOffset, const uint16_t maxValue)
+{
+    const int16_t roundingValue = (int16_t)(1 << (shift - 1));
+    const __m128i rounding = _mm_set1_epi16(roundingValue);
+    const __m128i offset = _mm_set1_epi16(signOffset);
+    const __m128i minV = _mm_set1_epi16(0);
+    const __m128i maxV = _mm_set1_epi16((int16_t)maxValue);
+    const uint32_t addStride = args->add->rowByteStride / sizeof(int16_t);
+    const int16_t* addRow = (const int16_t*)VN_PLANE_GETLINE(args->add, args->offset);
+
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint16_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const int16_t* srcPixel = srcRow;
+        const int16_t* addPixel = addRow;
+        uint16_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, addPixel += kStep, dstPixel += kStep) {
+            /* Load 16-pixels */
+            __m128i left = _mm_loadu_si128((const __m128i*)srcPixel);
+            __m128i right = _mm_loadu_si128((const __m128i*)(srcPixel + 8));
+            const __m128i addLeft = _mm_loadu_si128((const __m128i*)addPixel);
+            const __m128i addRight = _mm_loadu_si128((const __m128i*)(addPixel + 8));
+
+            /* val += add */
+            left = _mm_adds_epi16(left, addLeft);
+            right = _mm_adds_epi16(right, addRight);
+
+            /* val += rounding */
+            left = _mm_adds_epi16(left, rounding);
+            right = _mm_adds_epi16(right, rounding);
+
+            /* val >>= shift */
+            left = _mm_srai_epi16(left, shift);
+            right = _mm_srai_epi16(right, shift);
+
+            /* val += signed_offset */
+            left = _mm_add_epi16(left, offset);
+            right = _mm_add_epi16(right, offset);
+
+            /* clamp */
+            left = _mm_max_epi16(_mm_min_epi16(left, maxV), minV);
+            right = _mm_max_epi16(_mm_min_epi16(right, maxV), minV);
+
+            /* Store 16-pixels */
+            _mm_storeu_si128((__m128i*)dstPixel, left);
+            _mm_storeu_si128((__m128i*)(dstPixel + 8), right);
+        }
+
+        for (; x < width; x++, srcPixel++, addPixel++, dstPixel++) {
+            *dstPixel = fpS16ToU16(saturateS16(*srcPixel + *addPixel), shift, roundingValue,
+                                   signOffset, maxValue);
+        }
+
+        srcRow += srcStride;
+        addRow += addStride;
+        dstRow += dstStride;
+    }
+}
+
+/*------------------------------------------------------------------------------*/
+
 static void copyU8_U10_SSE(const LdppBlitArgs* args) { copyU8_U16_SSE(args, 2); }
 
 static void copyU8_U12_SSE(const LdppBlitArgs* args) { copyU8_U16_SSE(args, 4); }
@@ -512,6 +632,21 @@ static void copyS16_U12_SSE(const LdppBlitArgs* args) { copyS16_U16_SSE(args, 3,
 
 static void copyS16_U14_SSE(const LdppBlitArgs* args) { copyS16_U16_SSE(args, 1, 0x2000, 16383); }
 
+static void addCopyS16_U10_SSE(const LdppBlitArgs* args)
+{
+    addCopyS16_U16_SSE(args, 5, 0x200, 1023);
+}
+
+static void addCopyS16_U12_SSE(const LdppBlitArgs* args)
+{
+    addCopyS16_U16_SSE(args, 3, 0x800, 4095);
+}
+
+static void addCopyS16_U14_SSE(const LdppBlitArgs* args)
+{
+    addCopyS16_U16_SSE(args, 1, 0x2000, 16383);
+}
+
 /*------------------------------------------------------------------------------
  * Tables
  *------------------------------------------------------------------------------*/
@@ -529,6 +664,17 @@ static const PlaneBlitFunction kAddTable[LdpFPCount] = {
 	&addS16_SSE, /* FP_S14_1 */
 };
 
+static const PlaneBlitFunction kAddCopyTable[LdpFPCount] = {
+	&addCopyS16_U8_SSE,  /* FP_U8 */
+	&addCopyS16_U10_SSE, /* FP_U10 */
+	&addCopyS16_U12_SSE, /* FP_U12 */
+	&addCopyS16_U14_SSE, /* FP_U14 */
+	NULL,                /* FP_S8_7 */
+	NULL,                /* FP_S10_5 */
+	NULL,                /* FP_S12_3 */
+	NULL,                /* FP_S14_1 */
+};
+
 static const PlaneBlitFunction kCopyTable[LdpFPCount][LdpFPCount] = {
 	/* src/dst   U8                U10               U12               U14               S8.7             S10.5             S12.3             S14.1*/
 	/* U8    */ {NULL,             &copyU8_U10_SSE,  &copyU8_U12_SSE,  &copyU8_U14_SSE,  &copyU8_S16_SSE, &copyU8_S16_SSE,  &copyU8_S16_SSE,  &copyU8_S16_SSE},
@@ -568,6 +714,16 @@ PlaneBlitFunction planeBlitGetFunctionSSE(LdpFixedPoint srcFP, LdpFixedPoint dst
     return NULL;
 }
 
+PlaneBlitFunction planeBlitGetAddCopyFunctionSSE(LdpFixedPoint dstFP, uint32_t planeIndex,
+                                                 bool isNV12)
+{
+    /* Only the interleaved chroma plane of NV12 needs the scalar path */
+    if (isNV12 && planeIndex > 0) {
+        return NULL;
+    }
+    return kAddCopyTable[dstFP];
+}
+
 /*------------------------------------------------------------------------------*/
 
 #else /* VN_CORE_FEATURE(SSE) */
@@ -584,4 +740,14 @@ PlaneBlitFunction planeBlitGetFunctionSSE(LdpFixedPoint srcFP, LdpFixedPoint dst
     return NULL;
 }
 
+PlaneBlitFunction planeBlitGetAddCopyFunctionSSE(LdpFixedPoint dstFP, uint32_t planeIndex,
+                                                 bool isNV12)
+{
+    VNUnused(dstFP);
+    VNUnused(planeIndex);
+    VNUnused(isNV12);
+
+    return NULL;
+}
+
 #endif /* VN_CORE_FEATURE(SSE) */
@@ -0,0 +1,700 @@
+/* Copyright (c) V-Nova International Limited 2022-2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#ifndef VN_LCEVC_PIXEL_PROCESSING_BLIT_WIDE_H
+#define VN_LCEVC_PIXEL_PROCESSING_BLIT_WIDE_H
+
+/* Blit functions shared by the AVX2 and AVX-512 implementations. They are the blit_sse.c
+ * functions, written in terms of a vector of `kStep / 2` 16-bit values. Before including this
+ * file, the implementation must define:
+ *
+ *    VnWide                               The vector type.
+ *    VN_WIDE(op)                          Name of the intrinsic for `op`, e.g. `adds_epi16`.
+ *    kStep                                Number of pixels processed per SIMD iteration.
+ *    loadWide(), storeWide()              Unaligned vector load and store.
+ *    loadWideU8()                         Load `kStep / 2` U8 pixels, zero extended to 16-bit.
+ *    packusWideU8(a, b)                   Saturate a, then b, to U8, in order.
+ *    planeBlitGetFunctionTemplate         Name of the blit function getter.
+ *    planeBlitGetAddCopyFunctionTemplate  Name of the add-copy function getter.
+ */
+
+#include "blit_common.h"
+#include "fp_types.h"
+
+#include <assert.h>
+#include <LCEVC/common/limit.h>
+#include <LCEVC/pipeline/types.h>
+#include <LCEVC/pixel_processing/blit.h>
+
+/*------------------------------------------------------------------------------*/
+
+static inline uint32_t simdAlignment(const uint32_t width) { return alignTruncU32(width, kStep); }
+
+/*------------------------------------------------------------------------------*/
+
+/*! \brief Performs an additive blit of an S16 input onto a U8 destination */
+static void addU8(const LdppBlitArgs* args)
+{
+    static const int32_t kShift = 7;
+    const VnWide usToSOffset = VN_WIDE(set1_epi16)(0x4000);
+    const VnWide fractOffset = VN_WIDE(set1_epi16)(0x40);
+    const VnWide signOffset = VN_WIDE(set1_epi16)(0x80);
+
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint8_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const int16_t* srcPixel = srcRow;
+        uint8_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        /* SIMD loop */
+        for (; x < simdWidth; x += kStep, dstPixel += kStep, srcPixel += kStep) {
+            /* Load pixels, and cast from u8 to u16 */
+            VnWide dstLeft = loadWideU8(dstPixel);
+            VnWide dstRight = loadWideU8(dstPixel + (kStep / 2));
+            const VnWide srcLeft = loadWide(srcPixel);
+            const VnWide srcRight = loadWide(srcPixel + (kStep / 2));
+
+            /* val <<= 7 */
+            dstLeft = VN_WIDE(slli_epi16)(dstLeft, kShift);
+            dstRight = VN_WIDE(slli_epi16)(dstRight, kShift);
+
+            /* val -= 0x4000 */
+            dstLeft = VN_WIDE(sub_epi16)(dstLeft, usToSOffset);
+            dstRight = VN_WIDE(sub_epi16)(dstRight, usToSOffset);
+
+            /* val += src */
+            dstLeft = VN_WIDE(adds_epi16)(dstLeft, srcLeft);
+            dstRight = VN_WIDE(adds_epi16)(dstRight, srcRight);
+
+            /* val += 0x40*/
+            dstLeft = VN_WIDE(adds_epi16)(dstLeft, fractOffset);
+            dstRight = VN_WIDE(adds_epi16)(dstRight, fractOffset);
+
+            /* val >>= 7 */
+            dstLeft = VN_WIDE(srai_epi16)(dstLeft, kShift);
+            dstRight = VN_WIDE(srai_epi16)(dstRight, kShift);
+
+            /* val += 0x80 */
+            dstLeft = VN_WIDE(add_epi16)(dstLeft, signOffset);
+            dstRight = VN_WIDE(add_epi16)(dstRight, signOffset);
+
+            /* Saturated cast back to u8, and store */
+            storeWide(dstPixel, packusWideU8(dstLeft, dstRight));
+        }
+
+        /* Remainder */
+        for (; x < width; x += 1, dstPixel += 1, srcPixel += 1) {
+            int32_t pel = fpU8ToS8(*dstPixel);
+            pel += *srcPixel;
+            *dstPixel = fpS8ToU8(pel);
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+/*! \brief Performs an additive blit of an S16 input onto a U16 destination */
+static void addUN(const LdppBlitArgs* args, int32_t shift, int16_t roundingOffset,
+                  int16_t signOffset, int16_t resultMax, LdpFixedPoint unsignedFP)
+{
+    FixedPointPromotionFunction uToS = fixedPointGetPromotionFunction(unsignedFP);
+    FixedPointDemotionFunction sToU = fixedPointGetDemotionFunction(unsignedFP);
+
+    const VnWide usToSOffset = VN_WIDE(set1_epi16)(16384);
+    const VnWide roundingOffsetV = VN_WIDE(set1_epi16)(roundingOffset);
+    const VnWide signOffsetV = VN_WIDE(set1_epi16)(signOffset);
+    const VnWide minV = VN_WIDE(set1_epi16)(0);
+    const VnWide maxV = VN_WIDE(set1_epi16)(resultMax);
+
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint16_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const int16_t* srcPixel = srcRow;
+        uint16_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        /* SIMD loop*/
+        for (; x < simdWidth; x += kStep, dstPixel += kStep, srcPixel += kStep) {
+            /* Load pixels */
+            VnWide dst0 = loadWide(dstPixel);
+            VnWide dst1 = loadWide(dstPixel + (kStep / 2));
+            const VnWide src0 = loadWide(srcPixel);
+            const VnWide src1 = loadWide(srcPixel + (kStep / 2));
+
+            /* val <<= shift */
+            dst0 = VN_WIDE(slli_epi16)(dst0, shift);
+            dst1 = VN_WIDE(slli_epi16)(dst1, shift);
+
+            /* val -= 0x4000 */
+            dst0 = VN_WIDE(sub_epi16)(dst0, usToSOffset);
+            dst1 = VN_WIDE(sub_epi16)(dst1, usToSOffset);
+
+            /* val += src */
+            dst0 = VN_WIDE(adds_epi16)(dst0, src0);
+            dst1 = VN_WIDE(adds_epi16)(dst1, src1);
+
+            /* val += fract_half_offset */
+            dst0 = VN_WIDE(adds_epi16)(dst0, roundingOffsetV);
+            dst1 = VN_WIDE(adds_epi16)(dst1, roundingOffsetV);
+
+            /* val >>= shift */
+            dst0 = VN_WIDE(srai_epi16)(dst0, shift);
+            dst1 = VN_WIDE(srai_epi16)(dst1, shift);
+
+            /* val += sign_offset */
+            dst0 = VN_WIDE(add_epi16)(dst0, signOffsetV);
+            dst1 = VN_WIDE(add_epi16)(dst1, signOffsetV);
+
+            /* clamp to unsigned range */
+            dst0 = VN_WIDE(max_epi16)(VN_WIDE(min_epi16)(dst0, maxV), minV);
+            dst1 = VN_WIDE(max_epi16)(VN_WIDE(min_epi16)(dst1, maxV), minV);
+
+            /* Store pixels */
+            storeWide(dstPixel, dst0);
+            storeWide(dstPixel + (kStep / 2), dst1);
+        }
+
+        /* Remainder */
+        for (; x < width; x += 1, dstPixel += 1, srcPixel += 1) {
+            int32_t pel = uToS(*dstPixel);
+            pel += *srcPixel;
+            *dstPixel = sToU(pel);
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+/*! \brief Performs an additive blit of an S16 input onto a S16 destination */
+static void addS16(const LdppBlitArgs* args)
+{
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, int16_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const int16_t* srcPixel = srcRow;
+        int16_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        /* SIMD loop*/
+        for (; x < simdWidth; x += kStep, dstPixel += kStep, srcPixel += kStep) {
+            /* Load pixels */
+            VnWide dst0 = loadWide(dstPixel);
+            VnWide dst1 = loadWide(dstPixel + (kStep / 2));
+            const VnWide src0 = loadWide(srcPixel);
+            const VnWide src1 = loadWide(srcPixel + (kStep / 2));
+
+            /* val += src */
+            dst0 = VN_WIDE(adds_epi16)(dst0, src0);
+            dst1 = VN_WIDE(adds_epi16)(dst1, src1);
+
+            /* Store pixels */
+            storeWide(dstPixel, dst0);
+            storeWide(dstPixel + (kStep / 2), dst1);
+        }
+
+        /* Remainder */
+        for (; x < width; x += 1, dstPixel += 1, srcPixel += 1) {
+            int32_t pel = *dstPixel;
+            pel += *srcPixel;
+            *dstPixel = saturateS16(pel);
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+static void addU10(const LdppBlitArgs* args) { addUN(args, 5, 16, 512, 1023, LdpFPU10); }
+
+static void addU12(const LdppBlitArgs* args) { addUN(args, 3, 4, 2048, 4095, LdpFPU12); }
+
+static void addU14(const LdppBlitArgs* args) { addUN(args, 1, 1, 8192, 16383, LdpFPU14); }
+
+/*------------------------------------------------------------------------------*/
+
+/* Copy U8 to U16: val << shift  */
+static void copyU8_U16(const LdppBlitArgs* args, const int16_t shift)
+{
+    VN_BLIT_SIMD_BOILERPLATE(uint8_t, uint16_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const uint8_t* srcPixel = srcRow;
+        uint16_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        /* SIMD loop */
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, dstPixel += kStep) {
+            /* Load pixels, and convert to uint16_t */
+            VnWide left = loadWideU8(srcPixel);
+            VnWide right = loadWideU8(srcPixel + (kStep / 2));
+
+            /* val <<= shift */
+            left = VN_WIDE(slli_epi16)(left, shift);
+            right = VN_WIDE(slli_epi16)(right, shift);
+
+            /* Store pixels */
+            storeWide(dstPixel, left);
+            storeWide(dstPixel + (kStep / 2), right);
+        }
+
+        /* Remainder */
+        for (; x < width; x++, srcPixel++, dstPixel++) {
+            *dstPixel = (uint16_t)(*srcPixel << shift);
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+/* Copy U8 to S16: (val << 7) - 0x4000 */
+static void copyU8_S16(const LdppBlitArgs* args)
+{
+    static const int16_t kShift = 7;
+    const VnWide offset = VN_WIDE(set1_epi16)(0x4000);
+
+    VN_BLIT_SIMD_BOILERPLATE(uint8_t, int16_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const uint8_t* srcPixel = srcRow;
+        int16_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, dstPixel += kStep) {
+            /* Load pixels, and convert to int16_t */
+            VnWide left = loadWideU8(srcPixel);
+            VnWide right = loadWideU8(srcPixel + (kStep / 2));
+
+            /* val <<= shift */
+            left = VN_WIDE(slli_epi16)(left, kShift);
+            right = VN_WIDE(slli_epi16)(right, kShift);
+
+            /* val -= sign_offset */
+            left = VN_WIDE(sub_epi16)(left, offset);
+            right = VN_WIDE(sub_epi16)(right, offset);
+
+            /* Store pixels */
+            storeWide(dstPixel, left);
+            storeWide(dstPixel + (kStep / 2), right);
+        }
+
+        for (; x < width; x++, srcPixel++, dstPixel++) {
+            *dstPixel = fpU16ToS16(*srcPixel, kShift);
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+/* Copy U16 to S16: (val << shift) - 0x4000 */
+static void copyU16_S16(const LdppBlitArgs* args, const int16_t shift)
+{
+    const VnWide offset = VN_WIDE(set1_epi16)(0x4000);
+
+    VN_BLIT_SIMD_BOILERPLATE(uint16_t, int16_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const uint16_t* srcPixel = srcRow;
+        int16_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, dstPixel += kStep) {
+            /* Load pixels */
+            VnWide left = loadWide(srcPixel);
+            VnWide right = loadWide(srcPixel + (kStep / 2));
+
+            /* val <<= shift */
+            left = VN_WIDE(slli_epi16)(left, shift);
+            right = VN_WIDE(slli_epi16)(right, shift);
+
+            /* val -= signOffset */
+            left = VN_WIDE(sub_epi16)(left, offset);
+            right = VN_WIDE(sub_epi16)(right, offset);
+
+            /* Store pixels */
+            storeWide(dstPixel, left);
+            storeWide(dstPixel + (kStep / 2), right);
+        }
+
+        for (; x < width; x++, srcPixel++, dstPixel++) {
+            *dstPixel = fpU16ToS16(*srcPixel, shift);
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+/* Copy U16 to U8: val >> shift */
+static void copyU16_U8(const LdppBlitArgs* args, const int16_t shift)
+{
+    VN_BLIT_SIMD_BOILERPLATE(uint16_t, uint8_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const uint16_t* srcPixel = srcRow;
+        uint8_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, dstPixel += kStep) {
+            /* Load pixels */
+            VnWide left = loadWide(srcPixel);
+            VnWide right = loadWide(srcPixel + (kStep / 2));
+
+            /* val >>= shift */
+            left = VN_WIDE(srai_epi16)(left, shift);
+            right = VN_WIDE(srai_epi16)(right, shift);
+
+            /* clamp & store */
+            storeWide(dstPixel, packusWideU8(left, right));
+        }
+
+        for (; x < width; x++, srcPixel++, dstPixel++) {
+            *dstPixel = saturateU8(*srcPixel >> shift);
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+/* Copy S8.7 to U8: ((val + 64) >> 7) + 128 */
+static void copyS8_7_U8(const LdppBlitArgs* args)
+{
+    const VnWide rounding = VN_WIDE(set1_epi16)(0x40);
+    const VnWide offset = VN_WIDE(set1_epi16)(0x80);
+
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint8_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const int16_t* srcPixel = srcRow;
+        uint8_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, dstPixel += kStep) {
+            /* Load pixels */
+            VnWide left = loadWide(srcPixel);
+            VnWide right = loadWide(srcPixel + (kStep / 2));
+
+            /* val += rounding */
+            left = VN_WIDE(adds_epi16)(left, rounding);
+            right = VN_WIDE(adds_epi16)(right, rounding);
+
+            /* val >>= shift */
+            left = VN_WIDE(srai_epi16)(left, 7);
+            right = VN_WIDE(srai_epi16)(right, 7);
+
+            /* val += signed_offset */
+            left = VN_WIDE(add_epi16)(left, offset);
+            right = VN_WIDE(add_epi16)(right, offset);
+
+            /* clamp & store */
+            storeWide(dstPixel, packusWideU8(left, right));
+        }
+
+        for (; x < width; x++, srcPixel++, dstPixel++) {
+            *dstPixel = fpS8ToU8(*srcPixel);
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+/* Copy S16 to U16: clamped(0, maxValue, ((((val + rounding) >> shift) + signed_offset)) */
+static void copyS16_U16(const LdppBlitArgs* args, const int16_t shift, const int16_t signOffset,
+                        const uint16_t maxValue)
+{
+    const int16_t roundingValue = (int16_t)(1 << (shift - 1));
+    const VnWide rounding = VN_WIDE(set1_epi16)(roundingValue);
+    const VnWide offset = VN_WIDE(set1_epi16)(signOffset);
+    const VnWide minV = VN_WIDE(set1_epi16)(0);
+    const VnWide maxV = VN_WIDE(set1_epi16)((int16_t)maxValue);
+
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint16_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const int16_t* srcPixel = srcRow;
+        uint16_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, dstPixel += kStep) {
+            /* Load pixels */
+            VnWide left = loadWide(srcPixel);
+            VnWide right = loadWide(srcPixel + (kStep / 2));
+
+            /* val += rounding */
+            left = VN_WIDE(adds_epi16)(left, rounding);
+            right = VN_WIDE(adds_epi16)(right, rounding);
+
+            /* val >>= shift */
+            left = VN_WIDE(srai_epi16)(left, shift);
+            right = VN_WIDE(srai_epi16)(right, shift);
+
+            /* val += signed_offset */
+            left = VN_WIDE(add_epi16)(left, offset);
+            right = VN_WIDE(add_epi16)(right, offset);
+
+            /* clamp */
+            left = VN_WIDE(max_epi16)(VN_WIDE(min_epi16)(left, maxV), minV);
+            right = VN_WIDE(max_epi16)(VN_WIDE(min_epi16)(right, maxV), minV);
+
+            /* Store pixels */
+            storeWide(dstPixel, left);
+            storeWide(dstPixel + (kStep / 2), right);
+        }
+
+        for (; x < width; x++, srcPixel++, dstPixel++) {
+            *dstPixel = fpS16ToU16(*srcPixel, shift, roundingValue, signOffset, maxValue);
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+/*------------------------------------------------------------------------------*/
+
+/* Add S16 to S16 and copy to U8: ((saturate(val + add) + 64) >> 7) + 128 */
+static void addCopyS16_U8(const LdppBlitArgs* args)
+{
+    const VnWide rounding = VN_WIDE(set1_epi16)(0x40);
+    const VnWide offset = VN_WIDE(set1_epi16)(0x80);
+    const uint32_t addStride = args->add->rowByteStride / sizeof(int16_t);
+    const int16_t* addRow = (const int16_t*)VN_PLANE_GETLINE(args->add, args->offset);
+
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint8_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const int16_t* srcPixel = srcRow;
+        const int16_t* addPixel = addRow;
+        uint8_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, addPixel += kStep, dstPixel += kStep) {
+            /* Load pixels */
+            VnWide left = loadWide(srcPixel);
+            VnWide right = loadWide(srcPixel + (kStep / 2));
+            const VnWide addLeft = loadWide(addPixel);
+            const VnWide addRight = loadWide(addPixel + (kStep / 2));
+
+            /* val += add */
+            left = VN_WIDE(adds_epi16)(left, addLeft);
+            right = VN_WIDE(adds_epi16)(right, addRight);
+
+            /* val += rounding */
+            left = VN_WIDE(adds_epi16)(left, rounding);
+            right = VN_WIDE(adds_epi16)(right, rounding);
+
+            /* val >>= shift */
+            left = VN_WIDE(srai_epi16)(left, 7);
+            right = VN_WIDE(srai_epi16)(right, 7);
+
+            /* val += signed_offset */
+            left = VN_WIDE(add_epi16)(left, offset);
+            right = VN_WIDE(add_epi16)(right, offset);
+
+            /* clamp & store */
+            storeWide(dstPixel, packusWideU8(left, right));
+        }
+
+        for (; x < width; x++, srcPixel++, addPixel++, dstPixel++) {
+            *dstPixel = fpS8ToU8(saturateS16(*srcPixel + *addPixel));
+        }
+
+        srcRow += srcStride;
+        addRow += addStride;
+        dstRow += dstStride;
+    }
+}
+
+/* Add S16 to S16 and copy to U16: as copyS16_U16, applied to saturate(val + add) */
+static void addCopyS16_U16(const LdppBlitArgs* args, const int16_t shift, const int16_t signOffset,
+                           const uint16_t maxValue)
+{
+    const int16_t roundingValue = (int16_t)(1 << (shift - 1));
+    const VnWide rounding = VN_WIDE(set1_epi16)(roundingValue);
+    const VnWide offset = VN_WIDE(set1_epi16)(signOffset);
+    const VnWide minV = VN_WIDE(set1_epi16)(0);
+    const VnWide maxV = VN_WIDE(set1_epi16)((int16_t)maxValue);
+    const uint32_t addStride = args->add->rowByteStride / sizeof(int16_t);
+    const int16_t* addRow = (const int16_t*)VN_PLANE_GETLINE(args->add, args->offset);
+
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint16_t);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const int16_t* srcPixel = srcRow;
+        const int16_t* addPixel = addRow;
+        uint16_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep, srcPixel += kStep, addPixel += kStep, dstPixel += kStep) {
+            /* Load pixels */
+            VnWide left = loadWide(srcPixel);
+            VnWide right = loadWide(srcPixel + (kStep / 2));
+            const VnWide addLeft = loadWide(addPixel);
+            const VnWide addRight = loadWide(addPixel + (kStep / 2));
+
+            /* val += add */
+            left = VN_WIDE(adds_epi16)(left, addLeft);
+            right = VN_WIDE(adds_epi16)(right, addRight);
+
+            /* val += rounding */
+            left = VN_WIDE(adds_epi16)(left, rounding);
+            right = VN_WIDE(adds_epi16)(right, rounding);
+
+            /* val >>= shift */
+            left = VN_WIDE(srai_epi16)(left, shift);
+            right = VN_WIDE(srai_epi16)(right, shift);
+
+            /* val += signed_offset */
+            left = VN_WIDE(add_epi16)(left, offset);
+            right = VN_WIDE(add_epi16)(right, offset);
+
+            /* clamp */
+            left = VN_WIDE(max_epi16)(VN_WIDE(min_epi16)(left, maxV), minV);
+            right = VN_WIDE(max_epi16)(VN_WIDE(min_epi16)(right, maxV), minV);
+
+            /* Store pixels */
+            storeWide(dstPixel, left);
+            storeWide(dstPixel + (kStep / 2), right);
+        }
+
+        for (; x < width; x++, srcPixel++, addPixel++, dstPixel++) {
+            *dstPixel = fpS16ToU16(saturateS16(*srcPixel + *addPixel), shift, roundingValue,
+                                   signOffset, maxValue);
+        }
+
+        srcRow += srcStride;
+        addRow += addStride;
+        dstRow += dstStride;
+    }
+}
+
+/*------------------------------------------------------------------------------*/
+
+static void copyU8_U10(const LdppBlitArgs* args) { copyU8_U16(args, 2); }
+
+static void copyU8_U12(const LdppBlitArgs* args) { copyU8_U16(args, 4); }
+
+static void copyU8_U14(const LdppBlitArgs* args) { copyU8_U16(args, 6); }
+
+static void copyU10_S16(const LdppBlitArgs* args) { copyU16_S16(args, 5); }
+
+static void copyU12_S16(const LdppBlitArgs* args) { copyU16_S16(args, 3); }
+
+static void copyU14_S16(const LdppBlitArgs* args) { copyU16_S16(args, 1); }
+
+static void copyU10_U8(const LdppBlitArgs* args) { copyU16_U8(args, 2); }
+
+static void copyU12_U8(const LdppBlitArgs* args) { copyU16_U8(args, 4); }
+
+static void copyU14_U8(const LdppBlitArgs* args) { copyU16_U8(args, 6); }
+
+static void copyS16_U10(const LdppBlitArgs* args) { copyS16_U16(args, 5, 0x200, 1023); }
+
+static void copyS16_U12(const LdppBlitArgs* args) { copyS16_U16(args, 3, 0x800, 4095); }
+
+static void copyS16_U14(const LdppBlitArgs* args) { copyS16_U16(args, 1, 0x2000, 16383); }
+
+static void addCopyS16_U10(const LdppBlitArgs* args) { addCopyS16_U16(args, 5, 0x200, 1023); }
+
+static void addCopyS16_U12(const LdppBlitArgs* args) { addCopyS16_U16(args, 3, 0x800, 4095); }
+
+static void addCopyS16_U14(const LdppBlitArgs* args) { addCopyS16_U16(args, 1, 0x2000, 16383); }
+
+/*------------------------------------------------------------------------------
+ * Tables
+ *------------------------------------------------------------------------------*/
+
+/* clang-format off */
+
+static const PlaneBlitFunction kAddTable[LdpFPCount] = {
+	&addU8,  /* FP_U8 */
+	&addU10, /* FP_U10 */
+	&addU12, /* FP_U12 */
+	&addU14, /* FP_U14 */
+	&addS16, /* FP_S8_7 */
+	&addS16, /* FP_S10_5 */
+	&addS16, /* FP_S12_3 */
+	&addS16, /* FP_S14_1 */
+};
+
+static const PlaneBlitFunction kAddCopyTable[LdpFPCount] = {
+	&addCopyS16_U8,  /* FP_U8 */
+	&addCopyS16_U10, /* FP_U10 */
+	&addCopyS16_U12, /* FP_U12 */
+	&addCopyS16_U14, /* FP_U14 */
+	NULL,            /* FP_S8_7 */
+	NULL,            /* FP_S10_5 */
+	NULL,            /* FP_S12_3 */
+	NULL,            /* FP_S14_1 */
+};
+
+static const PlaneBlitFunction kCopyTable[LdpFPCount][LdpFPCount] = {
+	/* src/dst   U8             U10           U12           U14           S8.7         S10.5         S12.3         S14.1*/
+	/* U8    */ {NULL,          &copyU8_U10,  &copyU8_U12,  &copyU8_U14,  &copyU8_S16, &copyU8_S16,  &copyU8_S16,  &copyU8_S16},
+	/* U10   */ {&copyU10_U8,   NULL,         NULL,         NULL,         NULL,        &copyU10_S16, &copyU10_S16, &copyU10_S16},
+	/* U12   */ {&copyU12_U8,   NULL,         NULL,         NULL,         NULL,        NULL,         &copyU12_S16, &copyU12_S16},
+	/* U14   */ {&copyU14_U8,   NULL,         NULL,         NULL,         NULL,        NULL,         NULL,         &copyU14_S16},
+	/* S8.7  */ {&copyS8_7_U8,  &copyS16_U10, &copyS16_U12, &copyS16_U14, NULL,        NULL,         NULL,         NULL},
+	/* S10.5 */ {NULL,          &copyS16_U10, &copyS16_U12, &copyS16_U14, NULL,        NULL,         NULL,         NULL},
+	/* S12.3 */ {NULL,          NULL,         &copyS16_U12, &copyS16_U14, NULL,        NULL,         NULL,         NULL},
+	/* S14.1 */ {NULL,          NULL,         NULL,         &copyS16_U14, NULL,        NULL,         NULL,         NULL},
+};
+
+/* clang-format on */
+
+/*------------------------------------------------------------------------------*/
+
+PlaneBlitFunction planeBlitGetFunctionTemplate(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
+                                               LdppBlendingMode blending, uint32_t planeIndex,
+                                               bool isNV12)
+{
+    VNUnused(planeIndex);
+
+    if (blending == BMAdd) {
+        /* Ensure formats match */
+        assert(fixedPointIsValid(dstFP));
+        assert(fixedPointHighPrecision(dstFP) == srcFP);
+
+        return kAddTable[dstFP];
+    }
+
+    if (blending == BMCopy) {
+        if (isNV12) {
+            return NULL;
+        }
+        return kCopyTable[srcFP][dstFP];
+    }
+
+    return NULL;
+}
+
+PlaneBlitFunction planeBlitGetAddCopyFunctionTemplate(LdpFixedPoint dstFP, uint32_t planeIndex,
+                                                      bool isNV12)
+{
+    /* Only the interleaved chroma plane of NV12 needs the scalar path */
+    if (isNV12 && planeIndex > 0) {
+        return NULL;
+    }
+    return kAddCopyTable[dstFP];
+}
+
+/*------------------------------------------------------------------------------*/
+
+#endif // VN_LCEVC_PIXEL_PROCESSING_BLIT_WIDE_H
@@ -19,6 +19,7 @@
 #include <LCEVC/pixel_processing/upscale.h>
 //
 #include "fp_types.h"
+#include "upscale_avx2.h"
 #include "upscale_neon.h"
 #include "upscale_scalar.h"
 #include "upscale_sse.h"
@@ -28,6 +29,11 @@
 
 /*------------------------------------------------------------------------------*/
 
+/* Smallest number of source rows that an upscale slice will be split down to. */
+static const uint32_t kUpscaleMinSliceRows = 16;
+
+/*------------------------------------------------------------------------------*/
+
 /*! \brief  Helper function used to query the horizontal function look-up tables.
  *
  * It has a fall back mechanism when SIMD is desired to provide the non-SIMD
@@ -44,11 +50,15 @@ UpscaleHorizontalFunction getHorizontalFunction(LdpFixedPoint srcFP, LdpFixedPoi
     }
 
     UpscaleHorizontalFunction res = NULL;
-    const LdcAcceleration* acceleration = ldcAccelerationGet();
+    const LdcAccelerationFeatures* acceleration = ldcAccelerationGetKernel(LdcKernelUpscale);
 
     /* Find a SIMD functions */
 
-    if (!forceScalar && acceleration->SSE) {
+    if (!forceScalar && acceleration->AVX2) {
+        res = upscaleGetHorizontalFunctionAVX2(interleaving, srcFP, dstFP, baseFP);
+    }
+
+    if (!res && !forceScalar && acceleration->SSE) {
         res = upscaleGetHorizontalFunctionSSE(interleaving, srcFP, dstFP, baseFP);
     }
 
@@ -80,10 +90,15 @@ UpscaleVerticalFunction getVerticalFunction(LdpFixedPoint srcFP, LdpFixedPoint d
     }
 
     UpscaleVerticalFunction res = NULL;
-    const LdcAcceleration* acceleration = ldcAccelerationGet();
+    const LdcAccelerationFeatures* acceleration = ldcAccelerationGetKernel(LdcKernelUpscale);
 
     /* Find a SIMD function */
-    if (!forceScalar && acceleration->SSE) {
+    if (!forceScalar && acceleration->AVX2) {
+        res = upscaleGetVerticalFunctionAVX2(srcFP, dstFP);
+        *xStep = 16;
+    }
+
+    if (!res && !forceScalar && acceleration->SSE) {
         res = upscaleGetVerticalFunctionSSE(srcFP, dstFP);
         *xStep = 16;
     }
@@ -155,14 +170,7 @@ static void internalInitialise(LdcMemoryAllocator* allocator, const LdppUpscaleA
     }
 
     const LdpPictureLayoutInfo* dstLayoutInfo = params->dstLayout->layoutInfo;
-    const LdpFixedPoint fp = dstLayoutInfo->fixedPoint;
-    const int32_t channelCount = dstLayoutInfo->interleave[params->planeIndex];
-    const uint16_t strideAlignment =
-        (uint16_t)(getRequiredStrideAlignment(params->forceScalar) * channelCount);
-    const uint32_t upscaleWidth =
-        params->dstLayout->width >> (1 + dstLayoutInfo->planeWidthShift[params->planeIndex]);
-    const uint32_t upscaleStrideBytes =
-        alignU16((uint16_t)(upscaleWidth * channelCount), strideAlignment) * fixedPointByteSize(fp);
+    const uint32_t upscaleStrideBytes = ldppUpscaleIntermediateRowStride(params);
     const uint32_t upscaleHeight =
         params->dstLayout->height >> dstLayoutInfo->planeHeightShift[params->planeIndex];
     const uint32_t upscaleSize = upscaleHeight * upscaleStrideBytes;
@@ -221,6 +229,7 @@ typedef struct UpscaleSlicedJobContext
     LdpPicturePlaneDesc intermediatePlane;
     UpscaleHorizontalFunction lineFunction;
     UpscaleVerticalFunction colFunction;
+    LdpFixedPoint intermediateFP;
     LdeKernel kernel;
     bool applyPA;
     LdppDitherFrame* frameDither;
@@ -314,7 +323,7 @@ static void verticalTask(const UpscaleSlicedJobContext* context, uint32_t yStart
 {
     UpscaleVerticalFunction vertFunction = context->colFunction;
     const LdpFixedPoint srcFP = context->srcLayout->layoutInfo->fixedPoint;
-    const LdpFixedPoint dstFP = context->dstLayout->layoutInfo->fixedPoint;
+    const LdpFixedPoint dstFP = context->intermediateFP;
     const uint32_t srcPelSize = fixedPointByteSize(srcFP);
     const uint32_t dstPelSize = fixedPointByteSize(dstFP);
     uint32_t srcStep = xStep * srcPelSize;
@@ -326,11 +335,11 @@ static void verticalTask(const UpscaleSlicedJobContext* context, uint32_t yStart
     const uint8_t* srcPtr = context->srcPlane.firstSample;
     uint8_t* dstPtr = context->intermediatePlane.firstSample;
     const uint32_t width =
-        context->srcLayout->width >>
-        context->srcLayout->layoutInfo->planeWidthShift[context->planeIndex] * channelCount;
-    const uint32_t height =
-        context->srcLayout->height >>
-        context->srcLayout->layoutInfo->planeHeightShift[context->planeIndex] * channelCount;
+        (context->srcLayout->width >>
+         context->srcLayout->layoutInfo->planeWidthShift[context->planeIndex]) *
+        channelCount;
+    const uint32_t height = context->srcLayout->height >>
+                            context->srcLayout->layoutInfo->planeHeightShift[context->planeIndex];
     const uint32_t srcStride = context->srcPlane.rowByteStride / srcPelSize;
     const uint32_t dstStride = context->intermediatePlane.rowByteStride / dstPelSize;
 
@@ -400,66 +409,99 @@ static bool upscaleSlicedJobCompletion(void* argument, uint32_t count)
     return true;
 }
 
-/*! Execute a multi-threaded upscale operation. */
-static bool upscaleExecute(LdcMemoryAllocator* allocator, LdcTaskPool* taskPool, LdcTask* parent,
-                           const LdppUpscaleArgs* params, const LdeKernel* kernel)
+/*! Whether the upscale writes an unsigned destination at the precision of the signed type of the
+ *  same bit-depth, demoting as it stores. */
+static bool upscaleDemotes(const LdppUpscaleArgs* params)
 {
-    assert(params->mode != Scale0D);
+    const LdpFixedPoint srcFP = params->srcLayout->layoutInfo->fixedPoint;
+    const LdpFixedPoint dstFP = params->dstLayout->layoutInfo->fixedPoint;
 
-    UpscaleSlicedJobContext slicedJobContext = {0};
+    return !fixedPointIsSigned(dstFP) && (fixedPointIsSigned(srcFP) || params->signedPrecision);
+}
 
-    internalInitialise(allocator, params, &slicedJobContext.intermediateAllocation,
-                       &slicedJobContext.intermediatePlane);
+/*! The fixed-point type of the 2D intermediate plane, between the vertical and horizontal passes. */
+static LdpFixedPoint upscaleIntermediateFP(const LdppUpscaleArgs* params)
+{
+    const LdpFixedPoint dstFP = params->dstLayout->layoutInfo->fixedPoint;
+
+    return upscaleDemotes(params) ? fixedPointHighPrecision(dstFP) : dstFP;
+}
+
+/*! Fill out the shared upscale state, apart from the 2D intermediate plane. */
+static bool upscaleContextInitialize(UpscaleSlicedJobContext* context, const LdppUpscaleArgs* params,
+                                     const LdeKernel* kernel)
+{
+    assert(params->mode != Scale0D);
 
     const bool is2D = (params->mode == Scale2D);
 
     const LdpPictureLayoutInfo* srcLayoutInfo = params->srcLayout->layoutInfo;
-    const LdpPictureLayoutInfo* dstLayoutInfo = params->srcLayout->layoutInfo;
-    const LdpFixedPoint horizontalFPInput = is2D ? dstLayoutInfo->fixedPoint : srcLayoutInfo->fixedPoint;
-
-    slicedJobContext.planeIndex = params->planeIndex;
-    slicedJobContext.srcLayout = params->srcLayout;
-    slicedJobContext.dstLayout = params->dstLayout;
-    slicedJobContext.srcPlane = params->srcPlane;
-    slicedJobContext.dstPlane = params->dstPlane;
+    const LdpPictureLayoutInfo* dstLayoutInfo = params->dstLayout->layoutInfo;
+    const LdpFixedPoint intermediateFP = upscaleIntermediateFP(params);
+    const LdpFixedPoint horizontalFPInput = is2D ? intermediateFP : srcLayoutInfo->fixedPoint;
+
+    context->planeIndex = params->planeIndex;
+    context->srcLayout = params->srcLayout;
+    context->dstLayout = params->dstLayout;
+    context->srcPlane = params->srcPlane;
+    context->dstPlane = params->dstPlane;
     if (!is2D) {
-        slicedJobContext.intermediatePlane = params->srcPlane;
+        context->intermediatePlane = params->srcPlane;
     }
-    slicedJobContext.lineFunction =
+    context->lineFunction =
         getHorizontalFunction(horizontalFPInput, dstLayoutInfo->fixedPoint,
                               params->applyPA ? srcLayoutInfo->fixedPoint : LdpFPCount,
                               getInterleaving(srcLayoutInfo, params->planeIndex), params->forceScalar);
-    slicedJobContext.colFunction =
-        is2D ? getVerticalFunction(srcLayoutInfo->fixedPoint, dstLayoutInfo->fixedPoint,
-                                   params->forceScalar, &slicedJobContext.colStepping)
-             : NULL;
-    slicedJobContext.kernel = *kernel;
-    slicedJobContext.applyPA = params->applyPA;
-    slicedJobContext.frameDither = params->frameDither;
-
-    if (!slicedJobContext.lineFunction) {
+    context->colFunction = is2D ? getVerticalFunction(srcLayoutInfo->fixedPoint, intermediateFP,
+                                                      params->forceScalar, &context->colStepping)
+                                : NULL;
+    context->intermediateFP = intermediateFP;
+    context->kernel = *kernel;
+    context->applyPA = params->applyPA;
+    context->frameDither = params->frameDither;
+
+    if (!context->lineFunction) {
         VNLogError("Failed to find upscale horizontal function");
         return false;
     }
 
-    if (is2D && !slicedJobContext.colFunction) {
+    if (is2D && !context->colFunction) {
         VNLogError("Failed to find upscale vertical function");
         return false;
     }
 
+    return true;
+}
+
+/*! Execute a multi-threaded upscale operation. */
+static bool upscaleExecute(LdcMemoryAllocator* allocator, LdcTaskPool* taskPool, LdcTask* parent,
+                           const LdppUpscaleArgs* params, const LdeKernel* kernel)
+{
+    UpscaleSlicedJobContext slicedJobContext = {0};
+
+    internalInitialise(allocator, params, &slicedJobContext.intermediateAllocation,
+                       &slicedJobContext.intermediatePlane);
+
+    if (!upscaleContextInitialize(&slicedJobContext, params, kernel)) {
+        if (VNIsAllocated(slicedJobContext.intermediateAllocation)) {
+            VNFree(allocator, &slicedJobContext.intermediateAllocation);
+        }
+        return false;
+    }
+
     slicedJobContext.intermediateAllocator = allocator;
 
     const uint32_t srcHeight = params->srcLayout->height >>
                                params->srcLayout->layoutInfo->planeHeightShift[params->planeIndex];
 
     return ldcTaskPoolAddSlicedDeferred(taskPool, parent, &upscaleSlicedJob, &upscaleSlicedJobCompletion,
-                                        &slicedJobContext, sizeof(slicedJobContext), srcHeight);
+                                        &slicedJobContext, sizeof(slicedJobContext), srcHeight,
+                                        kUpscaleMinSliceRows);
 }
 
 /*------------------------------------------------------------------------------*/
 
-bool ldppUpscale(LdcMemoryAllocator* allocator, LdcTaskPool* taskPool, LdcTask* parent,
-                 const LdeKernel* kernel, const LdppUpscaleArgs* params)
+static bool upscaleValidate(const LdeKernel* kernel, const LdppUpscaleArgs* params)
 {
     const LdpPictureLayout* srcLayout = params->srcLayout;
     const LdpPictureLayout* dstLayout = params->dstLayout;
@@ -477,7 +519,33 @@ bool ldppUpscale(LdcMemoryAllocator* allocator, LdcTaskPool* taskPool, LdcTask*
     const LdpFixedPoint srcFP = srcLayout->layoutInfo->fixedPoint;
     const LdpFixedPoint dstFP = dstLayout->layoutInfo->fixedPoint;
 
-    if (fixedPointIsSigned(srcFP) != fixedPointIsSigned(dstFP)) {
+    /* Unsigned to signed is allowed at the same bit-depth, so the first upscale of a frame can
+     * read directly from the base picture, promoting as it loads. */
+    const bool promoteToSigned = !fixedPointIsSigned(srcFP) && fixedPointIsSigned(dstFP);
+
+    if (promoteToSigned && (fixedPointHighPrecision(srcFP) != dstFP)) {
+        VNLogError("upscale: unsigned to signed promotion must be to the same bitdepth\n");
+        return false;
+    }
+
+    /* Signed to unsigned is allowed at the same bit-depth, so the last upscale of a frame can
+     * write directly to the output picture, demoting as it stores. */
+    const bool demoteToUnsigned = fixedPointIsSigned(srcFP) && !fixedPointIsSigned(dstFP);
+
+    if (demoteToUnsigned && (fixedPointHighPrecision(dstFP) != srcFP)) {
+        VNLogError("upscale: signed to unsigned demotion must be to the same bitdepth\n");
+        return false;
+    }
+
+    if (params->signedPrecision && (fixedPointIsSigned(srcFP) || fixedPointIsSigned(dstFP) ||
+                                    (srcFP != dstFP) || (params->mode != Scale2D))) {
+        VNLogError("upscale: signed precision is only supported for 2D upscales between "
+                   "unsigned planes of the same bitdepth\n");
+        return false;
+    }
+
+    if (!promoteToSigned && !demoteToUnsigned &&
+        (fixedPointIsSigned(srcFP) != fixedPointIsSigned(dstFP))) {
         VNLogError("upscale: cannot convert between signed and unsigned formats\n");
         return false;
     }
@@ -488,7 +556,107 @@ bool ldppUpscale(LdcMemoryAllocator* allocator, LdcTaskPool* taskPool, LdcTask*
         return false;
     }
 
+    return true;
+}
+
+bool ldppUpscale(LdcMemoryAllocator* allocator, LdcTaskPool* taskPool, LdcTask* parent,
+                 const LdeKernel* kernel, const LdppUpscaleArgs* params)
+{
+    if (!upscaleValidate(kernel, params)) {
+        return false;
+    }
+
     return upscaleExecute(allocator, taskPool, parent, params, kernel);
 }
 
+bool ldppUpscalePromotionSupported(LdpFixedPoint srcFP, bool forceScalar)
+{
+    if (!fixedPointIsValid(srcFP) || fixedPointIsSigned(srcFP)) {
+        return false;
+    }
+
+    const LdcAccelerationFeatures* acceleration = ldcAccelerationGetKernel(LdcKernelUpscale);
+    const LdpFixedPoint dstFP = fixedPointHighPrecision(srcFP);
+
+    if (!forceScalar && acceleration->SSE) {
+        return upscaleGetVerticalFunctionSSE(srcFP, dstFP) &&
+               upscaleGetHorizontalFunctionSSE(ILNone, srcFP, dstFP, srcFP) &&
+               upscaleGetHorizontalFunctionSSE(ILNone, dstFP, dstFP, srcFP);
+    }
+
+    if (!forceScalar && acceleration->NEON) {
+        return upscaleGetVerticalFunctionNEON(srcFP, dstFP) &&
+               upscaleGetHorizontalFunctionNEON(ILNone, srcFP, dstFP, srcFP) &&
+               upscaleGetHorizontalFunctionNEON(ILNone, dstFP, dstFP, srcFP);
+    }
+
+    return true;
+}
+
+bool ldppUpscaleDemotionSupported(LdpFixedPoint srcFP, LdpFixedPoint dstFP, bool forceScalar)
+{
+    if (!fixedPointIsValid(dstFP) || fixedPointIsSigned(dstFP) ||
+        fixedPointHighPrecision(dstFP) != srcFP) {
+        return false;
+    }
+
+    const LdcAccelerationFeatures* acceleration = ldcAccelerationGetKernel(LdcKernelUpscale);
+
+    if (!forceScalar && acceleration->SSE) {
+        return upscaleGetHorizontalFunctionSSE(ILNone, srcFP, dstFP, srcFP) &&
+               upscaleGetHorizontalFunctionSSE(ILNone, srcFP, dstFP, dstFP);
+    }
+
+    if (!forceScalar && acceleration->NEON) {
+        return upscaleGetHorizontalFunctionNEON(ILNone, srcFP, dstFP, srcFP) &&
+               upscaleGetHorizontalFunctionNEON(ILNone, srcFP, dstFP, dstFP);
+    }
+
+    return true;
+}
+
+uint32_t ldppUpscaleIntermediateRowStride(const LdppUpscaleArgs* params)
+{
+    if (params->mode != Scale2D) {
+        return 0;
+    }
+
+    const LdpPictureLayoutInfo* dstLayoutInfo = params->dstLayout->layoutInfo;
+    const int32_t channelCount = dstLayoutInfo->interleave[params->planeIndex];
+    const uint16_t strideAlignment =
+        (uint16_t)(getRequiredStrideAlignment(params->forceScalar) * channelCount);
+    const uint32_t upscaleWidth =
+        params->dstLayout->width >> (1 + dstLayoutInfo->planeWidthShift[params->planeIndex]);
+
+    return alignU16((uint16_t)(upscaleWidth * channelCount), strideAlignment) *
+           fixedPointByteSize(upscaleIntermediateFP(params));
+}
+
+bool ldppUpscaleRows(const LdeKernel* kernel, const LdppUpscaleArgs* params,
+                     const LdpPicturePlaneDesc* intermediatePlane, uint32_t srcRowStart,
+                     uint32_t srcRowCount)
+{
+    if (!upscaleValidate(kernel, params)) {
+        return false;
+    }
+
+    UpscaleSlicedJobContext context = {0};
+    if (!upscaleContextInitialize(&context, params, kernel)) {
+        return false;
+    }
+
+    if (params->mode == Scale2D) {
+        assert(intermediatePlane);
+        context.intermediatePlane = *intermediatePlane;
+    }
+
+    const uint32_t srcHeight = params->srcLayout->height >>
+                               params->srcLayout->layoutInfo->planeHeightShift[params->planeIndex];
+    if (srcRowStart >= srcHeight) {
+        return true;
+    }
+
+    return upscaleSlicedJob(&context, srcRowStart, minU32(srcRowCount, srcHeight - srcRowStart));
+}
+
 /*------------------------------------------------------------------------------*/
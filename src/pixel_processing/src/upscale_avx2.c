@@ -0,0 +1,1323 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#include "upscale_avx2.h"
+
+#include "upscale_common.h"
+
+#include <LCEVC/build_config.h>
+#include <LCEVC/common/platform.h>
+//
+#include <stddef.h>
+
+#if VN_CORE_FEATURE(AVX2)
+#include "fp_types.h"
+#include "upscale_scalar.h"
+
+#include <LCEVC/common/avx2.h>
+#include <LCEVC/common/limit.h>
+#include <LCEVC/pixel_processing/dither.h>
+//
+#include <assert.h>
+
+/*------------------------------------------------------------------------------*/
+
+/* The AVX2 upscalers follow the SSE implementation, with each 128-bit lane performing the work
+ * of one SSE step. Horizontally the low lane upscales 8 pixels and the high lane the following
+ * 8 pixels, as every shuffle and shift used by the convolution stays within its lane. Vertically
+ * the 16 columns of the SSE implementation are held in half as many registers. The arithmetic is
+ * identical, so the results are bit-exact with both the SSE and scalar implementations. */
+
+enum UpscaleConstantsAVX2
+{
+    UCHoriStepping = 16,
+    UCHoriLoadAlignment = 16,     /* Horizontal requires 16-values loaded. */
+    UCHoriLoadAlignmentNV12 = 32, /* Horizontal NV12 requires 32-values loaded. */
+    UCMaxKernelSize = 6,
+    UCInterleavedStore = UCMaxKernelSize >> 1, /* PELs and Kernel are pair-wise interleaved. */
+    UCVertGroupSize = 2,                       /* 16 columns of 2 rows interleaved as S16 */
+    UCInverseShift = 14,
+    UCInverseShiftRounding = (1 << (UCInverseShift - 1))
+};
+
+VnAlign(static const uint8_t kDeinterleaveControl[32], 32) = {
+    0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x01, 0x03, 0x05, 0x07, 0x09, 0x0B, 0x0D, 0x0F,
+    0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x01, 0x03, 0x05, 0x07, 0x09, 0x0B, 0x0D, 0x0F};
+
+/* Shuffle an average per base pixel to the 2 upscaled pixels it covers. */
+VnAlign(static const uint8_t kAverageControl[2][32], 32) = {
+    {0x00, 0x01, 0x00, 0x01, 0x02, 0x03, 0x02, 0x03, 0x04, 0x05, 0x04, 0x05, 0x06, 0x07, 0x06, 0x07,
+     0x00, 0x01, 0x00, 0x01, 0x02, 0x03, 0x02, 0x03, 0x04, 0x05, 0x04, 0x05, 0x06, 0x07, 0x06, 0x07},
+    {0x08, 0x09, 0x08, 0x09, 0x0a, 0x0b, 0x0a, 0x0b, 0x0c, 0x0d, 0x0c, 0x0d, 0x0e, 0x0f, 0x0e, 0x0f,
+     0x08, 0x09, 0x08, 0x09, 0x0a, 0x0b, 0x0a, 0x0b, 0x0c, 0x0d, 0x0c, 0x0d, 0x0e, 0x0f, 0x0e, 0x0f}};
+
+/*------------------------------------------------------------------------------*/
+
+/*!
+ * Load up forward and reverse kernels as interleaved pairs respectively. i.e. For a 4-tap kernel:
+ *
+ *     kernelFwd[0] = {k0, k1, k0, k1, ...};
+ *     kernelFwd[1] = {k2, k3, k2, k3, ...};
+ *     kernelRev[0] = {k3, k2, k3, k2, ...};
+ *     kernelRev[1] = {k1, k0, k1, k0, ...};
+ *
+ * \param kernel     The kernel to load.
+ * \param kernelFwd  The forward kernel.
+ * \param kernelRev  The reverse kernel.
+ */
+static inline void loadKernelAVX2(const LdeKernel* kernel, __m256i kernelFwd[UCInterleavedStore],
+                                  __m256i kernelRev[UCInterleavedStore])
+{
+    const int16_t* kernelCoeffs = kernel->coeffs[0];
+    const int32_t kernelLength = (int32_t)kernel->length;
+
+    /* This implementation assumes kernel is even in length. This is because the
+     * implementation revolves around using _mm256_madd_epi16 for the convolution as
+     * 32-bits of storage are required for the calculation. */
+    assert(kernelLength % 2 == 0);
+    assert(kernelLength <= UCMaxKernelSize);
+
+    for (int32_t x = 0; x < (kernelLength >> 1); ++x) {
+        const int32_t fwdIdx = x * 2;
+        const int32_t revIdx = kernelLength - fwdIdx - 1;
+
+        kernelFwd[x] = set1PairS16AVX2(kernelCoeffs[fwdIdx], kernelCoeffs[fwdIdx + 1]);
+        kernelRev[x] = set1PairS16AVX2(kernelCoeffs[revIdx], kernelCoeffs[revIdx - 1]);
+    }
+}
+
+/*!
+ * Promote 16 unsigned values (zero-extended to 16-bit) to the signed fixed-point type of
+ * the same bit-depth, i.e. (value << shift) - 0x4000.
+ *
+ * \param pels    The unsigned values to promote.
+ * \param shift   The promotion shift, 7 for U8 down to 1 for U14.
+ *
+ * \return The promoted values.
+ */
+static inline __m256i promoteUNToS16AVX2(__m256i pels, __m128i shift)
+{
+    return _mm256_sub_epi16(_mm256_sll_epi16(pels, shift), _mm256_set1_epi16(0x4000));
+}
+
+/*!
+ * Load 16 consecutive values as 16-bit, zero-extending 8-bit values.
+ *
+ * \param src      The location to load from.
+ * \param pelSize  The byte size of each element, 1 or 2.
+ *
+ * \return The loaded values, the first 8 in the low lane.
+ */
+static inline __m256i loadPelsAsN16AVX2(const uint8_t* src, uint32_t pelSize)
+{
+    return (pelSize == 1) ? _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)src))
+                          : _mm256_loadu_si256((const __m256i*)src);
+}
+
+/*!
+ * Sum the pairs of adjacent 16-bit values, as 32-bit.
+ *
+ * \param values   The values to sum.
+ *
+ * \return values[0] + values[1], values[2] + values[3], ...
+ */
+static inline __m256i pairSumS16AVX2(__m256i values)
+{
+    return _mm256_add_epi32(_mm256_srai_epi32(_mm256_slli_epi32(values, 16), 16),
+                            _mm256_srai_epi32(values, 16));
+}
+
+/*!
+ * Store 32 upscaled S16 or U16 values, where the low lanes of `values` hold the first 16 and
+ * the high lanes the following 16.
+ *
+ * \param out      The location to write to.
+ * \param values   The values to write.
+ */
+static inline void storeN16AVX2(void* out, const __m256i values[2])
+{
+    int16_t* out16 = (int16_t*)out;
+
+    _mm256_storeu_si256((__m256i*)out16, _mm256_permute2x128_si256(values[0], values[1], 0x20));
+    _mm256_storeu_si256((__m256i*)(out16 + 16),
+                        _mm256_permute2x128_si256(values[0], values[1], 0x31));
+}
+
+/*------------------------------------------------------------------------------*/
+
+/*!
+ * Load a single channel of pixels for 2 steps of horizontal convolution, such that the low
+ * lanes hold the pixels for the first step, and the high lanes the pixels for the second.
+ *
+ * \param in       The input row to load from.
+ * \param offset   The offset in "elements" to load from.
+ * \param pelSize  The byte size of each element, 1 or 2.
+ * \param pels     The pels to load into, pixels [0, 16) and [8, 24).
+ */
+static inline void horizontalGetPelsAVX2(const uint8_t* in, int32_t offset, uint32_t pelSize,
+                                         __m256i pels[2])
+{
+    pels[0] = loadPelsAsN16AVX2(&in[offset * (int32_t)pelSize], pelSize);
+    pels[1] = loadPelsAsN16AVX2(&in[(offset + 8) * (int32_t)pelSize], pelSize);
+}
+
+/*!
+ * Load a single channel of unsigned pixels for 2 steps of horizontal convolution, and promote
+ * them to signed fixed-point.
+ *
+ * \param in       The input row to load from.
+ * \param offset   The offset in "elements" to load from.
+ * \param pelSize  The byte size of each element, 1 or 2.
+ * \param shift    The promotion shift.
+ * \param pels     The pels to load into.
+ */
+static inline void horizontalGetPelsUNAsS16AVX2(const uint8_t* in, int32_t offset, uint32_t pelSize,
+                                                __m128i shift, __m256i pels[2])
+{
+    horizontalGetPelsAVX2(in, offset, pelSize, pels);
+    pels[0] = promoteUNToS16AVX2(pels[0], shift);
+    pels[1] = promoteUNToS16AVX2(pels[1], shift);
+}
+
+/*!
+ * Load 32 interleaved pixels of 2 channels, deinterleave them and convert them to 16-bit.
+ *
+ * \param in       The input row to load from.
+ * \param offset   The offset in pixels to load from.
+ * \param pels     The 16 pixels of each channel.
+ */
+static inline void loadDeinterleavePelsU8AsI16AVX2(const uint8_t* in, int32_t offset,
+                                                   __m256i pels[2])
+{
+    const __m256i loaded = _mm256_loadu_si256((const __m256i*)&in[offset << 1]);
+    const __m256i shuffled = _mm256_shuffle_epi8(loaded, *(const __m256i*)kDeinterleaveControl);
+
+    /* Gather each channel into a single lane. */
+    const __m256i channels = _mm256_permute4x64_epi64(shuffled, 0xD8);
+
+    pels[0] = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(channels));
+    pels[1] = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(channels, 1));
+}
+
+/*!
+ * Load 2 interleaved channels of pixels for 2 steps of horizontal convolution.
+ *
+ * \param in       The input row to load from.
+ * \param offset   The offset in pixels to load from.
+ * \param pels     The pels to load into, indexed by [channel].
+ */
+static inline void horizontalGetPelsU8NV12AVX2(const uint8_t* in, int32_t offset,
+                                               __m256i pels[2][2])
+{
+    __m256i first[2];
+    __m256i second[2];
+
+    loadDeinterleavePelsU8AsI16AVX2(in, offset, first);
+    loadDeinterleavePelsU8AsI16AVX2(in, offset + 8, second);
+
+    pels[0][0] = first[0];
+    pels[0][1] = second[0];
+    pels[1][0] = first[1];
+    pels[1][1] = second[1];
+}
+
+/*!
+ * Performs horizontal convolution of input pels into result applying the forward
+ * and reverse kernels accordingly, whereby the first result pixel will have the
+ * reverse kernel applied, due to upscaling being off-pixel.
+ *
+ * This generates 32-pixels worth of output, the low lanes of result hold the 16 pixels
+ * upscaled from the low lane of pels, and the high lanes the following 16.
+ *
+ * \param pels           The pixels to upscale from.
+ * \param result         Place to store the resultant 32-pixels.
+ * \param kernelFwd      The forward kernel.
+ * \param kernelRev      The reverse kernel.
+ * \param kernelLength   The length of both kernelFwd and kernelRev.
+ */
+static inline void horizontalConvolveAVX2(const __m256i pels[2], __m256i result[2],
+                                          const __m256i kernelFwd[UCInterleavedStore],
+                                          const __m256i kernelRev[UCInterleavedStore],
+                                          uint32_t kernelLength)
+{
+    const uint32_t loopCount = kernelLength >> 1;
+
+    /* see saturateS15 for choice of min/max */
+    const __m256i minV = _mm256_set1_epi16(-16384);
+    const __m256i maxV = _mm256_set1_epi16(16383);
+
+    __m256i current = pels[0];
+    __m256i next = pels[1];
+    __m256i tap;
+    __m256i values[4] = {_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(),
+                         _mm256_setzero_si256()};
+
+    assert(kernelLength <= 8);
+
+    /* The convolution is off-pixel, therefore calculate initial reverse then
+     * load in next pixels and proceed. */
+    for (uint32_t i = 0; i < loopCount; i++) {
+        /* Reverse (even pixels) */
+        tap = _mm256_madd_epi16(kernelRev[i], current);
+        values[0] = _mm256_add_epi32(values[0], tap);
+
+        current = _mm256_alignr_epi8(next, current, 2);
+        next = _mm256_srli_si256(next, 2);
+
+        /* Forward (even pixels) */
+        tap = _mm256_madd_epi16(kernelFwd[i], current);
+        values[1] = _mm256_add_epi32(values[1], tap);
+
+        /* Reverse (odd pixels) */
+        tap = _mm256_madd_epi16(kernelRev[i], current);
+        values[2] = _mm256_add_epi32(values[2], tap);
+
+        current = _mm256_alignr_epi8(next, current, 2);
+        next = _mm256_srli_si256(next, 2);
+
+        /* Forward (odd pixels) */
+        tap = _mm256_madd_epi16(kernelFwd[i], current);
+        values[3] = _mm256_add_epi32(values[3], tap);
+    }
+
+    /* Shift back to 16 bits */
+    tap = _mm256_set1_epi32(UCInverseShiftRounding);
+    for (uint32_t i = 0; i < 4; i++) {
+        values[i] = _mm256_srai_epi32(_mm256_add_epi32(values[i], tap), UCInverseShift);
+    }
+
+    /* Combine fwd and rev  */
+    values[0] = _mm256_packs_epi32(values[0], values[2]); /* Reverse 0 2 4 6 1 3 5 7 */
+    values[1] = _mm256_packs_epi32(values[1], values[3]); /* Forward 0 2 4 6 1 3 5 7 */
+
+    /* Interleave */
+    values[2] = _mm256_unpacklo_epi16(values[0], values[1]); /* 0 0 2 2 4 4 6 6 */
+    values[3] = _mm256_unpackhi_epi16(values[0], values[1]); /* 1 1 3 3 5 5 7 7 */
+
+    result[0] = _mm256_unpacklo_epi32(values[2], values[3]); /* 0 0 1 1 2 2 3 3 */
+    result[1] = _mm256_unpackhi_epi32(values[2], values[3]); /* 4 4 5 5 6 6 7 7 */
+
+    /* Saturate to + / -2 ^ 14, this never clamps U8 input. */
+    result[0] = _mm256_max_epi16(_mm256_min_epi16(result[0], maxV), minV);
+    result[1] = _mm256_max_epi16(_mm256_min_epi16(result[1], maxV), minV);
+}
+
+/*!
+ * Apply 1D predicted-average to values using base for a single row.
+ *
+ * \param base     The base pixels for the PA calculation.
+ * \param values   The upscaled pixels to apply PA to.
+ */
+static inline void applyPA1DAVX2(__m256i base, __m256i values[2])
+{
+    /* avg = base - ((pel_even + pel_odd + 1) >> 1) */
+    const __m256i sum =
+        _mm256_add_epi16(_mm256_hadd_epi16(values[0], values[1]), _mm256_set1_epi16(1));
+    const __m256i avg = _mm256_sub_epi16(base, _mm256_srai_epi16(sum, 1));
+    const __m256i avg0 = _mm256_shuffle_epi8(avg, *(const __m256i*)kAverageControl[0]);
+    const __m256i avg1 = _mm256_shuffle_epi8(avg, *(const __m256i*)kAverageControl[1]);
+
+    values[0] = _mm256_add_epi16(values[0], avg0);
+    values[1] = _mm256_add_epi16(values[1], avg1);
+}
+
+/*!
+ * Apply 1D predicted-average to values using base for a single row, promoting the average
+ * to 32-bit.
+ *
+ * \param base     The base pixels for the PA calculation.
+ * \param values   The upscaled pixels to apply PA to.
+ */
+static inline void applyPA1DPrecisionAVX2(__m256i base, __m256i values[2])
+{
+    __m256i tmp[2];
+
+    /* Calculate horizontal average. */
+    tmp[0] = pairSumS16AVX2(values[0]);
+    tmp[1] = pairSumS16AVX2(values[1]);
+
+    tmp[0] = _mm256_srai_epi32(_mm256_add_epi32(tmp[0], _mm256_set1_epi32(1)), 1);
+    tmp[1] = _mm256_srai_epi32(_mm256_add_epi32(tmp[1], _mm256_set1_epi32(1)), 1);
+
+    /* Pack back down and calculate avg. */
+    tmp[0] = _mm256_packs_epi32(tmp[0], tmp[1]);
+    tmp[0] = _mm256_sub_epi16(base, tmp[0]);
+
+    const __m256i avg0 = _mm256_shuffle_epi8(tmp[0], *(const __m256i*)kAverageControl[0]);
+    const __m256i avg1 = _mm256_shuffle_epi8(tmp[0], *(const __m256i*)kAverageControl[1]);
+
+    values[0] = _mm256_adds_epi16(values[0], avg0);
+    values[1] = _mm256_adds_epi16(values[1], avg1);
+}
+
+/*!
+ * Apply 2D predicted-average to values using base, this requires 2 upscaled rows.
+ *
+ * \param base     The base pixels for the PA calculation.
+ * \param values   The upscaled pixels to apply PA to for 2 rows.
+ */
+static inline void applyPA2DSpeedAVX2(__m256i base, __m256i values[2][2])
+{
+    /* avg = base - ((row0_pel_even + row0_pel_odd + row1_pel_even + row1_pel_odd + 2) >> 2) */
+    const __m256i sum =
+        _mm256_add_epi16(_mm256_add_epi16(_mm256_hadd_epi16(values[0][0], values[0][1]),
+                                          _mm256_hadd_epi16(values[1][0], values[1][1])),
+                         _mm256_set1_epi16(2));
+    const __m256i avg = _mm256_sub_epi16(base, _mm256_srai_epi16(sum, 2));
+    const __m256i avg0 = _mm256_shuffle_epi8(avg, *(const __m256i*)kAverageControl[0]);
+    const __m256i avg1 = _mm256_shuffle_epi8(avg, *(const __m256i*)kAverageControl[1]);
+
+    values[0][0] = _mm256_add_epi16(values[0][0], avg0);
+    values[0][1] = _mm256_add_epi16(values[0][1], avg1);
+    values[1][0] = _mm256_add_epi16(values[1][0], avg0);
+    values[1][1] = _mm256_add_epi16(values[1][1], avg1);
+}
+
+/*!
+ * Apply 2D predicted-average to values using base, this requires 2 upscaled rows.
+ *
+ * As with the SSE implementation, the average is promoted to 32-bit as for S16 & U14
+ * it can trivially overflow.
+ *
+ * \param base     The base pixels for the PA calculation.
+ * \param values   The upscaled pixels to apply PA to for 2 rows.
+ */
+static inline void applyPA2DPrecisionAVX2(__m256i base, __m256i values[2][2])
+{
+    __m256i tmp[2];
+
+    tmp[0] = _mm256_add_epi32(pairSumS16AVX2(values[0][0]), pairSumS16AVX2(values[1][0]));
+    tmp[1] = _mm256_add_epi32(pairSumS16AVX2(values[0][1]), pairSumS16AVX2(values[1][1]));
+
+    tmp[0] = _mm256_srai_epi32(_mm256_add_epi32(tmp[0], _mm256_set1_epi32(2)), 2);
+    tmp[1] = _mm256_srai_epi32(_mm256_add_epi32(tmp[1], _mm256_set1_epi32(2)), 2);
+
+    /* The average result will never overflow 16-bit, so it is safe to pack back
+     * from 32-bit now and perform the rest of the operations in 16-bit. */
+    tmp[0] = _mm256_packs_epi32(tmp[0], tmp[1]);
+    tmp[0] = _mm256_sub_epi16(base, tmp[0]);
+
+    const __m256i avg0 = _mm256_shuffle_epi8(tmp[0], *(const __m256i*)kAverageControl[0]);
+    const __m256i avg1 = _mm256_shuffle_epi8(tmp[0], *(const __m256i*)kAverageControl[1]);
+
+    values[0][0] = _mm256_adds_epi16(values[0][0], avg0);
+    values[0][1] = _mm256_adds_epi16(values[0][1], avg1);
+    values[1][0] = _mm256_adds_epi16(values[1][0], avg0);
+    values[1][1] = _mm256_adds_epi16(values[1][1], avg1);
+}
+
+/*! \brief U8 Planar horizontal upscaling of 2 rows. */
+static void horizontalU8PlanarAVX2(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                   const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                   uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP)
+{
+    const uint32_t kernelLength = kernel->length;
+    __m256i pels[2];
+    __m256i values[2][2];
+    __m256i kernelFwd[UCInterleavedStore];
+    __m256i kernelRev[UCInterleavedStore];
+    const bool paEnabled = (base[0] != NULL);
+    const bool paEnabled1D = paEnabled && (base[1] != NULL);
+    const uint16_t* ditherBuffer = NULL;
+
+    UpscaleHorizontalCoords coords = {0};
+
+    loadKernelAVX2(kernel, kernelFwd, kernelRev);
+
+    /* Determine edge-cases that should be run in non-SIMD codepath. */
+    upscaleHorizontalGetCoords(width, xStart, xEnd, kernelLength, UCHoriLoadAlignment, &coords);
+
+    /* Run left edge non-SIMD loop */
+    if (upscaleHorizontalCoordsIsLeftValid(&coords)) {
+        horizontalU8Planar(dither, in, out, base, width, coords.leftStart, coords.leftEnd, kernel, dstFP);
+    }
+
+    int32_t loadOffset = (int32_t)(coords.start - (kernelLength >> 1));
+    int32_t storeOffset = (int32_t)(coords.start << 1);
+
+    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    if (dither != NULL) {
+        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 32));
+    }
+
+    /* Run middle SIMD loop */
+    for (uint32_t x = coords.start; x < coords.end; x += UCHoriStepping) {
+        horizontalGetPelsAVX2(in[0], loadOffset, 1, pels);
+        horizontalConvolveAVX2(pels, values[0], kernelFwd, kernelRev, kernelLength);
+
+        horizontalGetPelsAVX2(in[1], loadOffset, 1, pels);
+        horizontalConvolveAVX2(pels, values[1], kernelFwd, kernelRev, kernelLength);
+
+        if (paEnabled1D) {
+            applyPA1DAVX2(loadPelsAsN16AVX2(&base[0][x], 1), values[0]);
+            applyPA1DAVX2(loadPelsAsN16AVX2(&base[1][x], 1), values[1]);
+        } else if (paEnabled) {
+            applyPA2DSpeedAVX2(loadPelsAsN16AVX2(&base[0][x], 1), values);
+        }
+
+        if (ditherBuffer) {
+            ldppDitherApplyAVX2(values[0], &ditherBuffer, 0, dither->strength);
+            ldppDitherApplyAVX2(values[1], &ditherBuffer, 0, dither->strength);
+        }
+
+        /* Unsigned saturated pack back to 32 uint8_t, each lane packs 16 consecutive pixels. */
+        _mm256_storeu_si256((__m256i*)&out[0][storeOffset],
+                            _mm256_packus_epi16(values[0][0], values[0][1]));
+        _mm256_storeu_si256((__m256i*)&out[1][storeOffset],
+                            _mm256_packus_epi16(values[1][0], values[1][1]));
+
+        loadOffset += UCHoriStepping;
+        storeOffset += (UCHoriStepping << 1);
+    }
+
+    /* Run right edge non-SIMD loop */
+    if (upscaleHorizontalCoordsIsRightValid(&coords)) {
+        horizontalU8Planar(dither, in, out, base, width, coords.rightStart, coords.rightEnd, kernel, dstFP);
+    }
+}
+
+/*!
+ * S16 Planar horizontal upscaling of 2 rows.
+ *
+ * As with the SSE implementation, the input and PA base can be unsigned N-bit values that are
+ * promoted to S16 as they are loaded, and the output can be demoted to unsigned N-bit as it is
+ * stored.
+ *
+ * \param inUnsigned     True if `in` is unsigned N-bit rather than S16.
+ * \param baseUnsigned   True if `base` is unsigned N-bit rather than S16.
+ * \param outUnsigned    True if `out` is unsigned N-bit rather than S16.
+ * \param pelSize        The byte size of the unsigned values.
+ * \param promoteShift   The promotion shift for the unsigned values.
+ * \param edgeFunction   The non-SIMD function matching this configuration for edges.
+ */
+static inline void horizontalS16PlanarImplAVX2(LdppDitherSlice* dither, const uint8_t* in[2],
+                                               uint8_t* out[2], const uint8_t* base[2],
+                                               uint32_t width, uint32_t xStart, uint32_t xEnd,
+                                               const LdeKernel* kernel, const LdpFixedPoint dstFP,
+                                               bool inUnsigned, bool baseUnsigned, bool outUnsigned,
+                                               uint32_t pelSize, int32_t promoteShift,
+                                               UpscaleHorizontalFunction edgeFunction)
+{
+    const uint32_t kernelLength = kernel->length;
+    __m256i pels[2];
+    __m256i values[2][2];
+    __m256i basePels[2];
+    __m256i kernelFwd[UCInterleavedStore];
+    __m256i kernelRev[UCInterleavedStore];
+    const bool paEnabled = (base[0] != NULL);
+    const bool paEnabled1D = paEnabled && (base[1] != NULL);
+    const uint16_t* ditherBuffer = NULL;
+    int8_t shift = 0;
+    const __m128i shiftV = _mm_cvtsi32_si128(promoteShift);
+    const __m256i demoteRoundingV = _mm256_set1_epi16((int16_t)((1 << promoteShift) >> 1));
+    const __m256i demoteSignOffsetV = _mm256_set1_epi16((int16_t)(0x4000 >> promoteShift));
+    const __m256i demoteMaxV = _mm256_set1_epi16((int16_t)((0x8000 >> promoteShift) - 1));
+    UpscaleHorizontalCoords coords = {0};
+
+    loadKernelAVX2(kernel, kernelFwd, kernelRev);
+
+    /* Determine edge-cases that should be run in non-SIMD codepath. */
+    upscaleHorizontalGetCoords(width, xStart, xEnd, kernelLength, UCHoriLoadAlignment, &coords);
+
+    /* Run left edge non-SIMD loop */
+    if (upscaleHorizontalCoordsIsLeftValid(&coords)) {
+        edgeFunction(dither, in, out, base, width, coords.leftStart, coords.leftEnd, kernel, dstFP);
+    }
+
+    int32_t loadOffset = (int32_t)(coords.start - (kernelLength >> 1));
+    int32_t storeOffset = (int32_t)(coords.start << 1);
+
+    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    if (dither != NULL) {
+        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 32));
+        shift = ldppDitherGetShiftS16(outUnsigned ? fixedPointHighPrecision(dstFP) : dstFP);
+    }
+
+    /* Run middle SIMD loop */
+    for (uint32_t x = coords.start; x < coords.end; x += UCHoriStepping) {
+        for (uint32_t row = 0; row < 2; ++row) {
+            if (inUnsigned) {
+                horizontalGetPelsUNAsS16AVX2(in[row], loadOffset, pelSize, shiftV, pels);
+            } else {
+                horizontalGetPelsAVX2(in[row], loadOffset, sizeof(int16_t), pels);
+            }
+
+            horizontalConvolveAVX2(pels, values[row], kernelFwd, kernelRev, kernelLength);
+        }
+
+        if (paEnabled) {
+            for (uint32_t row = 0; row < (paEnabled1D ? 2 : 1); ++row) {
+                basePels[row] = baseUnsigned
+                                    ? loadPelsAsN16AVX2(&base[row][x * pelSize], pelSize)
+                                    : loadPelsAsN16AVX2(&base[row][x * sizeof(int16_t)],
+                                                        sizeof(int16_t));
+                if (baseUnsigned) {
+                    basePels[row] = promoteUNToS16AVX2(basePels[row], shiftV);
+                }
+            }
+
+            if (paEnabled1D) {
+                applyPA1DPrecisionAVX2(basePels[0], values[0]);
+                applyPA1DPrecisionAVX2(basePels[1], values[1]);
+            } else {
+                applyPA2DPrecisionAVX2(basePels[0], values);
+            }
+        }
+
+        if (ditherBuffer) {
+            ldppDitherApplyAVX2(values[0], &ditherBuffer, shift, dither->strength);
+            ldppDitherApplyAVX2(values[1], &ditherBuffer, shift, dither->strength);
+        }
+
+        for (uint32_t row = 0; row < 2; ++row) {
+            if (!outUnsigned) {
+                /* Write out (note that dither and PA used saturating add, so we're safely within S16). */
+                storeN16AVX2(&out[row][storeOffset * sizeof(int16_t)], values[row]);
+                continue;
+            }
+
+            /* Demote to unsigned - a saturated rounding add only affects values that clamp to
+             * the maximum anyway. */
+            for (uint32_t half = 0; half < 2; ++half) {
+                __m256i value = _mm256_adds_epi16(values[row][half], demoteRoundingV);
+                value = _mm256_add_epi16(_mm256_sra_epi16(value, shiftV), demoteSignOffsetV);
+                values[row][half] =
+                    _mm256_min_epi16(_mm256_max_epi16(value, _mm256_setzero_si256()), demoteMaxV);
+            }
+
+            if (pelSize == 1) {
+                _mm256_storeu_si256((__m256i*)&out[row][storeOffset],
+                                    _mm256_packus_epi16(values[row][0], values[row][1]));
+            } else {
+                storeN16AVX2(&out[row][storeOffset * sizeof(uint16_t)], values[row]);
+            }
+        }
+
+        loadOffset += UCHoriStepping;
+        storeOffset += (UCHoriStepping << 1);
+    }
+
+    /* Run right edge non-SIMD loop */
+    if (upscaleHorizontalCoordsIsRightValid(&coords)) {
+        edgeFunction(dither, in, out, base, width, coords.rightStart, coords.rightEnd, kernel, dstFP);
+    }
+}
+
+/*! \brief S16 Planar horizontal upscaling of 2 rows. */
+static void horizontalS16PlanarAVX2(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                    const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                    uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP)
+{
+    horizontalS16PlanarImplAVX2(dither, in, out, base, width, xStart, xEnd, kernel, dstFP, false,
+                                false, false, sizeof(int16_t), 0, horizontalS16Planar);
+}
+
+/* Planar horizontal upscaling of 2 unsigned rows promoted to S16, with an unsigned base. */
+#define VN_GEN_HORI_SIGNED_PROMOTION_FUNCS_AVX2(uFP, sFP, pelSize, shift)                                \
+    static void horizontal##uFP##To##sFP##PlanarAVX2(                                                     \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],           \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) \
+    {                                                                                                     \
+        horizontalS16PlanarImplAVX2(dither, in, out, base, width, xStart, xEnd, kernel, dstFP, true,      \
+                                    true, false, pelSize, shift, horizontal##uFP##To##sFP##Planar);       \
+    }                                                                                                     \
+    static void horizontal##sFP##Base##uFP##PlanarAVX2(                                                   \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],           \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) \
+    {                                                                                                     \
+        horizontalS16PlanarImplAVX2(dither, in, out, base, width, xStart, xEnd, kernel, dstFP, false,     \
+                                    true, false, pelSize, shift, horizontal##sFP##Base##uFP##Planar);     \
+    }
+
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS_AVX2(U8, S8, 1, 7)
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS_AVX2(U10, S10, 2, 5)
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS_AVX2(U12, S12, 2, 3)
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS_AVX2(U14, S14, 2, 1)
+
+/* Planar horizontal upscaling of 2 S16 rows demoted to unsigned, with a signed or unsigned base. */
+#define VN_GEN_HORI_SIGNED_DEMOTION_FUNCS_AVX2(uFP, sFP, pelSize, shift)                                 \
+    static void horizontal##sFP##To##uFP##PlanarAVX2(                                                     \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],           \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) \
+    {                                                                                                     \
+        horizontalS16PlanarImplAVX2(dither, in, out, base, width, xStart, xEnd, kernel, dstFP, false,     \
+                                    false, true, pelSize, shift, horizontal##sFP##To##uFP##Planar);       \
+    }                                                                                                     \
+    static void horizontal##sFP##Base##uFP##To##uFP##PlanarAVX2(                                          \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],           \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) \
+    {                                                                                                     \
+        horizontalS16PlanarImplAVX2(dither, in, out, base, width, xStart, xEnd, kernel, dstFP, false,     \
+                                    true, true, pelSize, shift,                                           \
+                                    horizontal##sFP##Base##uFP##To##uFP##Planar);                         \
+    }
+
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS_AVX2(U8, S8, 1, 7)
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS_AVX2(U10, S10, 2, 5)
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS_AVX2(U12, S12, 2, 3)
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS_AVX2(U14, S14, 2, 1)
+
+/*! \brief U16 Planar horizontal upscaling of 2 rows. */
+static inline void horizontalU16PlanarAVX2(LdppDitherSlice* dither, const uint8_t* in[2],
+                                           uint8_t* out[2], const uint8_t* base[2], uint32_t width,
+                                           uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel,
+                                           int16_t maxValue, bool is14Bit)
+{
+    const uint32_t kernelLength = kernel->length;
+    __m256i pels[2];
+    __m256i values[2][2];
+    __m256i kernelFwd[UCInterleavedStore];
+    __m256i kernelRev[UCInterleavedStore];
+    const __m256i minV = _mm256_setzero_si256();
+    const __m256i maxV = _mm256_set1_epi16(maxValue);
+    const bool paEnabled = (base[0] != NULL);
+    const bool paEnabled1D = paEnabled && (base[1] != NULL);
+    const uint16_t* ditherBuffer = NULL;
+
+    UpscaleHorizontalCoords coords = {0};
+
+    loadKernelAVX2(kernel, kernelFwd, kernelRev);
+
+    /* Determine edge-cases that should be run in non-SIMD codepath. */
+    upscaleHorizontalGetCoords(width, xStart, xEnd, kernelLength, UCHoriLoadAlignment, &coords);
+
+    /* Run left edge non-SIMD loop */
+    if (upscaleHorizontalCoordsIsLeftValid(&coords)) {
+        horizontalUNPlanar(dither, in, out, base, width, coords.leftStart, coords.leftEnd, kernel, maxValue);
+    }
+
+    int32_t loadOffset = (int32_t)(coords.start - (kernelLength >> 1));
+    int32_t storeOffset = (int32_t)(coords.start << 1);
+
+    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    if (dither != NULL) {
+        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 32));
+    }
+
+    /* Run middle SIMD loop */
+    for (uint32_t x = coords.start; x < coords.end; x += UCHoriStepping) {
+        horizontalGetPelsAVX2(in[0], loadOffset, sizeof(uint16_t), pels);
+        horizontalConvolveAVX2(pels, values[0], kernelFwd, kernelRev, kernelLength);
+
+        horizontalGetPelsAVX2(in[1], loadOffset, sizeof(uint16_t), pels);
+        horizontalConvolveAVX2(pels, values[1], kernelFwd, kernelRev, kernelLength);
+
+        if (paEnabled1D) {
+            applyPA1DAVX2(loadPelsAsN16AVX2(&base[0][x * sizeof(uint16_t)], sizeof(uint16_t)),
+                          values[0]);
+            applyPA1DAVX2(loadPelsAsN16AVX2(&base[1][x * sizeof(uint16_t)], sizeof(uint16_t)),
+                          values[1]);
+        } else if (paEnabled) {
+            const __m256i basePels =
+                loadPelsAsN16AVX2(&base[0][x * sizeof(uint16_t)], sizeof(uint16_t));
+
+            if (is14Bit) {
+                applyPA2DPrecisionAVX2(basePels, values);
+            } else {
+                applyPA2DSpeedAVX2(basePels, values);
+            }
+        }
+
+        if (ditherBuffer) {
+            ldppDitherApplyAVX2(values[0], &ditherBuffer, 0, dither->strength);
+            ldppDitherApplyAVX2(values[1], &ditherBuffer, 0, dither->strength);
+        }
+
+        /* Saturate to unsigned N-bit and write out. */
+        for (uint32_t row = 0; row < 2; ++row) {
+            values[row][0] = _mm256_min_epu16(_mm256_max_epi16(values[row][0], minV), maxV);
+            values[row][1] = _mm256_min_epu16(_mm256_max_epi16(values[row][1], minV), maxV);
+            storeN16AVX2(&out[row][storeOffset * sizeof(uint16_t)], values[row]);
+        }
+
+        loadOffset += UCHoriStepping;
+        storeOffset += (UCHoriStepping << 1);
+    }
+
+    /* Run right edge non-SIMD loop */
+    if (upscaleHorizontalCoordsIsRightValid(&coords)) {
+        horizontalUNPlanar(dither, in, out, base, width, coords.rightStart, coords.rightEnd, kernel,
+                           maxValue);
+    }
+}
+
+/* Generate unsigned 2-byte wide planar upscale functions */
+#define VN_HORI_MAX_VALUE_U10() , 1023, false
+#define VN_HORI_MAX_VALUE_U12() , 4095, false
+#define VN_HORI_MAX_VALUE_U14() , 16383, true
+
+#define horizontalU16PlanarAVX2(fp)                                                                 \
+    static void horizontal##fp##PlanarAVX2(LdppDitherSlice* dither, const uint8_t* in[2],           \
+                                           uint8_t* out[2], const uint8_t* base[2], uint32_t width, \
+                                           uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, \
+                                           const LdpFixedPoint dstFP)                               \
+    {                                                                                               \
+        horizontalU16PlanarAVX2(dither, in, out, base, width, xStart, xEnd,                         \
+                                kernel VN_HORI_MAX_VALUE_##fp());                                   \
+    }
+
+horizontalU16PlanarAVX2(U10);
+horizontalU16PlanarAVX2(U12);
+horizontalU16PlanarAVX2(U14);
+
+/*! \brief NV12 horizontal upscaling of 2 rows. */
+static void horizontalU8NV12AVX2(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                 const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                 uint32_t xEnd, const LdeKernel* kernel, LdpFixedPoint dstFP)
+{
+    const uint32_t kernelLength = kernel->length;
+    __m256i pels[2][2][2]; /* Indexed by [row][channel] */
+    __m256i result[2][2];
+    __m256i values[2][2];
+    __m256i basePels[2][2];
+    __m256i kernelFwd[UCInterleavedStore];
+    __m256i kernelRev[UCInterleavedStore];
+    const bool paEnabled = (base[0] != NULL);
+    const bool paEnabled1D = paEnabled && (base[1] != NULL);
+    const uint16_t* ditherBuffer = NULL;
+
+    UpscaleHorizontalCoords coords = {0};
+
+    loadKernelAVX2(kernel, kernelFwd, kernelRev);
+
+    /* Determine edge-cases that should be run in non-SIMD codepath. */
+    upscaleHorizontalGetCoords(width, xStart, xEnd, kernelLength, UCHoriLoadAlignmentNV12, &coords);
+
+    /* Run left edge non-SIMD loop */
+    if (upscaleHorizontalCoordsIsLeftValid(&coords)) {
+        horizontalU8NV12(dither, in, out, base, width, coords.leftStart, coords.leftEnd, kernel, dstFP);
+    }
+
+    int32_t loadOffset = (int32_t)(coords.start - (kernelLength >> 1));
+    int32_t storeOffset = (int32_t)(coords.start << 2);
+
+    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    if (dither != NULL) {
+        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(8 * (xEnd - xStart), 32));
+    }
+
+    /* Run middle SIMD loop */
+    for (uint32_t x = coords.start; x < coords.end; x += UCHoriStepping) {
+        horizontalGetPelsU8NV12AVX2(in[0], loadOffset, pels[0]);
+        horizontalGetPelsU8NV12AVX2(in[1], loadOffset, pels[1]);
+
+        if (paEnabled1D) {
+            loadDeinterleavePelsU8AsI16AVX2(base[0], (int32_t)x, basePels[0]);
+            loadDeinterleavePelsU8AsI16AVX2(base[1], (int32_t)x, basePels[1]);
+        } else if (paEnabled) {
+            loadDeinterleavePelsU8AsI16AVX2(base[0], (int32_t)x, basePels[0]);
+        }
+
+        for (uint32_t channelIdx = 0; channelIdx < 2; ++channelIdx) {
+            horizontalConvolveAVX2(pels[0][channelIdx], values[0], kernelFwd, kernelRev,
+                                   kernelLength);
+            horizontalConvolveAVX2(pels[1][channelIdx], values[1], kernelFwd, kernelRev,
+                                   kernelLength);
+
+            if (paEnabled1D) {
+                applyPA1DAVX2(basePels[0][channelIdx], values[0]);
+                applyPA1DAVX2(basePels[1][channelIdx], values[1]);
+            } else if (paEnabled) {
+                applyPA2DSpeedAVX2(basePels[0][channelIdx], values);
+            }
+
+            if (ditherBuffer) {
+                ldppDitherApplyAVX2(values[0], &ditherBuffer, 0, dither->strength);
+                ldppDitherApplyAVX2(values[1], &ditherBuffer, 0, dither->strength);
+            }
+
+            /* Unsigned saturated pack back to 32 consecutive uint8_t. */
+            result[0][channelIdx] = _mm256_packus_epi16(values[0][0], values[0][1]);
+            result[1][channelIdx] = _mm256_packus_epi16(values[1][0], values[1][1]);
+        }
+
+        /* Interleave results and write out, the interleave is within lanes so the low lanes
+         * of both hold the first 32 bytes. */
+        for (uint32_t row = 0; row < 2; ++row) {
+            const __m256i lo = _mm256_unpacklo_epi8(result[row][0], result[row][1]);
+            const __m256i hi = _mm256_unpackhi_epi8(result[row][0], result[row][1]);
+
+            _mm256_storeu_si256((__m256i*)&out[row][storeOffset],
+                                _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i*)&out[row][storeOffset + 32],
+                                _mm256_permute2x128_si256(lo, hi, 0x31));
+        }
+
+        loadOffset += UCHoriStepping;
+        storeOffset += (UCHoriStepping << 2);
+    }
+
+    /* Run right edge non-SIMD loop */
+    if (upscaleHorizontalCoordsIsRightValid(&coords)) {
+        horizontalU8NV12(dither, in, out, base, width, coords.rightStart, coords.rightEnd, kernel, dstFP);
+    }
+}
+
+/*------------------------------------------------------------------------------*/
+
+/*!
+ * Load a row of 16 values as 16-bit, optionally promoting them from unsigned to signed
+ * fixed-point.
+ *
+ * \param in       The input source surface to load from.
+ * \param stride   The stride of the input surface in elements.
+ * \param row      The row index to load.
+ * \param pelSize  The byte size of each element, 1 or 2.
+ * \param promote  True if the values should be promoted to signed fixed-point.
+ * \param shift    The promotion shift.
+ *
+ * \return The 16 values.
+ */
+static inline __m256i verticalLoadRowAVX2(const uint8_t* in, uint32_t stride, size_t row,
+                                          uint32_t pelSize, bool promote, __m128i shift)
+{
+    const __m256i loaded = loadPelsAsN16AVX2(&in[row * stride * pelSize], pelSize);
+
+    return promote ? promoteUNToS16AVX2(loaded, shift) : loaded;
+}
+
+/*!
+ * Loads kernel-length rows of initial upscale input data ensuring that edge extension
+ * is performed. This function interleaves loaded row pairs so that the madd intrinsic
+ * can be used for high precision upscaling.
+ *
+ * The interleaving follows the SSE implementation within each lane, so pels[i][0] holds
+ * columns 0-3 and 8-11 and pels[i][1] holds columns 4-7 and 12-15.
+ *
+ * \param  in       The input source surface to load from.
+ * \param  height   The height of the input surface being loaded.
+ * \param  stride   The stride of the input surface being loaded.
+ * \param  offset   The row offset to start loading from.
+ * \param  count    The number of rows to load in.
+ * \param  pelSize  The byte size of each input element.
+ * \param  promote  True if the input should be promoted to signed fixed-point.
+ * \param  shift    The promotion shift.
+ * \param  pels     The destination to load the pixels into.
+ */
+static inline void verticalGetPelsAVX2(const uint8_t* in, uint32_t height, uint32_t stride,
+                                       int32_t offset, int32_t count, uint32_t pelSize,
+                                       bool promote, __m128i shift,
+                                       __m256i pels[UCInterleavedStore][UCVertGroupSize])
+{
+    for (int32_t i = 0; i < (count >> 1); i++) {
+        const size_t row0 = (size_t)clampS32(offset + (i * 2), 0, (int32_t)height - 1);
+        const size_t row1 = (size_t)clampS32(offset + (i * 2) + 1, 0, (int32_t)height - 1);
+
+        const __m256i load0 = verticalLoadRowAVX2(in, stride, row0, pelSize, promote, shift);
+        const __m256i load1 = verticalLoadRowAVX2(in, stride, row1, pelSize, promote, shift);
+
+        pels[i][0] = _mm256_unpacklo_epi16(load0, load1);
+        pels[i][1] = _mm256_unpackhi_epi16(load0, load1);
+    }
+}
+
+/*!
+ * Loads the next row of upscale input data by shuffling the pels down 1, and loading
+ * next row into the last entry. This function ensures that edge extension is performed.
+ *
+ * \param  in       The input source surface to load from.
+ * \param  height   The height of the input surface being loaded.
+ * \param  stride   The stride of the input surface being loaded.
+ * \param  offset   The row to load from.
+ * \param  count    The number of rows loaded in.
+ * \param  pelSize  The byte size of each input element.
+ * \param  promote  True if the input should be promoted to signed fixed-point.
+ * \param  shift    The promotion shift.
+ * \param  pels     The destination to load the pixels into.
+ */
+static inline void verticalGetNextPelsAVX2(const uint8_t* in, uint32_t height, uint32_t stride,
+                                           int32_t offset, int32_t count, uint32_t pelSize,
+                                           bool promote, __m128i shift,
+                                           __m256i pels[UCInterleavedStore][UCVertGroupSize])
+{
+    const int32_t loopCount = (count >> 1) - 1;
+    const int32_t index = offset + count - 1;
+    const size_t row = (size_t)minS32(index, (int32_t)height - 1);
+
+    assert(index > 0);
+
+    /* Load up the next row */
+    const __m256i load = verticalLoadRowAVX2(in, stride, row, pelSize, promote, shift);
+
+    /* Shuffle rows out to make space for this new row. */
+    int32_t loopIndex = 0;
+    for (; loopIndex < loopCount; loopIndex++) {
+        for (int32_t j = 0; j < UCVertGroupSize; ++j) {
+            /* Shift curr up 2 bytes: [A0,B0,A1,B1] -> [B0,A1,B1,A2] */
+            const __m256i current = _mm256_srli_si256(pels[loopIndex][j], 2);
+
+            /* Shift next down 2 bytes: [C0,D0,C1,D1] -> [XX,C0,D0,C1] */
+            const __m256i next = _mm256_slli_si256(pels[loopIndex + 1][j], 2);
+
+            /* Combine shifted curr & next to form [B0,C0,B1,C1] */
+            pels[loopIndex][j] = _mm256_blend_epi16(current, next, 0xAA);
+        }
+    }
+
+    /* Shuffle last row up to odd lanes to make space for "load" in even lanes, and interleave
+     * the new row. */
+    pels[loopIndex][0] =
+        _mm256_blend_epi16(_mm256_srli_si256(pels[loopIndex][0], 2),
+                           _mm256_unpacklo_epi16(_mm256_setzero_si256(), load), 0xAA);
+    pels[loopIndex][1] =
+        _mm256_blend_epi16(_mm256_srli_si256(pels[loopIndex][1], 2),
+                           _mm256_unpackhi_epi16(_mm256_setzero_si256(), load), 0xAA);
+}
+
+/*!
+ * Performs vertical convolution of input pels applying the kernel, returning the
+ * 32-bit results scaled back down.
+ *
+ * \param  pels           The pixels to upscale from.
+ * \param  kernel         The kernel to upscale with
+ * \param  kernelLength   The length of kernel.
+ * \param  values         Place to store the 16 resultant values.
+ */
+static inline void verticalConvolveAVX2(const __m256i pels[UCInterleavedStore][UCVertGroupSize],
+                                        const __m256i kernel[UCInterleavedStore],
+                                        int32_t kernelLength, __m256i values[UCVertGroupSize])
+{
+    const int32_t loopCount = kernelLength >> 1;
+    const __m256i rounding = _mm256_set1_epi32(UCInverseShiftRounding);
+
+    values[0] = _mm256_setzero_si256();
+    values[1] = _mm256_setzero_si256();
+
+    for (int32_t i = 0; i < loopCount; i++) {
+        for (int32_t j = 0; j < UCVertGroupSize; j++) {
+            values[j] = _mm256_add_epi32(values[j], _mm256_madd_epi16(pels[i][j], kernel[i]));
+        }
+    }
+
+    for (int32_t j = 0; j < UCVertGroupSize; j++) {
+        values[j] = _mm256_srai_epi32(_mm256_add_epi32(values[j], rounding), UCInverseShift);
+    }
+}
+
+/*!
+ * Performs vertical convolution of input pels applying the kernel and returns the
+ * result as signed 16-bit saturated values.
+ *
+ * \param  pels           The pixels to upscale from.
+ * \param  kernel         The kernel to upscale with
+ * \param  kernelLength   The length of kernel.
+ *
+ * \return The resultant 16 pixels.
+ */
+static inline __m256i
+verticalConvolveS16AVX2(const __m256i pels[UCInterleavedStore][UCVertGroupSize],
+                        const __m256i kernel[UCInterleavedStore], int32_t kernelLength)
+{
+    /* see saturateS15 for choice of min/max */
+    const __m256i minV = _mm256_set1_epi32(-16384);
+    const __m256i maxV = _mm256_set1_epi32(16383);
+    __m256i values[UCVertGroupSize];
+
+    verticalConvolveAVX2(pels, kernel, kernelLength, values);
+
+    /* Clamp to +/-2^14 */
+    values[0] = _mm256_min_epi32(_mm256_max_epi32(values[0], minV), maxV);
+    values[1] = _mm256_min_epi32(_mm256_max_epi32(values[1], minV), maxV);
+
+    /* Pack back down to saturated int16_t, which restores column order within each lane. */
+    return _mm256_packs_epi32(values[0], values[1]);
+}
+
+/*!
+ * Vertical upscaling of 16 columns, from either 16-bit or unsigned N-bit input, to S16 or
+ * unsigned 16-bit.
+ *
+ * \param pelSize        The byte size of input elements.
+ * \param promote        True if unsigned input should be promoted to S16.
+ * \param promoteShift   The promotion shift for unsigned input.
+ * \param maxValue       The maximum value for unsigned 16-bit output, or 0 for S16 output.
+ */
+static inline void verticalN16ImplAVX2(const uint8_t* in, uint32_t inStride, uint8_t* out,
+                                       uint32_t outStride, uint32_t y, uint32_t rows,
+                                       uint32_t height, const LdeKernel* kernel, uint32_t pelSize,
+                                       bool promote, int32_t promoteShift, uint16_t maxValue)
+{
+    const __m128i shift = _mm_cvtsi32_si128(promoteShift);
+    const __m256i maxV = _mm256_set1_epi16((int16_t)maxValue);
+    __m256i kernelFwd[UCInterleavedStore];
+    __m256i kernelRev[UCInterleavedStore];
+    const int32_t kernelLength = (int32_t)kernel->length;
+    const uint32_t outSkip = 2 * outStride;
+    int16_t* out16 = (int16_t*)out;
+    int16_t* out0 = out16 + ((size_t)y * outSkip);
+    int16_t* out1 = out0 + outStride;
+    int32_t loadOffset = (int32_t)y - (kernelLength / 2);
+    __m256i pels[UCInterleavedStore][UCVertGroupSize];
+    __m256i values[UCVertGroupSize];
+
+    loadKernelAVX2(kernel, kernelFwd, kernelRev);
+
+    /* Prime interleaved rows. */
+    verticalGetPelsAVX2(in, height, inStride, loadOffset, kernelLength, pelSize, promote, shift,
+                        pels);
+    loadOffset += 1;
+
+    for (uint32_t rowIndex = 0; rowIndex < rows; ++rowIndex) {
+        for (uint32_t phase = 0; phase < 2; ++phase) {
+            int16_t* dst = phase ? out1 : out0;
+
+            if (phase) {
+                /* Next input due to being off-pixel */
+                verticalGetNextPelsAVX2(in, height, inStride, loadOffset, kernelLength, pelSize,
+                                        promote, shift, pels);
+                loadOffset += 1;
+            }
+
+            /* Reverse filter, then forward filter */
+            const __m256i* phaseKernel = phase ? kernelFwd : kernelRev;
+
+            if (maxValue) {
+                /* Only need to clamp max as the pack performs unsigned 16-bit saturation. */
+                verticalConvolveAVX2(pels, phaseKernel, kernelLength, values);
+                values[0] = _mm256_packus_epi32(values[0], values[1]);
+                _mm256_storeu_si256((__m256i*)dst, _mm256_min_epu16(values[0], maxV));
+            } else {
+                _mm256_storeu_si256((__m256i*)dst,
+                                    verticalConvolveS16AVX2(pels, phaseKernel, kernelLength));
+            }
+        }
+
+        out0 += outSkip;
+        out1 += outSkip;
+    }
+}
+
+/*! \brief Vertical upscaling of 16 columns. */
+static void verticalU8AVX2(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                           uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    __m256i kernelFwd[UCInterleavedStore];
+    __m256i kernelRev[UCInterleavedStore];
+    const int32_t kernelLength = (int32_t)kernel->length;
+    const uint32_t outSkip = 2 * outStride;
+    const __m128i shift = _mm_setzero_si128();
+    uint8_t* out0 = out + ((size_t)y * outSkip);
+    uint8_t* out1 = out0 + outStride;
+    int32_t loadOffset = (int32_t)y - (kernelLength / 2);
+    __m256i pels[UCInterleavedStore][UCVertGroupSize];
+    __m256i result;
+
+    loadKernelAVX2(kernel, kernelFwd, kernelRev);
+
+    /* Prime interleaved rows. */
+    verticalGetPelsAVX2(in, height, inStride, loadOffset, kernelLength, 1, false, shift, pels);
+    loadOffset += 1;
+
+    for (uint32_t rowIndex = 0; rowIndex < rows; ++rowIndex) {
+        /* Reverse filter, saturated and packed back to U8 */
+        result = verticalConvolveS16AVX2(pels, kernelRev, kernelLength);
+        _mm_storeu_si128((__m128i*)out0, _mm_packus_epi16(_mm256_castsi256_si128(result),
+                                                          _mm256_extracti128_si256(result, 1)));
+
+        /* Next input due to being off-pixel */
+        verticalGetNextPelsAVX2(in, height, inStride, loadOffset, kernelLength, 1, false, shift, pels);
+        loadOffset += 1;
+
+        /* Forward filter */
+        result = verticalConvolveS16AVX2(pels, kernelFwd, kernelLength);
+        _mm_storeu_si128((__m128i*)out1, _mm_packus_epi16(_mm256_castsi256_si128(result),
+                                                          _mm256_extracti128_si256(result, 1)));
+
+        out0 += outSkip;
+        out1 += outSkip;
+    }
+}
+
+static void verticalS16AVX2(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                            uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    verticalN16ImplAVX2(in, inStride, out, outStride, y, rows, height, kernel, 2, false, 0, 0);
+}
+
+/* Vertical upscaling of unsigned input promoted to S16, and of unsigned 16-bit input. */
+#define VN_GEN_VERT_FUNCS_AVX2(uFP, sFP, pelSize, shift, maxValue)                                   \
+    static void vertical##uFP##To##sFP##AVX2(const uint8_t* in, uint32_t inStride, uint8_t* out,     \
+                                             uint32_t outStride, uint32_t y, uint32_t rows,          \
+                                             uint32_t height, const LdeKernel* kernel)               \
+    {                                                                                                \
+        verticalN16ImplAVX2(in, inStride, out, outStride, y, rows, height, kernel, pelSize, true,    \
+                            shift, 0);                                                               \
+    }                                                                                                \
+    static void vertical##uFP##AVX2(const uint8_t* in, uint32_t inStride, uint8_t* out,              \
+                                    uint32_t outStride, uint32_t y, uint32_t rows, uint32_t height,  \
+                                    const LdeKernel* kernel)                                         \
+    {                                                                                                \
+        verticalN16ImplAVX2(in, inStride, out, outStride, y, rows, height, kernel, 2, false, 0,      \
+                            maxValue);                                                               \
+    }
+
+static void verticalU8ToS8AVX2(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                               uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    verticalN16ImplAVX2(in, inStride, out, outStride, y, rows, height, kernel, 1, true, 7, 0);
+}
+
+VN_GEN_VERT_FUNCS_AVX2(U10, S10, 2, 5, 1023)
+VN_GEN_VERT_FUNCS_AVX2(U12, S12, 2, 3, 4095)
+VN_GEN_VERT_FUNCS_AVX2(U14, S14, 2, 1, 16383)
+
+/*------------------------------------------------------------------------------*/
+
+/* clang-format off */
+
+/* kHorizontalFunctionTable[ilv][fp] */
+static const UpscaleHorizontalFunction kHorizontalFunctionTable[ILCount][LdpFPCount] = {
+    /* U8,                   U10,                     U12,                     U14,                     S8.7,                    S10.5,                   S12.3,                   S14.1 */
+    {horizontalU8PlanarAVX2, horizontalU10PlanarAVX2, horizontalU12PlanarAVX2, horizontalU14PlanarAVX2, horizontalS16PlanarAVX2, horizontalS16PlanarAVX2, horizontalS16PlanarAVX2, horizontalS16PlanarAVX2}, /* None*/
+    {NULL,                   NULL,                    NULL,                    NULL,                    NULL,                    NULL,                    NULL,                    NULL},                    /* YUYV */
+    {horizontalU8NV12AVX2,   NULL,                    NULL,                    NULL,                    NULL,                    NULL,                    NULL,                    NULL},                    /* NV12 */
+    {NULL,                   NULL,                    NULL,                    NULL,                    NULL,                    NULL,                    NULL,                    NULL},                    /* UYVY */
+    {NULL,                   NULL,                    NULL,                    NULL,                    NULL,                    NULL,                    NULL,                    NULL},                    /* RGB */
+    {NULL,                   NULL,                    NULL,                    NULL,                    NULL,                    NULL,                    NULL,                    NULL},                    /* RGBA */
+};
+
+/* kVerticalFunctionTable[fp] */
+static const UpscaleVerticalFunction kVerticalFunctionTable[LdpFPCount] = {
+    verticalU8AVX2,  /* U8 */
+    verticalU10AVX2, /* U10 */
+    verticalU12AVX2, /* U12 */
+    verticalU14AVX2, /* U14 */
+    verticalS16AVX2, /* S8.7 */
+    verticalS16AVX2, /* S10.5 */
+    verticalS16AVX2, /* S12.3 */
+    verticalS16AVX2, /* S14.1 */
+};
+
+/* kHorizontalPromotionFunctionTable[unsignedFP] - planar, unsigned input and base */
+static const UpscaleHorizontalFunction kHorizontalPromotionFunctionTable[LdpFPUnsignedCount] = {
+    horizontalU8ToS8PlanarAVX2,
+    horizontalU10ToS10PlanarAVX2,
+    horizontalU12ToS12PlanarAVX2,
+    horizontalU14ToS14PlanarAVX2,
+};
+
+/* kHorizontalBaseUnsignedFunctionTable[baseFP] - planar, signed input and unsigned base */
+static const UpscaleHorizontalFunction kHorizontalBaseUnsignedFunctionTable[LdpFPUnsignedCount] = {
+    horizontalS8BaseU8PlanarAVX2,
+    horizontalS10BaseU10PlanarAVX2,
+    horizontalS12BaseU12PlanarAVX2,
+    horizontalS14BaseU14PlanarAVX2,
+};
+
+/* kHorizontalDemotionFunctionTable[unsignedFP] - planar, signed input and base */
+static const UpscaleHorizontalFunction kHorizontalDemotionFunctionTable[LdpFPUnsignedCount] = {
+    horizontalS8ToU8PlanarAVX2,
+    horizontalS10ToU10PlanarAVX2,
+    horizontalS12ToU12PlanarAVX2,
+    horizontalS14ToU14PlanarAVX2,
+};
+
+/* kHorizontalDemotionBaseUnsignedFunctionTable[unsignedFP] - planar, signed input and unsigned base */
+static const UpscaleHorizontalFunction kHorizontalDemotionBaseUnsignedFunctionTable[LdpFPUnsignedCount] = {
+    horizontalS8BaseU8ToU8PlanarAVX2,
+    horizontalS10BaseU10ToU10PlanarAVX2,
+    horizontalS12BaseU12ToU12PlanarAVX2,
+    horizontalS14BaseU14ToU14PlanarAVX2,
+};
+
+/* kVerticalPromotionFunctionTable[unsignedFP] */
+static const UpscaleVerticalFunction kVerticalPromotionFunctionTable[LdpFPUnsignedCount] = {
+    verticalU8ToS8AVX2,   /* U8 -> S8.7 */
+    verticalU10ToS10AVX2, /* U10 -> S10.5 */
+    verticalU12ToS12AVX2, /* U12 -> S12.3 */
+    verticalU14ToS14AVX2, /* U14 -> S14.1 */
+};
+
+/* clang-format on */
+
+/*------------------------------------------------------------------------------*/
+
+UpscaleHorizontalFunction upscaleGetHorizontalFunctionAVX2(Interleaving ilv, LdpFixedPoint srcFP,
+                                                           LdpFixedPoint dstFP,
+                                                           LdpFixedPoint baseFP)
+{
+    /* Planar promotion from an unsigned picture to signed fixed-point of the same depth. */
+    if ((ilv == ILNone) && fixedPointIsSigned(dstFP) && !fixedPointIsSigned(srcFP)) {
+        if ((fixedPointHighPrecision(srcFP) != dstFP) ||
+            (fixedPointIsValid(baseFP) && (baseFP != srcFP))) {
+            return NULL;
+        }
+        return kHorizontalPromotionFunctionTable[srcFP];
+    }
+
+    /* Planar demotion from signed fixed-point to an unsigned picture of the same depth. */
+    if ((ilv == ILNone) && fixedPointIsSigned(srcFP) && !fixedPointIsSigned(dstFP)) {
+        const bool baseUnsigned = fixedPointIsValid(baseFP) && !fixedPointIsSigned(baseFP);
+
+        if ((fixedPointHighPrecision(dstFP) != srcFP) || (baseUnsigned && (baseFP != dstFP))) {
+            return NULL;
+        }
+        return baseUnsigned ? kHorizontalDemotionBaseUnsignedFunctionTable[dstFP]
+                            : kHorizontalDemotionFunctionTable[dstFP];
+    }
+
+    if ((ilv == ILNone) && fixedPointIsSigned(srcFP) && fixedPointIsValid(baseFP) &&
+        !fixedPointIsSigned(baseFP)) {
+        if ((srcFP != dstFP) || (fixedPointHighPrecision(baseFP) != dstFP)) {
+            return NULL;
+        }
+        return kHorizontalBaseUnsignedFunctionTable[baseFP];
+    }
+
+    /* Other conversions are not currently supported in SIMD. */
+    if ((srcFP != dstFP) || ((baseFP != dstFP) && fixedPointIsValid(baseFP))) {
+        return NULL;
+    }
+
+    return kHorizontalFunctionTable[ilv][srcFP];
+}
+
+UpscaleVerticalFunction upscaleGetVerticalFunctionAVX2(LdpFixedPoint srcFP, LdpFixedPoint dstFP)
+{
+    /* Promotion from an unsigned picture to signed fixed-point of the same depth. */
+    if (!fixedPointIsSigned(srcFP) && (fixedPointHighPrecision(srcFP) == dstFP)) {
+        return kVerticalPromotionFunctionTable[srcFP];
+    }
+
+    /* Other conversions are not currently supported in SIMD. */
+    if (srcFP != dstFP) {
+        return NULL;
+    }
+
+    return kVerticalFunctionTable[srcFP];
+}
+
+/*------------------------------------------------------------------------------*/
+
+#else
+
+UpscaleHorizontalFunction upscaleGetHorizontalFunctionAVX2(Interleaving ilv, LdpFixedPoint srcFP,
+                                                           LdpFixedPoint dstFP,
+                                                           LdpFixedPoint baseFP)
+{
+    VNUnused(ilv);
+    VNUnused(srcFP);
+    VNUnused(dstFP);
+    VNUnused(baseFP);
+    return NULL;
+}
+
+UpscaleVerticalFunction upscaleGetVerticalFunctionAVX2(LdpFixedPoint srcFP, LdpFixedPoint dstFP)
+{
+    VNUnused(srcFP);
+    VNUnused(dstFP);
+    return NULL;
+}
+
+#endif
@@ -160,6 +160,40 @@ static inline void getNextPelsUN(const uint8_t* in, uint32_t inSize, uint32_t st
     }
 }
 
+/* Unsigned N-bit values are promoted to signed fixed-point of the same bit-depth by shifting
+ * up to 15-bits and re-centering around zero. */
+static const int16_t kPromotionOffsetS16 = 16384;
+
+static inline int16_t promoteUN(const uint8_t* in, uint32_t pelSize, uint32_t shift)
+{
+    const int32_t value = (pelSize == 1) ? *in : *(const uint16_t*)in;
+    return (int16_t)((value << shift) - kPromotionOffsetS16);
+}
+
+static inline int16_t loadBaseS16(const uint8_t* base, bool baseUnsigned, uint32_t pelSize,
+                                  uint32_t shift)
+{
+    return baseUnsigned ? promoteUN(base, pelSize, shift) : *(const int16_t*)base;
+}
+
+static inline void getPelsUNToS16(const uint8_t* in, uint32_t inSize, uint32_t stride, int32_t offset,
+                                  int16_t* pels, int32_t pelsLength, uint32_t pelSize, uint32_t shift)
+{
+    getPelsUN(in, inSize, stride, offset, pels, pelsLength, pelSize, shift);
+
+    for (int32_t i = 0; i < pelsLength; i++) {
+        pels[i] = (int16_t)(pels[i] - kPromotionOffsetS16);
+    }
+}
+
+static inline void getNextPelsUNToS16(const uint8_t* in, uint32_t inSize, uint32_t stride,
+                                      int32_t offset, int16_t* pels, int32_t pelsLength,
+                                      const uint32_t pelSize, const uint32_t shift)
+{
+    getNextPelsUN(in, inSize, stride, offset, pels, pelsLength, pelSize, shift);
+    pels[pelsLength - 1] = (int16_t)(pels[pelsLength - 1] - kPromotionOffsetS16);
+}
+
 /*------------------------------------------------------------------------------*/
 
 /*!
@@ -819,6 +853,151 @@ void horizontalUNPlanar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t*
     horizontalU16(dither, in, out, base, width, xStart, xEnd, kernel, 1, channelSkip, channelMap, maxValue);
 }
 
+/*!
+ * Perform horizontal upscaling of 2 lines at a time for a planar surface, where any of the
+ * input, the PA base and the output may be an unsigned N-bit picture plane rather than signed
+ * 16-bit.
+ *
+ * Unsigned samples are promoted to the signed fixed-point type of the same bit-depth as they
+ * are loaded, so the first upscale of a frame can read the base picture directly instead of a
+ * converted copy. Likewise, results may be demoted to unsigned as they are stored, so the last
+ * upscale of a frame can write the output picture directly. The result is identical to
+ * converting first (or afterwards) and using `horizontalS16`.
+ *
+ * \param inUnsigned   True if `in` is unsigned N-bit, false if it is already signed 16-bit.
+ * \param baseUnsigned True if `base` is unsigned N-bit, false if it is signed 16-bit.
+ * \param outUnsigned  True if `out` is unsigned N-bit, false if it is signed 16-bit.
+ * \param pelSize      The byte size of an unsigned sample.
+ * \param shift        The promotion shift from the unsigned type to the signed type.
+ *
+ * \note See `horizontalS16` for the remaining parameters.
+ */
+static void horizontalUNToS16Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                    const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                    uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP,
+                                    bool inUnsigned, bool baseUnsigned, bool outUnsigned,
+                                    uint32_t pelSize, uint32_t shift)
+{
+    int16_t pels[2][8];
+    int16_t* outI16[2] = {(int16_t*)out[0], (int16_t*)out[1]};
+    uint16_t* outU16[2] = {(uint16_t*)out[0], (uint16_t*)out[1]};
+    const int16_t* kernelFwd = kernel->coeffs[0];
+    const int16_t* kernelRev = kernel->coeffs[1];
+    const int32_t kernelLength = (int32_t)kernel->length;
+    int32_t values[4];
+    const bool paEnabled = (base[0] != NULL);
+    const bool paEnabled1D = paEnabled && (base[1] != NULL);
+    const uint32_t baseStep = baseUnsigned ? pelSize : (uint32_t)sizeof(int16_t);
+    const size_t initialBaseOffset = (size_t)xStart * baseStep;
+    const uint8_t* base0 = (base[0] != NULL) ? &base[0][initialBaseOffset] : NULL;
+    const uint8_t* base1 = (base[1] != NULL) ? &base[1][initialBaseOffset] : NULL;
+    int32_t loadOffset = (int32_t)xStart - (kernelLength >> 1);
+    int32_t storeOffset = (int32_t)(xStart << 1);
+    const uint16_t* ditherBuffer = NULL;
+    int8_t ditherShift = 0;
+    const int16_t demoteRounding = (int16_t)(1 << (shift - 1));
+    const int16_t demoteSignOffset = (int16_t)(kPromotionOffsetS16 >> shift);
+    const uint16_t demoteMaxValue = (uint16_t)((0x8000 >> shift) - 1);
+
+    /* Prime pels with initial values. */
+    if (inUnsigned) {
+        getPelsUNToS16(in[0], width, 1, loadOffset, pels[0], kernelLength, pelSize, shift);
+        getPelsUNToS16(in[1], width, 1, loadOffset, pels[1], kernelLength, pelSize, shift);
+    } else {
+        getPelsS16((const int16_t*)in[0], width, 1, loadOffset, pels[0], kernelLength);
+        getPelsS16((const int16_t*)in[1], width, 1, loadOffset, pels[1], kernelLength);
+    }
+    loadOffset += 1;
+
+    if (dither != NULL) {
+        ditherBuffer = ldppDitherGetBuffer(dither, (xEnd - xStart) * (size_t)4);
+        ditherShift = ldppDitherGetShiftS16(outUnsigned ? fixedPointHighPrecision(dstFP) : dstFP);
+    }
+
+    for (uint32_t x = xStart; x < xEnd; ++x) {
+        memset(values, 0, sizeof(int32_t) * 4);
+
+        /* Reverse filter */
+        for (int32_t i = 0; i < kernelLength; ++i) {
+            values[0] += (kernelRev[i] * pels[0][i]);
+            values[2] += (kernelRev[i] * pels[1][i]);
+        }
+
+        /* Next input after reverse-phase as we are off pixel */
+        if (inUnsigned) {
+            getNextPelsUNToS16(in[0], width, 1, loadOffset, pels[0], kernelLength, pelSize, shift);
+            getNextPelsUNToS16(in[1], width, 1, loadOffset, pels[1], kernelLength, pelSize, shift);
+        } else {
+            getNextPelsS16((const int16_t*)in[0], width, 1, loadOffset, pels[0], kernelLength);
+            getNextPelsS16((const int16_t*)in[1], width, 1, loadOffset, pels[1], kernelLength);
+        }
+
+        /* Forward filter */
+        for (int32_t i = 0; i < kernelLength; ++i) {
+            values[1] += (kernelFwd[i] * pels[0][i]);
+            values[3] += (kernelFwd[i] * pels[1][i]);
+        }
+
+        values[0] = shiftResultSaturated(values[0]);
+        values[1] = shiftResultSaturated(values[1]);
+        values[2] = shiftResultSaturated(values[2]);
+        values[3] = shiftResultSaturated(values[3]);
+
+        /* Apply predicted average */
+        if (paEnabled1D) {
+            const int32_t avg0 = loadBaseS16(base0, baseUnsigned, pelSize, shift) -
+                                 ((values[0] + values[1] + 1) >> 1);
+            const int32_t avg1 = loadBaseS16(base1, baseUnsigned, pelSize, shift) -
+                                 ((values[2] + values[3] + 1) >> 1);
+            base0 += baseStep;
+            base1 += baseStep;
+
+            values[0] += avg0;
+            values[1] += avg0;
+            values[2] += avg1;
+            values[3] += avg1;
+        } else if (paEnabled) {
+            const int32_t avg = loadBaseS16(base0, baseUnsigned, pelSize, shift) -
+                                ((values[0] + values[1] + values[2] + values[3] + 2) >> 2);
+            base0 += baseStep;
+
+            values[0] += avg;
+            values[1] += avg;
+            values[2] += avg;
+            values[3] += avg;
+        }
+
+        /* Apply dithering */
+        if (ditherBuffer) {
+            ldppDitherApply(&values[0], &ditherBuffer, ditherShift, dither->strength);
+            ldppDitherApply(&values[1], &ditherBuffer, ditherShift, dither->strength);
+            ldppDitherApply(&values[2], &ditherBuffer, ditherShift, dither->strength);
+            ldppDitherApply(&values[3], &ditherBuffer, ditherShift, dither->strength);
+        }
+
+        if (!outUnsigned) {
+            outI16[0][storeOffset] = saturateS16(values[0]);
+            outI16[0][storeOffset + 1] = saturateS16(values[1]);
+            outI16[1][storeOffset] = saturateS16(values[2]);
+            outI16[1][storeOffset + 1] = saturateS16(values[3]);
+        } else {
+            for (uint32_t i = 0; i < 4; ++i) {
+                const uint16_t value = fpS16ToU16(saturateS16(values[i]), (int16_t)shift, demoteRounding,
+                                                  demoteSignOffset, demoteMaxValue);
+                const int32_t offset = storeOffset + (int32_t)(i & 1);
+                if (pelSize == 1) {
+                    out[i >> 1][offset] = (uint8_t)value;
+                } else {
+                    outU16[i >> 1][offset] = value;
+                }
+            }
+        }
+
+        storeOffset += 2;
+        loadOffset += 1;
+    }
+}
+
 /*!
  * Perform vertical upscaling of 2 columns at a time for unsigned 8-bit surfaces.
  *
@@ -1068,6 +1247,57 @@ static void verticalUNToU16(const uint8_t* in, uint32_t inStride, uint8_t* out,
     }
 }
 
+/* Promoting input vertical upscale from unsigned N-bits to signed fixed-point of the same depth. */
+static void verticalUNToS16(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                            uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel,
+                            const uint32_t inPelSize, const uint32_t inShift)
+{
+    int16_t pels[2][8];
+    const int16_t* kernelFwd = kernel->coeffs[0];
+    const int16_t* kernelRev = kernel->coeffs[1];
+    const int32_t kernelLength = (int32_t)kernel->length;
+    int32_t values[4];
+    const uint32_t outSkip = 2 * outStride;
+    int16_t* out0 = (int16_t*)out + ((size_t)y * outSkip);
+    int16_t* out1 = out0 + outStride;
+    int32_t loadOffset = (int32_t)y - (kernelLength / 2);
+
+    getPelsUNToS16(in, height, inStride, loadOffset, pels[0], kernelLength, inPelSize, inShift);
+    getPelsUNToS16(in + inPelSize, height, inStride, loadOffset, pels[1], kernelLength, inPelSize,
+                   inShift);
+    loadOffset += 1;
+
+    for (uint32_t rowIndex = 0; rowIndex < rows; ++rowIndex) {
+        memset(values, 0, sizeof(int32_t) * 4);
+
+        /* Reverse filter */
+        for (int32_t i = 0; i < kernelLength; ++i) {
+            values[0] += (kernelRev[i] * pels[0][i]);
+            values[1] += (kernelRev[i] * pels[1][i]);
+        }
+
+        /* Next input after reverse-phase as we are off pixel */
+        getNextPelsUNToS16(in, height, inStride, loadOffset, pels[0], kernelLength, inPelSize, inShift);
+        getNextPelsUNToS16(in + inPelSize, height, inStride, loadOffset, pels[1], kernelLength,
+                           inPelSize, inShift);
+        loadOffset += 1;
+
+        /* Forward filter */
+        for (int32_t i = 0; i < kernelLength; ++i) {
+            values[2] += (kernelFwd[i] * pels[0][i]);
+            values[3] += (kernelFwd[i] * pels[1][i]);
+        }
+
+        out0[0] = shiftResultSaturated(values[0]);
+        out0[1] = shiftResultSaturated(values[1]);
+        out1[0] = shiftResultSaturated(values[2]);
+        out1[1] = shiftResultSaturated(values[3]);
+
+        out0 += outSkip;
+        out1 += outSkip;
+    }
+}
+
 void verticalU10(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride, uint32_t y,
                  uint32_t rows, uint32_t height, const LdeKernel* kernel)
 {
@@ -1122,6 +1352,30 @@ void verticalU12ToU14(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32
     verticalUNToU16(in, inStride, out, outStride, y, rows, height, kernel, 2, 2, 16383);
 }
 
+void verticalU8ToS8(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                    uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    verticalUNToS16(in, inStride, out, outStride, y, rows, height, kernel, 1, 7);
+}
+
+void verticalU10ToS10(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                      uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    verticalUNToS16(in, inStride, out, outStride, y, rows, height, kernel, 2, 5);
+}
+
+void verticalU12ToS12(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                      uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    verticalUNToS16(in, inStride, out, outStride, y, rows, height, kernel, 2, 3);
+}
+
+void verticalU14ToS14(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                      uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    verticalUNToS16(in, inStride, out, outStride, y, rows, height, kernel, 2, 1);
+}
+
 /*------------------------------------------------------------------------------*/
 
 /* clang-format off */
@@ -1162,6 +1416,11 @@ static const uint32_t kShift_U8_U14  = 6;
 static const uint32_t kShift_U10_U14 = 4;
 static const uint32_t kShift_U12_U14 = 2;
 
+static const uint32_t kShift_U8_S8   = 7;
+static const uint32_t kShift_U10_S10 = 5;
+static const uint32_t kShift_U12_S12 = 3;
+static const uint32_t kShift_U14_S14 = 1;
+
 static const uint32_t kChannelCount_Planar = 1;
 static const uint32_t kChannelCount_YUYV   = 4;
 static const uint32_t kChannelCount_NV12   = 2;
@@ -1227,6 +1486,48 @@ static const uint16_t kMaxValuePromotion_U14 = 16383;
             kShift_##srcFP##_##dstFP, kFormatBytes_##baseFP,                                   \
             kShift_##baseFP##_##dstFP, kMaxValuePromotion_##dstFP); }
 
+/* Helper macro for generating the planar upscale_horizontal() signed promotion
+ * functor pair for an unsigned fixedpoint type.
+ *
+ * The first functor reads both input and base as unsigned (1D upscale from a picture),
+ * the second reads signed input with an unsigned base (2D upscale from a picture).
+ *
+ * \param uFP   The unsigned fixedpoint type read from the picture.
+ * \param sFP   The signed fixedpoint type of the same bit-depth.
+ */
+#define VN_GEN_HORI_SIGNED_PROMOTION_FUNCS(uFP, sFP)                                           \
+    void horizontal##uFP##To##sFP##Planar(                                                     \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],        \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) {              \
+        horizontalUNToS16Planar(dither, in, out, base, width, xStart, xEnd, kernel, dstFP,     \
+                                true, true, false, kFormatBytes_##uFP, kShift_##uFP##_##sFP); } \
+    void horizontal##sFP##Base##uFP##Planar(                                                   \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],        \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) {              \
+        horizontalUNToS16Planar(dither, in, out, base, width, xStart, xEnd, kernel, dstFP,     \
+                                false, true, false, kFormatBytes_##uFP, kShift_##uFP##_##sFP); }
+
+/* Helper macro for generating the planar signed to unsigned demoting horizontal functor pair
+ * for an unsigned fixedpoint type.
+ *
+ * The first functor reads a signed input and base (or no base), the second reads a signed
+ * input with an unsigned base (2D upscale from a picture). Both write unsigned output.
+ *
+ * \param uFP   The unsigned fixedpoint type written to the picture.
+ * \param sFP   The signed fixedpoint type of the same bit-depth.
+ */
+#define VN_GEN_HORI_SIGNED_DEMOTION_FUNCS(uFP, sFP)                                            \
+    void horizontal##sFP##To##uFP##Planar(                                                     \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],        \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) {              \
+        horizontalUNToS16Planar(dither, in, out, base, width, xStart, xEnd, kernel, dstFP,     \
+                                false, false, true, kFormatBytes_##uFP, kShift_##uFP##_##sFP); } \
+    void horizontal##sFP##Base##uFP##To##uFP##Planar(                                          \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],        \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) {              \
+        horizontalUNToS16Planar(dither, in, out, base, width, xStart, xEnd, kernel, dstFP,     \
+                                false, true, true, kFormatBytes_##uFP, kShift_##uFP##_##sFP); }
+
 /* Helper macro for generating the various horizontal functor interleaving
  * non-converting combinations required for a given fixedpoint type.
  *
@@ -1268,6 +1569,18 @@ VN_GEN_HORI_FUNCS_FOR_FP(horizontalU16, U12)
 VN_GEN_HORI_FUNCS_FOR_FP(horizontalU16, U14)
 VN_GEN_HORI_FUNCS_FOR_FP(horizontalS16, S16)
 
+/* Generate the signed promotion functors for reading directly from unsigned pictures. */
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS(U8,  S8)
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS(U10, S10)
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS(U12, S12)
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS(U14, S14)
+
+/* Signed to unsigned demotion, planar only. */
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS(U8,  S8)
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS(U10, S10)
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS(U12, S12)
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS(U14, S14)
+
 /* Generate the unsigned promotion functors for each interleaving type. */
 VN_GEN_HORI_UNSIGNED_PROMOTION_FOR_ILV(Planar);
 VN_GEN_HORI_UNSIGNED_PROMOTION_FOR_ILV(NV12);
@@ -1362,19 +1675,52 @@ static const UpscaleHorizontalFunction kHorizontalFuncTablePromotion[ILCount][Ld
     VN_REG_HORI_UNSIGNED_PROMOTION_FUNCS(RGBA),
 };
 
+/* kHoriFuncTableSignedPromotion[unsignedFP] - planar only, unsigned input and base. */
+static const UpscaleHorizontalFunction kHorizontalFuncTableSignedPromotion[LdpFPUnsignedCount] = {
+    horizontalU8ToS8Planar,
+    horizontalU10ToS10Planar,
+    horizontalU12ToS12Planar,
+    horizontalU14ToS14Planar,
+};
+
+/* kHoriFuncTableSignedBaseUnsigned[baseFP] - planar only, signed input and unsigned base. */
+static const UpscaleHorizontalFunction kHorizontalFuncTableSignedBaseUnsigned[LdpFPUnsignedCount] = {
+    horizontalS8BaseU8Planar,
+    horizontalS10BaseU10Planar,
+    horizontalS12BaseU12Planar,
+    horizontalS14BaseU14Planar,
+};
+
+/* kHoriFuncTableSignedDemotion[unsignedFP] - planar only, signed input and base. */
+static const UpscaleHorizontalFunction kHorizontalFuncTableSignedDemotion[LdpFPUnsignedCount] = {
+    horizontalS8ToU8Planar,
+    horizontalS10ToU10Planar,
+    horizontalS12ToU12Planar,
+    horizontalS14ToU14Planar,
+};
+
+/* kHoriFuncTableSignedDemotionBaseUnsigned[unsignedFP] - planar only, signed input and
+ * unsigned base. */
+static const UpscaleHorizontalFunction kHorizontalFuncTableSignedDemotionBaseUnsigned[LdpFPUnsignedCount] = {
+    horizontalS8BaseU8ToU8Planar,
+    horizontalS10BaseU10ToU10Planar,
+    horizontalS12BaseU12ToU12Planar,
+    horizontalS14BaseU14ToU14Planar,
+};
+
 /*------------------------------------------------------------------------------*/
 
 /* kVerticalFunctionTable[srcFP][dstFP] */
 static const UpscaleVerticalFunction kVerticalFunctionTable[LdpFPCount][LdpFPCount] = {
-    /* U8        U10              U12               U14               S8.7         S10.5        S12.3        S14.1 */
-    {verticalU8, verticalU8ToU10, verticalU8ToU12,  verticalU8ToU14,  NULL,        NULL,        NULL,        NULL},       /* U8    */
-    {NULL,       verticalU10,     verticalU10ToU12, verticalU10ToU14, NULL,        NULL,        NULL,        NULL},       /* U10   */
-    {NULL,       NULL,            verticalU12,      verticalU12ToU14, NULL,        NULL,        NULL,        NULL},       /* U12   */
-    {NULL,       NULL,            NULL,             verticalU14,      NULL,        NULL,        NULL,        NULL},       /* U14   */
-    {NULL,       NULL,            NULL,             NULL,             verticalS16, verticalS16, verticalS16, verticalS16},/* S8.7  */
-    {NULL,       NULL,            NULL,             NULL,             verticalS16, verticalS16, verticalS16, verticalS16},/* S10.5 */
-    {NULL,       NULL,            NULL,             NULL,             verticalS16, verticalS16, verticalS16, verticalS16},/* S12.3 */
-    {NULL,       NULL,            NULL,             NULL,             verticalS16, verticalS16, verticalS16, verticalS16} /* S14.1 */
+    /* U8        U10              U12               U14               S8.7            S10.5             S12.3             S14.1 */
+    {verticalU8, verticalU8ToU10, verticalU8ToU12,  verticalU8ToU14,  verticalU8ToS8, NULL,             NULL,             NULL},            /* U8    */
+    {NULL,       verticalU10,     verticalU10ToU12, verticalU10ToU14, NULL,           verticalU10ToS10, NULL,             NULL},            /* U10   */
+    {NULL,       NULL,            verticalU12,      verticalU12ToU14, NULL,           NULL,             verticalU12ToS12, NULL},            /* U12   */
+    {NULL,       NULL,            NULL,             verticalU14,      NULL,           NULL,             NULL,             verticalU14ToS14},/* U14   */
+    {NULL,       NULL,            NULL,             NULL,             verticalS16,    verticalS16,      verticalS16,      verticalS16},     /* S8.7  */
+    {NULL,       NULL,            NULL,             NULL,             verticalS16,    verticalS16,      verticalS16,      verticalS16},     /* S10.5 */
+    {NULL,       NULL,            NULL,             NULL,             verticalS16,    verticalS16,      verticalS16,      verticalS16},     /* S12.3 */
+    {NULL,       NULL,            NULL,             NULL,             verticalS16,    verticalS16,      verticalS16,      verticalS16}      /* S14.1 */
 };
 
 /*------------------------------------------------------------------------------*/
@@ -1384,6 +1730,32 @@ static const UpscaleVerticalFunction kVerticalFunctionTable[LdpFPCount][LdpFPCou
 UpscaleHorizontalFunction upscaleGetHorizontalFunction(Interleaving interleaving, LdpFixedPoint srcFP,
                                                        LdpFixedPoint dstFP, LdpFixedPoint baseFP)
 {
+    /* Promoting upsample reading an unsigned picture plane directly into signed fixed-point. */
+    if (fixedPointIsSigned(dstFP) &&
+        (!fixedPointIsSigned(srcFP) || (fixedPointIsValid(baseFP) && !fixedPointIsSigned(baseFP)))) {
+        const LdpFixedPoint unsignedFP = fixedPointIsSigned(srcFP) ? baseFP : srcFP;
+
+        if ((interleaving != ILNone) || (fixedPointHighPrecision(unsignedFP) != dstFP) ||
+            (fixedPointIsValid(baseFP) && (baseFP != unsignedFP))) {
+            return NULL;
+        }
+
+        return fixedPointIsSigned(srcFP) ? kHorizontalFuncTableSignedBaseUnsigned[unsignedFP]
+                                         : kHorizontalFuncTableSignedPromotion[unsignedFP];
+    }
+
+    /* Demoting upsample writing signed fixed-point directly into an unsigned picture plane. */
+    if (fixedPointIsSigned(srcFP) && !fixedPointIsSigned(dstFP)) {
+        if ((interleaving != ILNone) || (fixedPointHighPrecision(dstFP) != srcFP) ||
+            (fixedPointIsValid(baseFP) && !fixedPointIsSigned(baseFP) && (baseFP != dstFP))) {
+            return NULL;
+        }
+
+        return (fixedPointIsValid(baseFP) && !fixedPointIsSigned(baseFP))
+                   ? kHorizontalFuncTableSignedDemotionBaseUnsigned[dstFP]
+                   : kHorizontalFuncTableSignedDemotion[dstFP];
+    }
+
     if (fixedPointIsSigned(srcFP)) {
         assert(fixedPointIsSigned(dstFP) && (!fixedPointIsValid(baseFP) || fixedPointIsSigned(baseFP)));
 
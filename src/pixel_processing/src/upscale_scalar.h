@@ -39,6 +39,70 @@ void horizontalU8RGBA(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* ou
                       const uint8_t* base[2], uint32_t width, uint32_t xStart, uint32_t xEnd,
                       const LdeKernel* kernel, const LdpFixedPoint dstFP);
 
+void horizontalU8ToS8Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                            const uint8_t* base[2], uint32_t width, uint32_t xStart, uint32_t xEnd,
+                            const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalU10ToS10Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                              const uint8_t* base[2], uint32_t width, uint32_t xStart, uint32_t xEnd,
+                              const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalU12ToS12Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                              const uint8_t* base[2], uint32_t width, uint32_t xStart, uint32_t xEnd,
+                              const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalU14ToS14Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                              const uint8_t* base[2], uint32_t width, uint32_t xStart, uint32_t xEnd,
+                              const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS8BaseU8Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                              const uint8_t* base[2], uint32_t width, uint32_t xStart, uint32_t xEnd,
+                              const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS10BaseU10Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS12BaseU12Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS14BaseU14Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS8ToU8Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                            const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                            uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS8BaseU8ToU8Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                  const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                  uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS10ToU10Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                              const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                              uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS10BaseU10ToU10Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                     const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                     uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS12ToU12Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                              const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                              uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS12BaseU12ToU12Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                     const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                     uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS14ToU14Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                              const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                              uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
+void horizontalS14BaseU14ToU14Planar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                     const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                     uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP);
+
 void horizontalUNPlanar(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
                         const uint8_t* base[2], uint32_t width, uint32_t xStart, uint32_t xEnd,
                         const LdeKernel* kernel, uint16_t maxValue);
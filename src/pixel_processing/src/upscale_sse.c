@@ -78,6 +78,38 @@ static inline __m128i horizontalGetPelsN16(const uint8_t* in, int32_t offset)
     return _mm_loadu_si128((const __m128i*)&in16[offset]);
 }
 
+/*!
+ * Promote 8 unsigned values (zero-extended to 16-bit) to the signed fixed-point type of
+ * the same bit-depth, i.e. (value << shift) - 0x4000.
+ *
+ * \param pels    The unsigned values to promote.
+ * \param shift   The promotion shift, 7 for U8 down to 1 for U14.
+ *
+ * \return The promoted values.
+ */
+static inline __m128i promoteUNToS16(__m128i pels, __m128i shift)
+{
+    return _mm_sub_epi16(_mm_sll_epi16(pels, shift), _mm_set1_epi16(0x4000));
+}
+
+/*!
+ * Load a single channel of 8 unsigned pixels and promote them to signed fixed-point.
+ *
+ * \param in       The input row to load from.
+ * \param offset   The offset in "elements" to load from.
+ * \param pelSize  The byte size of each element, 1 or 2.
+ * \param shift    The promotion shift.
+ *
+ * \return The loaded and promoted pixels.
+ */
+static inline __m128i horizontalGetPelsUNAsS16(const uint8_t* in, int32_t offset, uint32_t pelSize,
+                                               __m128i shift)
+{
+    const __m128i loaded = (pelSize == 1) ? _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)&in[offset]))
+                                          : horizontalGetPelsN16(in, offset);
+    return promoteUNToS16(loaded, shift);
+}
+
 /*!
  * Load 2 channels and deinterleave into pels.
  *
@@ -544,10 +576,28 @@ static void horizontalU8PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2],
     }
 }
 
-/*! \brief S16 Planar horizontal upscaling of 2 rows. */
-static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
-                                   const uint8_t* base[2], uint32_t width, uint32_t xStart,
-                                   uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP)
+/*!
+ * S16 Planar horizontal upscaling of 2 rows.
+ *
+ * The input and PA base can be read as unsigned N-bit values that are promoted to S16 as
+ * they are loaded, allowing an upscale to read directly from a base picture. Likewise the
+ * output can be demoted to unsigned N-bit as it is stored, allowing an upscale to write
+ * directly to an output picture.
+ *
+ * \param inUnsigned     True if `in` is unsigned N-bit rather than S16.
+ * \param baseUnsigned   True if `base` is unsigned N-bit rather than S16.
+ * \param outUnsigned    True if `out` is unsigned N-bit rather than S16.
+ * \param pelSize        The byte size of the unsigned values.
+ * \param promoteShift   The promotion shift for the unsigned values.
+ * \param edgeFunction   The non-SIMD function matching this configuration for edges.
+ */
+static inline void horizontalS16PlanarImplSSE(LdppDitherSlice* dither, const uint8_t* in[2],
+                                              uint8_t* out[2], const uint8_t* base[2],
+                                              uint32_t width, uint32_t xStart, uint32_t xEnd,
+                                              const LdeKernel* kernel, const LdpFixedPoint dstFP,
+                                              bool inUnsigned, bool baseUnsigned, bool outUnsigned,
+                                              uint32_t pelSize, int32_t promoteShift,
+                                              UpscaleHorizontalFunction edgeFunction)
 {
     const int16_t* kernelCoeffs = kernel->coeffs[0];
     const uint32_t kernelLength = kernel->length;
@@ -561,6 +611,10 @@ static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2]
     int8_t shift = 0;
     int16_t* out16[2] = {(int16_t*)out[0], (int16_t*)out[1]};
     const int16_t* base16[2] = {(const int16_t*)base[0], (const int16_t*)base[1]};
+    const __m128i shiftV = _mm_cvtsi32_si128(promoteShift);
+    const __m128i demoteRoundingV = _mm_set1_epi16((int16_t)((1 << promoteShift) >> 1));
+    const __m128i demoteSignOffsetV = _mm_set1_epi16((int16_t)(0x4000 >> promoteShift));
+    const __m128i demoteMaxV = _mm_set1_epi16((int16_t)((0x8000 >> promoteShift) - 1));
     UpscaleHorizontalCoords coords = {0};
 
     /* This implementation assumes kernel is even in length. This is because the
@@ -589,26 +643,36 @@ static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2]
 
     /* Run left edge non-SIMD loop */
     if (upscaleHorizontalCoordsIsLeftValid(&coords)) {
-        horizontalS16Planar(dither, in, out, base, width, coords.leftStart, coords.leftEnd, kernel, dstFP);
+        edgeFunction(dither, in, out, base, width, coords.leftStart, coords.leftEnd, kernel, dstFP);
     }
 
     /* Prime I/O */
     int32_t loadOffset = (int32_t)(coords.start - (kernelLength >> 1));
-    pels[0][0] = horizontalGetPelsN16(in[0], loadOffset);
-    pels[1][0] = horizontalGetPelsN16(in[1], loadOffset);
+    if (inUnsigned) {
+        pels[0][0] = horizontalGetPelsUNAsS16(in[0], loadOffset, pelSize, shiftV);
+        pels[1][0] = horizontalGetPelsUNAsS16(in[1], loadOffset, pelSize, shiftV);
+    } else {
+        pels[0][0] = horizontalGetPelsN16(in[0], loadOffset);
+        pels[1][0] = horizontalGetPelsN16(in[1], loadOffset);
+    }
     loadOffset += UCHoriStepping;
     int32_t storeOffset = (int32_t)(coords.start << 1);
 
     /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
     if (dither != NULL) {
         ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 16));
-        shift = ldppDitherGetShiftS16(dstFP);
+        shift = ldppDitherGetShiftS16(outUnsigned ? fixedPointHighPrecision(dstFP) : dstFP);
     }
 
     /* Run middle SIMD loop */
     for (uint32_t x = coords.start; x < coords.end; x += UCHoriStepping) {
-        pels[0][1] = horizontalGetPelsN16(in[0], loadOffset);
-        pels[1][1] = horizontalGetPelsN16(in[1], loadOffset);
+        if (inUnsigned) {
+            pels[0][1] = horizontalGetPelsUNAsS16(in[0], loadOffset, pelSize, shiftV);
+            pels[1][1] = horizontalGetPelsUNAsS16(in[1], loadOffset, pelSize, shiftV);
+        } else {
+            pels[0][1] = horizontalGetPelsN16(in[0], loadOffset);
+            pels[1][1] = horizontalGetPelsN16(in[1], loadOffset);
+        }
 
         horizontalConvolveN16(pels[0], values[0], kernelFwd, kernelRev, kernelLength);
         horizontalConvolveN16(pels[1], values[1], kernelFwd, kernelRev, kernelLength);
@@ -617,13 +681,19 @@ static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2]
             /* @note: The base pels are already loaded, they are src - they are however
              *        offset by -kernelLength / 2. The SSE shift intrinsics require the
              *        shift amount to be a constant compile time expression. */
-            const __m128i basePels0 = _mm_loadu_si128((const __m128i*)&base16[0][x]);
-            const __m128i basePels1 = _mm_loadu_si128((const __m128i*)&base16[1][x]);
+            const __m128i basePels0 =
+                baseUnsigned ? horizontalGetPelsUNAsS16(base[0], (int32_t)x, pelSize, shiftV)
+                             : _mm_loadu_si128((const __m128i*)&base16[0][x]);
+            const __m128i basePels1 =
+                baseUnsigned ? horizontalGetPelsUNAsS16(base[1], (int32_t)x, pelSize, shiftV)
+                             : _mm_loadu_si128((const __m128i*)&base16[1][x]);
 
             applyPA1DPrecision(basePels0, values[0]);
             applyPA1DPrecision(basePels1, values[1]);
         } else if (paEnabled) {
-            const __m128i basePels = _mm_loadu_si128((const __m128i*)&base16[0][x]);
+            const __m128i basePels =
+                baseUnsigned ? horizontalGetPelsUNAsS16(base[0], (int32_t)x, pelSize, shiftV)
+                             : _mm_loadu_si128((const __m128i*)&base16[0][x]);
             applyPA2DPrecision(basePels, values);
         }
 
@@ -632,11 +702,36 @@ static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2]
             ldppDitherApplySSE(values[1], &ditherBuffer, shift, dither->strength);
         }
 
-        /* Write out (note that dither and PA used saturating add, so we're safely within S16). */
-        _mm_storeu_si128((__m128i*)&out16[0][storeOffset], values[0][0]);
-        _mm_storeu_si128((__m128i*)&out16[0][storeOffset + 8], values[0][1]);
-        _mm_storeu_si128((__m128i*)&out16[1][storeOffset], values[1][0]);
-        _mm_storeu_si128((__m128i*)&out16[1][storeOffset + 8], values[1][1]);
+        if (outUnsigned) {
+            /* Demote to unsigned - a saturated rounding add only affects values that clamp to
+             * the maximum anyway. */
+            for (uint32_t row = 0; row < 2; ++row) {
+                for (uint32_t half = 0; half < 2; ++half) {
+                    __m128i value = _mm_adds_epi16(values[row][half], demoteRoundingV);
+                    value = _mm_add_epi16(_mm_sra_epi16(value, shiftV), demoteSignOffsetV);
+                    values[row][half] =
+                        _mm_min_epi16(_mm_max_epi16(value, _mm_setzero_si128()), demoteMaxV);
+                }
+            }
+
+            if (pelSize == 1) {
+                _mm_storeu_si128((__m128i*)&out[0][storeOffset],
+                                 _mm_packus_epi16(values[0][0], values[0][1]));
+                _mm_storeu_si128((__m128i*)&out[1][storeOffset],
+                                 _mm_packus_epi16(values[1][0], values[1][1]));
+            } else {
+                _mm_storeu_si128((__m128i*)&out16[0][storeOffset], values[0][0]);
+                _mm_storeu_si128((__m128i*)&out16[0][storeOffset + 8], values[0][1]);
+                _mm_storeu_si128((__m128i*)&out16[1][storeOffset], values[1][0]);
+                _mm_storeu_si128((__m128i*)&out16[1][storeOffset + 8], values[1][1]);
+            }
+        } else {
+            /* Write out (note that dither and PA used saturating add, so we're safely within S16). */
+            _mm_storeu_si128((__m128i*)&out16[0][storeOffset], values[0][0]);
+            _mm_storeu_si128((__m128i*)&out16[0][storeOffset + 8], values[0][1]);
+            _mm_storeu_si128((__m128i*)&out16[1][storeOffset], values[1][0]);
+            _mm_storeu_si128((__m128i*)&out16[1][storeOffset + 8], values[1][1]);
+        }
 
         loadOffset += UCHoriStepping;
         storeOffset += (UCHoriStepping << 1);
@@ -644,10 +739,64 @@ static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2]
 
     /* Run right edge non-SIMD loop */
     if (upscaleHorizontalCoordsIsRightValid(&coords)) {
-        horizontalS16Planar(dither, in, out, base, width, coords.rightStart, coords.rightEnd, kernel, dstFP);
+        edgeFunction(dither, in, out, base, width, coords.rightStart, coords.rightEnd, kernel, dstFP);
     }
 }
 
+/*! \brief S16 Planar horizontal upscaling of 2 rows. */
+static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
+                                   const uint8_t* base[2], uint32_t width, uint32_t xStart,
+                                   uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP)
+{
+    horizontalS16PlanarImplSSE(dither, in, out, base, width, xStart, xEnd, kernel, dstFP, false,
+                               false, false, sizeof(int16_t), 0, horizontalS16Planar);
+}
+
+/* Planar horizontal upscaling of 2 unsigned rows promoted to S16, with an unsigned base. */
+#define VN_GEN_HORI_SIGNED_PROMOTION_FUNCS_SSE(uFP, sFP, pelSize, shift)                                 \
+    static void horizontal##uFP##To##sFP##PlanarSSE(                                                      \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],           \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) \
+    {                                                                                                     \
+        horizontalS16PlanarImplSSE(dither, in, out, base, width, xStart, xEnd, kernel, dstFP, true, true, \
+                                   false, pelSize, shift, horizontal##uFP##To##sFP##Planar);              \
+    }                                                                                                     \
+    static void horizontal##sFP##Base##uFP##PlanarSSE(                                                    \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],           \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) \
+    {                                                                                                     \
+        horizontalS16PlanarImplSSE(dither, in, out, base, width, xStart, xEnd, kernel, dstFP, false,      \
+                                   true, false, pelSize, shift, horizontal##sFP##Base##uFP##Planar);      \
+    }
+
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS_SSE(U8, S8, 1, 7)
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS_SSE(U10, S10, 2, 5)
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS_SSE(U12, S12, 2, 3)
+VN_GEN_HORI_SIGNED_PROMOTION_FUNCS_SSE(U14, S14, 2, 1)
+
+/* Planar horizontal upscaling of 2 S16 rows demoted to unsigned, with a signed or unsigned base. */
+#define VN_GEN_HORI_SIGNED_DEMOTION_FUNCS_SSE(uFP, sFP, pelSize, shift)                                  \
+    static void horizontal##sFP##To##uFP##PlanarSSE(                                                      \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],           \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) \
+    {                                                                                                     \
+        horizontalS16PlanarImplSSE(dither, in, out, base, width, xStart, xEnd, kernel, dstFP, false,      \
+                                   false, true, pelSize, shift, horizontal##sFP##To##uFP##Planar);        \
+    }                                                                                                     \
+    static void horizontal##sFP##Base##uFP##To##uFP##PlanarSSE(                                           \
+        LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2], const uint8_t* base[2],           \
+        uint32_t width, uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP) \
+    {                                                                                                     \
+        horizontalS16PlanarImplSSE(dither, in, out, base, width, xStart, xEnd, kernel, dstFP, false,      \
+                                   true, true, pelSize, shift,                                            \
+                                   horizontal##sFP##Base##uFP##To##uFP##Planar);                          \
+    }
+
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS_SSE(U8, S8, 1, 7)
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS_SSE(U10, S10, 2, 5)
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS_SSE(U12, S12, 2, 3)
+VN_GEN_HORI_SIGNED_DEMOTION_FUNCS_SSE(U14, S14, 2, 1)
+
 /*! \brief U16 Planar horizontal upscaling of 2 rows. */
 static inline void horizontalU16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2],
                                           uint8_t* out[2], const uint8_t* base[2], uint32_t width,
@@ -939,31 +1088,84 @@ static inline void verticalGetPelsU8(const uint8_t* in, uint32_t height, uint32_
     }
 }
 
-static inline void verticalGetPelsN16(const uint8_t* in, uint32_t height, uint32_t stride, int32_t offset,
-                                      int32_t count, __m128i pels[UCInterleavedStore][UCVertGroupSize])
+/*!
+ * Load 16 values from a row of an unsigned source and promote them to signed fixed-point.
+ *
+ * \param row      The row to load from.
+ * \param pelSize  The byte size of each element, 1 or 2.
+ * \param shift    The promotion shift.
+ * \param load     The destination for the 16 promoted values.
+ */
+static inline void verticalLoadRowUNAsS16(const uint8_t* row, uint32_t pelSize, __m128i shift,
+                                          __m128i load[2])
 {
-    const int16_t* in16 = (const int16_t*)in;
-    __m128i load0;
-    __m128i load1;
+    if (pelSize == 1) {
+        const __m128i loaded = _mm_loadu_si128((const __m128i*)row);
+        load[0] = _mm_cvtepu8_epi16(loaded);
+        load[1] = _mm_cvtepu8_epi16(_mm_srli_si128(loaded, 8));
+    } else {
+        load[0] = _mm_loadu_si128((const __m128i*)row);
+        load[1] = _mm_loadu_si128((const __m128i*)(row + 16));
+    }
+
+    load[0] = promoteUNToS16(load[0], shift);
+    load[1] = promoteUNToS16(load[1], shift);
+}
+
+/*!
+ * Load 16 values from a row of a 16-bit source.
+ *
+ * \param row      The row to load from.
+ * \param load     The destination for the 16 values.
+ */
+static inline void verticalLoadRowN16(const uint8_t* row, __m128i load[2])
+{
+    load[0] = _mm_loadu_si128((const __m128i*)row);
+    load[1] = _mm_loadu_si128((const __m128i*)(row + 16));
+}
+
+/*!
+ * Load a row of 16-bit values, either directly or promoted from an unsigned source.
+ *
+ * \param in       The input source surface to load from.
+ * \param stride   The stride of the input surface in elements.
+ * \param row      The row index to load.
+ * \param pelSize  The byte size of an unsigned element, or 0 for a 16-bit source.
+ * \param shift    The promotion shift for an unsigned source.
+ * \param load     The destination for the 16 values.
+ */
+static inline void verticalLoadRowS16(const uint8_t* in, uint32_t stride, size_t row,
+                                      uint32_t pelSize, __m128i shift, __m128i load[2])
+{
+    if (pelSize) {
+        verticalLoadRowUNAsS16(&in[row * stride * pelSize], pelSize, shift, load);
+    } else {
+        verticalLoadRowN16(&in[row * stride * sizeof(int16_t)], load);
+    }
+}
+
+static inline void verticalGetPelsN16(const uint8_t* in, uint32_t height, uint32_t stride,
+                                      int32_t offset, int32_t count, uint32_t pelSize, __m128i shift,
+                                      __m128i pels[UCInterleavedStore][UCVertGroupSize])
+{
+    __m128i load0[2];
+    __m128i load1[2];
 
     /* Load as 16-bit and interleave row pairs. */
     for (int32_t i = 0; i < (count >> 1); i++) {
         const size_t row0 = (size_t)clampS32(offset + (i * 2), 0, (int32_t)height - 1);
         const size_t row1 = (size_t)clampS32(offset + (i * 2) + 1, 0, (int32_t)height - 1);
 
-        /* First 8 elements */
-        load0 = _mm_loadu_si128((const __m128i*)&in16[row0 * stride]);
-        load1 = _mm_loadu_si128((const __m128i*)&in16[row1 * stride]);
+        verticalLoadRowS16(in, stride, row0, pelSize, shift, load0);
+        verticalLoadRowS16(in, stride, row1, pelSize, shift, load1);
 
-        pels[i][0] = _mm_unpacklo_epi16(load0, load1);
-        pels[i][1] = _mm_unpackhi_epi16(load0, load1);
+        /* First 8 elements */
+        pels[i][0] = _mm_unpacklo_epi16(load0[0], load1[0]);
+        pels[i][1] = _mm_unpackhi_epi16(load0[0], load1[0]);
 
         /* Next 8 elements */
-        load0 = _mm_loadu_si128((const __m128i*)&in16[(row0 * stride) + 8]);
-        load1 = _mm_loadu_si128((const __m128i*)&in16[(row1 * stride) + 8]);
-
-        pels[i][2] = _mm_unpacklo_epi16(load0, load1);
-        pels[i][3] = _mm_unpackhi_epi16(load0, load1);
+        pels[i][2] = _mm_unpacklo_epi16(load0[1], load1[1]);
+        pels[i][3] = _mm_unpackhi_epi16(load0[1], load1[1]);
     }
 }
 
@@ -1043,22 +1245,24 @@ static inline void verticalGetNextPelsU8(const uint8_t* in, uint32_t height, uin
  * \param  stride   The stride of the input surface being loaded.
  * \param  offset   The row to load from.
  * \param  count    The number of rows loaded in.
+ * \param  pelSize  The byte size of unsigned input elements, or 0 for 16-bit input.
+ * \param  shift    The promotion shift for unsigned input.
  * \param pels     The destination to load the pixels into.
  */
 static inline void verticalGetNextPelsN16(const uint8_t* in, uint32_t height, uint32_t stride,
-                                          int32_t offset, int32_t count,
+                                          int32_t offset, int32_t count, uint32_t pelSize,
+                                          __m128i shift,
                                           __m128i pels[UCInterleavedStore][UCVertGroupSize])
 {
-    const int16_t* in16 = (const int16_t*)in;
     const int32_t loopCount = (count >> 1) - 1;
     const int32_t index = offset + count - 1;
     const size_t row = (size_t)minS32(index, (int32_t)height - 1);
-    __m128i load;
+    __m128i load[2];
 
     assert(index > 0);
 
-    /* Load up first 8 elements */
-    load = _mm_loadu_si128((const __m128i*)&in16[row * stride]);
+    /* Load up next 16 elements */
+    verticalLoadRowS16(in, stride, row, pelSize, shift, load);
 
     int32_t loopIndex = 0;
 
@@ -1084,17 +1288,15 @@ static inline void verticalGetNextPelsN16(const uint8_t* in, uint32_t height, ui
 
     /* Interleave first 8 elements. */
     pels[loopIndex][0] =
-        _mm_blend_epi16(pels[loopIndex][0], _mm_unpacklo_epi16(_mm_setzero_si128(), load), 0xAA);
+        _mm_blend_epi16(pels[loopIndex][0], _mm_unpacklo_epi16(_mm_setzero_si128(), load[0]), 0xAA);
     pels[loopIndex][1] =
-        _mm_blend_epi16(pels[loopIndex][1], _mm_unpackhi_epi16(_mm_setzero_si128(), load), 0xAA);
+        _mm_blend_epi16(pels[loopIndex][1], _mm_unpackhi_epi16(_mm_setzero_si128(), load[0]), 0xAA);
 
     /* Interleave next 8 elements. */
-    load = _mm_loadu_si128((const __m128i*)&in16[(row * stride) + 8]);
-
     pels[loopIndex][2] =
-        _mm_blend_epi16(pels[loopIndex][2], _mm_unpacklo_epi16(_mm_setzero_si128(), load), 0xAA);
+        _mm_blend_epi16(pels[loopIndex][2], _mm_unpacklo_epi16(_mm_setzero_si128(), load[1]), 0xAA);
     pels[loopIndex][3] =
-        _mm_blend_epi16(pels[loopIndex][3], _mm_unpackhi_epi16(_mm_setzero_si128(), load), 0xAA);
+        _mm_blend_epi16(pels[loopIndex][3], _mm_unpackhi_epi16(_mm_setzero_si128(), load[1]), 0xAA);
 }
 
 /*!
@@ -1310,9 +1512,18 @@ void verticalU8SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t
     }
 }
 
-void verticalS16SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
-                    uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+/*!
+ * Vertical upscaling of 16 columns to S16, reading either S16 or unsigned N-bit input that
+ * is promoted to S16 as it is loaded.
+ *
+ * \param pelSize        The byte size of unsigned input elements, or 0 for S16 input.
+ * \param promoteShift   The promotion shift for unsigned input.
+ */
+static inline void verticalS16ImplSSE(const uint8_t* in, uint32_t inStride, uint8_t* out,
+                                      uint32_t outStride, uint32_t y, uint32_t rows, uint32_t height,
+                                      const LdeKernel* kernel, uint32_t pelSize, int32_t promoteShift)
 {
+    const __m128i shift = _mm_cvtsi32_si128(promoteShift);
     __m128i kernelFwd[UCInterleavedStore];
     __m128i kernelRev[UCInterleavedStore];
     const int16_t* kernelCoeffs = kernel->coeffs[0];
@@ -1344,7 +1555,7 @@ void verticalS16SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t
     }
 
     /* Prime interleaved rows. */
-    verticalGetPelsN16(in, height, inStride, loadOffset, kernelLength, pels);
+    verticalGetPelsN16(in, height, inStride, loadOffset, kernelLength, pelSize, shift, pels);
     loadOffset += 1;
 
     for (uint32_t rowIndex = 0; rowIndex < rows; ++rowIndex) {
@@ -1354,7 +1565,7 @@ void verticalS16SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t
         _mm_storeu_si128((__m128i*)(out0 + 8), result[1]);
 
         /* Next input due to being off-pixel */
-        verticalGetNextPelsN16(in, height, inStride, loadOffset, kernelLength, pels);
+        verticalGetNextPelsN16(in, height, inStride, loadOffset, kernelLength, pelSize, shift, pels);
         loadOffset += 1;
 
         /* Forward filter */
@@ -1367,6 +1578,36 @@ void verticalS16SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t
     }
 }
 
+void verticalS16SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                    uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    verticalS16ImplSSE(in, inStride, out, outStride, y, rows, height, kernel, 0, 0);
+}
+
+static void verticalU8ToS8SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                              uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    verticalS16ImplSSE(in, inStride, out, outStride, y, rows, height, kernel, 1, 7);
+}
+
+static void verticalU10ToS10SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                                uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    verticalS16ImplSSE(in, inStride, out, outStride, y, rows, height, kernel, 2, 5);
+}
+
+static void verticalU12ToS12SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                                uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    verticalS16ImplSSE(in, inStride, out, outStride, y, rows, height, kernel, 2, 3);
+}
+
+static void verticalU14ToS14SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
+                                uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel)
+{
+    verticalS16ImplSSE(in, inStride, out, outStride, y, rows, height, kernel, 2, 1);
+}
+
 static void verticalU16SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, uint32_t outStride,
                            uint32_t y, uint32_t rows, uint32_t height, const LdeKernel* kernel,
                            uint16_t maxValue)
@@ -1383,6 +1624,8 @@ static void verticalU16SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, u
     __m128i pels[UCInterleavedStore][UCVertGroupSize];
     __m128i result[2];
     __m128i maxV = _mm_set1_epi16((int16_t)maxValue);
+    const uint32_t pelSize = 0;
+    const __m128i shift = _mm_setzero_si128();
 
     assert(kernelLength % 2 == 0);
     assert(kernelLength <= UCMaxKernelSize);
@@ -1403,7 +1646,7 @@ static void verticalU16SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, u
     }
 
     /* Prime interleaved rows. */
-    verticalGetPelsN16(in, height, inStride, loadOffset, kernelLength, pels);
+    verticalGetPelsN16(in, height, inStride, loadOffset, kernelLength, pelSize, shift, pels);
     loadOffset += 1;
 
     /* Only need to clamp max as the convolve function performs unsigned 16-bit
@@ -1416,7 +1659,7 @@ static void verticalU16SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, u
         _mm_storeu_si128((__m128i*)(out0 + 8), _mm_min_epu16(result[1], maxV));
 
         /* Next input due to being off-pixel */
-        verticalGetNextPelsN16(in, height, inStride, loadOffset, kernelLength, pels);
+        verticalGetNextPelsN16(in, height, inStride, loadOffset, kernelLength, pelSize, shift, pels);
         loadOffset += 1;
 
         /* Forward filter */
@@ -1474,6 +1717,46 @@ static const UpscaleVerticalFunction kVerticalFunctionTable[LdpFPCount] = {
     verticalS16SSE, /* S14.1 */
 };
 
+/* kHorizontalPromotionFunctionTable[unsignedFP] - planar, unsigned input and base */
+static const UpscaleHorizontalFunction kHorizontalPromotionFunctionTable[LdpFPUnsignedCount] = {
+    horizontalU8ToS8PlanarSSE,
+    horizontalU10ToS10PlanarSSE,
+    horizontalU12ToS12PlanarSSE,
+    horizontalU14ToS14PlanarSSE,
+};
+
+/* kHorizontalBaseUnsignedFunctionTable[baseFP] - planar, signed input and unsigned base */
+static const UpscaleHorizontalFunction kHorizontalBaseUnsignedFunctionTable[LdpFPUnsignedCount] = {
+    horizontalS8BaseU8PlanarSSE,
+    horizontalS10BaseU10PlanarSSE,
+    horizontalS12BaseU12PlanarSSE,
+    horizontalS14BaseU14PlanarSSE,
+};
+
+/* kHorizontalDemotionFunctionTable[unsignedFP] - planar, signed input and base */
+static const UpscaleHorizontalFunction kHorizontalDemotionFunctionTable[LdpFPUnsignedCount] = {
+    horizontalS8ToU8PlanarSSE,
+    horizontalS10ToU10PlanarSSE,
+    horizontalS12ToU12PlanarSSE,
+    horizontalS14ToU14PlanarSSE,
+};
+
+/* kHorizontalDemotionBaseUnsignedFunctionTable[unsignedFP] - planar, signed input and unsigned base */
+static const UpscaleHorizontalFunction kHorizontalDemotionBaseUnsignedFunctionTable[LdpFPUnsignedCount] = {
+    horizontalS8BaseU8ToU8PlanarSSE,
+    horizontalS10BaseU10ToU10PlanarSSE,
+    horizontalS12BaseU12ToU12PlanarSSE,
+    horizontalS14BaseU14ToU14PlanarSSE,
+};
+
+/* kVerticalPromotionFunctionTable[unsignedFP] */
+static const UpscaleVerticalFunction kVerticalPromotionFunctionTable[LdpFPUnsignedCount] = {
+    verticalU8ToS8SSE,   /* U8 -> S8.7 */
+    verticalU10ToS10SSE, /* U10 -> S10.5 */
+    verticalU12ToS12SSE, /* U12 -> S12.3 */
+    verticalU14ToS14SSE, /* U14 -> S14.1 */
+};
+
 /* clang-format on */
 
 /*------------------------------------------------------------------------------*/
@@ -1481,7 +1764,35 @@ static const UpscaleVerticalFunction kVerticalFunctionTable[LdpFPCount] = {
 UpscaleHorizontalFunction upscaleGetHorizontalFunctionSSE(Interleaving ilv, LdpFixedPoint srcFP,
                                                           LdpFixedPoint dstFP, LdpFixedPoint baseFP)
 {
-    /* Conversion is not currently supported in SIMD. */
+    /* Planar promotion from an unsigned picture to signed fixed-point of the same depth. */
+    if ((ilv == ILNone) && fixedPointIsSigned(dstFP) && !fixedPointIsSigned(srcFP)) {
+        if ((fixedPointHighPrecision(srcFP) != dstFP) ||
+            (fixedPointIsValid(baseFP) && (baseFP != srcFP))) {
+            return NULL;
+        }
+        return kHorizontalPromotionFunctionTable[srcFP];
+    }
+
+    /* Planar demotion from signed fixed-point to an unsigned picture of the same depth. */
+    if ((ilv == ILNone) && fixedPointIsSigned(srcFP) && !fixedPointIsSigned(dstFP)) {
+        const bool baseUnsigned = fixedPointIsValid(baseFP) && !fixedPointIsSigned(baseFP);
+
+        if ((fixedPointHighPrecision(dstFP) != srcFP) || (baseUnsigned && (baseFP != dstFP))) {
+            return NULL;
+        }
+        return baseUnsigned ? kHorizontalDemotionBaseUnsignedFunctionTable[dstFP]
+                            : kHorizontalDemotionFunctionTable[dstFP];
+    }
+
+    if ((ilv == ILNone) && fixedPointIsSigned(srcFP) && fixedPointIsValid(baseFP) &&
+        !fixedPointIsSigned(baseFP)) {
+        if ((srcFP != dstFP) || (fixedPointHighPrecision(baseFP) != dstFP)) {
+            return NULL;
+        }
+        return kHorizontalBaseUnsignedFunctionTable[baseFP];
+    }
+
+    /* Other conversions are not currently supported in SIMD. */
     if ((srcFP != dstFP) || ((baseFP != dstFP) && fixedPointIsValid(baseFP))) {
         return NULL;
     }
@@ -1491,7 +1802,12 @@ UpscaleHorizontalFunction upscaleGetHorizontalFunctionSSE(Interleaving ilv, LdpF
 
 UpscaleVerticalFunction upscaleGetVerticalFunctionSSE(LdpFixedPoint srcFP, LdpFixedPoint dstFP)
 {
-    /* Conversion is not currently supported in SIMD. */
+    /* Promotion from an unsigned picture to signed fixed-point of the same depth. */
+    if (!fixedPointIsSigned(srcFP) && (fixedPointHighPrecision(srcFP) == dstFP)) {
+        return kVerticalPromotionFunctionTable[srcFP];
+    }
+
+    /* Other conversions are not currently supported in SIMD. */
     if (srcFP != dstFP) {
         return NULL;
     }
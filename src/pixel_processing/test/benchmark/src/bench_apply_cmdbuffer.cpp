@@ -0,0 +1,193 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Benchmarks applying a dense LOQ0 command buffer - every TU of a 1080p plane has residuals - with
+// each of the scalar, SSE and AVX2 applicators.
+
+#include "fp_types.h"
+
+#include <benchmark/benchmark.h>
+#include <LCEVC/common/acceleration.h>
+#include <LCEVC/common/diagnostics.h>
+#include <LCEVC/common/memory.h>
+#include <LCEVC/enhancement/cmdbuffer_cpu.h>
+#include <LCEVC/enhancement/transform_unit.h>
+#include <LCEVC/pipeline/frame.h>
+#include <LCEVC/pipeline/types.h>
+#include <LCEVC/pixel_processing/apply_cmdbuffer.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kWidth = 1920;
+constexpr uint32_t kHeight = 1080;
+
+enum SimdMode : int64_t
+{
+    SimdScalar,
+    SimdSSE,
+    SimdAVX2,
+};
+
+// -----------------------------------------------------------------------------
+
+class ApplyCmdBufferFixture : public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& state) final
+    {
+        simd = static_cast<SimdMode>(state.range(0));
+        fixedPoint = static_cast<LdpFixedPoint>(state.range(1));
+        transformSize = static_cast<uint8_t>(state.range(2));
+        rasterOrder = state.range(3) != 0;
+
+        plane.resize(static_cast<size_t>(kWidth) * kHeight * fixedPointByteSize(fixedPoint));
+        memset(plane.data(), 0x40, plane.size());
+        planeDesc.firstSample = plane.data();
+        planeDesc.rowByteStride = kWidth * fixedPointByteSize(fixedPoint);
+
+        enhancementTile.tileWidth = kWidth;
+        enhancementTile.tileHeight = kHeight;
+        enhancementTile.planeWidth = kWidth;
+        enhancementTile.planeHeight = kHeight;
+        ldeCmdBufferCpuInitialize(ldcMemoryAllocatorMalloc(), &enhancementTile.buffer, 0);
+        ldeCmdBufferCpuReset(&enhancementTile.buffer, transformSize);
+        fillDense();
+
+        const LdcAccelerationLevel level =
+            (simd == SimdAVX2) ? LdcAccelerationLevelAuto : LdcAccelerationLevelBaseline;
+        ldcAccelerationSetKernelLevel(LdcKernelApplyCmdBuffer, level);
+    }
+
+    void TearDown(benchmark::State&) final
+    {
+        ldcAccelerationSetKernelLevel(LdcKernelApplyCmdBuffer, LdcAccelerationLevelAuto);
+        ldeCmdBufferCpuFree(&enhancementTile.buffer);
+    }
+
+    bool simdAvailable() const
+    {
+        const LdcAccelerationFeatures* acceleration =
+            ldcAccelerationGetKernel(LdcKernelApplyCmdBuffer);
+        switch (simd) {
+            case SimdScalar: return true;
+            case SimdSSE: return acceleration->SSE && !acceleration->AVX2;
+            case SimdAVX2: return acceleration->AVX2;
+        }
+        return false;
+    }
+
+    SimdMode simd = SimdScalar;
+    LdpFixedPoint fixedPoint = LdpFPU8;
+    uint8_t transformSize = CBCKDDSLayers;
+    bool rasterOrder = true;
+    std::vector<uint8_t> plane;
+    LdpPicturePlaneDesc planeDesc = {};
+    LdpEnhancementTile enhancementTile = {};
+
+private:
+    // Append an ADD for every TU of the plane, in the order that the applicator walks them.
+    void fillDense()
+    {
+        const uint8_t tuWidthShift = (transformSize == CBCKDDSLayers) ? 2 : 1;
+        TUState tuState;
+        ldeTuStateInitialize(&tuState, kWidth, kHeight, 0, 0, tuWidthShift);
+
+        int16_t residuals[CBCKDDSLayers];
+        uint32_t seed = 1;
+        uint32_t lastIndex = 0;
+        const uint32_t tuCount = rasterOrder
+                                     ? tuState.tuTotal
+                                     : tuState.block.blocksPerCol * tuState.blockAligned.tuPerRow;
+        for (uint32_t tuIndex = 0; tuIndex < tuCount; ++tuIndex) {
+            if (!rasterOrder) {
+                uint32_t x = 0;
+                uint32_t y = 0;
+                ldeTuCoordsBlockAlignedRaster(&tuState, tuIndex, &x, &y);
+                if (x >= kWidth || y >= kHeight) {
+                    continue;
+                }
+            }
+            for (int16_t& residual : residuals) {
+                seed = seed * 1103515245 + 12345;
+                residual = static_cast<int16_t>(static_cast<int32_t>((seed >> 16) & 0x1FF) - 256);
+            }
+            ldeCmdBufferCpuAppend(&enhancementTile.buffer, CBCCAdd, residuals, tuIndex - lastIndex);
+            lastIndex = tuIndex;
+        }
+    }
+};
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK_DEFINE_F(ApplyCmdBufferFixture, ApplyDense)(benchmark::State& state)
+{
+    if (!simdAvailable()) {
+        state.SkipWithError("Cannot benchmark this SIMD mode on this platform");
+        return;
+    }
+
+    for (auto _ : state) {
+        ldppApplyCmdBuffer(nullptr, nullptr, &enhancementTile, fixedPoint, &planeDesc, rasterOrder,
+                           simd == SimdScalar, false);
+        benchmark::DoNotOptimize(plane.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            enhancementTile.buffer.count);
+}
+
+static void applyDenseArgs(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"SIMD", "FixedPoint", "TransformSize", "Raster"});
+    for (const int64_t simd : {SimdScalar, SimdSSE, SimdAVX2}) {
+        for (const int64_t fixedPoint : {LdpFPU8, LdpFPU10, LdpFPS10}) {
+            for (const int64_t transformSize : {CBCKDDLayers, CBCKDDSLayers}) {
+                for (const int64_t raster : {1, 0}) {
+                    benchmark->Args({simd, fixedPoint, transformSize, raster});
+                }
+            }
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(ApplyCmdBufferFixture, ApplyDense)
+    ->Apply(applyDenseArgs)
+    ->Unit(benchmark::kMicrosecond);
+
+// -----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    ldcDiagnosticsInitialize(nullptr);
+    ldcAccelerationInitialize(true);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    ldcDiagnosticsRelease();
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
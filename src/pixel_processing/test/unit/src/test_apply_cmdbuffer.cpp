@@ -16,9 +16,11 @@
 #include "test_plane.h"
 
 #include <gtest/gtest.h>
+#include <LCEVC/common/acceleration.h>
 #include <LCEVC/common/diagnostics.h>
 #include <LCEVC/common/memory.h>
 #include <LCEVC/enhancement/cmdbuffer_cpu.h>
+#include <LCEVC/enhancement/transform_unit.h>
 #include <LCEVC/pipeline/types.h>
 #include <LCEVC/pixel_processing/apply_cmdbuffer.h>
 #include <LCEVC/utility/md5.h>
@@ -26,7 +28,10 @@
 #include <range/v3/view/cartesian_product.hpp>
 #include <stdint.h>
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 namespace rg = ranges;
 namespace rv = ranges::views;
@@ -174,13 +179,164 @@ INSTANTIATE_TEST_SUITE_P(
         applyCmdBufferTestParams{4, LdpFPU8, 0, false, true, false, "f2468e478689739ea95e7daf9b1c5d4e"},
         applyCmdBufferTestParams{4, LdpFPU8, 0, false, false, false, "f2468e478689739ea95e7daf9b1c5d4e"},
         applyCmdBufferTestParams{4, LdpFPU8, 2, false, false, false, "f2468e478689739ea95e7daf9b1c5d4e"},
-        applyCmdBufferTestParams{4, LdpFPS8, 0, false, false, false, "9495d255bfab0bdbb06ac305bfff1e21"},
-        applyCmdBufferTestParams{16, LdpFPS8, 0, false, false, false, "8a28bc2f91d597679712d6d717cb2800"},
+        applyCmdBufferTestParams{4, LdpFPS8, 0, false, false, false, "594087680684703c94cc2b1854f66e29"},
+        applyCmdBufferTestParams{16, LdpFPS8, 0, false, false, false, "0ff4a90a59968a54e35ee34d8ab7da57"},
         applyCmdBufferTestParams{16, LdpFPS10, 0, false, false, false, "0ff4a90a59968a54e35ee34d8ab7da57"},
-        applyCmdBufferTestParams{16, LdpFPS8, 0, true, false, false, "1601070b19d3f68761b18b5693d6c89d"},
+        applyCmdBufferTestParams{16, LdpFPS8, 0, true, false, false, "43f8e9f02215913b66f1ab2ff51c022e"},
         applyCmdBufferTestParams{16, LdpFPS10, 0, true, false, false, "43f8e9f02215913b66f1ab2ff51c022e"},
         applyCmdBufferTestParams{16, LdpFPU12, 0, true, false, false, "9ad5b2cd7aa4115fea6f9d51e38c670c"},
         applyCmdBufferTestParams{16, LdpFPU12, 3, true, false, false, "9ad5b2cd7aa4115fea6f9d51e38c670c"},
-        applyCmdBufferTestParams{16, LdpFPS8, 0, false, false, true, "6fc6eee07ccad0a2f1d271360d9da5aa"},
+        applyCmdBufferTestParams{16, LdpFPS8, 0, false, false, true, "41451267c6a190a58f8b326fdd4c1f38"},
         applyCmdBufferTestParams{4, LdpFPU10, 0, false, false, true, "d8e7eb2cee934527d5cf0c49bc86b441"}),
-    testNames);
\ No newline at end of file
+    testNames);
+// -----------------------------------------------------------------------------
+
+// Fills almost every TU of the plane, so that runs of the same command on horizontally adjacent
+// TUs reach the paired SIMD paths. Every eleventh TU is left out to break up the pairs.
+class ApplyCmdBufferDense : public ApplyCmdBufferHash
+{
+protected:
+    void SetUp() override
+    {
+        ApplyCmdBufferHash::SetUp();
+        fillPlaneWithNoise(testPlane);
+        initialPlane.assign(testPlane.planeDesc.firstSample,
+                            testPlane.planeDesc.firstSample + testPlane.size());
+    }
+
+    void TearDown() override
+    {
+        ldcAccelerationSetKernelLevel(LdcKernelApplyCmdBuffer, LdcAccelerationLevelAuto);
+        ApplyCmdBufferHash::TearDown();
+    }
+
+    static void fillDenseCmdBuffer(LdeCmdBufferCpu* cmdBuffer, uint8_t transformSize,
+                                   LdpFixedPoint fixedPoint, bool surfaceRasterOrder)
+    {
+        const uint8_t tuWidthShift = (transformSize == 16) ? 2 : 1;
+        const uint32_t tuSize = 1 << tuWidthShift;
+        TUState tuState = {};
+        ldeTuStateInitialize(&tuState, kWidth, kHeight, 0, 0, tuWidthShift);
+
+        std::vector<uint32_t> tuIndices;
+        for (uint32_t y = 0; y < kHeight; y += tuSize) {
+            for (uint32_t x = 0; x < kWidth; x += tuSize) {
+                tuIndices.push_back(surfaceRasterOrder
+                                        ? ldeTuCoordsSurfaceIndex(&tuState, x, y)
+                                        : ldeTuCoordsBlockAlignedIndex(&tuState, x, y));
+            }
+        }
+        std::sort(tuIndices.begin(), tuIndices.end());
+
+        // Surface raster order is only used for adds, block order mixes in runs of other commands
+        const bool mixCommands = !surfaceRasterOrder && fixedPointIsSigned(fixedPoint);
+        int16_t residuals[16] = {0};
+        uint32_t lastTuIndex = 0;
+
+        for (uint32_t idx = 0; idx < tuIndices.size(); ++idx) {
+            if (idx % 11 == 10) {
+                continue;
+            }
+
+            LdeCmdBufferCpuCmd command = CBCCAdd;
+            if (mixCommands && (idx % 7 == 3 || idx % 7 == 4)) {
+                command = CBCCSet;
+            } else if (mixCommands && idx % 7 == 5) {
+                command = CBCCSetZero;
+            }
+
+            for (uint32_t layer = 0; layer < 16; ++layer) {
+                residuals[layer] = static_cast<int16_t>(((idx * 37 + layer * 101) % 4096) - 2048);
+            }
+
+            ldeCmdBufferCpuAppend(cmdBuffer, command, residuals, tuIndices[idx] - lastTuIndex);
+            lastTuIndex = tuIndices[idx];
+        }
+    }
+
+    std::string applyAndHash(LdpEnhancementTile* tile, bool forceScalar)
+    {
+        const applyCmdBufferTestParams params = GetParam();
+
+        memcpy(testPlane.planeDesc.firstSample, initialPlane.data(), initialPlane.size());
+        EXPECT_TRUE(ldppApplyCmdBuffer(&taskPool, NULL, tile, params.fixedPoint,
+                                       &testPlane.planeDesc, params.surfaceRasterOrder,
+                                       forceScalar, params.highlight));
+        return hashPlane();
+    }
+
+    std::vector<uint8_t> initialPlane;
+};
+
+TEST_P(ApplyCmdBufferDense, MatchesScalarAtEachLevel)
+{
+    const applyCmdBufferTestParams params = GetParam();
+    fillDenseCmdBuffer(&enhancementTile.buffer, params.transformSize, params.fixedPoint,
+                       params.surfaceRasterOrder);
+
+    const std::string expected = applyAndHash(&enhancementTile, true);
+
+    ldcAccelerationSetKernelLevel(LdcKernelApplyCmdBuffer, LdcAccelerationLevelBaseline);
+    EXPECT_EQ(applyAndHash(&enhancementTile, false), expected) << "baseline";
+
+    ldcAccelerationSetKernelLevel(LdcKernelApplyCmdBuffer, LdcAccelerationLevelAVX2);
+    if (ldcAccelerationGetKernel(LdcKernelApplyCmdBuffer)->AVX2) {
+        EXPECT_EQ(applyAndHash(&enhancementTile, false), expected) << "avx2";
+    }
+}
+
+const std::vector<bool> kFalse = {false};
+
+const auto kDenseParams =
+    rv::cartesian_product(kTransformSizes, kFixedPointAll, kEntryPoints, kBools, kFalse, kBools) |
+    rv::transform([](auto value) {
+        return applyCmdBufferTestParams{std::get<0>(value), std::get<1>(value), std::get<2>(value),
+                                        std::get<3>(value), std::get<4>(value), std::get<5>(value)};
+    }) |
+    rg::to_vector;
+
+INSTANTIATE_TEST_SUITE_P(Dense, ApplyCmdBufferDense, testing::ValuesIn(kDenseParams), testNames);
+
+// -----------------------------------------------------------------------------
+
+// Splitting a command buffer into one entry point per worker must give the same plane as applying
+// it from a single entry point.
+class ApplyCmdBufferEntryPoints : public ApplyCmdBufferDense
+{};
+
+TEST_P(ApplyCmdBufferEntryPoints, MatchesSingleEntryPoint)
+{
+    const applyCmdBufferTestParams params = GetParam();
+
+    LdpEnhancementTile singleTile = enhancementTile;
+    ldeCmdBufferCpuInitialize(allocator, &singleTile.buffer, 0);
+    ldeCmdBufferCpuReset(&singleTile.buffer, params.transformSize);
+    fillDenseCmdBuffer(&singleTile.buffer, params.transformSize, params.fixedPoint,
+                       params.surfaceRasterOrder);
+    const std::string expected = applyAndHash(&singleTile, params.forceScalar);
+    ldeCmdBufferCpuFree(&singleTile.buffer);
+
+    fillDenseCmdBuffer(&enhancementTile.buffer, params.transformSize, params.fixedPoint,
+                       params.surfaceRasterOrder);
+    ldeCmdBufferCpuSplit(&enhancementTile.buffer);
+    for (uint16_t idx = 0; idx < params.entryPoints; ++idx) {
+        EXPECT_GT(enhancementTile.buffer.entryPoints[idx].count, 0u);
+    }
+
+    EXPECT_EQ(applyAndHash(&enhancementTile, params.forceScalar), expected);
+}
+
+// One entry point for each worker thread of the task pool
+const std::vector<uint16_t> kWorkerEntryPoints = {4};
+
+const auto kEntryPointParams =
+    rv::cartesian_product(kTransformSizes, kFixedPointAll, kWorkerEntryPoints, kBools, kBools,
+                          kFalse) |
+    rv::transform([](auto value) {
+        return applyCmdBufferTestParams{std::get<0>(value), std::get<1>(value), std::get<2>(value),
+                                        std::get<3>(value), std::get<4>(value), std::get<5>(value)};
+    }) |
+    rg::to_vector;
+
+INSTANTIATE_TEST_SUITE_P(EntryPoints, ApplyCmdBufferEntryPoints,
+                         testing::ValuesIn(kEntryPointParams), testNames);
@@ -17,6 +17,8 @@
 #include "test_plane.h"
 
 #include <gtest/gtest.h>
+#include <LCEVC/common/acceleration.h>
+#include <LCEVC/pipeline/picture_layout.h>
 #include <LCEVC/pixel_processing/blit.h>
 #include <range/v3/view.hpp>
 #include <rng.h>
@@ -49,15 +51,56 @@ struct BlitTestParams
 {
     LdpFixedPoint srcFP;
     LdpFixedPoint dstFP;
+    LdcAccelerationLevel level;
 };
 
 // -----------------------------------------------------------------------------
 
-class BlitTest : public testing::TestWithParam<BlitTestParams>
+// Forces the blit kernels to the parameter's acceleration level, so each SIMD implementation is
+// compared with scalar rather than only the widest one this CPU supports.
+class BlitLevelTest : public testing::TestWithParam<BlitTestParams>
 {
 protected:
     void SetUp() override
     {
+        const LdcAccelerationLevel level = GetParam().level;
+        ldcAccelerationSetKernelLevel(LdcKernelBlit, level);
+
+        if (!levelSupported(level)) {
+            GTEST_SKIP() << "Acceleration level not supported";
+        }
+    }
+
+    void TearDown() override
+    {
+        ldcAccelerationSetKernelLevel(LdcKernelBlit, LdcAccelerationLevelAuto);
+    }
+
+    static bool levelSupported(LdcAccelerationLevel level)
+    {
+        const LdcAccelerationFeatures* features = ldcAccelerationGetKernel(LdcKernelBlit);
+
+        switch (level) {
+            case LdcAccelerationLevelAVX512: return features->AVX512;
+            case LdcAccelerationLevelAVX2: return features->AVX2;
+            default: break;
+        }
+        return features->SSE || features->NEON;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+class BlitTest : public BlitLevelTest
+{
+protected:
+    void SetUp() override
+    {
+        BlitLevelTest::SetUp();
+        if (IsSkipped()) {
+            return;
+        }
+
         const auto& params = GetParam();
         m_scalarFunction =
             planeBlitGetFunction(params.srcFP, params.dstFP, BMCopy, kForceScalar, 0, false);
@@ -141,6 +184,62 @@ TEST_P(AddTest, CompareSIMD)
 
 // -----------------------------------------------------------------------------
 
+class AddCopyTest : public BlitLevelTest
+{};
+
+TEST_P(AddCopyTest, MatchesAddThenCopy)
+{
+    const LdpFixedPoint dstFP = GetParam().dstFP;
+    const LdpFixedPoint srcFP = GetParam().srcFP;
+    const LdpColorFormat kFormats[] = {LdpColorFormatGRAY_8, LdpColorFormatGRAY_10_LE,
+                                       LdpColorFormatGRAY_12_LE, LdpColorFormatGRAY_14_LE};
+
+    LdpPictureLayout srcLayout{};
+    LdpPictureLayout dstLayout{};
+    ldpInternalPictureLayoutInitialize(&srcLayout, kFormats[dstFP], kWidth, kHeight, 0);
+    ldpPictureLayoutInitialize(&dstLayout, kFormats[dstFP], kWidth, kHeight, 0);
+
+    TestPlane src{};
+    TestPlane residuals{};
+    TestPlane sum{};
+    TestPlane expected{};
+    TestPlane actual{};
+    src.initialize(kWidth, kHeight, kStride, srcFP);
+    residuals.initialize(kWidth, kHeight, kStride, srcFP);
+    sum.initialize(kWidth, kHeight, kStride, srcFP);
+    expected.initialize(kWidth, kHeight, kStride, dstFP);
+    actual.initialize(kWidth, kHeight, kStride, dstFP);
+    fillPlaneWithNoise(src);
+    fillPlaneWithNoise(residuals);
+
+    // Reference: add residuals to a copy of the source, then convert
+    memcpy(sum.planeDesc.firstSample, src.planeDesc.firstSample, src.size());
+    EXPECT_TRUE(ldppPlaneBlitRows(kForceScalar, 0, &srcLayout, &srcLayout, &residuals.planeDesc,
+                                  &sum.planeDesc, BMAdd, 0, kHeight));
+    EXPECT_TRUE(ldppPlaneBlitRows(kForceScalar, 0, &srcLayout, &dstLayout, &sum.planeDesc,
+                                  &expected.planeDesc, BMCopy, 0, kHeight));
+
+    for (const bool forceScalar : {kForceScalar, kSelectSIMD}) {
+        memset(actual.planeDesc.firstSample, 0, actual.size());
+        EXPECT_TRUE(ldppPlaneBlitAddRows(forceScalar, 0, &srcLayout, &dstLayout, &src.planeDesc,
+                                         &residuals.planeDesc, &actual.planeDesc, 0, kHeight));
+        EXPECT_EQ(memcmp(expected.planeDesc.firstSample, actual.planeDesc.firstSample, expected.size()), 0);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+static const char* levelToString(LdcAccelerationLevel level)
+{
+    switch (level) {
+        case LdcAccelerationLevelBaseline: return "baseline";
+        case LdcAccelerationLevelAVX2: return "avx2";
+        case LdcAccelerationLevelAVX512: return "avx512";
+        default: break;
+    }
+    return "auto";
+}
+
 // Helper for printing a meaningful name for the test parameter
 std::string CopyToString(const testing::TestParamInfo<BlitTestParams>& value)
 {
@@ -148,7 +247,8 @@ std::string CopyToString(const testing::TestParamInfo<BlitTestParams>& value)
     const LdpFixedPoint dstFP = value.param.dstFP;
 
     std::stringstream ss;
-    ss << fixedPointToString(srcFP) << "_to_" << fixedPointToString(dstFP);
+    ss << fixedPointToString(srcFP) << "_to_" << fixedPointToString(dstFP) << "_"
+       << levelToString(value.param.level);
     return ss.str();
 }
 //
@@ -158,7 +258,8 @@ std::string BlitToString(const testing::TestParamInfo<BlitTestParams>& value)
     const LdpFixedPoint dstFP = value.param.dstFP;
 
     std::stringstream ss;
-    ss << fixedPointToString(srcFP) << "_on_" << fixedPointToString(dstFP);
+    ss << fixedPointToString(srcFP) << "_on_" << fixedPointToString(dstFP) << "_"
+       << levelToString(value.param.level);
     return ss.str();
 }
 
@@ -169,9 +270,12 @@ const std::vector<LdpFixedPoint> kFixedPointUnsigned = {LdpFPU8, LdpFPU10, LdpFP
 const std::vector<LdpFixedPoint> kFixedPointAll = {LdpFPU8, LdpFPU10, LdpFPU12, LdpFPU14,
                                                    LdpFPS8, LdpFPS10, LdpFPS12, LdpFPS14};
 
+const std::vector<LdcAccelerationLevel> kLevels = {
+    LdcAccelerationLevelBaseline, LdcAccelerationLevelAVX2, LdcAccelerationLevelAVX512};
+
 // -----------------------------------------------------------------------------
 
-const auto kCopyParams = rv::cartesian_product(kFixedPointAll, kFixedPointAll) |
+const auto kCopyParams = rv::cartesian_product(kFixedPointAll, kFixedPointAll, kLevels) |
                          rv::filter([](auto value) {
                              const LdpFixedPoint srcFP = std::get<0>(value);
                              const LdpFixedPoint dstFP = std::get<1>(value);
@@ -192,7 +296,8 @@ const auto kCopyParams = rv::cartesian_product(kFixedPointAll, kFixedPointAll) |
                              return isDepthPromotion && !areBothSigned;
                          }) |
                          rv::transform([](auto value) {
-                             return BlitTestParams{std::get<0>(value), std::get<1>(value)};
+                             return BlitTestParams{std::get<0>(value), std::get<1>(value),
+                                                   std::get<2>(value)};
                          }) |
                          rg::to_vector;
 
@@ -200,11 +305,32 @@ INSTANTIATE_TEST_SUITE_P(BlitTests, CopyTest, testing::ValuesIn(kCopyParams), Co
 
 // -----------------------------------------------------------------------------
 
-const auto kBlitParams = kFixedPointAll | rv::transform([](auto value) {
-                             return BlitTestParams{fixedPointHighPrecision(value), value};
+const auto kBlitParams = rv::cartesian_product(kFixedPointAll, kLevels) |
+                         rv::transform([](auto value) {
+                             const LdpFixedPoint fp = std::get<0>(value);
+                             return BlitTestParams{fixedPointHighPrecision(fp), fp,
+                                                   std::get<1>(value)};
                          }) |
                          rg::to_vector;
 
 INSTANTIATE_TEST_SUITE_P(BlitTests, AddTest, testing::ValuesIn(kBlitParams), BlitToString);
 
 // -----------------------------------------------------------------------------
+
+const auto kAddCopyParams = rv::cartesian_product(kFixedPointUnsigned, kLevels) |
+                            rv::transform([](auto value) {
+                                const LdpFixedPoint fp = std::get<0>(value);
+                                return BlitTestParams{fixedPointHighPrecision(fp), fp,
+                                                      std::get<1>(value)};
+                            }) |
+                            rg::to_vector;
+
+INSTANTIATE_TEST_SUITE_P(BlitTests, AddCopyTest, testing::ValuesIn(kAddCopyParams),
+                         [](const testing::TestParamInfo<BlitTestParams>& value) {
+                             std::stringstream ss;
+                             ss << fixedPointToString(value.param.dstFP) << "_"
+                                << levelToString(value.param.level);
+                             return ss.str();
+                         });
+
+// -----------------------------------------------------------------------------
@@ -15,7 +15,10 @@
 #include "test_plane.h"
 
 #include <find_assets_dir.h>
+#include <LCEVC/common/acceleration.h>
 #include <LCEVC/common/diagnostics.h>
+#include <LCEVC/common/limit.h>
+#include <LCEVC/pixel_processing/dither.h>
 #include <LCEVC/pixel_processing/upscale.h>
 extern "C"
 {
@@ -26,6 +29,10 @@ extern "C"
 #include <range/v3/view.hpp>
 #include <range/v3/view/cartesian_product.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
 // -----------------------------------------------------------------------------
 
 using namespace lcevc_dec::utility;
@@ -164,4 +171,443 @@ TEST_P(UpscaleTest, HashPlane)
     EXPECT_EQ(params.hash, hashActiveRegion(m_dst));
 }
 
+TEST_P(UpscaleTest, HashPlaneWithoutAVX2)
+{
+    const UpscaleTestParams params = GetParam();
+
+    // The SIMD hashes are shared, so check the SSE path as well on CPUs that select AVX2
+    ldcAccelerationSetKernelLevel(LdcKernelUpscale, LdcAccelerationLevelBaseline);
+    ldppUpscale(m_allocator, &m_taskPool, NULL, &m_kernel, &m_args);
+    ldcAccelerationSetKernelLevel(LdcKernelUpscale, LdcAccelerationLevelAuto);
+
+    EXPECT_EQ(params.hash, hashActiveRegion(m_dst));
+}
+
+TEST_P(UpscaleTest, HashPlaneRows)
+{
+    const UpscaleTestParams params = GetParam();
+
+    // Upscale in bands of source rows, with an intermediate plane that only holds one band
+    constexpr uint32_t kBandRows = 7;
+    const uint32_t rowScale = (params.scalingMode == Scale2D) ? 2 : 1;
+    const uint32_t intermediateStride = ldppUpscaleIntermediateRowStride(&m_args);
+    std::vector<uint8_t> intermediate(kBandRows * rowScale * intermediateStride + 1);
+
+    for (uint32_t row = 0; row < kHeight; row += kBandRows) {
+        const uintptr_t bandOffset = static_cast<uintptr_t>(row) * rowScale * intermediateStride;
+        const LdpPicturePlaneDesc intermediateDesc{
+            reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(intermediate.data()) - bandOffset),
+            intermediateStride};
+        EXPECT_TRUE(ldppUpscaleRows(&m_kernel, &m_args, &intermediateDesc, row, kBandRows));
+    }
+
+    EXPECT_EQ(params.hash, hashActiveRegion(m_dst));
+}
+
 INSTANTIATE_TEST_SUITE_P(UpscaleTests, UpscaleTest, testing::ValuesIn(kUpscaleTestParams), testNames);
+
+// -----------------------------------------------------------------------------
+
+// Upscales that read or write an unsigned plane directly, compared with the same upscale done
+// in the internal signed format with separate conversions.
+
+typedef struct UpscaleConversionTestParams
+{
+    UpscaleTestParams upscale;
+    LdpFixedPoint unsignedFP;
+} UpscaleConversionTestParams;
+
+std::string conversionTestNames(const testing::TestParamInfo<UpscaleConversionTestParams>& value)
+{
+    const UpscaleConversionTestParams params = value.param;
+    return testNames({params.upscale, value.index}) + "_" + fixedPointToString(params.unsignedFP);
+}
+
+const std::vector<LdpFixedPoint> kUnsignedFixedPoints = {LdpFPU8, LdpFPU10, LdpFPU12, LdpFPU14};
+
+const auto kUpscaleConversionTestParams =
+    rv::cartesian_product(kUpscaleTestParams, kUnsignedFixedPoints) |
+    rv::transform([](auto value) {
+        return UpscaleConversionTestParams{std::get<0>(value), std::get<1>(value)};
+    }) |
+    rg::to_vector;
+
+static LdpColorFormat grayColorFormat(LdpFixedPoint fp)
+{
+    switch (fp) {
+        case LdpFPU10: return LdpColorFormatGRAY_10_LE;
+        case LdpFPU12: return LdpColorFormatGRAY_12_LE;
+        case LdpFPU14: return LdpColorFormatGRAY_14_LE;
+        default: return LdpColorFormatGRAY_8;
+    }
+}
+
+static int16_t promoteSample(LdpFixedPoint unsignedFP, uint16_t value)
+{
+    switch (unsignedFP) {
+        case LdpFPU10: return fpU10ToS10(value);
+        case LdpFPU12: return fpU12ToS12(value);
+        case LdpFPU14: return fpU14ToS14(value);
+        default: return fpU8ToS8(static_cast<uint8_t>(value));
+    }
+}
+
+static uint16_t demoteSample(LdpFixedPoint unsignedFP, int32_t value)
+{
+    switch (unsignedFP) {
+        case LdpFPU10: return fpS10ToU10(value);
+        case LdpFPU12: return fpS12ToU12(value);
+        case LdpFPU14: return fpS14ToU14(value);
+        default: return fpS8ToU8(value);
+    }
+}
+
+class UpscaleConversionTest : public testing::TestWithParam<UpscaleConversionTestParams>
+{
+protected:
+    void SetUp() override
+    {
+        const UpscaleConversionTestParams params = GetParam();
+        m_allocator = ldcMemoryAllocatorMalloc();
+        ldcTaskPoolInitialize(&m_taskPool, m_allocator, m_allocator, params.upscale.threads,
+                              params.upscale.threads);
+
+        m_unsignedFP = params.unsignedFP;
+        m_signedFP = fixedPointHighPrecision(m_unsignedFP);
+        m_dstWidth = kWidth * 2;
+        m_dstHeight = params.upscale.scalingMode == Scale1D ? kHeight : kHeight * 2;
+
+        // Unsigned source, and the same source converted to the internal signed format
+        m_unsignedSrc.initialize(kWidth, kHeight, 256, m_unsignedFP);
+        m_convertedSrc.initialize(kWidth, kHeight, 256, m_signedFP);
+        fillPlaneWithNoise(m_unsignedSrc);
+        for (uint32_t y = 0; y < kHeight; ++y) {
+            const uint8_t* src =
+                m_unsignedSrc.planeDesc.firstSample + y * m_unsignedSrc.planeDesc.rowByteStride;
+            int16_t* dst = reinterpret_cast<int16_t*>(m_convertedSrc.planeDesc.firstSample +
+                                                      y * m_convertedSrc.planeDesc.rowByteStride);
+            for (uint32_t x = 0; x < kWidth; ++x) {
+                const uint16_t value = m_unsignedFP == LdpFPU8
+                                           ? src[x]
+                                           : reinterpret_cast<const uint16_t*>(src)[x];
+                dst[x] = promoteSample(m_unsignedFP, value);
+            }
+        }
+
+        const LdpColorFormat format = grayColorFormat(m_unsignedFP);
+        ldpPictureLayoutInitialize(&m_unsignedSrcLayout, format, kWidth, kHeight, 0);
+        ldpInternalPictureLayoutInitialize(&m_convertedSrcLayout, format, kWidth, kHeight, 0);
+        ldpInternalPictureLayoutInitialize(&m_signedDstLayout, format, m_dstWidth, m_dstHeight, 0);
+        ldpPictureLayoutInitialize(&m_unsignedDstLayout, format, m_dstWidth, m_dstHeight, 0);
+
+        m_kernel = getUpscaleKernel(params.upscale.upscaleType);
+        m_args.applyPA = params.upscale.predictedAverage;
+        m_args.forceScalar = params.upscale.forceScalar;
+        m_args.mode = params.upscale.scalingMode;
+
+        // Signed upscale of the converted source, as the reference
+        m_signedDst.initialize(m_dstWidth, m_dstHeight, 512, m_signedFP);
+        m_args.srcLayout = &m_convertedSrcLayout;
+        m_args.srcPlane = m_convertedSrc.planeDesc;
+        m_args.dstLayout = &m_signedDstLayout;
+        m_args.dstPlane = m_signedDst.planeDesc;
+        EXPECT_TRUE(ldppUpscale(m_allocator, &m_taskPool, NULL, &m_kernel, &m_args));
+    }
+
+    void TearDown() override { ldcTaskPoolDestroy(&m_taskPool); }
+
+    LdcMemoryAllocator* m_allocator = nullptr;
+    LdcTaskPool m_taskPool = {0};
+    LdpFixedPoint m_unsignedFP = LdpFPU8;
+    LdpFixedPoint m_signedFP = LdpFPS8;
+    uint32_t m_dstWidth = 0;
+    uint32_t m_dstHeight = 0;
+    TestPlane m_unsignedSrc = {};
+    TestPlane m_convertedSrc = {};
+    TestPlane m_signedDst = {};
+    LdpPictureLayout m_unsignedSrcLayout = {0};
+    LdpPictureLayout m_convertedSrcLayout = {0};
+    LdpPictureLayout m_signedDstLayout = {0};
+    LdpPictureLayout m_unsignedDstLayout = {0};
+    LdeKernel m_kernel = {};
+    LdppUpscaleArgs m_args = {0};
+};
+
+TEST_P(UpscaleConversionTest, PromotionMatchesConvertedSource)
+{
+    if (!ldppUpscalePromotionSupported(m_unsignedFP, m_args.forceScalar)) {
+        GTEST_SKIP() << "Upscale from " << fixedPointToString(m_unsignedFP) << " not supported";
+    }
+
+    TestPlane actual;
+    actual.initialize(m_dstWidth, m_dstHeight, 512, m_signedFP);
+    m_args.srcLayout = &m_unsignedSrcLayout;
+    m_args.srcPlane = m_unsignedSrc.planeDesc;
+    m_args.dstPlane = actual.planeDesc;
+    EXPECT_TRUE(ldppUpscale(m_allocator, &m_taskPool, NULL, &m_kernel, &m_args));
+    EXPECT_EQ(hashActiveRegion(m_signedDst), hashActiveRegion(actual));
+}
+
+TEST_P(UpscaleConversionTest, DemotionMatchesConvertedDestination)
+{
+    if (!ldppUpscaleDemotionSupported(m_signedFP, m_unsignedFP, m_args.forceScalar)) {
+        GTEST_SKIP() << "Upscale to " << fixedPointToString(m_unsignedFP) << " not supported";
+    }
+
+    // The signed reference upscale, converted to unsigned afterwards
+    TestPlane expected;
+    expected.initialize(m_dstWidth, m_dstHeight, 512, m_unsignedFP);
+    for (uint32_t y = 0; y < m_dstHeight; ++y) {
+        const int16_t* src = reinterpret_cast<const int16_t*>(
+            m_signedDst.planeDesc.firstSample + y * m_signedDst.planeDesc.rowByteStride);
+        uint8_t* dst = expected.planeDesc.firstSample + y * expected.planeDesc.rowByteStride;
+        for (uint32_t x = 0; x < m_dstWidth; ++x) {
+            const uint16_t value = demoteSample(m_unsignedFP, src[x]);
+            if (m_unsignedFP == LdpFPU8) {
+                dst[x] = static_cast<uint8_t>(value);
+            } else {
+                reinterpret_cast<uint16_t*>(dst)[x] = value;
+            }
+        }
+    }
+
+    TestPlane actual;
+    actual.initialize(m_dstWidth, m_dstHeight, 512, m_unsignedFP);
+    m_args.dstLayout = &m_unsignedDstLayout;
+    m_args.dstPlane = actual.planeDesc;
+    EXPECT_TRUE(ldppUpscale(m_allocator, &m_taskPool, NULL, &m_kernel, &m_args));
+    EXPECT_EQ(hashActiveRegion(expected), hashActiveRegion(actual));
+
+    // Unsigned source and destination at signed precision
+    if (m_args.mode == Scale2D && ldppUpscalePromotionSupported(m_unsignedFP, m_args.forceScalar)) {
+        TestPlane actualUnsigned;
+        actualUnsigned.initialize(m_dstWidth, m_dstHeight, 512, m_unsignedFP);
+        m_args.srcLayout = &m_unsignedSrcLayout;
+        m_args.srcPlane = m_unsignedSrc.planeDesc;
+        m_args.dstPlane = actualUnsigned.planeDesc;
+        m_args.signedPrecision = true;
+        EXPECT_TRUE(ldppUpscale(m_allocator, &m_taskPool, NULL, &m_kernel, &m_args));
+        EXPECT_EQ(hashActiveRegion(expected), hashActiveRegion(actualUnsigned));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(UpscaleConversionTests, UpscaleConversionTest,
+                         testing::ValuesIn(kUpscaleConversionTestParams), conversionTestNames);
+
+// -----------------------------------------------------------------------------
+
+// Every SIMD level must produce the same upscale as the scalar reference, so each level is forced
+// in turn. Dithered output is not bit-identical across levels - each kernel consumes the entropy
+// buffer in its own order - so dither is checked by its amplitude instead.
+
+static constexpr uint8_t kDitherStrength = 7;
+
+typedef struct UpscaleSIMDTestParams
+{
+    LdpColorFormat format;
+    bool internal;
+    uint32_t planeIndex;
+    LdeScalingMode scalingMode;
+    bool predictedAverage;
+    LdcAccelerationLevel level;
+} UpscaleSIMDTestParams;
+
+std::string simdTestNames(const testing::TestParamInfo<UpscaleSIMDTestParams>& value)
+{
+    const UpscaleSIMDTestParams params = value.param;
+    LdpPictureLayout layout = {0};
+
+    if (params.internal) {
+        ldpInternalPictureLayoutInitialize(&layout, params.format, kWidth, kHeight, 0);
+    } else {
+        ldpPictureLayoutInitialize(&layout, params.format, kWidth, kHeight, 0);
+    }
+
+    std::string level = params.level == LdcAccelerationLevelAVX2 ? "_avx2" : "_baseline";
+    std::string interleaving = ldpPictureLayoutIsInterleaved(&layout) ? "_nv12" : "_planar";
+    std::string pa = params.predictedAverage ? "_paOn" : "_paOff";
+    std::stringstream ss;
+    ss << fixedPointToString(layout.layoutInfo->fixedPoint) << interleaving << "_"
+       << scalingModeToString(params.scalingMode) << pa << level;
+    return ss.str();
+}
+
+const std::vector<UpscaleSIMDTestParams> kSIMDFormats = {
+    /* clang-format off */
+    {LdpColorFormatGRAY_8,     false, 0},
+    {LdpColorFormatGRAY_10_LE, false, 0},
+    {LdpColorFormatGRAY_12_LE, false, 0},
+    {LdpColorFormatGRAY_14_LE, false, 0},
+    {LdpColorFormatGRAY_8,     true,  0},
+    {LdpColorFormatGRAY_10_LE, true,  0},
+    {LdpColorFormatGRAY_12_LE, true,  0},
+    {LdpColorFormatGRAY_14_LE, true,  0},
+    {LdpColorFormatNV12_8,     false, 1},
+    {LdpColorFormatNV12_8,     true,  1},
+    /* clang-format on */
+};
+
+const std::vector<LdeScalingMode> kSIMDScalingModes = {Scale1D, Scale2D};
+const std::vector<bool> kSIMDPredictedAverage = {kPAOff, kPAOn};
+const std::vector<LdcAccelerationLevel> kSIMDLevels = {LdcAccelerationLevelBaseline,
+                                                       LdcAccelerationLevelAVX2};
+
+const auto kUpscaleSIMDTestParams =
+    rv::cartesian_product(kSIMDFormats, kSIMDScalingModes, kSIMDPredictedAverage, kSIMDLevels) |
+    rv::transform([](auto value) {
+        UpscaleSIMDTestParams test = std::get<0>(value);
+        test.scalingMode = std::get<1>(value);
+        test.predictedAverage = std::get<2>(value);
+        test.level = std::get<3>(value);
+        return test;
+    }) |
+    rg::to_vector;
+
+static int32_t sampleAt(const TestPlane& plane, uint32_t x, uint32_t y)
+{
+    const uint8_t* row = plane.planeDesc.firstSample + y * plane.planeDesc.rowByteStride;
+
+    if (fixedPointByteSize(plane.fixedPoint) == 1) {
+        return row[x];
+    }
+    if (fixedPointIsSigned(plane.fixedPoint)) {
+        return reinterpret_cast<const int16_t*>(row)[x];
+    }
+    return reinterpret_cast<const uint16_t*>(row)[x];
+}
+
+class UpscaleSIMDTest : public testing::TestWithParam<UpscaleSIMDTestParams>
+{
+protected:
+    void SetUp() override
+    {
+        m_allocator = ldcMemoryAllocatorMalloc();
+        const UpscaleSIMDTestParams params = GetParam();
+        ldcTaskPoolInitialize(&m_taskPool, m_allocator, m_allocator, 1, 1);
+        ldppDitherGlobalInitialize(m_allocator, &m_ditherGlobal, 1);
+        ldppDitherFrameInitialise(&m_ditherFrame, &m_ditherGlobal, 1, kDitherStrength);
+
+        const uint32_t dstWidth = kWidth * 2;
+        const uint32_t dstHeight = params.scalingMode == Scale1D ? kHeight : kHeight * 2;
+
+        if (params.internal) {
+            ldpInternalPictureLayoutInitialize(&m_srcLayout, params.format, kWidth, kHeight, 0);
+            ldpInternalPictureLayoutInitialize(&m_dstLayout, params.format, dstWidth, dstHeight, 0);
+        } else {
+            ldpPictureLayoutInitialize(&m_srcLayout, params.format, kWidth, kHeight, 0);
+            ldpPictureLayoutInitialize(&m_dstLayout, params.format, dstWidth, dstHeight, 0);
+        }
+
+        m_src.initialize(planeSamples(m_srcLayout), planeHeight(m_srcLayout), 512,
+                         m_srcLayout.layoutInfo->fixedPoint);
+        fillPlaneWithNoise(m_src);
+
+        m_kernel = getUpscaleKernel(USCubic);
+        m_args.planeIndex = params.planeIndex;
+        m_args.applyPA = params.predictedAverage;
+        m_args.srcLayout = &m_srcLayout;
+        m_args.dstLayout = &m_dstLayout;
+        m_args.srcPlane = m_src.planeDesc;
+        m_args.mode = params.scalingMode;
+    }
+
+    void TearDown() override
+    {
+        ldcAccelerationSetKernelLevel(LdcKernelUpscale, LdcAccelerationLevelAuto);
+        ldppDitherGlobalRelease(&m_ditherGlobal);
+        ldcTaskPoolDestroy(&m_taskPool);
+    }
+
+    // Force the level under test, returning false if this CPU cannot run it.
+    bool forceLevel(LdcAccelerationLevel level) const
+    {
+        ldcAccelerationSetKernelLevel(LdcKernelUpscale, level);
+        const LdcAccelerationFeatures* features = ldcAccelerationGetKernel(LdcKernelUpscale);
+        if (level == LdcAccelerationLevelAVX2) {
+            return features->AVX2;
+        }
+        return features->SSE || features->NEON;
+    }
+
+    uint32_t planeSamples(const LdpPictureLayout& layout) const
+    {
+        const uint32_t plane = GetParam().planeIndex;
+        return (layout.width >> layout.layoutInfo->planeWidthShift[plane]) *
+               layout.layoutInfo->interleave[plane];
+    }
+
+    uint32_t planeHeight(const LdpPictureLayout& layout) const
+    {
+        return layout.height >> layout.layoutInfo->planeHeightShift[GetParam().planeIndex];
+    }
+
+    void upscale(TestPlane& dst, bool forceScalar, bool dither)
+    {
+        dst.initialize(planeSamples(m_dstLayout), planeHeight(m_dstLayout), 1024,
+                       m_dstLayout.layoutInfo->fixedPoint);
+        m_args.dstPlane = dst.planeDesc;
+        m_args.forceScalar = forceScalar;
+        m_args.frameDither = dither ? &m_ditherFrame : NULL;
+        EXPECT_TRUE(ldppUpscale(m_allocator, &m_taskPool, NULL, &m_kernel, &m_args));
+    }
+
+    // Largest perturbation the dither may add to a sample of the destination plane.
+    int32_t ditherAmplitude() const
+    {
+        const LdpFixedPoint dstFP = m_dstLayout.layoutInfo->fixedPoint;
+        return kDitherStrength << ldppDitherGetShiftS16(dstFP);
+    }
+
+    LdcMemoryAllocator* m_allocator = nullptr;
+    LdcTaskPool m_taskPool = {0};
+    LdppDitherGlobal m_ditherGlobal = {0};
+    LdppDitherFrame m_ditherFrame = {0};
+    TestPlane m_src = {};
+    LdpPictureLayout m_srcLayout = {0};
+    LdpPictureLayout m_dstLayout = {0};
+    LdppUpscaleArgs m_args = {0};
+    LdeKernel m_kernel = {};
+};
+
+TEST_P(UpscaleSIMDTest, MatchesScalar)
+{
+    TestPlane expected;
+    upscale(expected, true, false);
+
+    if (!forceLevel(GetParam().level)) {
+        GTEST_SKIP() << "Acceleration level not supported";
+    }
+
+    TestPlane actual;
+    upscale(actual, false, false);
+
+    EXPECT_EQ(hashActiveRegion(expected), hashActiveRegion(actual));
+}
+
+TEST_P(UpscaleSIMDTest, DitherAmplitude)
+{
+    if (!forceLevel(GetParam().level)) {
+        GTEST_SKIP() << "Acceleration level not supported";
+    }
+
+    for (const bool forceScalar : {true, false}) {
+        TestPlane plain;
+        TestPlane dithered;
+        upscale(plain, forceScalar, false);
+        upscale(dithered, forceScalar, true);
+
+        int32_t maxDifference = 0;
+        for (uint32_t y = 0; y < plain.height; ++y) {
+            for (uint32_t x = 0; x < plain.width; ++x) {
+                maxDifference = std::max(
+                    maxDifference, std::abs(sampleAt(dithered, x, y) - sampleAt(plain, x, y)));
+            }
+        }
+
+        EXPECT_GT(maxDifference, 0) << (forceScalar ? "scalar" : "simd");
+        EXPECT_LE(maxDifference, ditherAmplitude()) << (forceScalar ? "scalar" : "simd");
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(UpscaleSIMDTests, UpscaleSIMDTest,
+                         testing::ValuesIn(kUpscaleSIMDTestParams), simdTestNames);
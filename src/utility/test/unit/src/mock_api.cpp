@@ -256,6 +256,15 @@ LCEVC_ReturnCode LCEVC_SendDecoderEnhancementData(LCEVC_DecoderHandle decHandle,
     return LCEVC_Error;
 }
 
+LCEVC_ReturnCode LCEVC_SendDecoderEnhancementDataEx(LCEVC_DecoderHandle decHandle, uint64_t timestamp,
+                                                    const uint8_t* data, uint32_t byteSize,
+                                                    LCEVC_EnhancementDataReleaseCallback releaseCallback,
+                                                    void* userData)
+{
+    assert(0);
+    return LCEVC_Error;
+}
+
 LCEVC_ReturnCode LCEVC_SendDecoderBase(LCEVC_DecoderHandle decHandle, uint64_t timestamp,
                                        LCEVC_PictureHandle base, uint32_t timeoutUs, void* userData)
 {